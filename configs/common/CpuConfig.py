@@ -75,3 +75,15 @@ def config_etrace(cpu_cls, cpu_list, options):
             " type or inherited from DerivO3CPU.",
             cpu_cls,
         )
+
+
+def config_branch_trace(cpu_list, options):
+    # Attach a branch trace recorder to each cpu. The traces can be
+    # replayed into any branch predictor with configs/example/bpred_replay.py
+    for i, cpu in enumerate(cpu_list):
+        trace_file = options.branch_trace_file
+        if len(cpu_list) > 1:
+            trace_file = f"cpu{i}.{trace_file}"
+        cpu.branchTraceRecorder = m5.objects.BranchTraceRecorder(
+            trace_file=trace_file
+        )
@@ -378,6 +378,14 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
                       Trace CPU in a replay simulation""",
         default="",
     )
+    parser.add_argument(
+        "--branch-trace-file",
+        action="store",
+        type=str,
+        help="""Record the branches retired by each cpu to this
+                      branch trace in the output directory""",
+        default="",
+    )
 
     # dist-gem5 options
     parser.add_argument(
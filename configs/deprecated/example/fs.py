@@ -232,6 +232,9 @@ def build_test_system(np, isa: ISA):
         ):
             CpuConfig.config_etrace(TestCPUClass, test_sys.cpu, args)
 
+        if args.branch_trace_file:
+            CpuConfig.config_branch_trace(test_sys.cpu, args)
+
         CacheConfig.config_cache(args, test_sys)
 
         MemConfig.config_mem(args, test_sys)
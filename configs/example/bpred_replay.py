@@ -0,0 +1,122 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replay a recorded branch trace into a branch predictor without
+# simulating the CPU. The trace is written by a BranchTraceRecorder
+# attached to any CPU model, e.g. with the --branch-trace-file option
+# of se.py and fs.py:
+#
+#   build/ALL/gem5.opt configs/deprecated/example/se.py \
+#       --cpu-type O3CPU --branch-trace-file branches.trace.gz -c <binary>
+#   build/ALL/gem5.opt configs/example/bpred_replay.py \
+#       --trace m5out/branches.trace.gz --bp-type TAGE_SC_L_64KB
+#
+# The MPKI and the direction, BTB and RAS accuracy are reported in
+# stats.txt by the replayer, next to the usual predictor statistics.
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument(
+    "--trace", required=True, help="Branch trace of the branches to replay"
+)
+parser.add_argument(
+    "--bp-type",
+    default="TournamentBP",
+    choices=ObjectList.bp_list.get_names(),
+    help="Branch predictor to replay the trace into",
+)
+parser.add_argument(
+    "--indirect-bp-type",
+    default=None,
+    choices=ObjectList.indirect_bp_list.get_names(),
+    help="Indirect branch predictor, the predictor default if not set",
+)
+parser.add_argument(
+    "--btb-entries", type=int, default=None, help="Number of BTB entries"
+)
+parser.add_argument(
+    "--ras-entries", type=int, default=None, help="Number of RAS entries"
+)
+parser.add_argument(
+    "--inst-shift-amt",
+    type=int,
+    default=None,
+    help="Bits to shift the PCs by to index the predictor tables",
+)
+parser.add_argument(
+    "--inst-size",
+    type=int,
+    default=4,
+    help="Size of the branches the trace does not give the size of",
+)
+parser.add_argument(
+    "--num-threads", type=int, default=1, help="Number of threads in the trace"
+)
+
+args = parser.parse_args()
+
+bpred = ObjectList.bp_list.get(args.bp_type)()
+if args.indirect_bp_type:
+    bpred.indirectBranchPred = ObjectList.indirect_bp_list.get(
+        args.indirect_bp_type
+    )()
+if args.btb_entries:
+    bpred.btb.numEntries = args.btb_entries
+if args.ras_entries:
+    bpred.ras.numEntries = args.ras_entries
+if args.inst_shift_amt is not None:
+    bpred.instShiftAmt = args.inst_shift_amt
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=VoltageDomain()
+)
+
+system.replayer = BranchTraceReplayer(
+    bpred=bpred,
+    trace_file=args.trace,
+    inst_size=args.inst_size,
+    numThreads=args.num_threads,
+)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+start = time.perf_counter()
+exit_event = m5.simulate()
+host_seconds = time.perf_counter() - start
+
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
+print(f"Replayed the trace in {host_seconds:.2f} host seconds")
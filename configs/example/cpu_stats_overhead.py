@@ -0,0 +1,128 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Measure the host time a CPU model spends per simulated instruction,
+# e.g. to see the cost of the per instruction statistics accounting on
+# the commit paths. The workload is run in SE mode for a number of
+# instructions, optionally dumping the statistics periodically, and the
+# host time per committed instruction is reported:
+#
+#   build/RISCV/gem5.opt configs/example/cpu_stats_overhead.py \
+#       --cpu-type RiscvAtomicSimpleCPU --max-insts 100000000 \
+#       --dump-insts 1000000 tests/test-progs/hello/bin/riscv/linux/hello
+#
+# gem5 can't switch statistics off at run time, so compare runs of builds
+# with and without a change to the accounting, and runs with and without
+# periodic dumps, which is where the accounted counts are flushed.
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument("binary", help="SE mode workload to run")
+parser.add_argument("--options", default="", help="Arguments of the workload")
+parser.add_argument(
+    "--cpu-type",
+    default="AtomicSimpleCPU",
+    choices=ObjectList.cpu_list.get_names(),
+    help="CPU model to measure",
+)
+parser.add_argument(
+    "--max-insts",
+    type=int,
+    default=10000000,
+    help="Number of instructions to simulate",
+)
+parser.add_argument(
+    "--dump-insts",
+    type=int,
+    default=0,
+    help="Dump the statistics every this many instructions (0 disables "
+    "the periodic dumps)",
+)
+parser.add_argument("--clock", default="1GHz", help="CPU clock")
+
+args = parser.parse_args()
+
+CPUClass = ObjectList.cpu_list.get(args.cpu_type)
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock=args.clock, voltage_domain=VoltageDomain()
+)
+system.mem_mode = CPUClass.memory_mode()
+system.mem_ranges = [AddrRange("512MiB")]
+
+system.cpu = CPUClass()
+system.membus = SystemXBar()
+system.cpu.icache_port = system.membus.cpu_side_ports
+system.cpu.dcache_port = system.membus.cpu_side_ports
+system.cpu.createInterruptController()
+if hasattr(m5.objects, "X86CPU") and issubclass(CPUClass, m5.objects.X86CPU):
+    system.cpu.interrupts[0].pio = system.membus.mem_side_ports
+    system.cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+    system.cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+
+system.mem_ctrl = SimpleMemory(range=system.mem_ranges[0], latency="30ns")
+system.mem_ctrl.port = system.membus.mem_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+system.workload = SEWorkload.init_compatible(args.binary)
+process = Process(cmd=[args.binary] + args.options.split())
+system.cpu.workload = process
+system.cpu.createThreads()
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+step = args.dump_insts if args.dump_insts else args.max_insts
+insts = 0
+cause = None
+start = time.perf_counter()
+while insts < args.max_insts:
+    target = min(insts + step, args.max_insts)
+    system.cpu.scheduleInstStopAnyThread(target - insts)
+    exit_event = m5.simulate()
+    cause = exit_event.getCause()
+    insts = system.cpu.totalInsts()
+    if cause != "a thread reached the max instruction count":
+        break
+    if args.dump_insts:
+        m5.stats.dump()
+host_seconds = time.perf_counter() - start
+
+print(f"Exiting @ tick {m5.curTick()} because {cause}")
+print(f"Instructions: {insts}")
+print(f"Host seconds: {host_seconds:.3f}")
+if insts:
+    print(f"Host ns per instruction: {host_seconds * 1e9 / insts:.2f}")
@@ -0,0 +1,118 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Measure the replay throughput of the Trace CPU, i.e. the host time it
+# spends per replayed micro-op, e.g. to compare decoding the elastic data
+# trace on demand with decoding it ahead in a background thread:
+#
+#   build/ARM/gem5.opt configs/example/etrace_replay_throughput.py \
+#       --inst-trace system.cpu.traceListener.fetch.proto.gz \
+#       --data-trace system.cpu.traceListener.deptrace.proto.gz \
+#       --read-ahead 0
+#
+# The simulated result does not depend on the read ahead, only the host
+# time does.
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument(
+    "--inst-trace", required=True, help="Instruction fetch trace to replay"
+)
+parser.add_argument(
+    "--data-trace", required=True, help="Data dependency trace to replay"
+)
+parser.add_argument(
+    "--read-ahead",
+    type=int,
+    default=4,
+    help="Batches of dependency records decoded ahead in the background "
+    "(0 decodes on demand)",
+)
+parser.add_argument("--clock", default="2GHz", help="CPU clock")
+
+args = parser.parse_args()
+
+system = System(
+    mem_mode=TraceCPU.memory_mode(), mem_ranges=[AddrRange("512MiB")]
+)
+system.clk_domain = SrcClockDomain(
+    clock=args.clock, voltage_domain=VoltageDomain()
+)
+
+system.cpu = TraceCPU(
+    instTraceFile=args.inst_trace,
+    dataTraceFile=args.data_trace,
+    elasticReadAhead=args.read_ahead,
+)
+
+system.l1i = Cache(
+    size="32KiB",
+    assoc=2,
+    tag_latency=2,
+    data_latency=2,
+    response_latency=2,
+    mshrs=4,
+    tgts_per_mshr=20,
+    is_read_only=True,
+    writeback_clean=True,
+)
+system.l1d = Cache(
+    size="64KiB",
+    assoc=2,
+    tag_latency=2,
+    data_latency=2,
+    response_latency=2,
+    mshrs=4,
+    tgts_per_mshr=20,
+)
+system.cpu.icache_port = system.l1i.cpu_side
+system.cpu.dcache_port = system.l1d.cpu_side
+
+system.membus = SystemXBar()
+system.l1i.mem_side = system.membus.cpu_side_ports
+system.l1d.mem_side = system.membus.cpu_side_ports
+
+system.mem_ctrl = SimpleMemory(range=system.mem_ranges[0], latency="30ns")
+system.mem_ctrl.port = system.membus.mem_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+start = time.perf_counter()
+exit_event = m5.simulate()
+host_seconds = time.perf_counter() - start
+
+ops = system.cpu.totalOps()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
+print(f"Micro-ops: {ops}")
+print(f"Host seconds: {host_seconds:.3f}")
+if host_seconds > 0:
+    print(f"Micro-ops per host second: {ops / host_seconds:.0f}")
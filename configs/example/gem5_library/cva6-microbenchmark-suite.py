@@ -0,0 +1,146 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script runs a workload of the RISC-V Vertical Microbenchmark Suite on
+the CVA6Board and reports the IPC of the modelled CVA6 core. When given a
+JSON file of reference IPCs (e.g., measured on an FPGA build of the CVA6
+RTL), mapping workload IDs to IPCs, the error of the model against the
+reference is reported as well.
+
+Usage
+-----
+
+```
+scons build/RISCV/gem5.opt
+./build/RISCV/gem5.opt \
+    configs/example/gem5_library/cva6-microbenchmark-suite.py \
+    --workload riscv-cca-run --reference-ipc cva6_ipc.json
+```
+
+Run the script without ``--workload`` to list the workloads of the suite.
+"""
+
+import argparse
+import json
+
+from gem5.isas import ISA
+from gem5.prebuilt.cva6.cva6_board import CVA6Board
+from gem5.resources.resource import obtain_resource
+from gem5.simulate.simulator import Simulator
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.RISCV)
+
+parser = argparse.ArgumentParser(
+    description="Run a RISC-V microbenchmark on the CVA6 board."
+)
+parser.add_argument(
+    "--workload",
+    type=str,
+    default=None,
+    help="The ID of the workload of the suite to run.",
+)
+parser.add_argument(
+    "--scoreboard-entries",
+    type=int,
+    default=8,
+    help="The number of issue scoreboard entries.",
+)
+parser.add_argument(
+    "--commit-ports",
+    type=int,
+    default=2,
+    help="The number of commit ports.",
+)
+parser.add_argument(
+    "--clock",
+    type=str,
+    default="1GHz",
+    help="The clock frequency of the core.",
+)
+parser.add_argument(
+    "--reference-ipc",
+    type=str,
+    default=None,
+    help="A JSON file mapping workload IDs to the reference IPC to compare "
+    "against.",
+)
+
+args = parser.parse_args()
+
+microbenchmarks = obtain_resource("riscv-vertical-microbenchmarks")
+
+workloads = {workload.get_id(): workload for workload in microbenchmarks}
+
+if args.workload is None:
+    print("Workloads present in the suite:")
+    for workload_id in sorted(workloads):
+        print(f"  {workload_id}")
+    exit(0)
+
+if args.workload not in workloads:
+    raise ValueError(
+        f"Workload '{args.workload}' is not part of the suite. Run the "
+        "script without --workload to list the workloads."
+    )
+
+board = CVA6Board(
+    clk_freq=args.clock,
+    scoreboard_entries=args.scoreboard_entries,
+    commit_ports=args.commit_ports,
+)
+board.set_workload(workloads[args.workload])
+
+simulator = Simulator(board=board, full_system=False)
+simulator.run()
+print(
+    "Exiting @ tick {} because {}.".format(
+        simulator.get_current_tick(),
+        simulator.get_last_exit_event_cause(),
+    )
+)
+
+core = board.get_processor().get_cores()[0].get_simobject()
+insts = core.totalInsts()
+cycles = (
+    simulator.get_current_tick()
+    / board.get_clock_domain().clock[0].getValue()
+)
+ipc = insts / cycles
+
+print(f"Workload: {args.workload}")
+print(f"Instructions: {insts}")
+print(f"Cycles: {int(cycles)}")
+print(f"IPC: {ipc:.4f}")
+
+if args.reference_ipc is not None:
+    with open(args.reference_ipc) as f:
+        reference = json.load(f)
+    if args.workload in reference:
+        reference_ipc = float(reference[args.workload])
+        error = (ipc - reference_ipc) / reference_ipc
+        print(f"Reference IPC: {reference_ipc:.4f}")
+        print(f"Error: {error * 100:+.2f}%")
+    else:
+        print(f"No reference IPC for {args.workload}")
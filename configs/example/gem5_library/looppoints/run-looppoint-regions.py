@@ -0,0 +1,104 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This configuration script shows an example of how to run all the LoopPoint
+regions of a workload in parallel with the gem5 stdlib. Each region is run in
+its own gem5 process by the restore-looppoint-checkpoint.py script, as many at
+a time as the host CPUs and memory allow. The counters of the regions are
+then extrapolated to the whole workload with the region multipliers found in
+the LoopPoint JSON file, the ratios and rates are averaged with the same
+weights, and both are written to `m5out/looppoint-report.json`.
+
+The LoopPoint JSON file is the one written by
+create-looppoint-checkpoints.py.
+
+Usage
+-----
+```
+scons build/X86/gem5.opt
+./build/X86/gem5.opt \
+    configs/example/gem5_library/looppoints/create-looppoint-checkpoint.py
+
+./build/X86/gem5.opt \
+    configs/example/gem5_library/looppoints/run-looppoint-regions.py \
+    --looppoint-json m5out/looppoint.json
+```
+"""
+
+import argparse
+from pathlib import Path
+
+import m5
+
+from gem5.resources.looppoint import LooppointJsonLoader
+from gem5.utils.multiprocessing.regions import (
+    RegionRunner,
+    looppoint_regions,
+)
+
+parser = argparse.ArgumentParser(
+    description="Run the LoopPoint regions of a workload in parallel."
+)
+
+parser.add_argument(
+    "--looppoint-json",
+    type=str,
+    required=True,
+    help="The LoopPoint JSON file with the regions and their multipliers.",
+)
+
+parser.add_argument(
+    "--jobs",
+    type=int,
+    default=None,
+    help="The maximum number of regions run at once. Defaults to the number "
+    "of host CPUs.",
+)
+
+parser.add_argument(
+    "--memory-per-region",
+    type=str,
+    default=None,
+    help="The host memory a region needs (e.g., 4GiB). By default it is "
+    "measured from the first region.",
+)
+
+args = parser.parse_args()
+
+restore_script = Path(__file__).parent / "restore-looppoint-checkpoint.py"
+
+runner = RegionRunner(
+    regions=looppoint_regions(LooppointJsonLoader(args.looppoint_json)),
+    config=restore_script,
+    config_args=["--checkpoint-region", "{region}"],
+    max_processes=args.jobs,
+    memory_per_region=args.memory_per_region,
+)
+runner.run()
+
+failed = runner.get_failed_regions()
+if failed:
+    print(f"Regions {[region.region_id for region in failed]} failed.")
+
+runner.write_report(Path(m5.options.outdir) / "looppoint-report.json")
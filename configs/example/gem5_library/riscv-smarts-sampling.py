@@ -0,0 +1,165 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script shows an example of SMARTS-style sampling with the gem5 library.
+The simulation boots Ubuntu 20.04 on a single ATOMIC core, which keeps the
+caches warm, and periodically switches to an O3 core to measure short units
+of instructions. It stops once the mean IPC of the units is known to within
+the target error, and writes the estimate to `m5out/smarts.json`.
+
+Usage
+-----
+
+```
+scons build/RISCV/gem5.opt
+./build/RISCV/gem5.opt \
+    configs/example/gem5_library/riscv-smarts-sampling.py \
+    --unit-size 1000 --period 1000000 --target-error 0.03
+```
+"""
+
+import argparse
+from pathlib import Path
+
+import m5
+
+from gem5.components.boards.riscv_board import RiscvBoard
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_cache_hierarchy import (
+    PrivateL1PrivateL2CacheHierarchy,
+)
+from gem5.components.memory import DualChannelDDR4_2400
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+from gem5.isas import ISA
+from gem5.resources.resource import obtain_resource
+from gem5.simulate.exit_event import ExitEvent
+from gem5.simulate.sampling import SMARTSSampler
+from gem5.simulate.simulator import Simulator
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.RISCV)
+
+parser = argparse.ArgumentParser(
+    description="Estimate the IPC of an Ubuntu boot with SMARTS sampling."
+)
+
+parser.add_argument(
+    "--detailed-cpu",
+    type=str,
+    choices=["o3", "minor"],
+    default="o3",
+    help="The CPU model used for the measurement units.",
+)
+
+parser.add_argument(
+    "--unit-size",
+    type=int,
+    default=1000,
+    help="The number of instructions measured per unit.",
+)
+
+parser.add_argument(
+    "--detailed-warmup",
+    type=int,
+    default=2000,
+    help="The number of instructions run on the detailed CPU before a unit.",
+)
+
+parser.add_argument(
+    "--period",
+    type=int,
+    default=1000000,
+    help="The number of instructions between the start of two units.",
+)
+
+parser.add_argument(
+    "--target-error",
+    type=float,
+    default=0.03,
+    help="The relative error of the IPC at which sampling stops.",
+)
+
+parser.add_argument(
+    "--confidence",
+    type=float,
+    default=0.997,
+    help="The confidence level of the error.",
+)
+
+args = parser.parse_args()
+
+cache_hierarchy = PrivateL1PrivateL2CacheHierarchy(
+    l1d_size="16kB", l1i_size="16kB", l2_size="256kB"
+)
+
+memory = DualChannelDDR4_2400(size="3GB")
+
+# The processor starts on the ATOMIC core used for functional warming. The
+# sampler switches to the detailed core for each unit and back again.
+processor = SimpleSwitchableProcessor(
+    starting_core_type=CPUTypes.ATOMIC,
+    switch_core_type=(
+        CPUTypes.O3 if args.detailed_cpu == "o3" else CPUTypes.MINOR
+    ),
+    isa=ISA.RISCV,
+    num_cores=1,
+)
+
+board = RiscvBoard(
+    clk_freq="3GHz",
+    processor=processor,
+    memory=memory,
+    cache_hierarchy=cache_hierarchy,
+)
+
+board.set_workload(obtain_resource("riscv-ubuntu-20.04-boot"))
+
+sampler = SMARTSSampler(
+    board=board,
+    unit_size=args.unit_size,
+    detailed_warmup=args.detailed_warmup,
+    period=args.period,
+    target_error=args.target_error,
+    confidence=args.confidence,
+)
+
+simulator = Simulator(
+    board=board,
+    on_exit_event={ExitEvent.MAX_INSTS: sampler.get_generator()},
+)
+simulator.run()
+
+summary = sampler.get_summary()
+print(
+    f"IPC: {summary['ipc']} +/- {summary['confidence_interval']} "
+    f"({summary['num_units']} units)"
+)
+if summary["relative_error"] is None or (
+    summary["relative_error"] > args.target_error
+):
+    print("The workload ended before the target error was reached.")
+
+sampler.write_json(Path(m5.options.outdir) / "smarts.json")
@@ -0,0 +1,86 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replay a recorded access stream into a hardware prefetcher without
+# simulating the rest of the system. The trace is a packet trace as
+# written by a PrefetchAccessHistory (trace_file parameter) or by a
+# MemTraceProbe, e.g.:
+#
+#   build/ALL/gem5.opt configs/example/prefetch_replay.py \
+#       --trace m5out/l1d_history.trc.gz --prefetcher StridePrefetcher
+#
+# The prefetcher statistics (accuracy, coverage, timeliness) are
+# reported as usual in stats.txt.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument(
+    "--trace", required=True, help="Packet trace of the accesses to replay"
+)
+parser.add_argument(
+    "--prefetcher",
+    default="StridePrefetcher",
+    choices=ObjectList.hwp_list.get_names(),
+    help="Prefetcher to replay the trace into",
+)
+parser.add_argument(
+    "--cache-size",
+    default="32KiB",
+    help="Capacity of the cache the prefetcher is modelled in",
+)
+parser.add_argument(
+    "--cacheline-size", type=int, default=64, help="Cache line size"
+)
+parser.add_argument(
+    "--clock", default="1GHz", help="Clock of the prefetcher and replayer"
+)
+
+args = parser.parse_args()
+
+system = System(cache_line_size=args.cacheline_size)
+system.clk_domain = SrcClockDomain(
+    clock=args.clock, voltage_domain=VoltageDomain()
+)
+
+system.replayer = PrefetchTraceReplayer(
+    prefetcher=ObjectList.hwp_list.get(args.prefetcher)(),
+    trace_file=args.trace,
+    cache_size=args.cache_size,
+)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
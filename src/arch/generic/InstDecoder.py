@@ -34,3 +34,8 @@ class InstDecoder(SimObject):
     cxx_class = "gem5::InstDecoder"
 
     isa = Param.BaseISA(NULL, "ISA object for this context")
+    shared_cache = Param.SharedDecodeCache(
+        NULL,
+        "Decode cache shared with the decoders of the other CPUs, e.g., "
+        "one per system (only used by decoders which support it)",
+    )
@@ -0,0 +1,66 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "arch/generic/shared_decode_cache.hh"
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+SharedDecodeCache::SharedDecodeCacheStats::SharedDecodeCacheStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of instructions found decoded by another decoder"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of instructions decoded and added to the cache"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of the lookups which found the instruction",
+               hits / (hits + misses)),
+      ADD_STAT(mapBytes, statistics::units::Byte::get(),
+               "Approximate size of the cache, not counting the "
+               "instructions themselves")
+{
+    hitRate.precision(6);
+}
+
+SharedDecodeCache::SharedDecodeCache(const SharedDecodeCacheParams &p)
+    : SimObject(p), stats(this)
+{}
+
+bool
+SharedDecodeCache::addDecoder(const SimObject *decoder)
+{
+    if (decoder->eventQueue() != eventQueue()) {
+        warn("%s: %s is in another event queue and keeps its own decode "
+             "cache, as StaticInsts can't be shared between simulation "
+             "threads.", name(), decoder->name());
+        return false;
+    }
+    return true;
+}
+
+} // namespace gem5
@@ -0,0 +1,196 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_SHARED_DECODE_CACHE_HH__
+#define __ARCH_GENERIC_SHARED_DECODE_CACHE_HH__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "base/statistics.hh"
+#include "cpu/decode_cache.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "params/SharedDecodeCache.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * A decode cache shared by the decoders of several CPUs, so that each
+ * machine instruction is decoded, and its StaticInst stored, only once for
+ * all of them. Decoders keep their own map from machine instructions to
+ * StaticInsts in front of this one, and only look here when they miss.
+ *
+ * The instructions are kept in one map per ISA configuration, named by
+ * the decoders, as the same machine instruction may decode differently
+ * with, e.g., another vector length.
+ *
+ * StaticInst reference counts aren't atomic, so the cache is only shared
+ * by the decoders in its event queue. The others keep to their own maps.
+ */
+class SharedDecodeCache : public SimObject
+{
+  public:
+    /** The instructions decoded for one ISA configuration. */
+    class MapBase
+    {
+      public:
+        virtual ~MapBase() = default;
+    };
+
+    template <typename EMI>
+    class Map : public MapBase
+    {
+      public:
+        decode_cache::InstMap<EMI> insts;
+    };
+
+  protected:
+    std::unordered_map<std::string, std::unique_ptr<MapBase>> maps;
+
+    struct SharedDecodeCacheStats : public statistics::Group
+    {
+        SharedDecodeCacheStats(statistics::Group *parent);
+
+        /** Instructions found, which another decoder had decoded */
+        statistics::Scalar hits;
+        /** Instructions decoded and added to the cache */
+        statistics::Scalar misses;
+        statistics::Formula hitRate;
+        /** Approximate size of the maps, not counting the StaticInsts */
+        statistics::Scalar mapBytes;
+    } stats;
+
+  public:
+    SharedDecodeCache(const SharedDecodeCacheParams &p);
+
+    /**
+     * Check whether a decoder can use this cache, i.e. whether it is in
+     * the event queue of the cache.
+     *
+     * @param decoder The decoder which will look up instructions here.
+     * @return true if the decoder can use the cache.
+     */
+    bool addDecoder(const SimObject *decoder);
+
+    /**
+     * Get the map of the instructions decoded for an ISA configuration,
+     * creating it on first use.
+     *
+     * @param config Name of the ISA configuration. Decoders must use the
+     *        same name only if they decode every machine instruction to
+     *        the same StaticInst.
+     */
+    template <typename EMI>
+    Map<EMI> &
+    getMap(const std::string &config)
+    {
+        auto &map = maps[config];
+        if (!map)
+            map = std::make_unique<Map<EMI>>();
+        auto *typed = dynamic_cast<Map<EMI> *>(map.get());
+        panic_if(!typed, "%s: ISA configuration %s is used with different "
+                 "machine instruction types.", name(), config);
+        return *typed;
+    }
+
+    /**
+     * Find the StaticInst a machine instruction decodes to, decoding it
+     * with decode_inst if no decoder did before.
+     */
+    template <typename EMI, typename DecodeInst>
+    StaticInstPtr
+    lookup(Map<EMI> &map, const EMI &mach_inst, DecodeInst &&decode_inst)
+    {
+        auto [it, inserted] = map.insts.try_emplace(mach_inst);
+        if (inserted) {
+            it->second = decode_inst(mach_inst);
+            stats.misses++;
+            stats.mapBytes += sizeof(*it) + sizeof(void *);
+        } else {
+            stats.hits++;
+        }
+        return it->second;
+    }
+
+    /**
+     * The instructions decoded by one decoder, in front of the ones of
+     * the decoders sharing a cache with it, if any.
+     */
+    template <typename EMI>
+    class Client
+    {
+      private:
+        decode_cache::InstMap<EMI> insts;
+        SharedDecodeCache *cache = nullptr;
+        Map<EMI> *shared = nullptr;
+
+      public:
+        /**
+         * Share the instructions decoded for an ISA configuration with
+         * the other decoders using a cache. The decoder keeps to its own
+         * instructions if there is no cache or if it can't use it.
+         *
+         * @param _cache The cache to share, may be null.
+         * @param decoder The decoder using this client.
+         * @param config Name of the ISA configuration of the decoder.
+         */
+        void
+        join(SharedDecodeCache *_cache, const SimObject *decoder,
+             const std::string &config)
+        {
+            if (_cache && _cache->addDecoder(decoder)) {
+                cache = _cache;
+                shared = &cache->getMap<EMI>(config);
+            }
+        }
+
+        /** Whether the decoder shares the instructions of a cache. */
+        bool sharing() const { return cache; }
+
+        /**
+         * Find the StaticInst a machine instruction decodes to, decoding
+         * it with decode_inst if neither this decoder nor, when sharing,
+         * another decoder did before.
+         */
+        template <typename DecodeInst>
+        StaticInstPtr &
+        lookup(const EMI &mach_inst, DecodeInst &&decode_inst)
+        {
+            StaticInstPtr &si = insts[mach_inst];
+            if (!si) {
+                si = cache ? cache->lookup(*shared, mach_inst, decode_inst) :
+                    decode_inst(mach_inst);
+            }
+            return si;
+        }
+    };
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_SHARED_DECODE_CACHE_HH__
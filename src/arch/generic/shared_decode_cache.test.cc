@@ -0,0 +1,239 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "arch/generic/shared_decode_cache.hh"
+#include "base/bitunion.hh"
+#include "cpu/static_inst.hh"
+#include "params/SharedDecodeCache.hh"
+#include "sim/cur_tick.hh"
+#include "sim/root.hh"
+
+using namespace gem5;
+
+namespace gem5
+{
+
+// statistics.cc resolves stats by name through the Root object, there is
+// none in this test
+Root *Root::_root = nullptr;
+
+// The names of the StaticInst flags are generated with the Python bindings,
+// which this test doesn't link, and only used to print the flags
+const char *StaticInstFlags::FlagsStrings[StaticInstFlags::Num_Flags] = {};
+
+} // namespace gem5
+
+namespace
+{
+
+// A machine instruction with decoder state, like the RISC-V one: the same
+// instruction bits decode differently in another mode or context.
+BitUnion64(TestMachInst)
+    Bitfield<63, 62> mode;
+    Bitfield<57, 41> context;
+    Bitfield<31, 0> instBits;
+EndBitUnion(TestMachInst)
+
+class TestInst : public StaticInst
+{
+  public:
+    TestMachInst machInst;
+
+    TestInst(TestMachInst mach_inst)
+        : StaticInst("test", No_OpClass), machInst(mach_inst)
+    {}
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        return NoFault;
+    }
+
+    void advancePC(PCStateBase &pc_state) const override {}
+
+    std::string
+    generateDisassembly(
+            Addr pc, const loader::SymbolTable *symtab) const override
+    {
+        return "test";
+    }
+};
+
+SimObjectParams
+objectParams(const std::string &name, uint32_t eventq_index)
+{
+    SimObjectParams params;
+    params.name = name;
+    params.eventq_index = eventq_index;
+    return params;
+}
+
+/** A decoder with its ISA configuration, looking up a shared cache */
+class TestDecoder : public SimObject
+{
+  public:
+    SharedDecodeCache::Client<TestMachInst> insts;
+    int decoded = 0;
+
+    TestDecoder(const std::string &name, SharedDecodeCache *cache,
+                const std::string &config = "vlen=128",
+                uint32_t eventq_index = 0)
+        : SimObject(objectParams(name, eventq_index))
+    {
+        insts.join(cache, this, config);
+    }
+
+    StaticInstPtr
+    decode(TestMachInst mach_inst)
+    {
+        return insts.lookup(mach_inst, [this](TestMachInst emi) {
+            decoded++;
+            return StaticInstPtr(new TestInst(emi));
+        });
+    }
+};
+
+class SharedDecodeCacheTest : public ::testing::Test
+{
+  protected:
+    Tick tick = 0;
+    std::unique_ptr<SharedDecodeCache> cache;
+
+    void
+    SetUp() override
+    {
+        Gem5Internal::_curTickPtr = &tick;
+
+        SharedDecodeCacheParams params;
+        params.name = "cache";
+        params.eventq_index = 0;
+        cache = std::make_unique<SharedDecodeCache>(params);
+    }
+
+    static TestMachInst
+    inst(uint32_t bits, unsigned mode = 0, unsigned context = 0)
+    {
+        TestMachInst mach_inst = 0;
+        mach_inst.instBits = bits;
+        mach_inst.mode = mode;
+        mach_inst.context = context;
+        return mach_inst;
+    }
+};
+
+} // anonymous namespace
+
+/** Decoders sharing a cache get the same instruction, decoded once */
+TEST_F(SharedDecodeCacheTest, SameInstruction)
+{
+    TestDecoder cpu0("cpu0.decoder", cache.get());
+    TestDecoder cpu1("cpu1.decoder", cache.get());
+    ASSERT_TRUE(cpu0.insts.sharing());
+    ASSERT_TRUE(cpu1.insts.sharing());
+
+    const StaticInstPtr add = cpu0.decode(inst(0x00b50533));
+    EXPECT_EQ(cpu1.decode(inst(0x00b50533)), add);
+    EXPECT_EQ(cpu0.decode(inst(0x00b50533)), add);
+    EXPECT_EQ(cpu0.decoded, 1);
+    EXPECT_EQ(cpu1.decoded, 0);
+
+    const StaticInstPtr sub = cpu1.decode(inst(0x40b50533));
+    EXPECT_NE(sub, add);
+    EXPECT_EQ(cpu0.decode(inst(0x40b50533)), sub);
+    EXPECT_EQ(cpu0.decoded, 1);
+    EXPECT_EQ(cpu1.decoded, 1);
+}
+
+/** The mode and the context of an instruction are part of its key */
+TEST_F(SharedDecodeCacheTest, ModesAndContexts)
+{
+    TestDecoder cpu0("cpu0.decoder", cache.get());
+    TestDecoder cpu1("cpu1.decoder", cache.get());
+
+    const StaticInstPtr rv64 = cpu0.decode(inst(0x00b50533, 2));
+    const StaticInstPtr rv32 = cpu1.decode(inst(0x00b50533, 1));
+    const StaticInstPtr vl8 = cpu1.decode(inst(0x00b50533, 2, 8));
+    EXPECT_NE(rv32, rv64);
+    EXPECT_NE(vl8, rv64);
+    EXPECT_EQ(static_cast<const TestInst &>(*rv32).machInst.mode, 1);
+    EXPECT_EQ(static_cast<const TestInst &>(*vl8).machInst.context, 8);
+
+    EXPECT_EQ(cpu1.decode(inst(0x00b50533, 2)), rv64);
+    EXPECT_EQ(cpu0.decode(inst(0x00b50533, 1)), rv32);
+    EXPECT_EQ(cpu0.decoded + cpu1.decoded, 3);
+}
+
+/** Decoders of different ISA configurations don't share instructions */
+TEST_F(SharedDecodeCacheTest, Configurations)
+{
+    TestDecoder narrow0("cpu0.decoder", cache.get(), "vlen=128");
+    TestDecoder wide("cpu1.decoder", cache.get(), "vlen=256");
+    TestDecoder narrow1("cpu2.decoder", cache.get(), "vlen=128");
+
+    const StaticInstPtr vadd = narrow0.decode(inst(0x02208057));
+    EXPECT_NE(wide.decode(inst(0x02208057)), vadd);
+    EXPECT_EQ(narrow1.decode(inst(0x02208057)), vadd);
+    EXPECT_EQ(wide.decoded, 1);
+    EXPECT_EQ(narrow1.decoded, 0);
+}
+
+/**
+ * A decoder in another event queue, i.e. simulation thread, than the
+ * cache keeps to its own instructions.
+ */
+TEST_F(SharedDecodeCacheTest, OtherEventQueue)
+{
+    TestDecoder local("cpu0.decoder", cache.get());
+    TestDecoder remote("cpu1.decoder", cache.get(), "vlen=128", 1);
+    EXPECT_TRUE(local.insts.sharing());
+    EXPECT_FALSE(remote.insts.sharing());
+
+    const StaticInstPtr add = local.decode(inst(0x00b50533));
+    const StaticInstPtr remote_add = remote.decode(inst(0x00b50533));
+    EXPECT_NE(remote_add, add);
+    EXPECT_EQ(remote.decode(inst(0x00b50533)), remote_add);
+    EXPECT_EQ(remote.decoded, 1);
+
+    // The remote decoder didn't add its instruction to the cache
+    TestDecoder other("cpu2.decoder", cache.get());
+    EXPECT_EQ(other.decode(inst(0x00b50533)), add);
+}
+
+/** Decoders without a cache only use their own instructions */
+TEST_F(SharedDecodeCacheTest, NoCache)
+{
+    TestDecoder cpu0("cpu0.decoder", nullptr);
+    TestDecoder cpu1("cpu1.decoder", nullptr);
+    EXPECT_FALSE(cpu0.insts.sharing());
+
+    const StaticInstPtr add = cpu0.decode(inst(0x00b50533));
+    EXPECT_NE(cpu1.decode(inst(0x00b50533)), add);
+    EXPECT_EQ(cpu0.decode(inst(0x00b50533)), add);
+    EXPECT_EQ(cpu0.decoded, 1);
+}
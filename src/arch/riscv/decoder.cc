@@ -31,6 +31,7 @@
 #include "arch/riscv/isa.hh"
 #include "arch/riscv/types.hh"
 #include "base/bitfield.hh"
+#include "base/cprintf.hh"
 #include "debug/Decode.hh"
 
 namespace gem5
@@ -44,6 +45,10 @@ Decoder::Decoder(const RiscvDecoderParams &p) : InstDecoder(p, &machInst)
     ISA *isa = dynamic_cast<ISA*>(p.isa);
     vlen = isa->getVecLenInBits();
     elen = isa->getVecElemLenInBits();
+
+    instMap.join(p.shared_cache, this,
+            csprintf("riscv vlen=%d elen=%d", vlen, elen));
+
     reset();
 }
 
@@ -95,9 +100,8 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst.instBits, addr);
 
-    StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
-        si = decodeInst(mach_inst);
+    StaticInstPtr &si = instMap.lookup(mach_inst,
+            [this](ExtMachInst emi) { return decodeInst(emi); });
 
     si->size(compressed(mach_inst) ? 2 : 4);
 
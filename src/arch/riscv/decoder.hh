@@ -32,6 +32,7 @@
 
 #include "arch/generic/decode_cache.hh"
 #include "arch/generic/decoder.hh"
+#include "arch/generic/shared_decode_cache.hh"
 #include "arch/riscv/insts/vector.hh"
 #include "arch/riscv/types.hh"
 #include "base/logging.hh"
@@ -51,7 +52,9 @@ namespace RiscvISA
 class Decoder : public InstDecoder
 {
   private:
-    decode_cache::InstMap<ExtMachInst> instMap;
+    /// Decoded instructions, shared with the decoders with the same
+    /// vector configuration if there is a shared cache.
+    SharedDecodeCache::Client<ExtMachInst> instMap;
     bool aligned;
     bool mid;
 
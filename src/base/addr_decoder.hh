@@ -0,0 +1,212 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ADDR_DECODER_HH__
+#define __BASE_ADDR_DECODER_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Precomputed decode table mapping addresses to values, e.g. the ports
+ * of a crossbar, built from a set of non-overlapping address ranges.
+ *
+ * Ranges that merge with each other, i.e. the stripes of an
+ * interleaved range, are grouped in a single interval with one value
+ * per stripe, so the stripe is selected by evaluating the interleaving
+ * bits of the address instead of testing each range in turn. The
+ * intervals are kept in a sorted flat vector, and a radix table
+ * indexed by the high bits of the address points at the first
+ * interval that may contain it, which makes a lookup constant time in
+ * practice. The table does not track updates, it has to be rebuilt
+ * when the ranges change.
+ *
+ * @ingroup api_addr_range
+ */
+template <typename V>
+class AddrDecoder
+{
+  private:
+    /** An interval and the value of each of its interleaved stripes */
+    struct Interval
+    {
+        /** A range describing the interval and its interleaving */
+        AddrRange range;
+        /** Value of each stripe */
+        std::vector<V> values;
+        /** Whether each stripe is mapped */
+        std::vector<bool> valid;
+    };
+
+    /** The intervals, sorted by start address and non-overlapping */
+    std::vector<Interval> intervals;
+
+    /** Number of address bits used to index the radix table */
+    static constexpr unsigned radixBits = 10;
+
+    /** First address covered by the table */
+    Addr low = 0;
+
+    /** Right shift turning an offset from low into a radix index */
+    unsigned shift = 0;
+
+    /** For each radix bucket, the first interval that may match */
+    std::vector<uint32_t> firstInterval;
+
+  public:
+    /**
+     * Remove all the entries from the table.
+     */
+    void
+    clear()
+    {
+        intervals.clear();
+        firstInterval.clear();
+    }
+
+    /**
+     * Rebuild the table from a sorted sequence of (range, value)
+     * pairs, such as the contents of an AddrRangeMap. Ranges must not
+     * intersect, and the stripes of an interleaved range must be
+     * adjacent in the sequence.
+     *
+     * @param begin_it Iterator to the first pair
+     * @param end_it Iterator past the last pair
+     */
+    template <typename Iterator>
+    void
+    build(Iterator begin_it, Iterator end_it)
+    {
+        clear();
+
+        for (auto it = begin_it; it != end_it; ++it) {
+            const AddrRange &r = it->first;
+            if (intervals.empty() ||
+                !intervals.back().range.mergesWith(r)) {
+                panic_if(!intervals.empty() &&
+                         intervals.back().range.end() > r.start(),
+                         "Decode ranges %s and %s overlap\n",
+                         intervals.back().range.to_string(),
+                         r.to_string());
+                intervals.push_back(Interval{r,
+                        std::vector<V>(r.stripes()),
+                        std::vector<bool>(r.stripes(), false)});
+            }
+            Interval &interval = intervals.back();
+            interval.values[r.getIntlvMatch()] = it->second;
+            interval.valid[r.getIntlvMatch()] = true;
+        }
+
+        if (intervals.empty())
+            return;
+
+        // Size the radix buckets to cover all the intervals with at
+        // most 2^radixBits entries
+        low = intervals.front().range.start();
+        const Addr span = intervals.back().range.end() - low;
+        const unsigned span_bits = span > 1 ? ceilLog2(span) : 0;
+        shift = span_bits > radixBits ? span_bits - radixBits : 0;
+
+        const size_t num_buckets = ((span - 1) >> shift) + 1;
+        firstInterval.resize(num_buckets);
+        uint32_t idx = 0;
+        for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+            const Addr bucket_start = low + (Addr(bucket) << shift);
+            while (idx < intervals.size() &&
+                   intervals[idx].range.end() <= bucket_start) {
+                ++idx;
+            }
+            firstInterval[bucket] = idx;
+        }
+    }
+
+    /**
+     * Find the value mapped to an address range. The range must fall
+     * within a single range of the table, and for interleaved ranges
+     * within a single interleaving chunk, otherwise no value is
+     * returned.
+     *
+     * @param addr First address of the range to decode
+     * @param size Size of the range to decode, at least 1
+     * @return A pointer to the value, nullptr if there is none
+     */
+    const V *
+    decode(Addr addr, Addr size = 1) const
+    {
+        if (intervals.empty() || addr < low)
+            return nullptr;
+
+        const Addr bucket = (addr - low) >> shift;
+        if (bucket >= firstInterval.size())
+            return nullptr;
+
+        for (size_t idx = firstInterval[bucket];
+             idx < intervals.size() && intervals[idx].range.start() <= addr;
+             ++idx) {
+            const Interval &interval = intervals[idx];
+            const AddrRange &r = interval.range;
+            if (addr >= r.end())
+                continue;
+
+            const Addr last = addr + size - 1;
+            if (last < addr || last >= r.end())
+                return nullptr;
+
+            if (!r.interleaved())
+                return interval.valid[0] ? &interval.values[0] : nullptr;
+
+            // Only accept ranges within a single interleaving chunk,
+            // anything else is left to the caller
+            const uint8_t sel = r.getIntlvSelect(addr);
+            if (!interval.valid[sel] ||
+                (addr ^ last) >= r.granularity()) {
+                return nullptr;
+            }
+            return &interval.values[sel];
+        }
+
+        return nullptr;
+    }
+
+    /** Number of intervals in the table */
+    size_t size() const { return intervals.size(); }
+
+    /** Check if the table is empty */
+    bool empty() const { return intervals.empty(); }
+};
+
+} // namespace gem5
+
+#endif // __BASE_ADDR_DECODER_HH__
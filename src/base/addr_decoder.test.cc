@@ -0,0 +1,133 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "base/addr_decoder.hh"
+#include "base/addr_range_map.hh"
+
+using namespace gem5;
+
+TEST(AddrDecoderTest, Empty)
+{
+    AddrDecoder<int> d;
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(d.decode(0), nullptr);
+    EXPECT_EQ(d.decode(0x1000, 64), nullptr);
+}
+
+TEST(AddrDecoderTest, ContiguousRanges)
+{
+    AddrRangeMap<int> m;
+    m.insert(AddrRange(0x0, 0x1000), 1);
+    m.insert(AddrRange(0x2000, 0x3000), 2);
+    m.insert(AddrRange(0x80000000, 0x90000000), 3);
+
+    AddrDecoder<int> d;
+    d.build(m.begin(), m.end());
+    EXPECT_EQ(d.size(), 3);
+
+    ASSERT_NE(d.decode(0x0), nullptr);
+    EXPECT_EQ(*d.decode(0x0), 1);
+    EXPECT_EQ(*d.decode(0xfc0, 64), 1);
+    EXPECT_EQ(d.decode(0xfc0, 128), nullptr);
+    EXPECT_EQ(d.decode(0x1000), nullptr);
+    EXPECT_EQ(d.decode(0x1fff), nullptr);
+    EXPECT_EQ(*d.decode(0x2000, 64), 2);
+    EXPECT_EQ(*d.decode(0x2fff), 2);
+    EXPECT_EQ(d.decode(0x3000), nullptr);
+    EXPECT_EQ(*d.decode(0x80000000), 3);
+    EXPECT_EQ(*d.decode(0x8fffffc0, 64), 3);
+    EXPECT_EQ(d.decode(0x90000000), nullptr);
+    EXPECT_EQ(d.decode(0xffffffffffffffc0, 64), nullptr);
+}
+
+/**
+ * Four ways interleaved at a 64 byte granularity. The decode table must
+ * agree with the port map for every address, including accesses that
+ * span more than one interleaving chunk, which are never decoded.
+ */
+TEST(AddrDecoderTest, InterleavedRanges)
+{
+    const std::vector<Addr> masks = {1 << 6, 1 << 7};
+    AddrRangeMap<int> m;
+    for (uint8_t i = 0; i < 4; i++)
+        m.insert(AddrRange(0x10000, 0x20000, masks, i), 10 + i);
+    m.insert(AddrRange(0x20000, 0x21000), 20);
+
+    AddrDecoder<int> d;
+    d.build(m.begin(), m.end());
+    EXPECT_EQ(d.size(), 2);
+
+    for (Addr a = 0x10000; a < 0x21000; a += 32) {
+        auto expected = m.contains(RangeSize(a, 32));
+        const int *value = d.decode(a, 32);
+        ASSERT_NE(expected, m.end());
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, expected->second);
+    }
+
+    EXPECT_EQ(*d.decode(0x10000), 10);
+    EXPECT_EQ(*d.decode(0x10040), 11);
+    EXPECT_EQ(*d.decode(0x10080), 12);
+    EXPECT_EQ(*d.decode(0x100c0), 13);
+    EXPECT_EQ(d.decode(0x10020, 64), nullptr);
+    EXPECT_EQ(d.decode(0x0fff0, 16), nullptr);
+}
+
+TEST(AddrDecoderTest, PartialInterleaving)
+{
+    const std::vector<Addr> masks = {1 << 6};
+    AddrRangeMap<int> m;
+    m.insert(AddrRange(0x0, 0x1000, masks, 1), 7);
+
+    AddrDecoder<int> d;
+    d.build(m.begin(), m.end());
+
+    EXPECT_EQ(d.decode(0x0), nullptr);
+    ASSERT_NE(d.decode(0x40), nullptr);
+    EXPECT_EQ(*d.decode(0x40), 7);
+}
+
+TEST(AddrDecoderTest, Rebuild)
+{
+    AddrRangeMap<int> m;
+    m.insert(AddrRange(0x0, 0x1000), 1);
+
+    AddrDecoder<int> d;
+    d.build(m.begin(), m.end());
+    EXPECT_EQ(*d.decode(0x800), 1);
+
+    m.erase(m.begin());
+    m.insert(AddrRange(0x1000, 0x2000), 2);
+    d.build(m.begin(), m.end());
+    EXPECT_EQ(d.decode(0x800), nullptr);
+    EXPECT_EQ(*d.decode(0x1800), 2);
+
+    d.clear();
+    EXPECT_EQ(d.decode(0x1800), nullptr);
+}
@@ -475,20 +475,48 @@ class AddrRange
         // bits from the address match the interleaving value
         bool in_range = a >= _start && a < _end;
         if (in_range) {
-            auto sel = 0;
-            for (unsigned int i = 0; i < masks.size(); i++) {
-                Addr masked = a & masks[i];
-                // The result of an xor operation is 1 if the number
-                // of bits set is odd or 0 othersize, thefore it
-                // suffices to count the number of bits set to
-                // determine the i-th bit of sel.
-                sel |= (popCount(masked) % 2) << i;
-            }
-            return sel == intlvMatch;
+            return getIntlvSelect(a) == intlvMatch;
         }
         return false;
     }
 
+    /**
+     * Determine which of the interleaved stripes an address falls in,
+     * i.e. the interleaving match value of the range, among the ones
+     * merging with this one, that would contain the address. No check
+     * is made to ensure the address is within the start and end of
+     * the range.
+     *
+     * @param a Address to compute the stripe of
+     * @return The stripe index, always 0 for a non-interleaved range
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t
+    getIntlvSelect(const Addr& a) const
+    {
+        uint8_t sel = 0;
+        for (unsigned int i = 0; i < masks.size(); i++) {
+            Addr masked = a & masks[i];
+            // The result of an xor operation is 1 if the number
+            // of bits set is odd or 0 othersize, thefore it
+            // suffices to count the number of bits set to
+            // determine the i-th bit of sel.
+            sel |= (popCount(masked) % 2) << i;
+        }
+        return sel;
+    }
+
+    /**
+     * Get the interleaving match value of the range, i.e. the stripe
+     * it covers among the ones merging with it.
+     *
+     * @return The interleaving match value
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t getIntlvMatch() const { return intlvMatch; }
+
     /**
      * Remove the interleaving bits from an input address.
      *
@@ -73,7 +73,7 @@ class CircularQueue
 
     using reference = typename std::vector<T>::reference;
     using const_reference = typename std::vector<T>::const_reference;
-    const size_t _capacity;
+    size_t _capacity;
     size_t _size = 0;
     size_t _head = 1;
 
@@ -426,6 +426,28 @@ class CircularQueue
         _size = 0;
     }
 
+    /**
+     * Increase the capacity of the queue. The elements keep their
+     * indices, so indices held by the users of the queue stay valid.
+     *
+     * @param capacity The new capacity, not smaller than the current one
+     *
+     * @ingroup api_base_utils
+     */
+    void
+    grow(size_t capacity)
+    {
+        assert(capacity >= _capacity);
+        if (capacity == _capacity)
+            return;
+
+        std::vector<T> grown(capacity);
+        for (size_t idx = _head; idx < _head + _size; ++idx)
+            grown[idx % capacity] = std::move(data[idx % _capacity]);
+        data.swap(grown);
+        _capacity = capacity;
+    }
+
     /**
      * Test if the index is in the range of valid elements.
      */
@@ -265,3 +265,36 @@ TEST(CircularQueueTest, MultipleRound)
 
     ASSERT_EQ(ending_it - starting_it, cq_size);
 }
+
+/**
+ * Testing that growing the queue keeps the elements at their indices,
+ * including when the elements wrap around the end of the storage.
+ */
+TEST(CircularQueueTest, Grow)
+{
+    const auto cq_size = 8;
+    CircularQueue<uint32_t> cq(cq_size);
+
+    for (auto idx = 0; idx < cq_size + 3; idx++) {
+        cq.push_back(idx);
+    }
+    cq.pop_front(2);
+
+    const auto head = cq.head();
+    const auto tail = cq.tail();
+
+    cq.grow(cq_size * 2);
+    ASSERT_EQ(cq.capacity(), cq_size * 2);
+    ASSERT_EQ(cq.head(), head);
+    ASSERT_EQ(cq.tail(), tail);
+    for (auto idx = head; idx <= tail; idx++) {
+        ASSERT_EQ(cq[idx], idx - 1);
+    }
+
+    // the queue can now hold more elements without overwriting
+    for (auto idx = 0; idx < cq_size; idx++) {
+        cq.push_back(0);
+    }
+    ASSERT_EQ(cq.head(), head);
+    ASSERT_EQ(cq.front(), head - 1);
+}
@@ -28,6 +28,8 @@
 
 #include "base/hostinfo.hh"
 
+#include <sys/resource.h>
+
 #ifdef __APPLE__
 #include <mach/mach_init.h>
 #include <mach/shared_region.h>
@@ -96,4 +98,14 @@ memUsage()
 #endif
 }
 
+uint64_t
+pageFaults(bool major)
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return major ? usage.ru_majflt : usage.ru_minflt;
+}
+
 } // namespace gem5
@@ -41,6 +41,15 @@ namespace gem5
  */
 uint64_t memUsage();
 
+/**
+ * Determine the number of page faults taken by the simulator process.
+ *
+ * @param major Count the faults requiring I/O rather than the ones
+ * served without it
+ * @return Number of page faults since the process started
+ */
+uint64_t pageFaults(bool major);
+
 } // namespace gem5
 
 #endif // __HOSTINFO_HH__
@@ -204,17 +204,59 @@ Formula::operator/=(Temp r)
 }
 
 
+namespace
+{
+
+/** Current formula caching epoch, 0 when caching is off */
+uint64_t formulaEpoch = 0;
+uint64_t lastFormulaEpoch = 0;
+
+} // anonymous namespace
+
+void
+beginFormulaCache()
+{
+    formulaEpoch = ++lastFormulaEpoch;
+}
+
+void
+endFormulaCache()
+{
+    formulaEpoch = 0;
+}
+
 void
 Formula::result(VResult &vec) const
 {
-    if (root)
+    if (!root)
+        return;
+
+    if (!formulaEpoch) {
         vec = root->result();
+        return;
+    }
+
+    if (resultEpoch != formulaEpoch) {
+        cachedResult = root->result();
+        resultEpoch = formulaEpoch;
+    }
+    vec = cachedResult;
 }
 
 Result
 Formula::total() const
 {
-    return root ? root->total() : 0.0;
+    if (!root)
+        return 0.0;
+
+    if (!formulaEpoch)
+        return root->total();
+
+    if (totalEpoch != formulaEpoch) {
+        cachedTotal = root->total();
+        totalEpoch = formulaEpoch;
+    }
+    return cachedTotal;
 }
 
 size_type
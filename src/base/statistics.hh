@@ -2542,6 +2542,16 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
     NodePtr root;
     friend class Temp;
 
+    /**
+     * Results kept while formula caching is on, and the caching epoch
+     * they were computed in.
+     * @sa beginFormulaCache
+     */
+    mutable VResult cachedResult;
+    mutable Result cachedTotal = 0.0;
+    mutable uint64_t resultEpoch = 0;
+    mutable uint64_t totalEpoch = 0;
+
   public:
     /**
      * Create and initialize thie formula, and register it with the database.
@@ -2917,6 +2927,19 @@ void processResetQueue();
  */
 void processDumpQueue();
 
+/**
+ * Cache the results of the formulas until endFormulaCache() is called.
+ * A formula used by other formulas, or visited by several outputs, is then
+ * evaluated once per dump rather than every time it is read. The stats
+ * must not change while the cache is on.
+ */
+void beginFormulaCache();
+
+/**
+ * Stop caching the results of the formulas.
+ */
+void endFormulaCache();
+
 std::list<Info *> &statsList();
 
 typedef std::map<const void *, Info *> MapType;
@@ -0,0 +1,387 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+void
+putVarint(std::string &buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(char(value));
+}
+
+void
+putLE(std::string &buf, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; i++)
+        buf.push_back(char(value >> (8 * i)));
+}
+
+void
+putDouble(std::string &buf, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putLE(buf, bits, sizeof(bits));
+}
+
+void
+putString(std::string &buf, const std::string &str)
+{
+    putVarint(buf, str.size());
+    buf += str;
+}
+
+bool
+sameValue(double a, double b)
+{
+    // Compare the representations, so that a NaN that stays a NaN is not
+    // a change
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+std::string
+label(const std::vector<std::string> &names, size_t i)
+{
+    if (i < names.size() && !names[i].empty())
+        return names[i];
+    return std::to_string(i);
+}
+
+} // anonymous namespace
+
+Binary::Binary(const std::string &file, bool desc, bool formulas)
+    : fname(file), enableDescriptions(desc), enableFormula(formulas),
+      stream(simout.create(file, true)), schemaCount(0), changedCount(0)
+{
+    if (!valid())
+        fatal("Unable to open statistics file %s for writing\n", file);
+
+    std::string header = "gem5stat";
+    putLE(header, version, 4);
+    stream->stream()->write(header.data(), header.size());
+}
+
+Binary::~Binary()
+{
+    simout.close(stream);
+}
+
+void
+Binary::begin()
+{
+    schema.clear();
+    schemaCount = 0;
+    changes.clear();
+    changedCount = 0;
+}
+
+void
+Binary::end()
+{
+    std::string record;
+    if (schemaCount) {
+        record.push_back('S');
+        putVarint(record, schemaCount);
+        record += schema;
+    }
+    record.push_back('D');
+    putLE(record, curTick(), 8);
+    putVarint(record, changedCount);
+    record += changes;
+
+    std::ostream &os = *stream->stream();
+    os.write(record.data(), record.size());
+    os.flush();
+}
+
+bool
+Binary::valid() const
+{
+    return stream != nullptr && stream->stream()->good();
+}
+
+std::string
+Binary::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return path.top() + "." + name;
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    path.push(statName(name));
+}
+
+void
+Binary::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+Binary::keepZero(const Info &info) const
+{
+    // Dumps only record changes, a stat that is not visited keeps its
+    // last values
+    return recorded.count(&info);
+}
+
+template <typename Labels>
+Binary::Column &
+Binary::column(const Info &info, Kind kind, const Labels &labels)
+{
+    const std::string name = statName(info.name);
+    auto it = columns.find(name);
+    if (it != columns.end())
+        return it->second;
+
+    Column &col = columns[name];
+    col.id = columns.size() - 1;
+    recorded.insert(&info);
+
+    const std::vector<std::string> value_labels = labels();
+    putString(schema, name);
+    schema.push_back(kind);
+    putString(schema, info.unit->getUnitString());
+    putString(schema, enableDescriptions ? info.desc : "");
+    putVarint(schema, value_labels.size());
+    for (const auto &value_label : value_labels)
+        putString(schema, value_label);
+    schemaCount++;
+
+    return col;
+}
+
+void
+Binary::record(Column &col, const std::vector<double> &values)
+{
+    // The first dump of a stat records all its values
+    if (col.values.empty()) {
+        col.values.resize(values.size());
+        if (values.empty())
+            return;
+        putVarint(changes, col.id);
+        putVarint(changes, values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            putDouble(changes, values[i]);
+            col.values[i] = values[i];
+        }
+        changedCount++;
+        return;
+    }
+
+    panic_if(values.size() != col.values.size(),
+             "Stat %d changed size from %d to %d values\n", col.id,
+             col.values.size(), values.size());
+
+    size_t changed = 0;
+    for (size_t i = 0; i < values.size(); i++)
+        changed += !sameValue(values[i], col.values[i]);
+    if (!changed)
+        return;
+
+    putVarint(changes, col.id);
+    putVarint(changes, changed);
+    for (size_t i = 0; i < values.size(); i++) {
+        if (changed == values.size()) {
+            putDouble(changes, values[i]);
+        } else if (!sameValue(values[i], col.values[i])) {
+            putVarint(changes, i);
+            putDouble(changes, values[i]);
+        }
+        col.values[i] = values[i];
+    }
+    changedCount++;
+}
+
+void
+Binary::appendDist(std::vector<double> &values, const DistData &data)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+    values.push_back(data.min_val);
+    values.push_back(data.max_val);
+    values.push_back(data.underflow);
+    values.push_back(data.overflow);
+    values.push_back(data.min);
+    values.push_back(data.max);
+    values.push_back(data.bucket_size);
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Binary::appendDistLabels(std::vector<std::string> &labels,
+                         const DistData &data, const std::string &prefix)
+{
+    for (const char *field : {"samples", "sum", "squares", "min_value",
+             "max_value", "underflows", "overflows", "min", "max",
+             "bucket_size"}) {
+        labels.push_back(prefix + field);
+    }
+    for (size_t i = 0; i < data.cvec.size(); i++)
+        labels.push_back(prefix + "bucket" + std::to_string(i));
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    Column &col = column(info, KindScalar, [] {
+        return std::vector<std::string>{""};
+    });
+    values.assign(1, info.result());
+    record(col, values);
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &vr = info.result();
+    Column &col = column(info, KindVector, [&info, &vr] {
+        std::vector<std::string> labels;
+        for (size_t i = 0; i < vr.size(); i++)
+            labels.push_back(label(info.subnames, i));
+        return labels;
+    });
+    values.assign(vr.begin(), vr.end());
+    record(col, values);
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    Column &col = column(info, KindDist, [&info] {
+        std::vector<std::string> labels;
+        appendDistLabels(labels, info.data, "");
+        return labels;
+    });
+    values.clear();
+    appendDist(values, info.data);
+    record(col, values);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    Column &col = column(info, KindVectorDist, [&info] {
+        std::vector<std::string> labels;
+        for (size_t i = 0; i < info.data.size(); i++) {
+            appendDistLabels(labels, info.data[i],
+                             label(info.subnames, i) + "::");
+        }
+        return labels;
+    });
+    values.clear();
+    for (const auto &data : info.data)
+        appendDist(values, data);
+    record(col, values);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    Column &col = column(info, KindVector2d, [&info] {
+        std::vector<std::string> labels;
+        for (size_t x = 0; x < info.x; x++) {
+            for (size_t y = 0; y < info.y; y++) {
+                labels.push_back(label(info.subnames, x) + "::" +
+                                 label(info.y_subnames, y));
+            }
+        }
+        return labels;
+    });
+    values.assign(info.cvec.begin(), info.cvec.end());
+    record(col, values);
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    if (!enableFormula || !info.flags.isSet(display))
+        return;
+
+    const VResult &vr = info.result();
+    Column &col = column(info, KindFormula, [&info, &vr] {
+        std::vector<std::string> labels;
+        for (size_t i = 0; i < vr.size(); i++)
+            labels.push_back(label(info.subnames, i));
+        return labels;
+    });
+    values.assign(vr.begin(), vr.end());
+    record(col, values);
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    warn_once("Binary stat files don't support sparse histograms.\n");
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename, bool desc, bool formulas)
+{
+    return std::unique_ptr<Output>(new Binary(filename, desc, formulas));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,180 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Info;
+
+/**
+ * Compact binary stat output for frequent dumps. The file describes every
+ * stat once, in a schema record, and each dump only records the values
+ * that changed since the previous dump, so a long run with periodic dumps
+ * writes little more than what the simulation actually changed.
+ *
+ * Every stat is a column of doubles: a scalar has one value, a vector or
+ * a formula one per element, a 2d vector x * y, and a distribution its
+ * sample count, sum, squares, extremes, bucket bounds and buckets. The
+ * file starts with the magic "gem5stat" and a u32 version, followed by
+ * records starting with a tag byte, with integers as LEB128 varints and
+ * doubles as little endian IEEE 754:
+ *
+ *   'S': stats added to the schema, numbered in order from 0
+ *        count, then for each stat: name, kind, unit, description,
+ *        number of values and their labels, strings being a length
+ *        followed by the characters
+ *   'D': a dump
+ *        u64 tick, count of changed stats, then for each stat: its
+ *        number, the count of changed values and either all the values
+ *        if they all changed, or pairs of value index and value
+ *
+ * src/python/m5/stats/binary.py reads the file back.
+ */
+class Binary : public Output
+{
+  public:
+    /** Kind of a stat, recorded in the schema */
+    enum Kind : uint8_t
+    {
+        KindScalar = 0,
+        KindVector = 1,
+        KindDist = 2,
+        KindVectorDist = 3,
+        KindVector2d = 4,
+        KindFormula = 5,
+    };
+
+    static constexpr uint32_t version = 1;
+
+    Binary(const std::string &file, bool desc, bool formulas);
+
+    ~Binary();
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    bool keepZero(const Info &info) const override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** A stat of the schema and its values at the last dump */
+    struct Column
+    {
+        uint64_t id;
+        std::vector<double> values;
+    };
+
+    /** Full name of a stat in the current group */
+    std::string statName(const std::string &name) const;
+
+    /**
+     * Find the column of a stat, adding it to the schema if it is new.
+     *
+     * @param info Stat info structure.
+     * @param kind Kind of the stat.
+     * @param labels Labels of the values, only built for a new stat.
+     */
+    template <typename Labels>
+    Column &column(const Info &info, Kind kind, const Labels &labels);
+
+    /**
+     * Record the values of a stat that changed since the last dump.
+     */
+    void record(Column &col, const std::vector<double> &values);
+
+    /** Append the values of a distribution to a vector of values */
+    static void appendDist(std::vector<double> &values,
+                           const DistData &data);
+
+    /** Append the labels of the values of a distribution */
+    static void appendDistLabels(std::vector<std::string> &labels,
+                                 const DistData &data,
+                                 const std::string &prefix);
+
+    const std::string fname;
+    const bool enableDescriptions;
+    const bool enableFormula;
+
+    OutputStream *stream;
+
+    std::stack<std::string> path;
+
+    std::unordered_map<std::string, Column> columns;
+
+    /// Stats in the schema, whose zero values still have to be recorded
+    std::unordered_set<const Info *> recorded;
+
+    /// Stats added to the schema during the current dump
+    std::string schema;
+    uint64_t schemaCount;
+
+    /// Changed values of the current dump
+    std::string changes;
+    uint64_t changedCount;
+
+    /// Scratch buffer for the values of a stat
+    std::vector<double> values;
+};
+
+std::unique_ptr<Output> initBinary(const std::string &filename,
+                                   bool desc = true, bool formulas = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -0,0 +1,440 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/binary.hh"
+#include "base/stats/filter.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+#include "sim/root.hh"
+
+using namespace gem5;
+
+namespace gem5
+{
+
+// statistics.cc resolves stats by name through the Root object, there is
+// none in this test
+Root *Root::_root = nullptr;
+
+} // namespace gem5
+
+namespace
+{
+
+/** The values of every stat of a binary stat file at every dump */
+struct Decoded
+{
+    std::vector<Tick> ticks;
+    std::vector<std::string> names;
+    std::vector<statistics::Binary::Kind> kinds;
+    std::vector<std::vector<std::string>> labels;
+    /** Values of each stat at each dump, empty before it first appears */
+    std::map<std::string, std::vector<std::vector<double>>> values;
+    /** Number of dumps recording values of each stat */
+    std::map<std::string, int> recorded;
+};
+
+/** Decode a binary stat file, following the format of binary.hh */
+class Decoder
+{
+  public:
+    explicit Decoder(const std::string &bytes) : data(bytes) {}
+
+    Decoded
+    decode()
+    {
+        Decoded file;
+        EXPECT_EQ(data.substr(0, 8), "gem5stat");
+        pos = 8;
+        EXPECT_EQ(le(4), statistics::Binary::version);
+
+        std::vector<std::vector<double>> current;
+        while (pos < data.size()) {
+            const char tag = data[pos++];
+            if (tag == 'S') {
+                for (uint64_t count = varint(); count; count--) {
+                    file.names.push_back(string());
+                    file.kinds.push_back(
+                        statistics::Binary::Kind(data[pos++]));
+                    string();
+                    string();
+                    std::vector<std::string> labels(varint());
+                    for (auto &label : labels)
+                        label = string();
+                    file.labels.push_back(labels);
+                    current.emplace_back();
+                }
+            } else if (tag == 'D') {
+                file.ticks.push_back(le(8));
+                for (uint64_t count = varint(); count; count--) {
+                    const uint64_t stat = varint();
+                    const uint64_t changed = varint();
+                    const size_t width = file.labels.at(stat).size();
+                    auto &values = current.at(stat);
+                    values.resize(width);
+                    if (changed == width) {
+                        for (auto &value : values)
+                            value = real();
+                    } else {
+                        for (uint64_t i = 0; i < changed; i++) {
+                            const uint64_t index = varint();
+                            values.at(index) = real();
+                        }
+                    }
+                    file.recorded[file.names[stat]]++;
+                }
+                for (size_t stat = 0; stat < current.size(); stat++)
+                    file.values[file.names[stat]].push_back(current[stat]);
+            } else {
+                ADD_FAILURE() << "Unexpected record " << tag;
+                break;
+            }
+        }
+        return file;
+    }
+
+  private:
+    uint64_t
+    le(unsigned bytes)
+    {
+        uint64_t value = 0;
+        for (unsigned i = 0; i < bytes; i++)
+            value |= uint64_t(uint8_t(data.at(pos++))) << (8 * i);
+        return value;
+    }
+
+    uint64_t
+    varint()
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; ; shift += 7) {
+            const uint8_t byte = data.at(pos++);
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+    }
+
+    double
+    real()
+    {
+        const uint64_t bits = le(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    std::string
+    string()
+    {
+        const uint64_t size = varint();
+        std::string str = data.substr(pos, size);
+        pos += size;
+        return str;
+    }
+
+    const std::string &data;
+    size_t pos = 0;
+};
+
+/**
+ * A few stats of every kind in a "sys" group, and a scalar in a "late"
+ * group which the first dumps leave out.
+ */
+class BinaryStatsTest : public ::testing::Test
+{
+  protected:
+    Tick tick = 0;
+    std::string filename;
+
+    statistics::Group root{nullptr};
+    statistics::Group sys{&root, "sys"};
+    statistics::Group late{&root, "late"};
+
+    statistics::Scalar count{&sys, "count",
+        statistics::units::Count::get(), "A changing scalar"};
+    statistics::Scalar freq{&sys, "freq",
+        statistics::units::Count::get(), "An unchanged scalar"};
+    statistics::Vector vec{&sys, "vec",
+        statistics::units::Count::get(), "A vector"};
+    statistics::Distribution dist{&sys, "dist",
+        statistics::units::Count::get(), "A distribution"};
+    statistics::Formula ratio{&sys, "ratio",
+        statistics::units::Ratio::get(), "A formula"};
+    statistics::Scalar lateStat{&late, "stat",
+        statistics::units::Count::get(), "A scalar of a later dump"};
+
+    std::unique_ptr<statistics::Output> output;
+
+    void
+    SetUp() override
+    {
+        Gem5Internal::_curTickPtr = &tick;
+
+        char name[] = "/tmp/binary-stats-XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        filename = name;
+
+        vec.init(3).subname(0, "a").subname(1, "b").subname(2, "c");
+        dist.init(0, 3, 1);
+        ratio = count / freq;
+    }
+
+    void
+    TearDown() override
+    {
+        output.reset();
+        unlink(filename.c_str());
+    }
+
+    void open() { output = statistics::initBinary(filename, false); }
+
+    /** Dump the stats of the given groups of the root, at a tick */
+    void
+    dump(Tick when, const std::vector<std::string> &groups)
+    {
+        tick = when;
+        output->begin();
+        for (const auto &[name, group] : root.getStatGroups()) {
+            if (std::find(groups.begin(), groups.end(), name) ==
+                groups.end()) {
+                continue;
+            }
+            output->beginGroup(name.c_str());
+            for (auto *info : group->getStats()) {
+                info->prepare();
+                info->visit(*output);
+            }
+            output->endGroup();
+        }
+        output->end();
+    }
+
+    /** Dump the stats through a filter skipping the zero stats */
+    void
+    dumpNonZero(Tick when)
+    {
+        tick = when;
+        statistics::DumpFilter filter({}, true);
+        filter.prepare(root);
+        output->begin();
+        filter.visit(root, *output);
+        output->end();
+    }
+
+    std::string
+    contents()
+    {
+        output.reset();
+        std::ifstream file(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * Dump the stats four times: the first dumps leave the late group
+     * out, freq never changes and the last dump changes nothing.
+     */
+    void
+    dumpSequence()
+    {
+        open();
+        count = 1;
+        freq = 1000;
+        vec[0] = 1;
+        dist.sample(0);
+        dist.sample(1);
+        dump(100, {"sys"});
+
+        count = 2;
+        vec[1] = 5;
+        dist.sample(2);
+        dump(200, {"sys"});
+
+        count = 3;
+        vec[0] = 2;
+        vec[1] = 6;
+        vec[2] = 7;
+        lateStat = 4;
+        dump(300, {"sys", "late"});
+
+        dump(400, {"sys", "late"});
+    }
+};
+
+std::vector<double>
+distValues(double samples, double sum, double squares, double min_val,
+           double max_val, std::vector<double> buckets)
+{
+    std::vector<double> values = {samples, sum, squares, min_val, max_val,
+                                  0, 0, 0, 3, 1};
+    values.insert(values.end(), buckets.begin(), buckets.end());
+    return values;
+}
+
+/**
+ * The bytes the dump sequence writes. tests/pyunit/stats reads them back
+ * with m5.stats.binary, so a change of the format must update both.
+ */
+const char *sequenceHex =
+    "67656d3573746174010000005305097379732e636f756e740005436f756e7400"
+    "0100087379732e667265710005436f756e74000100077379732e766563010543"
+    "6f756e740003016101620163087379732e646973740205436f756e74000e0773"
+    "616d706c65730373756d0773717561726573096d696e5f76616c7565096d6178"
+    "5f76616c75650a756e646572666c6f7773096f766572666c6f7773036d696e03"
+    "6d61780b6275636b65745f73697a65076275636b657430076275636b65743107"
+    "6275636b657432076275636b657433097379732e726174696f0505526174696f"
+    "00010130446400000000000000050001000000000000f03f0101000000000040"
+    "8f400203000000000000f03f00000000000000000000000000000000030e0000"
+    "000000000040000000000000f03f000000000000f03f00000000000000000000"
+    "00000000f03f0000000000000000000000000000000000000000000000000000"
+    "000000000840000000000000f03f000000000000f03f000000000000f03f0000"
+    "00000000000000000000000000000401fca9f1d24d62503f44c8000000000000"
+    "0004000100000000000000400201010000000000001440030500000000000000"
+    "08400100000000000008400200000000000014400400000000000000400c0000"
+    "00000000f03f0401fca9f1d24d62603f5301096c6174652e737461740005436f"
+    "756e74000100442c010000000000000405010000000000001040000100000000"
+    "000008400203000000000000004000000000000018400000000000001c400401"
+    "fa7e6abc7493683f44900100000000000000";
+
+std::string
+toHex(const std::string &bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (unsigned char c : bytes) {
+        hex.push_back(digits[c >> 4]);
+        hex.push_back(digits[c & 0xf]);
+    }
+    return hex;
+}
+
+} // anonymous namespace
+
+TEST_F(BinaryStatsTest, Schema)
+{
+    dumpSequence();
+    const Decoded file = Decoder(contents()).decode();
+
+    using Kind = statistics::Binary::Kind;
+    EXPECT_EQ(file.names, (std::vector<std::string>{"sys.count",
+        "sys.freq", "sys.vec", "sys.dist", "sys.ratio", "late.stat"}));
+    EXPECT_EQ(file.kinds, (std::vector<Kind>{Kind::KindScalar,
+        Kind::KindScalar, Kind::KindVector, Kind::KindDist,
+        Kind::KindFormula, Kind::KindScalar}));
+    EXPECT_EQ(file.labels[2], (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(file.labels[3].size(), 10 + 4);
+    EXPECT_EQ(file.labels[3][0], "samples");
+    EXPECT_EQ(file.labels[3][13], "bucket3");
+}
+
+TEST_F(BinaryStatsTest, Values)
+{
+    dumpSequence();
+    const Decoded file = Decoder(contents()).decode();
+
+    EXPECT_EQ(file.ticks, (std::vector<Tick>{100, 200, 300, 400}));
+
+    using Values = std::vector<std::vector<double>>;
+    EXPECT_EQ(file.values.at("sys.count"), (Values{{1}, {2}, {3}, {3}}));
+    EXPECT_EQ(file.values.at("sys.freq"),
+              (Values{{1000}, {1000}, {1000}, {1000}}));
+    EXPECT_EQ(file.values.at("sys.vec"),
+              (Values{{1, 0, 0}, {1, 5, 0}, {2, 6, 7}, {2, 6, 7}}));
+    EXPECT_EQ(file.values.at("sys.ratio"),
+              (Values{{0.001}, {0.002}, {0.003}, {0.003}}));
+    const auto one = distValues(2, 1, 1, 0, 1, {1, 1, 0, 0});
+    const auto two = distValues(3, 3, 5, 0, 2, {1, 1, 1, 0});
+    EXPECT_EQ(file.values.at("sys.dist"), (Values{one, two, two, two}));
+    // The late stat is only in the schema from the dump it appears in
+    EXPECT_EQ(file.values.at("late.stat"), (Values{{4}, {4}}));
+}
+
+/** Each dump only records the stats that changed */
+TEST_F(BinaryStatsTest, OnlyChanges)
+{
+    dumpSequence();
+    const Decoded file = Decoder(contents()).decode();
+
+    EXPECT_EQ(file.recorded.at("sys.count"), 3);
+    EXPECT_EQ(file.recorded.at("sys.freq"), 1);
+    EXPECT_EQ(file.recorded.at("sys.vec"), 3);
+    EXPECT_EQ(file.recorded.at("sys.dist"), 2);
+    EXPECT_EQ(file.recorded.at("sys.ratio"), 3);
+    EXPECT_EQ(file.recorded.at("late.stat"), 1);
+}
+
+/** The bytes read back by the Python reader test */
+TEST_F(BinaryStatsTest, Format)
+{
+    dumpSequence();
+    EXPECT_EQ(toHex(contents()), sequenceHex);
+}
+
+/**
+ * A dump skipping the zero stats still records the stats that become
+ * zero, the reader would otherwise carry their old values forward.
+ */
+TEST_F(BinaryStatsTest, SkipZeroAfterReset)
+{
+    open();
+    count = 5;
+    freq = 1000;
+    vec[1] = 2;
+    dumpNonZero(100);
+
+    root.resetStats();
+    dumpNonZero(200);
+
+    count = 1;
+    dumpNonZero(300);
+
+    const Decoded file = Decoder(contents()).decode();
+    using Values = std::vector<std::vector<double>>;
+    EXPECT_EQ(file.values.at("sys.count"), (Values{{5}, {0}, {1}}));
+    EXPECT_EQ(file.values.at("sys.freq"), (Values{{1000}, {0}, {0}}));
+    EXPECT_EQ(file.values.at("sys.vec"),
+              (Values{{0, 2, 0}, {0, 0, 0}, {0, 0, 0}}));
+    // Stats that were always zero are never written
+    EXPECT_EQ(file.values.count("sys.dist"), 0);
+    EXPECT_EQ(file.values.count("late.stat"), 0);
+}
@@ -0,0 +1,121 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/filter.hh"
+
+#include "base/logging.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+std::string
+alternation(const std::vector<std::string> &patterns)
+{
+    std::string regex;
+    for (const auto &pattern : patterns) {
+        if (!regex.empty())
+            regex += "|";
+        regex += "(?:" + pattern + ")";
+    }
+    return regex;
+}
+
+std::string
+subPath(const std::string &path, const std::string &name)
+{
+    return path.empty() ? name : path + "." + name;
+}
+
+} // anonymous namespace
+
+DumpFilter::DumpFilter(const std::vector<std::string> &patterns,
+                       bool skip_zero)
+    : matchAll(patterns.empty()), allowlist(alternation(patterns),
+          std::regex::ECMAScript | std::regex::optimize),
+      skipZero(skip_zero)
+{
+}
+
+bool
+DumpFilter::matched(const Info &info, const std::string &path)
+{
+    if (matchAll)
+        return true;
+
+    auto it = matches.find(&info);
+    if (it == matches.end()) {
+        it = matches.emplace(&info, std::regex_match(
+                subPath(path, info.name), allowlist)).first;
+    }
+    return it->second;
+}
+
+void
+DumpFilter::prepare(const Group &group, const std::string &path)
+{
+    for (auto *info : group.getStats()) {
+        if (matched(*info, path) && (!skipZero || !info->zero()))
+            info->prepare();
+    }
+
+    for (const auto &[name, sub_group] : group.getStatGroups())
+        prepare(*sub_group, subPath(path, name));
+}
+
+void
+DumpFilter::visit(const Group &group, Output &output,
+                  const std::string &path)
+{
+    for (auto *info : group.getStats()) {
+        if (!matched(*info, path))
+            continue;
+
+        if (!skipZero || !info->zero()) {
+            info->visit(output);
+        } else if (output.keepZero(*info)) {
+            // prepare() skipped it as it is zero
+            info->prepare();
+            info->visit(output);
+        }
+    }
+
+    for (const auto &[name, sub_group] : group.getStatGroups()) {
+        output.beginGroup(name.c_str());
+        visit(*sub_group, output, subPath(path, name));
+        output.endGroup();
+    }
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,98 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_FILTER_HH__
+#define __BASE_STATS_FILTER_HH__
+
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Group;
+class Info;
+struct Output;
+
+/**
+ * Selects the stats a dump prepares and visits, and walks the stat groups
+ * in C++ rather than from Python. A stat is dumped if its full name, e.g.
+ * system.cpu.ipc, matches one of the regular expressions of the
+ * allowlist, or any name if the allowlist is empty. Stats whose values are
+ * all zero, i.e. that were not touched since the last reset, can be
+ * skipped as well, unless the output has to see them become zero (see
+ * Output::keepZero()).
+ *
+ * Names don't change once the stats are enabled, so whether a stat
+ * matches is decided at the first dump and remembered.
+ */
+class DumpFilter
+{
+  public:
+    /**
+     * @param patterns Regular expressions matching the full names of the
+     *                 stats to dump, all the stats if empty.
+     * @param skip_zero Whether to skip the stats whose values are zero.
+     */
+    DumpFilter(const std::vector<std::string> &patterns, bool skip_zero);
+
+    /**
+     * Prepare the selected stats of a group and of its subgroups.
+     *
+     * @param group Group to start from.
+     * @param path Full name of the group, empty for the root.
+     */
+    void prepare(const Group &group, const std::string &path = "");
+
+    /**
+     * Visit the selected stats of a group and of its subgroups.
+     *
+     * @param group Group to start from.
+     * @param output Output to visit the stats with.
+     * @param path Full name of the group, empty for the root.
+     */
+    void visit(const Group &group, Output &output,
+               const std::string &path = "");
+
+  private:
+    /** Whether the full name of a stat matches the allowlist */
+    bool matched(const Info &info, const std::string &path);
+
+    const bool matchAll;
+    const std::regex allowlist;
+    const bool skipZero;
+
+    std::unordered_map<const Info *, bool> matches;
+};
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_FILTER_HH__
@@ -0,0 +1,196 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/stats/filter.hh"
+#include "base/stats/group.hh"
+#include "base/stats/info.hh"
+#include "base/stats/output.hh"
+
+using namespace gem5;
+
+class FilterTestInfo : public statistics::Info
+{
+  public:
+    FilterTestInfo(statistics::Group &group, const std::string &name,
+                   bool is_zero = false)
+        : isZero(is_zero)
+    {
+        setName(name, false);
+        group.addStat(this);
+    }
+
+    bool isZero;
+    int prepared = 0;
+    int visited = 0;
+
+    bool check() const override { return true; }
+    void prepare() override { prepared++; }
+    void reset() override {}
+    bool zero() const override { return isZero; }
+    void visit(statistics::Output &visitor) override { visited++; }
+};
+
+/** Output that only records the groups it goes through. */
+class GroupRecorder : public statistics::Output
+{
+  public:
+    std::vector<std::string> groups;
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+
+    void beginGroup(const char *name) override { groups.push_back(name); }
+    void endGroup() override {}
+
+    void visit(const statistics::ScalarInfo &info) override {}
+    void visit(const statistics::VectorInfo &info) override {}
+    void visit(const statistics::DistInfo &info) override {}
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+};
+
+/** Output that has to see the given stats even when they are zero. */
+class ChangeRecorder : public GroupRecorder
+{
+  public:
+    std::set<const statistics::Info *> kept;
+
+    bool
+    keepZero(const statistics::Info &info) const override
+    {
+        return kept.count(&info);
+    }
+};
+
+/** Test that an empty allowlist selects all the stats. */
+TEST(StatsFilterTest, EmptyAllowlist)
+{
+    statistics::Group root(nullptr);
+    statistics::Group cpu(&root, "cpu");
+    FilterTestInfo cycles(cpu, "cycles");
+    FilterTestInfo insts(cpu, "insts");
+
+    statistics::DumpFilter filter({}, false);
+    GroupRecorder output;
+    filter.prepare(root);
+    filter.visit(root, output);
+
+    ASSERT_EQ(cycles.prepared, 1);
+    ASSERT_EQ(cycles.visited, 1);
+    ASSERT_EQ(insts.prepared, 1);
+    ASSERT_EQ(insts.visited, 1);
+    ASSERT_EQ(output.groups, std::vector<std::string>{"cpu"});
+}
+
+/** Test that the allowlist matches the full names of the stats. */
+TEST(StatsFilterTest, AllowlistFullNames)
+{
+    statistics::Group root(nullptr);
+    statistics::Group cpu0(&root, "cpu0");
+    statistics::Group cpu1(&root, "cpu1");
+    statistics::Group dcache(&cpu1, "dcache");
+    FilterTestInfo ipc0(cpu0, "ipc");
+    FilterTestInfo ipc1(cpu1, "ipc");
+    FilterTestInfo misses(dcache, "misses");
+    FilterTestInfo top(root, "ipc");
+
+    statistics::DumpFilter filter({"cpu\\d+\\.ipc", "cpu1\\.dcache\\..*"},
+                                  false);
+    GroupRecorder output;
+    filter.prepare(root);
+    filter.visit(root, output);
+
+    ASSERT_EQ(ipc0.visited, 1);
+    ASSERT_EQ(ipc1.visited, 1);
+    ASSERT_EQ(misses.visited, 1);
+    ASSERT_EQ(top.prepared, 0);
+    ASSERT_EQ(top.visited, 0);
+}
+
+/** Test that the path of a sub-tree is part of the full names. */
+TEST(StatsFilterTest, AllowlistSubTree)
+{
+    statistics::Group root(nullptr);
+    statistics::Group cpu(&root, "cpu");
+    FilterTestInfo ipc(cpu, "ipc");
+    FilterTestInfo cpi(cpu, "cpi");
+
+    statistics::DumpFilter filter({"system\\.cpu\\.ipc"}, false);
+    GroupRecorder output;
+    filter.visit(root, output, "system");
+
+    ASSERT_EQ(ipc.visited, 1);
+    ASSERT_EQ(cpi.visited, 0);
+}
+
+/** Test that zero stats can be skipped, and that it is not cached. */
+TEST(StatsFilterTest, SkipZero)
+{
+    statistics::Group root(nullptr);
+    FilterTestInfo touched(root, "touched");
+    FilterTestInfo untouched(root, "untouched", true);
+
+    statistics::DumpFilter filter({}, true);
+    GroupRecorder output;
+    filter.prepare(root);
+    filter.visit(root, output);
+
+    ASSERT_EQ(touched.prepared, 1);
+    ASSERT_EQ(touched.visited, 1);
+    ASSERT_EQ(untouched.prepared, 0);
+    ASSERT_EQ(untouched.visited, 0);
+
+    untouched.isZero = false;
+    filter.visit(root, output);
+    ASSERT_EQ(untouched.visited, 1);
+}
+
+/** Test that zero stats the output has to keep are still visited. */
+TEST(StatsFilterTest, SkipZeroKept)
+{
+    statistics::Group root(nullptr);
+    FilterTestInfo reset(root, "reset", true);
+    FilterTestInfo untouched(root, "untouched", true);
+
+    statistics::DumpFilter filter({}, true);
+    ChangeRecorder output;
+    output.kept.insert(&reset);
+    filter.prepare(root);
+    filter.visit(root, output);
+
+    ASSERT_EQ(reset.prepared, 1);
+    ASSERT_EQ(reset.visited, 1);
+    ASSERT_EQ(untouched.prepared, 0);
+    ASSERT_EQ(untouched.visited, 0);
+}
@@ -72,6 +72,13 @@ struct Output
     virtual void beginGroup(const char *name) = 0;
     virtual void endGroup() = 0;
 
+    /**
+     * Whether a dump skipping the stats whose values are zero must still
+     * visit this one, e.g. because the output only records changes and
+     * would otherwise keep the values it had before a reset.
+     */
+    virtual bool keepZero(const Info &info) const { return false; }
+
     virtual void visit(const ScalarInfo &info) = 0;
     virtual void visit(const VectorInfo &info) = 0;
     virtual void visit(const DistInfo &info) = 0;
@@ -57,6 +57,14 @@ from m5.util.fdthelper import *
 default_tracer = ExeTracer()
 
 
+# How a CPU model handles the cycles where its pipeline is stalled waiting
+# for an event, such as a memory response: tick them (Off), skip them until
+# the event (Skip), or tick them while checking that they could have been
+# skipped (Validate).
+class CycleSkipMode(ScopedEnum):
+    vals = ["Off", "Skip", "Validate"]
+
+
 class BaseCPU(ClockedObject):
     type = "BaseCPU"
     abstract = True
@@ -238,6 +246,12 @@ class BaseCPU(ClockedObject):
         if self.checker != NULL:
             self.checker.createThreads()
 
+    def useSharedDecodeCache(self, cache):
+        """Make the decoders made by createThreads() share a
+        SharedDecodeCache, e.g., one per system, with other CPUs."""
+        for decoder in self.decoder:
+            decoder.shared_cache = cache
+
     def addCheckerCpu(self):
         pass
 
@@ -87,6 +87,16 @@ ActivityRecorder::advance()
     activityBuffer.advance();
 }
 
+bool
+ActivityRecorder::hasRecentActivity() const
+{
+    int active_stages = 0;
+    for (int i = 0; i < numStages; ++i)
+        active_stages += stageActive[i];
+
+    return activityCount > active_stages;
+}
+
 void
 ActivityRecorder::activateStage(const int idx)
 {
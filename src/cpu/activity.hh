@@ -90,6 +90,13 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /**
+     * Returns if any activity was recorded in the last longestLatency
+     * cycles, as opposed to the CPU only being active because some
+     * stages are.
+     */
+    bool hasRecentActivity() const;
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
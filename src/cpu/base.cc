@@ -382,16 +382,20 @@ BaseCPU::regProbePoints()
     ppRetiredStores = pmuProbePoint("RetiredStores");
     ppRetiredBranches = pmuProbePoint("RetiredBranches");
 
+    ppRetiredCtrl = new ProbePointArg<RetiredCtrl>(getProbeManager(),
+                                                   "RetiredCtrl");
+
     ppSleeping = new ProbePointArg<bool>(this->getProbeManager(),
                                          "Sleeping");
 }
 
 void
-BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
+BaseCPU::probeInstCommit(const StaticInstPtr &inst, const PCStateBase &pc,
+                         ThreadID tid)
 {
     if (!inst->isMicroop() || inst->isLastMicroop()) {
         ppRetiredInsts->notify(1);
-        ppRetiredInstsPC->notify(pc);
+        ppRetiredInstsPC->notify(pc.instAddr());
     }
 
     if (inst->isLoad())
@@ -400,8 +404,10 @@ BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
     if (inst->isStore() || inst->isAtomic())
         ppRetiredStores->notify(1);
 
-    if (inst->isControl())
+    if (inst->isControl()) {
         ppRetiredBranches->notify(1);
+        ppRetiredCtrl->notify(RetiredCtrl{tid, inst, pc});
+    }
 }
 
 BaseCPU::
@@ -427,6 +433,25 @@ BaseCPUStats::BaseCPUStats(statistics::Group *parent)
     ipc = numInsts / numCycles;
 }
 
+void
+BaseCPU::
+BaseCPUStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    numInsts += counts.numInsts;
+    numOps += counts.numOps;
+    counts = Counts();
+}
+
+void
+BaseCPU::
+BaseCPUStats::resetStats()
+{
+    counts = Counts();
+    statistics::Group::resetStats();
+}
+
 void
 BaseCPU::regStats()
 {
@@ -1049,27 +1074,65 @@ CommitCPUStats::updateComCtrlStats(const StaticInstPtr staticInst)
 {
     /* Add a count for every control instruction type */
     if (staticInst->isControl()) {
+        auto &control = counts.committedControl;
         if (staticInst->isReturn()) {
-            committedControl[gem5::StaticInstFlags::Flags::IsReturn]++;
+            control[gem5::StaticInstFlags::Flags::IsReturn]++;
         }
         if (staticInst->isCall()) {
-            committedControl[gem5::StaticInstFlags::Flags::IsCall]++;
+            control[gem5::StaticInstFlags::Flags::IsCall]++;
         }
         if (staticInst->isDirectCtrl()) {
-            committedControl[gem5::StaticInstFlags::Flags::IsDirectControl]++;
+            control[gem5::StaticInstFlags::Flags::IsDirectControl]++;
         }
         if (staticInst->isIndirectCtrl()) {
-            committedControl
-                [gem5::StaticInstFlags::Flags::IsIndirectControl]++;
+            control[gem5::StaticInstFlags::Flags::IsIndirectControl]++;
         }
         if (staticInst->isCondCtrl()) {
-            committedControl[gem5::StaticInstFlags::Flags::IsCondControl]++;
+            control[gem5::StaticInstFlags::Flags::IsCondControl]++;
         }
         if (staticInst->isUncondCtrl()) {
-            committedControl[gem5::StaticInstFlags::Flags::IsUncondControl]++;
+            control[gem5::StaticInstFlags::Flags::IsUncondControl]++;
         }
-        committedControl[gem5::StaticInstFlags::Flags::IsControl]++;
+        control[gem5::StaticInstFlags::Flags::IsControl]++;
+    }
+}
+
+void
+BaseCPU::
+CommitCPUStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    numInsts += counts.numInsts;
+    numOps += counts.numOps;
+    numInstsNotNOP += counts.numInstsNotNOP;
+    numOpsNotNOP += counts.numOpsNotNOP;
+    numMemRefs += counts.numMemRefs;
+    numFpInsts += counts.numFpInsts;
+    numIntInsts += counts.numIntInsts;
+    numLoadInsts += counts.numLoadInsts;
+    numStoreInsts += counts.numStoreInsts;
+    numVecInsts += counts.numVecInsts;
+
+    for (unsigned i = 0; i < Num_OpClasses; ++i) {
+        if (counts.committedInstType[i])
+            committedInstType[i] += counts.committedInstType[i];
     }
+
+    for (unsigned i = 0; i < StaticInstFlags::Flags::Num_Flags; i++) {
+        if (counts.committedControl[i])
+            committedControl[i] += counts.committedControl[i];
+    }
+
+    counts = Counts();
+}
+
+void
+BaseCPU::
+CommitCPUStats::resetStats()
+{
+    counts = Counts();
+    statistics::Group::resetStats();
 }
 
 } // namespace gem5
@@ -42,11 +42,14 @@
 #ifndef __CPU_BASE_HH__
 #define __CPU_BASE_HH__
 
+#include <array>
 #include <memory>
 #include <vector>
 
 #include "arch/generic/interrupts.hh"
 #include "base/statistics.hh"
+#include "cpu/op_class.hh"
+#include "cpu/static_inst.hh"
 #include "debug/Mwait.hh"
 #include "mem/htm.hh"
 #include "mem/port_proxy.hh"
@@ -496,9 +499,24 @@ class BaseCPU : public ClockedObject
      * instruction.
      *
      * @param inst Instruction that just committed
-     * @param pc PC of the instruction that just committed
+     * @param pc PC state of the instruction that just committed, as left
+     *        by its execution
+     * @param tid Thread the instruction belongs to
      */
-    virtual void probeInstCommit(const StaticInstPtr &inst, Addr pc);
+    virtual void probeInstCommit(const StaticInstPtr &inst,
+                                 const PCStateBase &pc, ThreadID tid);
+
+    /**
+     * Argument of the RetiredCtrl probe point. The PC state is the one
+     * left by the execution of the instruction, advancing it gives the
+     * PC of the next instruction.
+     */
+    struct RetiredCtrl
+    {
+        ThreadID tid;
+        const StaticInstPtr &inst;
+        const PCStateBase &pc;
+    };
 
    protected:
     /**
@@ -529,6 +547,9 @@ class BaseCPU : public ClockedObject
     /** Retired branches (any type) */
     probing::PMUUPtr ppRetiredBranches;
 
+    /** Retired control instructions, with their outcome */
+    ProbePointArg<RetiredCtrl> *ppRetiredCtrl;
+
     /** CPU cycle counter even if any thread Context is suspended*/
     probing::PMUUPtr ppAllCycles;
 
@@ -633,6 +654,10 @@ class BaseCPU : public ClockedObject
     struct BaseCPUStats : public statistics::Group
     {
         BaseCPUStats(statistics::Group *parent);
+
+        void preDumpStats() override;
+        void resetStats() override;
+
         // Number of CPU insts and ops committed at CPU core level
         statistics::Scalar numInsts;
         statistics::Scalar numOps;
@@ -643,6 +668,13 @@ class BaseCPU : public ClockedObject
         statistics::Formula ipc;
         statistics::Scalar numWorkItemsStarted;
         statistics::Scalar numWorkItemsCompleted;
+
+        /* Core level commit counts, see CommitCPUStats::Counts */
+        struct Counts
+        {
+            Counter numInsts = 0;
+            Counter numOps = 0;
+        } counts;
     } baseStats;
 
   private:
@@ -777,6 +809,9 @@ class BaseCPU : public ClockedObject
     {
         CommitCPUStats(statistics::Group *parent, int thread_id);
 
+        void preDumpStats() override;
+        void resetStats() override;
+
         /* Number of simulated instructions committed */
         statistics::Scalar numInsts;
         statistics::Scalar numOps;
@@ -814,6 +849,29 @@ class BaseCPU : public ClockedObject
         statistics::Vector committedControl;
         void updateComCtrlStats(const StaticInstPtr staticInst);
 
+        /**
+         * Counts of the committed instructions. The commit paths of the
+         * CPUs increment these plain integers rather than the stats above,
+         * as updating a stat for every instruction is a measurable part of
+         * the cost of simulating it. The counts are added to the stats
+         * before they are dumped, and dropped when they are reset.
+         */
+        struct Counts
+        {
+            Counter numInsts = 0;
+            Counter numOps = 0;
+            Counter numInstsNotNOP = 0;
+            Counter numOpsNotNOP = 0;
+            Counter numMemRefs = 0;
+            Counter numFpInsts = 0;
+            Counter numIntInsts = 0;
+            Counter numLoadInsts = 0;
+            Counter numStoreInsts = 0;
+            Counter numVecInsts = 0;
+            std::array<Counter, Num_OpClasses> committedInstType = {};
+            std::array<Counter, StaticInstFlags::Flags::Num_Flags>
+                committedControl = {};
+        } counts;
     };
 
     std::vector<std::unique_ptr<FetchCPUStats>> fetchStats;
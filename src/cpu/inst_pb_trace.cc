@@ -101,7 +101,7 @@ void
 InstPBTrace::closeStreams()
 {
     if (curMsg) {
-        traceStream->write(*curMsg);
+        traceStream->write(*curMsg, curMsg->tick());
         delete curMsg;
         curMsg = NULL;
     }
@@ -136,7 +136,7 @@ InstPBTrace::traceInst(ThreadContext *tc, StaticInstPtr si,
 {
     if (curMsg) {
         //TODO if we are running multi-threaded I assume we'd need a lock here
-        traceStream->write(*curMsg);
+        traceStream->write(*curMsg, curMsg->tick());
         delete curMsg;
         curMsg = NULL;
     }
@@ -325,6 +325,11 @@ class BaseMinorCPU(BaseCPU):
         "Fetch1 maximum fetch size in bytes (0 means use system cache"
         " line size)",
     )
+    fetch1FTQSize = Param.Unsigned(
+        0,
+        "Number of cache lines the decoupled frontend predicts and "
+        "prefetches ahead of Fetch1, per thread (0 disables it)",
+    )
     fetch1ToFetch2ForwardDelay = Param.Cycles(
         1, "Forward cycle delay from Fetch1 to Fetch2 (1 means next cycle)"
     )
@@ -386,6 +391,12 @@ class BaseMinorCPU(BaseCPU):
     executeInputBufferSize = Param.Unsigned(
         7, "Size of input buffer to Execute in cycles-worth of insts."
     )
+    executeMaxInFlightInsts = Param.Unsigned(
+        0,
+        "Number of issued instructions which can wait to be committed, like"
+        " the entries of an issue scoreboard (0 means no limit other than"
+        " the FU pipelines' capacity)",
+    )
     executeMemoryWidth = Param.Unsigned(
         0,
         "Width (and snap) in bytes of the data memory interface. (0 mean use"
@@ -432,6 +443,12 @@ class BaseMinorCPU(BaseCPU):
     enableIdling = Param.Bool(
         True, "Enable cycle skipping when the processor is idle\n"
     )
+    cycleSkipping = Param.CycleSkipMode(
+        "Off",
+        "Whether to skip the cycles where instructions only move along the "
+        "FU pipelines, e.g. behind a divide, rather than ticking them. "
+        "Requires enableIdling",
+    )
 
     branchPred = Param.BranchPredictor(
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
@@ -348,6 +348,19 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
     /** There's data (not a bubble) at the end of the pipe */
     bool isPopable() { return !BubbleTraits::isBubble(front()); }
 
+    /** The number of advances needed for the data nearest to the end of
+     *  the pipe to get there, or 0 if there's no data before the end */
+    unsigned int
+    advancesToPopable() const
+    {
+        for (int i = 1 - this->past; i <= 0; i++) {
+            if (!BubbleTraits::isBubble((*this)[i]))
+                return i + this->past;
+        }
+
+        return 0;
+    }
+
     /** Try to advance the pipeline.  If we're stalled, don't advance.  If
      *  we're not stalled, advance then check to see if we become stalled
      *  (a non-bubble at the end of the pipe) */
@@ -145,6 +145,14 @@ MinorCPU::wakeup(ThreadID tid)
     DPRINTF(Drain, "[tid:%d] MinorCPU wakeup\n", tid);
     assert(tid < numThreads);
 
+    /* Interrupts are checked by Execute every cycle, so only restart
+     *  the pipeline if it is skipping cycles.  When validating, just
+     *  note that the cycles which would be skipped end here */
+    if (pipeline->isSkippingCycles())
+        wakeupOnEvent(minor::Pipeline::CPUStageId);
+    else
+        pipeline->noteEventWakeup();
+
     if (threads[tid]->status() == ThreadContext::Suspended) {
         threads[tid]->activate();
     }
@@ -294,6 +302,7 @@ MinorCPU::wakeupOnEvent(unsigned int stage_id)
 
     /* Mark that some activity has taken place and start the pipeline */
     activityRecorder->activateStage(stage_id);
+    pipeline->noteEventWakeup();
     pipeline->start();
 }
 
@@ -73,6 +73,7 @@ Execute::Execute(const std::string &name_,
     memoryIssueLimit(params.executeMemoryIssueLimit),
     commitLimit(params.executeCommitLimit),
     memoryCommitLimit(params.executeMemoryCommitLimit),
+    maxInFlightInsts(params.executeMaxInFlightInsts),
     processMoreThanOneInput(params.executeCycleInput),
     fuDescriptions(*params.executeFuncUnits),
     numFuncUnits(fuDescriptions.funcUnits.size()),
@@ -80,6 +81,9 @@ Execute::Execute(const std::string &name_,
     setTraceTimeOnIssue(params.executeSetTraceTimeOnIssue),
     allowEarlyMemIssue(params.executeAllowEarlyMemoryIssue),
     noCostFUIndex(fuDescriptions.funcUnits.size() + 1),
+    cycleSkipMode(params.cycleSkipping),
+    maxSrcRegRelativeLat(0),
+    wakeCycle(0),
     lsq(name_ + ".lsq", name_ + ".dcache_port",
         cpu_, *this,
         params.executeMaxAccessesInMemory,
@@ -140,6 +144,15 @@ Execute::Execute(const std::string &name_,
          *  (for sizing the activity recorder) */
         total_slots += fu_description->opLat;
 
+        /* Note the earliest any FU can read a source register for
+         *  skipping cycles until an instruction can issue */
+        for (MinorFUTiming *timing : fu_description->timings) {
+            for (Cycles lat : timing->srcRegsRelativeLats) {
+                maxSrcRegRelativeLat =
+                    std::max(maxSrcRegRelativeLat, lat);
+            }
+        }
+
         fu_name << name_ << ".fu." << i;
 
         FUPipeline *fu = new FUPipeline(fu_name.str(), *fu_description, cpu);
@@ -543,6 +556,14 @@ cyclicIndexDec(unsigned int index, unsigned int cycle_size)
     return ret;
 }
 
+bool
+Execute::isInFlightInstsFull(ThreadID thread_id) const
+{
+    return maxInFlightInsts != 0 &&
+        executeInfo[thread_id].inFlightInsts->occupiedSpace() >=
+            maxInFlightInsts;
+}
+
 unsigned int
 Execute::issue(ThreadID thread_id)
 {
@@ -591,6 +612,10 @@ Execute::issue(ThreadID thread_id)
                 *inst, thread.streamSeqNum);
             issued = true;
             discarded = true;
+        } else if (isInFlightInstsFull(thread_id)) {
+            DPRINTF(MinorExecute, "Can't issue inst: %s as %d insts are"
+                " already waiting to commit\n", *inst, maxInFlightInsts);
+            issued = false;
         } else {
             /* Try and issue an instruction into an FU, assume we didn't and
              * fix that in the loop */
@@ -865,23 +890,24 @@ Execute::doInstCommitAccounting(MinorDynInstPtr inst)
     {
         thread->numInst++;
         thread->threadStats.numInsts++;
-        cpu.commitStats[inst->id.threadId]->numInsts++;
-        cpu.baseStats.numInsts++;
+        cpu.commitStats[inst->id.threadId]->counts.numInsts++;
+        cpu.baseStats.counts.numInsts++;
 
         /* Act on events related to instruction counts */
         thread->comInstEventQueue.serviceEvents(thread->numInst);
     }
     thread->numOp++;
     thread->threadStats.numOps++;
-    cpu.commitStats[inst->id.threadId]->numOps++;
+    cpu.commitStats[inst->id.threadId]->counts.numOps++;
     cpu.commitStats[inst->id.threadId]
-        ->committedInstType[inst->staticInst->opClass()]++;
+        ->counts.committedInstType[inst->staticInst->opClass()]++;
 
     /* Set the CP SeqNum to the numOps commit number */
     if (inst->traceData)
         inst->traceData->setCPSeq(thread->numOp);
 
-    cpu.probeInstCommit(inst->staticInst, inst->pc->instAddr());
+    cpu.probeInstCommit(inst->staticInst, thread->pcState(),
+                        inst->id.threadId);
 }
 
 bool
@@ -1509,7 +1535,7 @@ Execute::evaluate()
     for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
         /* Find the next issuable instruction for each thread and see if it can
            be issued */
-        if (getInput(tid)) {
+        if (getInput(tid) && !isInFlightInstsFull(tid)) {
             unsigned int input_index = executeInfo[tid].inputIndex;
             MinorDynInstPtr inst = getInput(tid)->insts[input_index];
             if (inst->isFault()) {
@@ -1580,13 +1606,28 @@ Execute::evaluate()
 
     bool need_to_tick =
        num_issued != 0 || /* Issued some insts this cycle */
-       !becoming_stalled || /* Some FU pipelines can still move */
        can_issue_next || /* Can still issue a new inst */
        head_inst_might_commit || /* Could possible commit the next inst */
        lsq.needsToTick() || /* Must step the dcache port */
        interrupted; /* There are pending interrupts */
 
-    if (!need_to_tick) {
+    wakeCycle = Cycles(0);
+
+    /* Some FU pipelines can still move.  If cycles can be skipped, leave
+     *  the pipeline to sleep until the FUs can make a difference */
+    if (!need_to_tick && !becoming_stalled) {
+        if (cycleSkipMode != CycleSkipMode::Off)
+            wakeCycle = findWakeCycle();
+
+        if (wakeCycle == 0) {
+            need_to_tick = true;
+        } else {
+            DPRINTF(Activity, "Only advancing FUs until cycle %d\n",
+                wakeCycle);
+        }
+    }
+
+    if (!need_to_tick && wakeCycle == 0) {
         DPRINTF(Activity, "The next cycle might be skippable as there are no"
             " advanceable FUs\n");
     }
@@ -1604,6 +1645,73 @@ Execute::evaluate()
         inputBuffer[inp.outputWire->threadId].pushTail();
 }
 
+Cycles
+Execute::findWakeCycle()
+{
+    /* Thread priorities can change every cycle and the LSQ may have
+     *  requests to step along */
+    if (cpu.numThreads != 1 || !lsq.isQuiescent())
+        return Cycles(0);
+
+    Cycles now = cpu.curCycle();
+    Cycles wake_cycle = Cycles(0);
+
+    /* The first instruction to reach the end of an advancing FU */
+    for (unsigned int i = 0; i < numFuncUnits; i++) {
+        FUPipeline *fu = funcUnits[i];
+
+        if (fu->occupancy != 0 && !fu->stalled) {
+            Cycles fu_cycle = now + Cycles(fu->advancesToPopable());
+
+            if (wake_cycle == 0 || fu_cycle < wake_cycle)
+                wake_cycle = fu_cycle;
+        }
+    }
+
+    const ForwardInstData *insts_in = getInput(0);
+
+    /* Only the scoreboard may be holding back the next inst.  Anything
+     *  else issue would do with it could happen in any cycle */
+    if (insts_in) {
+        ExecuteThreadInfo &thread = executeInfo[0];
+        MinorDynInstPtr inst = insts_in->insts[thread.inputIndex];
+        Cycles ready_cycle;
+
+        if (inst->isBubble() || inst->isFault() || inst->isNoCostInst() ||
+            inst->id.streamSeqNum != thread.streamSeqNum ||
+            cpu.getContext(0)->status() == ThreadContext::Suspended)
+        {
+            return Cycles(0);
+        }
+
+        if (scoreboard[0].findSrcRegsReadyCycle(inst,
+            maxSrcRegRelativeLat, cpu.getContext(0), ready_cycle) &&
+            ready_cycle < wake_cycle)
+        {
+            wake_cycle = ready_cycle;
+        }
+    }
+
+    /* Not worth skipping */
+    if (wake_cycle <= now + Cycles(1))
+        return Cycles(0);
+
+    return wake_cycle;
+}
+
+void
+Execute::skipCycles(Cycles num_cycles)
+{
+    /* Nothing could be pushed or reach the end of an FU pipeline in the
+     *  skipped cycles */
+    for (unsigned int i = 0; i < numFuncUnits; i++) {
+        FUPipeline *fu = funcUnits[i];
+
+        for (Cycles cycle(0); cycle < num_cycles; ++cycle)
+            fu->advance();
+    }
+}
+
 ThreadID
 Execute::checkInterrupts(BranchData& branch, bool& interrupted)
 {
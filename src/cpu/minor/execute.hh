@@ -55,6 +55,7 @@
 #include "cpu/minor/lsq.hh"
 #include "cpu/minor/pipe_data.hh"
 #include "cpu/minor/scoreboard.hh"
+#include "enums/CycleSkipMode.hh"
 
 namespace gem5
 {
@@ -89,6 +90,10 @@ class Execute : public Named
     /** Number of memory instructions that can be committed per cycle */
     unsigned int memoryCommitLimit;
 
+    /** Number of issued instructions per thread which can wait to be
+     *  committed, 0 for no limit */
+    unsigned int maxInFlightInsts;
+
     /** If true, more than one input line can be processed each cycle if
      *  there is room to execute more instructions than taken from the first
      *  line */
@@ -118,6 +123,20 @@ class Execute : public Named
      *  which pass the MinorDynInst::isNoCostInst test */
     unsigned int noCostFUIndex;
 
+    /** How the cycles where instructions are only moving along the FU
+     *  pipelines are handled */
+    CycleSkipMode cycleSkipMode;
+
+    /** Largest number of cycles before its result is ready that any FU
+     *  can read a source register */
+    Cycles maxSrcRegRelativeLat;
+
+    /** When cycles can be skipped, the cycle at which an instruction
+     *  next reaches the end of its FU or the next instruction can next
+     *  issue.  Execute doesn't wake itself up for the cycles until then.
+     *  Cycles(0) when it must or needn't be ticked */
+    Cycles wakeCycle;
+
     /** Dcache port to pass on to the CPU.  Execute owns this */
     LSQ lsq;
 
@@ -263,6 +282,10 @@ class Execute : public Named
      *  signalled and invoked */
     bool takeInterrupt(ThreadID thread_id, BranchData &branch);
 
+    /** Has the thread as many issued instructions waiting to be
+     *  committed as maxInFlightInsts allows */
+    bool isInFlightInstsFull(ThreadID thread_id) const;
+
     /** Try and issue instructions from the inputBuffer */
     unsigned int issue(ThreadID thread_id);
 
@@ -319,6 +342,11 @@ class Execute : public Named
     ThreadID getCommittingThread();
     ThreadID getIssuingThread();
 
+    /** Find the cycle to set wakeCycle to when the only work left is to
+     *  advance instructions along the FU pipelines, or Cycles(0) if
+     *  anything else may happen before then */
+    Cycles findWakeCycle();
+
   public:
     Execute(const std::string &name_,
         MinorCPU &cpu_,
@@ -356,6 +384,14 @@ class Execute : public Named
     /** Like the drain interface on SimObject */
     unsigned int drain();
     void drainResume();
+
+    /** The cycle until which the pipeline can skip cycles for Execute,
+     *  Cycles(0) if none */
+    Cycles getWakeCycle() const { return wakeCycle; }
+
+    /** Catch up with cycles which were skipped by advancing the FU
+     *  pipelines as evaluate would have */
+    void skipCycles(Cycles num_cycles);
 };
 
 } // namespace minor
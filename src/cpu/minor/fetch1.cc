@@ -50,6 +50,7 @@
 #include "debug/Drain.hh"
 #include "debug/Fetch.hh"
 #include "debug/MinorTrace.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -81,7 +82,9 @@ Fetch1::Fetch1(const std::string &name_,
     icacheState(IcacheRunning),
     lineSeqNum(InstId::firstLineSeqNum),
     numFetchesInMemorySystem(0),
-    numFetchesInITLB(0)
+    numFetchesInITLB(0),
+    numPrefetchesInMemorySystem(0),
+    prefetchNeedsRetry(false)
 {
     for (auto &info: fetchInfo)
         info.pc.reset(params.isa[0]->newPCState());
@@ -117,6 +120,12 @@ Fetch1::Fetch1(const std::string &name_,
         fatal("%s: fetch1FetchLimit must be >= 1 (%d)\n", name_,
             fetchLimit);
     }
+
+    if (params.fetch1FTQSize != 0) {
+        ftq.reset(new branch_prediction::FetchTargetQueue(&cpu,
+            params.branchPred, params.numThreads, params.fetch1FTQSize,
+            cpu.cacheLineSize(), inst_size));
+    }
 }
 
 inline ThreadID
@@ -201,12 +210,55 @@ Fetch1::fetchLine(ThreadID tid)
 
     lineSeqNum++;
 
+    /* Let the decoupled frontend know where fetch has got to */
+    if (ftq)
+        ftq->advance(tid, thread.fetchAddr);
+
     /* Step the PC for the next line onto the line aligned next address.
      * Note that as instructions can span lines, this PC is only a
      * reliable 'new' PC if the next line has a new stream sequence number. */
     thread.fetchAddr = aligned_pc + request_size;
 }
 
+bool
+Fetch1::prefetchLine(ThreadID tid, Addr vaddr)
+{
+    /* Wait for the icache to take requests again. The queue offers the
+     *  same line again on the next cycle */
+    if (icacheState != IcacheRunning || prefetchNeedsRetry)
+        return false;
+
+    RequestPtr request = std::make_shared<Request>(
+        vaddr, cpu.cacheLineSize(), Request::INST_FETCH | Request::PREFETCH,
+        cpu.instRequestorId(), vaddr,
+        cpu.threads[tid]->getTC()->contextId());
+
+    /* The queued path is speculative so a prefetch which faults is just
+     *  dropped */
+    Fault fault = cpu.threads[tid]->mmu->translateFunctional(
+        request, cpu.getContext(tid), BaseMMU::Execute);
+    if (fault != NoFault || !cpu.system->isMemAddr(request->getPaddr()) ||
+        request->isUncacheable()) {
+        return true;
+    }
+
+    PacketPtr packet = Packet::createRead(request);
+    packet->allocate();
+
+    if (!icachePort.sendTimingReq(packet)) {
+        /* The refused prefetch is dropped rather than retried, so that
+         *  it does not hold up line fetches */
+        DPRINTF(Fetch, "Prefetch of 0x%x refused\n", vaddr);
+        delete packet;
+        prefetchNeedsRetry = true;
+        return false;
+    }
+
+    DPRINTF(Fetch, "Issued prefetch of 0x%x\n", vaddr);
+    numPrefetchesInMemorySystem++;
+    return true;
+}
+
 std::ostream &
 operator <<(std::ostream &os, Fetch1::IcacheState state)
 {
@@ -418,6 +470,14 @@ Fetch1::recvTimingResp(PacketPtr response)
 {
     DPRINTF(Fetch, "recvTimingResp %d\n", numFetchesInMemorySystem);
 
+    /* Prefetches only warm the icache, nothing waits for them */
+    if (response->req->isPrefetch()) {
+        assert(numPrefetchesInMemorySystem > 0);
+        numPrefetchesInMemorySystem--;
+        delete response;
+        return true;
+    }
+
     /* Only push the response if we didn't change stream?  No,  all responses
      *  should hit the responses queue.  It's the job of 'step' to throw them
      *  away. */
@@ -454,7 +514,18 @@ void
 Fetch1::recvReqRetry()
 {
     DPRINTF(Fetch, "recvRetry\n");
-    assert(icacheState == IcacheNeedsRetry);
+
+    /* A refused prefetch was dropped, so the retry only lets the queue
+     *  prefetch again from the next cycle */
+    if (prefetchNeedsRetry) {
+        prefetchNeedsRetry = false;
+        cpu.wakeupOnEvent(Pipeline::Fetch1StageId);
+    }
+
+    /* A line fetch refused after the prefetch shares its retry */
+    if (icacheState != IcacheNeedsRetry)
+        return;
+
     assert(!requests.empty());
 
     FetchRequestPtr retryRequest = requests.front();
@@ -516,6 +587,9 @@ Fetch1::changeStream(const BranchData &branch)
     }
     set(thread.pc, branch.target);
     thread.fetchAddr = thread.pc->instAddr();
+
+    if (ftq)
+        ftq->squash(branch.threadId);
 }
 
 void
@@ -665,6 +739,17 @@ Fetch1::evaluate()
     /* Step fetches through the icachePort queues and memory system */
     stepQueues();
 
+    /* Run the decoupled frontend ahead of the line fetches, giving the
+     *  icache to demand fetches first */
+    if (ftq) {
+        for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
+            if (fetchInfo[tid].state == FetchRunning) {
+                ftq->fill(tid, [this, tid](Addr addr)
+                    { return prefetchLine(tid, addr); });
+            }
+        }
+    }
+
     /* As we've thrown away early lines, if there is a line, it must
      *  be from the right stream */
     if (!transfers.empty() &&
@@ -695,6 +780,8 @@ Fetch1::evaluate()
      *  to encourage that output on to the next stage */
     if (!line_out.isBubble())
         cpu.activityRecorder->activity();
+    else if (ftq)
+        ftq->stall();
 
     /* Fetch1 has no inputBuffer so the only activity we can have is to
      *  generate a line output (tested just above) or to initiate a memory
@@ -722,6 +809,8 @@ Fetch1::wakeupFetch(ThreadID tid)
     thread.fetchAddr = thread.pc->instAddr();
     thread.state = FetchRunning;
     thread.wakeupGuard = true;
+    if (ftq)
+        ftq->squash(tid);
     DPRINTF(Fetch, "[tid:%d]: Changing stream wakeup %s\n", tid, *thread.pc);
 
     cpu.wakeupOnEvent(Pipeline::Fetch1StageId);
@@ -730,7 +819,9 @@ Fetch1::wakeupFetch(ThreadID tid)
 bool
 Fetch1::isDrained()
 {
-    bool drained = numInFlightFetches() == 0 && (*out.inputWire).isBubble();
+    bool drained = numInFlightFetches() == 0 &&
+        numPrefetchesInMemorySystem == 0 && !prefetchNeedsRetry &&
+        (*out.inputWire).isBubble();
     for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
         Fetch1ThreadInfo &thread = fetchInfo[tid];
         DPRINTF(Drain, "isDrained[tid:%d]: %s %s%s\n",
@@ -45,6 +45,7 @@
 #ifndef __CPU_MINOR_FETCH1_HH__
 #define __CPU_MINOR_FETCH1_HH__
 
+#include <memory>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
@@ -53,6 +54,7 @@
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/pipe_data.hh"
+#include "cpu/pred/ftq.hh"
 #include "mem/packet.hh"
 
 namespace gem5
@@ -318,6 +320,16 @@ class Fetch1 : public Named
      *  transfers queue */
     unsigned int numFetchesInITLB;
 
+    /** Fetch target queue of the decoupled frontend, if enabled */
+    std::unique_ptr<branch_prediction::FetchTargetQueue> ftq;
+
+    /** Number of instruction prefetches in the memory system */
+    unsigned int numPrefetchesInMemorySystem;
+
+    /** Has the icache refused a prefetch and not yet sent the retry?
+     *  Line fetches carry on meanwhile, only prefetches wait */
+    bool prefetchNeedsRetry;
+
   protected:
     friend std::ostream &operator <<(std::ostream &os,
         Fetch1::FetchState state);
@@ -347,6 +359,10 @@ class Fetch1 : public Named
      *  line. */
     void fetchLine(ThreadID tid);
 
+    /** Prefetch a line on the path queued by the fetch target queue.
+     *  Returns false if the icache could not accept the prefetch */
+    bool prefetchLine(ThreadID tid, Addr vaddr);
+
     /** Try and issue a fetch for a translated request at the
      *  head of the requests queue.  Also tries to move the request
      *  between queues */
@@ -517,7 +517,7 @@ class LSQ : public Named
 
         /** Number of stores in the store buffer which have not been
          *  completely issued to the memory system */
-        unsigned int numUnissuedStores() { return numUnissuedAccesses; }
+        unsigned int numUnissuedStores() const { return numUnissuedAccesses; }
 
         /** Count a store being issued to memory by decrementing
          *  numUnissuedAccesses.  Does not count barrier requests as they
@@ -705,6 +705,11 @@ class LSQ : public Named
      *  an actionable transfers or address translation */
     bool needsToTick();
 
+    /** Will stepping do nothing until a response, retry or address
+     *  translation wakes up the CPU */
+    bool isQuiescent() const
+    { return requests.empty() && storeBuffer.numUnissuedStores() == 0; }
+
     /** Complete a barrier instruction.  Where committed, makes a
      *  BarrierDataRequest and pushed it into the store buffer */
     void completeMemBarrierInst(MinorDynInstPtr inst,
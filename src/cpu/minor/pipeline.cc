@@ -58,6 +58,12 @@ Pipeline::Pipeline(MinorCPU &cpu_, const BaseMinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::baseStats.numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    cycleSkipMode(params.cycleSkipping),
+    skipUntilCycle(0),
+    skipStartCycle(0),
+    evaluating(false),
+    skipWakeEvent([this]{ endSkippedCycles(); },
+        cpu_.name() + ".skipWakeEvent"),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -104,6 +110,11 @@ Pipeline::Pipeline(MinorCPU &cpu_, const BaseMinorCPUParams &params) :
         fatal("%s: executeBranchDelay must be >= 1\n",
             cpu.name(), params.executeBranchDelay);
     }
+
+    if (cycleSkipMode != CycleSkipMode::Off && !allow_idling) {
+        fatal("%s: cycleSkipping requires enableIdling\n",
+            cpu.name());
+    }
 }
 
 void
@@ -124,6 +135,8 @@ Pipeline::minorTrace() const
 void
 Pipeline::evaluate()
 {
+    evaluating = true;
+
     /** We tick the CPU to update the BaseCPU cycle counters */
     cpu.tick();
 
@@ -150,10 +163,21 @@ Pipeline::evaluate()
     activityRecorder.evaluate();
 
     if (allow_idling) {
+        bool idle = !activityRecorder.active() && !needToSignalDrained;
+
+        /* Execute may only be waiting for instructions to move along its
+         *  FU pipelines */
+        Cycles wake_cycle = execute.getWakeCycle();
+
+        if (cycleSkipMode == CycleSkipMode::Validate)
+            validateSkippedCycle(idle ? wake_cycle : Cycles(0));
+
         /* Become idle if we can but are not draining */
-        if (!activityRecorder.active() && !needToSignalDrained) {
+        if (idle && wake_cycle == 0) {
             DPRINTF(Quiesce, "Suspending as the processor is idle\n");
             stop();
+        } else if (idle && cycleSkipMode == CycleSkipMode::Skip) {
+            skipCycles(wake_cycle);
         }
 
         /* Deactivate all stages.  Note that the stages *could*
@@ -177,6 +201,78 @@ Pipeline::evaluate()
             stop();
         }
     }
+
+    evaluating = false;
+}
+
+void
+Pipeline::skipCycles(Cycles wake_cycle)
+{
+    DPRINTF(Quiesce, "Skipping cycles until cycle %d\n", wake_cycle);
+
+    stop();
+    skipStartCycle = cpu.curCycle();
+    skipUntilCycle = wake_cycle;
+
+    cpu.schedule(skipWakeEvent,
+        cpu.clockEdge(wake_cycle - skipStartCycle));
+}
+
+void
+Pipeline::endSkippedCycles()
+{
+    if (skipWakeEvent.scheduled())
+        cpu.deschedule(skipWakeEvent);
+
+    /* Tick from the next clock edge on.  That is now if the pipeline
+     *  would not have been ticked yet at this edge */
+    Cycles wake_cycle = std::max(cpu.curCycle(),
+        skipStartCycle + Cycles(1));
+    Cycles num_skipped = wake_cycle - skipStartCycle - Cycles(1);
+
+    DPRINTF(Quiesce, "Waking up after skipping %d cycles\n", num_skipped);
+
+    execute.skipCycles(num_skipped);
+    cpu.stats.skippedCycles += num_skipped;
+    skipUntilCycle = Cycles(0);
+
+    /* Account for the skipped cycles as start would */
+    running = true;
+    numCycles += num_skipped;
+    countCycles(num_skipped);
+    cpu.schedule(event, cpu.clockEdge(wake_cycle - cpu.curCycle()));
+}
+
+void
+Pipeline::validateSkippedCycle(Cycles wake_cycle)
+{
+    if (skipUntilCycle != 0 && cpu.curCycle() < skipUntilCycle) {
+        /* Nothing but the FU pipelines must have moved */
+        if (wake_cycle == skipUntilCycle) {
+            cpu.stats.skippableCycles++;
+            return;
+        }
+
+        DPRINTF(Quiesce, "Progress in a cycle which would be skipped\n");
+        warn_once("%s: The pipeline made progress in a cycle which would "
+            "have been skipped, cycle skipping would change timing.",
+            cpu.name());
+        cpu.stats.skipMispredicts++;
+    }
+
+    skipUntilCycle = wake_cycle;
+}
+
+void
+Pipeline::noteEventWakeup()
+{
+    if (evaluating || skipUntilCycle == 0)
+        return;
+
+    if (cycleSkipMode == CycleSkipMode::Skip)
+        endSkippedCycles();
+    else
+        skipUntilCycle = Cycles(0);
 }
 
 MinorCPU::MinorCPUPort &
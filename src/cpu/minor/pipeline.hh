@@ -51,7 +51,9 @@
 #include "cpu/minor/execute.hh"
 #include "cpu/minor/fetch1.hh"
 #include "cpu/minor/fetch2.hh"
+#include "enums/CycleSkipMode.hh"
 #include "params/BaseMinorCPU.hh"
+#include "sim/eventq.hh"
 #include "sim/ticked_object.hh"
 
 namespace gem5
@@ -77,6 +79,25 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** How the cycles where instructions are only moving along the FU
+     *  pipelines are handled */
+    CycleSkipMode cycleSkipMode;
+
+    /** When skipping cycles, the cycle at which the pipeline will be
+     *  woken up.  When validating, the end of the cycles which would be
+     *  skipped.  Cycles(0) if none */
+    Cycles skipUntilCycle;
+
+    /** The cycle in which the pipeline started to skip cycles */
+    Cycles skipStartCycle;
+
+    /** True while evaluating to tell wakeups from outside the pipeline
+     *  apart from the stages' own */
+    bool evaluating;
+
+    /** Restarts the pipeline at skipUntilCycle */
+    EventFunctionWrapper skipWakeEvent;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -107,6 +128,19 @@ class Pipeline : public Ticked
     /** True after drain is called but draining isn't complete */
     bool needToSignalDrained;
 
+  protected:
+    /** Stop ticking until the given cycle, unless an event wakes the
+     *  pipeline up earlier */
+    void skipCycles(Cycles wake_cycle);
+
+    /** Catch up with the cycles skipped until now and restart ticking */
+    void endSkippedCycles();
+
+    /** When validating, check that the cycles which would be skipped don't
+     *  make progress.  wake_cycle is the cycle until which cycles would be
+     *  skipped from now on, Cycles(0) if none */
+    void validateSkippedCycle(Cycles wake_cycle);
+
   public:
     Pipeline(MinorCPU &cpu_, const BaseMinorCPUParams &params);
 
@@ -115,6 +149,18 @@ class Pipeline : public Ticked
      *  after quiesce wakeup */
     void wakeupFetch(ThreadID tid);
 
+    /** Note an event waking up the pipeline.  This ends skipping cycles
+     *  as the pipeline may now make progress */
+    void noteEventWakeup();
+
+    /** Is the pipeline skipping cycles.  This is never the case when
+     *  validating, as the pipeline then ticks every cycle */
+    bool
+    isSkippingCycles() const
+    {
+        return cycleSkipMode == CycleSkipMode::Skip && skipUntilCycle != 0;
+    }
+
     /** Try to drain the CPU */
     bool drain();
 
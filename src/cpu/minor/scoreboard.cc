@@ -278,6 +278,35 @@ Scoreboard::canInstIssue(MinorDynInstPtr inst,
     return ret;
 }
 
+bool
+Scoreboard::findSrcRegsReadyCycle(MinorDynInstPtr inst,
+    Cycles max_relative_latency, ThreadContext *thread_context,
+    Cycles &ready_cycle)
+{
+    StaticInstPtr staticInst = inst->staticInst;
+    unsigned int num_srcs = staticInst->numSrcRegs();
+
+    auto *isa = thread_context->getIsaPtr();
+
+    ready_cycle = Cycles(0);
+
+    /* The latest result decides, as for canInstIssue */
+    for (unsigned int src_index = 0; src_index < num_srcs; src_index++) {
+        RegId reg = staticInst->srcRegIdx(src_index).flatten(*isa);
+        unsigned short int index;
+
+        if (findIndex(reg, index)) {
+            if (numUnpredictableResults[index] != 0)
+                return false;
+
+            if (returnCycle[index] > ready_cycle + max_relative_latency)
+                ready_cycle = returnCycle[index] - max_relative_latency;
+        }
+    }
+
+    return true;
+}
+
 void
 Scoreboard::minorTrace() const
 {
@@ -160,6 +160,16 @@ class Scoreboard : public Named
         const std::vector<bool> *cant_forward_from_fu_indices,
         Cycles now, ThreadContext *thread_context);
 
+    /** Find the earliest cycle at which canInstIssue can find the source
+     *  registers of this instruction ready, if no instruction commits
+     *  before then and sources can be read up to max_relative_latency
+     *  cycles before their results are ready.  Returns false if a source
+     *  waits for a result of unpredictable timing, which only a commit
+     *  can make ready */
+    bool findSrcRegsReadyCycle(MinorDynInstPtr inst,
+        Cycles max_relative_latency, ThreadContext *thread_context,
+        Cycles &ready_cycle);
+
     /** MinorTraceIF interface */
     void minorTrace() const;
 };
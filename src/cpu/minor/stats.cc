@@ -47,9 +47,21 @@ MinorStats::MinorStats(BaseCPU *base_cpu)
     : statistics::Group(base_cpu),
     ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
              "Total number of cycles that CPU has spent quiesced or waiting "
-             "for an interrupt")
+             "for an interrupt"),
+    ADD_STAT(skippedCycles, statistics::units::Cycle::get(),
+             "Number of cycles skipped while instructions were only moving "
+             "along the FU pipelines"),
+    ADD_STAT(skippableCycles, statistics::units::Cycle::get(),
+             "Number of ticked cycles which could have been skipped, when "
+             "validating cycle skipping"),
+    ADD_STAT(skipMispredicts, statistics::units::Count::get(),
+             "Number of times the pipeline made progress in a cycle which "
+             "would have been skipped, when validating cycle skipping")
 {
     quiesceCycles.prereq(quiesceCycles);
+    skippedCycles.prereq(skippedCycles);
+    skippableCycles.prereq(skippableCycles);
+    skipMispredicts.prereq(skipMispredicts);
 }
 
 } // namespace minor
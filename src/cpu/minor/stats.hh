@@ -62,6 +62,17 @@ struct MinorStats : public statistics::Group
     /** Number of cycles in quiescent state */
     statistics::Scalar quiesceCycles;
 
+    /** Number of cycles skipped while only the FU pipelines moved */
+    statistics::Scalar skippedCycles;
+
+    /** Number of ticked cycles which could have been skipped, when
+     *  validating cycle skipping */
+    statistics::Scalar skippableCycles;
+
+    /** Number of cycles which would have been skipped but made progress,
+     *  when validating cycle skipping */
+    statistics::Scalar skipMispredicts;
+
 };
 
 } // namespace minor
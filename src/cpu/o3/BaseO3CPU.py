@@ -58,6 +58,14 @@ class CommitPolicy(ScopedEnum):
     vals = ["RoundRobin", "OldestReady"]
 
 
+class IQSchedulerPolicy(ScopedEnum):
+    vals = ["ListOrder", "ReadyBitmap"]
+
+
+class MemDepPredictorType(ScopedEnum):
+    vals = ["StoreSet", "StoreDistance"]
+
+
 class BaseO3CPU(BaseCPU):
     type = "BaseO3CPU"
     cxx_class = "gem5::o3::CPU"
@@ -91,6 +99,11 @@ class BaseO3CPU(BaseCPU):
     fetchQueueSize = Param.Unsigned(
         32, "Fetch queue size in micro-ops per-thread"
     )
+    ftqSize = Param.Unsigned(
+        0,
+        "Number of cache lines the decoupled frontend predicts and "
+        "prefetches ahead of fetch, per thread (0 disables it)",
+    )
 
     renameToDecodeDelay = Param.Cycles(1, "Rename to decode delay")
     iewToDecodeDelay = Param.Cycles(
@@ -154,6 +167,12 @@ class BaseO3CPU(BaseCPU):
     )
     LFSTSize = Param.Unsigned(1024, "Last fetched store table size")
     SSITSize = Param.Unsigned(1024, "Store set ID table size")
+    memDepPredictor = Param.MemDepPredictorType(
+        "StoreSet", "Memory dependence predictor"
+    )
+    SDTSize = Param.Unsigned(
+        1024, "Store distance table size, for the StoreDistance predictor"
+    )
 
     numRobs = Param.Unsigned(1, "Number of Reorder Buffers")
 
@@ -172,6 +191,22 @@ class BaseO3CPU(BaseCPU):
     numPhysCCRegs = Param.Unsigned(0, "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
+    cycleSkipping = Param.CycleSkipMode(
+        "Off",
+        "Whether to skip the cycles where the pipeline is stalled waiting "
+        "for an event, e.g. a memory response, rather than ticking it",
+    )
+    dynInstPool = Param.Bool(
+        True,
+        "Recycle the memory of the dynamic instructions through a per CPU "
+        "pool rather than allocating each from the heap",
+    )
+    iqScheduler = Param.IQSchedulerPolicy(
+        "ListOrder",
+        "How the IQ selects the oldest ready instructions: through per op "
+        "class ready queues ordered in a list, or through a bitmap of the "
+        "ready instructions indexed by sequence number",
+    )
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
     smtFetchPolicy = Param.SMTFetchPolicy("RoundRobin", "SMT Fetch policy")
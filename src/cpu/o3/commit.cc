@@ -79,6 +79,8 @@ Commit::processTrapEvent(ThreadID tid)
     // This will get reset by commit if it was switched out at the
     // time of this event processing.
     trapSquash[tid] = true;
+
+    cpu->wakeSkippedCPU();
 }
 
 Commit::Commit(CPU *_cpu, const BaseO3CPUParams &params)
@@ -348,6 +350,17 @@ Commit::isDrained() const
         interrupt == NoFault;
 }
 
+bool
+Commit::isQuiescent() const
+{
+    for (ThreadID tid : *activeThreads) {
+        if (trapSquash[tid] || tcSquash[tid])
+            return false;
+    }
+
+    return !drainPending;
+}
+
 void
 Commit::takeOverFrom()
 {
@@ -973,7 +986,7 @@ Commit::commitInsts()
             if (commit_success) {
                 ++num_committed;
                 cpu->commitStats[tid]
-                    ->committedInstType[head_inst->opClass()]++;
+                    ->counts.committedInstType[head_inst->opClass()]++;
                 stats.committedInstType[tid][head_inst->opClass()]++;
                 ppCommit->notify(head_inst);
 
@@ -1339,10 +1352,10 @@ Commit::updateComInstStats(const DynInstPtr &inst)
     ThreadID tid = inst->threadNumber;
 
     if (!inst->isMicroop() || inst->isLastMicroop()) {
-        cpu->commitStats[tid]->numInsts++;
-        cpu->baseStats.numInsts++;
+        cpu->commitStats[tid]->counts.numInsts++;
+        cpu->baseStats.counts.numInsts++;
     }
-    cpu->commitStats[tid]->numOps++;
+    cpu->commitStats[tid]->counts.numOps++;
 
     // To match the old model, don't count nops and instruction
     // prefetches towards the total commit count.
@@ -1359,14 +1372,14 @@ Commit::updateComInstStats(const DynInstPtr &inst)
     //  Memory references
     //
     if (inst->isMemRef()) {
-        cpu->commitStats[tid]->numMemRefs++;
+        cpu->commitStats[tid]->counts.numMemRefs++;
 
         if (inst->isLoad()) {
-            cpu->commitStats[tid]->numLoadInsts++;
+            cpu->commitStats[tid]->counts.numLoadInsts++;
         }
 
         if (inst->isStore()) {
-            cpu->commitStats[tid]->numStoreInsts++;
+            cpu->commitStats[tid]->counts.numStoreInsts++;
         }
     }
 
@@ -1376,16 +1389,16 @@ Commit::updateComInstStats(const DynInstPtr &inst)
 
     // Integer Instruction
     if (inst->isInteger()) {
-        cpu->commitStats[tid]->numIntInsts++;
+        cpu->commitStats[tid]->counts.numIntInsts++;
     }
 
     // Floating Point Instruction
     if (inst->isFloating()) {
-        cpu->commitStats[tid]->numFpInsts++;
+        cpu->commitStats[tid]->counts.numFpInsts++;
     }
     // Vector Instruction
     if (inst->isVector()) {
-        cpu->commitStats[tid]->numVecInsts++;
+        cpu->commitStats[tid]->counts.numVecInsts++;
     }
 
     // Function Calls
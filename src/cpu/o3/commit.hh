@@ -190,6 +190,9 @@ class Commit
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Can the stage make progress only after an event? */
+    bool isQuiescent() const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
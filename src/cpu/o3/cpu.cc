@@ -79,6 +79,8 @@ CPU::CPU(const BaseO3CPUParams &params)
 #ifndef NDEBUG
       instcount(0),
 #endif
+      dynInstPool(params.dynInstPool),
+      instList(params.numROBEntries * 2),
       removeInstsThisCycle(false),
       fetch(this, params),
       decode(this, params),
@@ -114,6 +116,7 @@ CPU::CPU(const BaseO3CPUParams &params)
       globalSeqNum(1),
       system(params.system),
       lastRunningCycle(curCycle()),
+      cycleSkipMode(params.cycleSkipping),
       cpuStats(this)
 {
     fatal_if(FullSystem && params.numThreads > 1,
@@ -328,7 +331,20 @@ CPU::CPUStats::CPUStats(CPU *cpu)
                "to idling"),
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
-               "for an interrupt")
+               "for an interrupt"),
+      ADD_STAT(skippedCycles, statistics::units::Cycle::get(),
+               "Number of cycles skipped while the pipeline was stalled "
+               "waiting for an event"),
+      ADD_STAT(skippableCycles, statistics::units::Cycle::get(),
+               "Number of ticked cycles which could have been skipped, when "
+               "validating cycle skipping"),
+      ADD_STAT(skipMispredicts, statistics::units::Count::get(),
+               "Number of times the pipeline made progress in a cycle which "
+               "would have been skipped, when validating cycle skipping"),
+      ADD_STAT(dynInstPoolHits, statistics::units::Count::get(),
+               "Number of dynamic instructions allocated from the pool"),
+      ADD_STAT(dynInstPoolMisses, statistics::units::Count::get(),
+               "Number of dynamic instructions allocated from the heap")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -339,6 +355,23 @@ CPU::CPUStats::CPUStats(CPU *cpu)
 
     quiesceCycles
         .prereq(quiesceCycles);
+
+    skippedCycles
+        .prereq(skippedCycles);
+
+    skippableCycles
+        .prereq(skippableCycles);
+
+    skipMispredicts
+        .prereq(skipMispredicts);
+
+    dynInstPoolHits
+        .functor([cpu]() { return cpu->dynInstPool.hits(); })
+        .flags(statistics::nozero);
+
+    dynInstPoolMisses
+        .functor([cpu]() { return cpu->dynInstPool.misses(); })
+        .flags(statistics::nozero);
 }
 
 void
@@ -348,6 +381,9 @@ CPU::tick()
     assert(!switchedOut());
     assert(drainState() != DrainState::Drained);
 
+    if (skippingCycles)
+        endSkippedCycles();
+
     ++baseStats.numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -387,9 +423,16 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (cycleSkipMode == CycleSkipMode::Skip && isQuiescent()) {
+            DPRINTF(O3CPU, "Stalled, skipping cycles until woken!\n");
+            lastRunningCycle = curCycle();
+            skippingCycles = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
+
+            if (cycleSkipMode == CycleSkipMode::Validate)
+                validateSkippedCycle();
         }
     }
 
@@ -498,6 +541,9 @@ CPU::activateContext(ThreadID tid)
 {
     assert(!switchedOut());
 
+    if (skippingCycles)
+        endSkippedCycles();
+
     // Needs to set each stage to running as well.
     activateThread(tid);
 
@@ -541,6 +587,8 @@ CPU::suspendContext(ThreadID tid)
 
     // If this was the last thread then unschedule the tick event.
     if (activeThreads.size() == 0) {
+        if (skippingCycles)
+            endSkippedCycles();
         unscheduleTickEvent();
         lastRunningCycle = curCycle();
         _status = Idle;
@@ -563,6 +611,8 @@ CPU::haltContext(ThreadID tid)
 
     // If this was the last thread then unschedule the tick event.
     if (activeThreads.size() == 0) {
+        if (skippingCycles)
+            endSkippedCycles();
         if (tickEvent.scheduled())
         {
             unscheduleTickEvent();
@@ -747,6 +797,8 @@ CPU::drain()
         return DrainState::Draining;
     } else {
         DPRINTF(Drain, "CPU is already drained\n");
+        if (skippingCycles)
+            endSkippedCycles();
         if (tickEvent.scheduled())
             deschedule(tickEvent);
 
@@ -1111,12 +1163,21 @@ CPU::squashFromTC(ThreadID tid)
     commit.generateTCEvent(tid);
 }
 
-CPU::ListIt
+size_t
 CPU::addInst(const DynInstPtr &inst)
 {
+    // The in-flight instructions are bounded by the pipeline buffers,
+    // but removed slots can linger in the middle of the list with SMT,
+    // so let the list grow if needed. The indices stay valid.
+    if (instList.full()) {
+        DPRINTF(O3CPU, "Growing the instruction list to %d entries.\n",
+                instList.capacity() * 2);
+        instList.grow(instList.capacity() * 2);
+    }
+
     instList.push_back(inst);
 
-    return --(instList.end());
+    return instList.tail();
 }
 
 void
@@ -1126,16 +1187,16 @@ CPU::instDone(ThreadID tid, const DynInstPtr &inst)
     if (!inst->isMicroop() || inst->isLastMicroop()) {
         thread[tid]->numInst++;
         thread[tid]->threadStats.numInsts++;
-        commitStats[tid]->numInstsNotNOP++;
+        commitStats[tid]->counts.numInstsNotNOP++;
 
         // Check for instruction-count-based events.
         thread[tid]->comInstEventQueue.serviceEvents(thread[tid]->numInst);
     }
     thread[tid]->numOp++;
     thread[tid]->threadStats.numOps++;
-    commitStats[tid]->numOpsNotNOP++;
+    commitStats[tid]->counts.numOpsNotNOP++;
 
-    probeInstCommit(inst->staticInst, inst->pcState().instAddr());
+    probeInstCommit(inst->staticInst, inst->pcState(), tid);
 }
 
 void
@@ -1148,7 +1209,7 @@ CPU::removeFrontInst(const DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    removeList.push_back(inst->getInstListIdx());
 }
 
 void
@@ -1157,41 +1218,26 @@ CPU::removeInstsNotInROB(ThreadID tid)
     DPRINTF(O3CPU, "Thread %i: Deleting instructions from instruction"
             " list.\n", tid);
 
-    ListIt end_it;
-
-    bool rob_empty = false;
+    size_t end_idx;
 
     if (instList.empty()) {
         return;
     } else if (rob.isEmpty(tid)) {
         DPRINTF(O3CPU, "ROB is empty, squashing all insts.\n");
-        end_it = instList.begin();
-        rob_empty = true;
+        end_idx = instList.head() - 1;
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
+        end_idx = (rob.readTailInst(tid))->getInstListIdx();
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
     }
 
     removeInstsThisCycle = true;
 
-    ListIt inst_it = instList.end();
-
-    inst_it--;
-
     // Walk through the instruction list, removing any instructions
-    // that were inserted after the given instruction iterator, end_it.
-    while (inst_it != end_it) {
-        assert(!instList.empty());
-
-        squashInstIt(inst_it, tid);
-
-        inst_it--;
-    }
+    // that were inserted after the given instruction index, end_idx.
+    for (size_t idx = instList.tail(); idx != end_idx; --idx) {
+        assert(instList.isValidIdx(idx));
 
-    // If the ROB was empty, then we actually need to remove the first
-    // instruction as well.
-    if (rob_empty) {
-        squashInstIt(inst_it, tid);
+        squashInstIdx(idx, tid);
     }
 }
 
@@ -1202,62 +1248,70 @@ CPU::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 
     removeInstsThisCycle = true;
 
-    ListIt inst_iter = instList.end();
-
-    inst_iter--;
-
     DPRINTF(O3CPU, "Deleting instructions from instruction "
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
-            tid, seq_num, (*inst_iter)->seqNum);
-
-    while ((*inst_iter)->seqNum > seq_num) {
+            tid, seq_num, instList.back()->seqNum);
 
-        bool break_loop = (inst_iter == instList.begin());
+    for (size_t idx = instList.tail(); instList.isValidIdx(idx); --idx) {
+        // slots of removed instructions have no sequence number to
+        // compare with, skip them
+        if (!instList[idx])
+            continue;
 
-        squashInstIt(inst_iter, tid);
-
-        inst_iter--;
-
-        if (break_loop)
+        if (instList[idx]->seqNum <= seq_num)
             break;
+
+        squashInstIdx(idx, tid);
     }
 }
 
 void
-CPU::squashInstIt(const ListIt &instIt, ThreadID tid)
+CPU::squashInstIdx(size_t idx, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
+    const DynInstPtr &inst = instList[idx];
+
+    if (inst && inst->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*instIt)->threadNumber,
-                (*instIt)->seqNum,
-                (*instIt)->pcState());
+                inst->threadNumber,
+                inst->seqNum,
+                inst->pcState());
 
         // Mark it as squashed.
-        (*instIt)->setSquashed();
+        inst->setSquashed();
 
         // @todo: Formulate a consistent method for deleting
         // instructions from the instruction list
         // Remove the instruction from the list.
-        removeList.push(instIt);
+        removeList.push_back(idx);
     }
 }
 
 void
 CPU::cleanUpRemovedInsts()
 {
-    while (!removeList.empty()) {
+    for (size_t idx : removeList) {
+        if (!instList[idx])
+            continue;
+
         DPRINTF(O3CPU, "Removing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*removeList.front())->threadNumber,
-                (*removeList.front())->seqNum,
-                (*removeList.front())->pcState());
-
-        instList.erase(removeList.front());
+                instList[idx]->threadNumber,
+                instList[idx]->seqNum,
+                instList[idx]->pcState());
 
-        removeList.pop();
+        instList[idx] = nullptr;
     }
 
+    removeList.clear();
+
+    // Drop the removed slots at either end of the list, the ones in
+    // between are dropped once the instructions around them are gone
+    while (!instList.empty() && !instList.front())
+        instList.pop_front();
+    while (!instList.empty() && !instList.back())
+        instList.pop_back();
+
     removeInstsThisCycle = false;
 }
 /*
@@ -1272,18 +1326,18 @@ CPU::dumpInsts()
 {
     int num = 0;
 
-    ListIt inst_list_it = instList.begin();
-
     cprintf("Dumping Instruction List\n");
 
-    while (inst_list_it != instList.end()) {
+    for (const auto &inst : instList) {
+        if (!inst)
+            continue;
+
         cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
                 "Squashed:%i\n\n",
-                num, (*inst_list_it)->pcState().instAddr(),
-                (*inst_list_it)->threadNumber,
-                (*inst_list_it)->seqNum, (*inst_list_it)->isIssued(),
-                (*inst_list_it)->isSquashed());
-        inst_list_it++;
+                num, inst->pcState().instAddr(),
+                inst->threadNumber,
+                inst->seqNum, inst->isIssued(),
+                inst->isSquashed());
         ++num;
     }
 }
@@ -1294,9 +1348,72 @@ CPU::wakeDependents(const DynInstPtr &inst)
     iew.wakeDependents(inst);
 }
 */
+bool
+CPU::isQuiescent()
+{
+    return _status == Running && drainState() == DrainState::Running &&
+        !removeInstsThisCycle && !activityRec.hasRecentActivity() &&
+        fetch.isQuiescent() && iew.isQuiescent() && commit.isQuiescent();
+}
+
+void
+CPU::endSkippedCycles()
+{
+    skippingCycles = false;
+
+    // Account for the cycles ticked without skipping, as for idle cycles.
+    Cycles cycles(curCycle() - lastRunningCycle);
+    if (cycles > 1) {
+        --cycles;
+        cpuStats.skippedCycles += cycles;
+        baseStats.numCycles += cycles;
+    }
+}
+
+bool
+CPU::wakeSkippedCPU()
+{
+    // The cycles from now on would be ticked.
+    skipPredicted = false;
+
+    if (!skippingCycles)
+        return false;
+
+    DPRINTF(Activity, "Waking up CPU from skipped cycles\n");
+
+    endSkippedCycles();
+    if (!tickEvent.scheduled())
+        schedule(tickEvent, clockEdge());
+
+    return true;
+}
+
+void
+CPU::validateSkippedCycle()
+{
+    bool quiescent = isQuiescent();
+
+    if (!skipPredicted) {
+        // Cycles from the next one on would be skipped.
+        skipPredicted = quiescent;
+    } else if (quiescent) {
+        ++cpuStats.skippableCycles;
+    } else {
+        DPRINTF(O3CPU, "Progress in a cycle which would be skipped!\n");
+        warn_once("%s: The pipeline made progress in a cycle which would "
+                  "have been skipped, cycle skipping would change timing.",
+                  name());
+        ++cpuStats.skipMispredicts;
+        skipPredicted = false;
+    }
+}
+
 void
 CPU::wakeCPU()
 {
+    if (wakeSkippedCPU())
+        return;
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1318,6 +1435,9 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
+    // Interrupts are checked by commit every cycle.
+    wakeSkippedCPU();
+
     if (thread[tid]->status() != gem5::ThreadContext::Suspended)
         return;
 
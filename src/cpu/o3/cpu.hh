@@ -50,10 +50,12 @@
 #include <vector>
 
 #include "arch/generic/pcstate.hh"
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
@@ -67,6 +69,7 @@
 #include "cpu/base.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
+#include "enums/CycleSkipMode.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/process.hh"
 
@@ -93,8 +96,6 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
-
     friend class ThreadContext;
 
   public:
@@ -344,8 +345,9 @@ class CPU : public BaseCPU
 
     /** Function to add instruction onto the head of the list of the
      *  instructions.  Used when new instructions are fetched.
+     *  @return The index of the instruction in the list.
      */
-    ListIt addInst(const DynInstPtr &inst);
+    size_t addInst(const DynInstPtr &inst);
 
     /** Function to tell the CPU that an instruction has completed. */
     void instDone(ThreadID tid, const DynInstPtr &inst);
@@ -362,8 +364,8 @@ class CPU : public BaseCPU
     /** Remove all instructions younger than the given sequence number. */
     void removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid);
 
-    /** Removes the instruction pointed to by the iterator. */
-    void squashInstIt(const ListIt &instIt, ThreadID tid);
+    /** Removes the instruction at the given index of the list. */
+    void squashInstIdx(size_t idx, ThreadID tid);
 
     /** Cleans up all instructions on the remove list. */
     void cleanUpRemovedInsts();
@@ -377,13 +379,22 @@ class CPU : public BaseCPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** Pool the dynamic instructions are allocated from. Declared before
+     *  anything holding instructions, so that it is destroyed last.
+     */
+    DynInstPool dynInstPool;
+
+    /** List of all the instructions in flight, in program order across
+     *  threads. Instructions are removed by clearing their slot, and the
+     *  cleared slots are dropped once they reach either end of the list,
+     *  so the slots in between may be null.
+     */
+    CircularQueue<DynInstPtr> instList;
 
-    /** List of all the instructions that will be removed at the end of this
-     *  cycle.
+    /** Indices of all the instructions that will be removed at the end of
+     *  this cycle.
      */
-    std::queue<ListIt> removeList;
+    std::vector<size_t> removeList;
 
 #ifdef GEM5_DEBUG
     /** Debug structure to keep track of the sequence numbers still in
@@ -501,6 +512,15 @@ class CPU : public BaseCPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+    /**
+     * Wakes the CPU if it is skipping stalled cycles. To be called by the
+     * events which the pipeline notices on its next cycle without waking
+     * the CPU.
+     *
+     * @return Whether the CPU was woken
+     */
+    bool wakeSkippedCPU();
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -535,6 +555,37 @@ class CPU : public BaseCPU
     /** The cycle that the CPU was last running, used for statistics. */
     Cycles lastRunningCycle;
 
+  private:
+    /** How the cycles where the pipeline is stalled are handled. */
+    const CycleSkipMode cycleSkipMode;
+
+    /** Whether the CPU is descheduled while its pipeline is stalled. */
+    bool skippingCycles = false;
+
+    /** In validation mode, whether the cycles since the pipeline stalled
+     *  are being checked.
+     */
+    bool skipPredicted = false;
+
+    /**
+     * Checks if no stage can make progress until an event wakes the CPU,
+     * so that the cycles until then can be skipped. This is the case when
+     * no instruction moved in the last cycles, so that nothing is in
+     * flight between the stages, and none of the stages polls for
+     * something that changes without waking the CPU.
+     */
+    bool isQuiescent();
+
+    /** Accounts for the cycles skipped until now. */
+    void endSkippedCycles();
+
+    /** Checks in validation mode that the cycles which would be skipped
+     *  make no progress.
+     */
+    void validateSkippedCycle();
+
+  public:
+
     /** The cycle that the CPU was last activated by a new thread*/
     Tick lastActivatedCycle;
 
@@ -581,6 +632,18 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for the number of stalled cycles skipped. */
+        statistics::Scalar skippedCycles;
+        /** Stat for the number of ticked cycles which could have been
+         *  skipped, in validation mode. */
+        statistics::Scalar skippableCycles;
+        /** Stat for the number of times the pipeline made progress in a
+         *  cycle which would have been skipped, in validation mode. */
+        statistics::Scalar skipMispredicts;
+        /** Stat for the number of instructions allocated from the pool. */
+        statistics::Value dynInstPoolHits;
+        /** Stat for the number of instructions allocated from the heap. */
+        statistics::Value dynInstPoolMisses;
     } cpuStats;
 
   public:
@@ -168,7 +168,9 @@ DynInst::operator new(size_t count, Arrays &arrays)
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
     // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    static DynInstPool heap(false);
+    DynInstPool *pool = arrays.pool ? arrays.pool : &heap;
+    uint8_t *buf = (uint8_t *)pool->allocate(total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -187,13 +189,13 @@ DynInst::operator new(size_t count, Arrays &arrays)
     return buf;
 }
 
-// Because of the custom "new" operator that allocates more bytes than the
-// size of the DynInst object, AddressSanitizer throw new-delete-type-mismatch.
-// Adding a custom delete function is enough to shut down this false positive
+// The custom "new" operator allocates the buffer from a pool, which the
+// buffer is returned to here. This also keeps AddressSanitizer from throwing
+// new-delete-type-mismatch because of the extra bytes allocated.
 void
 DynInst::operator delete(void *ptr)
 {
-    ::operator delete(ptr);
+    DynInstPool::deallocate(ptr);
 }
 
 DynInst::~DynInst()
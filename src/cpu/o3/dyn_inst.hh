@@ -56,6 +56,7 @@
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
@@ -79,9 +80,6 @@ class DynInst : public ExecContext, public RefCounted
             InstSeqNum seq_num, CPU *cpu);
 
   public:
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
     struct Arrays
     {
         size_t numSrcs;
@@ -92,6 +90,9 @@ class DynInst : public ExecContext, public RefCounted
         PhysRegIdPtr *prevDestIdx;
         PhysRegIdPtr *srcIdx;
         uint8_t *readySrcIdx;
+
+        /** Pool to allocate the instruction from, the heap if null. */
+        DynInstPool *pool = nullptr;
     };
 
     static void *operator new(size_t count, Arrays &arrays);
@@ -316,8 +317,8 @@ class DynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber = 0;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
-    ListIt instListIt;
+    /** Index of this BaseDynInst in the list of all insts. */
+    size_t instListIdx = 0;
 
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
@@ -933,11 +934,11 @@ class DynInst : public ExecContext, public RefCounted
     /** Assert this instruction has generated a memory request. */
     void setRequest() { instFlags[ReqMade] = true; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
-    ListIt &getInstListIt() { return instListIt; }
+    /** Returns the index of this instruction in the list of all insts. */
+    size_t getInstListIdx() const { return instListIdx; }
 
-    /** Sets iterator for this instruction in the list of all insts. */
-    void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
+    /** Sets the index of this instruction in the list of all insts. */
+    void setInstListIdx(size_t idx) { instListIdx = idx; }
 
   public:
     /** Returns the number of consecutive store conditional failures. */
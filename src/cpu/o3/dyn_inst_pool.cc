@@ -0,0 +1,99 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <cassert>
+#include <new>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+DynInstPool::DynInstPool(bool enabled) : enabled(enabled)
+{}
+
+DynInstPool::~DynInstPool()
+{
+    for (auto *&block: freeLists) {
+        while (block) {
+            FreeBlock *next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+}
+
+void *
+DynInstPool::allocate(size_t size)
+{
+    const size_t rounded = roundUp(size, Granularity);
+    const unsigned size_class = rounded / Granularity - 1;
+
+    uint8_t *buf;
+    Header header{this, size_class};
+    if (!enabled || size_class >= NumClasses) {
+        buf = (uint8_t *)::operator new(sizeof(Header) + size);
+        header.sizeClass = NoClass;
+    } else if (FreeBlock *block = freeLists[size_class]) {
+        freeLists[size_class] = block->next;
+        numFreeBytes -= sizeof(Header) + rounded;
+        ++numHits;
+        buf = (uint8_t *)block;
+    } else {
+        buf = (uint8_t *)::operator new(sizeof(Header) + rounded);
+        ++numMisses;
+    }
+
+    new (buf) Header(header);
+    return buf + sizeof(Header);
+}
+
+void
+DynInstPool::deallocate(void *ptr)
+{
+    uint8_t *buf = (uint8_t *)ptr - sizeof(Header);
+    const Header header = *(Header *)buf;
+
+    if (header.sizeClass == NoClass) {
+        ::operator delete(buf);
+        return;
+    }
+
+    DynInstPool *pool = header.pool;
+    assert(header.sizeClass < NumClasses);
+    FreeBlock *block = new (buf) FreeBlock;
+    block->next = pool->freeLists[header.sizeClass];
+    pool->freeLists[header.sizeClass] = block;
+    pool->numFreeBytes +=
+        sizeof(Header) + (header.sizeClass + 1) * Granularity;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,118 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Free list allocator for the buffers holding a DynInst and its register
+ * index arrays. The size of the buffers depends on the number of
+ * registers of the instruction, so the buffers are rounded up to a size
+ * class and recycled through one free list per size class. Instructions
+ * are created and destroyed at a high rate, most of them squashed soon
+ * after fetch, and the free lists are LIFO so that the buffer of a
+ * recently destroyed instruction, likely still in the cache, is reused
+ * first.
+ *
+ * Each buffer is preceded by a header recording its pool and size
+ * class, so that it can be returned to its pool without knowing which
+ * CPU it belongs to. The pool must outlive the buffers it allocated,
+ * which holds as the instructions cannot outlive their CPU.
+ */
+class DynInstPool
+{
+  public:
+    /**
+     * @param enabled Whether to recycle the buffers, or to allocate
+     * each from the heap
+     */
+    explicit DynInstPool(bool enabled=true);
+    ~DynInstPool();
+
+    DynInstPool(const DynInstPool &) = delete;
+    DynInstPool &operator=(const DynInstPool &) = delete;
+
+    /** Allocate a buffer of at least a given size. */
+    void *allocate(size_t size);
+
+    /** Free a buffer, returning it to the pool which allocated it. */
+    static void deallocate(void *ptr);
+
+    /** Number of allocations served from a free list. */
+    uint64_t hits() const { return numHits; }
+
+    /** Number of allocations served from the heap. */
+    uint64_t misses() const { return numMisses; }
+
+    /** Number of bytes held in the free lists. */
+    size_t freeBytes() const { return numFreeBytes; }
+
+  private:
+    /** Header preceding each buffer. */
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        DynInstPool *pool;
+        unsigned sizeClass;
+    };
+
+    /** Free buffer, linked through its header. */
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    /** Buffer sizes are rounded up to a multiple of this. */
+    static constexpr size_t Granularity = 64;
+
+    /** Number of size classes, larger buffers are not recycled. */
+    static constexpr unsigned NumClasses = 32;
+
+    /** Size class of buffers which are not recycled. */
+    static constexpr unsigned NoClass = NumClasses;
+
+    const bool enabled;
+
+    /** Free buffers, including their header, per size class */
+    std::array<FreeBlock *, NumClasses> freeLists{};
+
+    uint64_t numHits = 0;
+    uint64_t numMisses = 0;
+    size_t numFreeBytes = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
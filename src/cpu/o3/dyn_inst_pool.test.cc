@@ -0,0 +1,201 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * Stand-in for a DynInst: allocated from a pool together with a trailing
+ * array sized by its number of sources, and reset by its constructor.
+ */
+class TestInst
+{
+  public:
+    static void *
+    operator new(size_t count, o3::DynInstPool &pool, unsigned num_srcs)
+    {
+        return pool.allocate(count + num_srcs);
+    }
+
+    static void
+    operator delete(void *ptr)
+    {
+        o3::DynInstPool::deallocate(ptr);
+    }
+
+    // Called if the constructor throws
+    static void
+    operator delete(void *ptr, o3::DynInstPool &, unsigned)
+    {
+        o3::DynInstPool::deallocate(ptr);
+    }
+
+    TestInst(uint64_t seq_num, unsigned num_srcs)
+        : seqNum(seq_num), numSrcs(num_srcs),
+          readySrcs((uint8_t *)(this + 1))
+    {
+        std::fill(readySrcs, readySrcs + numSrcs, 0);
+    }
+
+    uint64_t seqNum;
+    bool squashed = false;
+    unsigned numSrcs;
+    uint8_t *readySrcs;
+};
+
+} // anonymous namespace
+
+/** A freed buffer is reused by the next allocation of its size class. */
+TEST(DynInstPoolTest, Recycle)
+{
+    o3::DynInstPool pool;
+    void *first = pool.allocate(100);
+    EXPECT_EQ(pool.misses(), 1);
+    EXPECT_EQ(pool.hits(), 0);
+    EXPECT_EQ(pool.freeBytes(), 0);
+
+    o3::DynInstPool::deallocate(first);
+    EXPECT_GE(pool.freeBytes(), 128);
+
+    // 90 bytes are in the same size class as 100 bytes
+    void *second = pool.allocate(90);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(pool.misses(), 1);
+    EXPECT_EQ(pool.hits(), 1);
+    EXPECT_EQ(pool.freeBytes(), 0);
+
+    o3::DynInstPool::deallocate(second);
+}
+
+/** Buffers are only reused for allocations of the same size class. */
+TEST(DynInstPoolTest, SizeClasses)
+{
+    o3::DynInstPool pool;
+    void *small = pool.allocate(64);
+    o3::DynInstPool::deallocate(small);
+
+    void *large = pool.allocate(65);
+    EXPECT_NE(large, small);
+    EXPECT_EQ(pool.misses(), 2);
+    EXPECT_EQ(pool.hits(), 0);
+
+    void *small_again = pool.allocate(1);
+    EXPECT_EQ(small_again, small);
+    EXPECT_EQ(pool.hits(), 1);
+
+    o3::DynInstPool::deallocate(large);
+    o3::DynInstPool::deallocate(small_again);
+}
+
+/** The most recently freed buffer is reused first. */
+TEST(DynInstPoolTest, LastInFirstOut)
+{
+    o3::DynInstPool pool;
+    void *bufs[3];
+    for (auto &buf : bufs)
+        buf = pool.allocate(200);
+    for (auto buf : bufs)
+        o3::DynInstPool::deallocate(buf);
+
+    EXPECT_EQ(pool.allocate(200), bufs[2]);
+    EXPECT_EQ(pool.allocate(200), bufs[1]);
+    EXPECT_EQ(pool.allocate(200), bufs[0]);
+    EXPECT_EQ(pool.freeBytes(), 0);
+
+    for (auto buf : bufs)
+        o3::DynInstPool::deallocate(buf);
+}
+
+/** Buffers are returned to the pool which allocated them. */
+TEST(DynInstPoolTest, OwningPool)
+{
+    o3::DynInstPool pool_a;
+    o3::DynInstPool pool_b;
+    void *buf = pool_a.allocate(100);
+    o3::DynInstPool::deallocate(buf);
+    EXPECT_GT(pool_a.freeBytes(), 0);
+    EXPECT_EQ(pool_b.freeBytes(), 0);
+
+    buf = pool_b.allocate(100);
+    EXPECT_EQ(pool_b.misses(), 1);
+    EXPECT_EQ(pool_b.hits(), 0);
+    o3::DynInstPool::deallocate(buf);
+}
+
+/** Buffers too large for a size class go back to the heap. */
+TEST(DynInstPoolTest, LargeBuffers)
+{
+    o3::DynInstPool pool;
+    void *buf = pool.allocate(1 << 16);
+    o3::DynInstPool::deallocate(buf);
+    EXPECT_EQ(pool.freeBytes(), 0);
+    EXPECT_EQ(pool.hits(), 0);
+}
+
+/** A disabled pool allocates every buffer from the heap. */
+TEST(DynInstPoolTest, Disabled)
+{
+    o3::DynInstPool pool(false);
+    void *buf = pool.allocate(100);
+    o3::DynInstPool::deallocate(buf);
+    EXPECT_EQ(pool.freeBytes(), 0);
+
+    buf = pool.allocate(100);
+    EXPECT_EQ(pool.hits(), 0);
+    o3::DynInstPool::deallocate(buf);
+}
+
+/**
+ * An instruction constructed in a recycled buffer does not see the state
+ * of the instruction which used the buffer before.
+ */
+TEST(DynInstPoolTest, ReuseAfterReset)
+{
+    o3::DynInstPool pool;
+    TestInst *old_inst = new (pool, 16) TestInst(1, 16);
+    old_inst->squashed = true;
+    std::fill(old_inst->readySrcs, old_inst->readySrcs + 16, 0xff);
+    delete old_inst;
+
+    TestInst *new_inst = new (pool, 8) TestInst(2, 8);
+    EXPECT_EQ((void *)new_inst, (void *)old_inst);
+    EXPECT_EQ(pool.hits(), 1);
+    EXPECT_EQ(new_inst->seqNum, 2);
+    EXPECT_FALSE(new_inst->squashed);
+    EXPECT_EQ(new_inst->numSrcs, 8);
+    for (unsigned i = 0; i < new_inst->numSrcs; ++i)
+        EXPECT_EQ(new_inst->readySrcs[i], 0);
+    delete new_inst;
+}
@@ -99,7 +99,8 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
       numThreads(params.numThreads),
       numFetchingThreads(params.smtNumFetchingThreads),
       icachePort(this, _cpu),
-      finishTranslationEvent(this), fetchStats(_cpu, this)
+      finishTranslationEvent(this), fetchStats(_cpu, this),
+      outstandingPrefetches(0)
 {
     if (numThreads > MaxThreads)
         fatal("numThreads (%d) is larger than compiled limit (%d),\n"
@@ -143,6 +144,12 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
 
     // Get the size of an instruction.
     instSize = decoder[0]->moreBytesSize();
+
+    if (params.ftqSize) {
+        ftq.reset(new branch_prediction::FetchTargetQueue(
+                &fetchStats, branchPred, numThreads, params.ftqSize,
+                cacheBlkSize, instSize));
+    }
 }
 
 std::string Fetch::name() const { return cpu->name() + ".fetch"; }
@@ -284,6 +291,8 @@ Fetch::clearStates(ThreadID tid)
     fetchBufferPC[tid] = 0;
     fetchBufferValid[tid] = false;
     fetchQueue[tid].clear();
+    if (ftq)
+        ftq->squash(tid);
 
     // TODO not sure what to do with priorityList for now
     // priorityList.push_back(tid);
@@ -315,6 +324,8 @@ Fetch::resetStage()
         fetchBufferValid[tid] = false;
 
         fetchQueue[tid].clear();
+        if (ftq)
+            ftq->squash(tid);
 
         priorityList.push_back(tid);
     }
@@ -326,6 +337,14 @@ Fetch::resetStage()
 void
 Fetch::processCacheCompletion(PacketPtr pkt)
 {
+    if (pkt->req->isPrefetch()) {
+        // Prefetches only warm the icache, nothing waits for them
+        assert(outstandingPrefetches > 0);
+        --outstandingPrefetches;
+        delete pkt;
+        return;
+    }
+
     ThreadID tid = cpu->contextToThread(pkt->req->contextId());
 
     DPRINTF(Fetch, "[tid:%i] Waking up from cache miss.\n", tid);
@@ -383,6 +402,7 @@ Fetch::drainSanityCheck() const
     assert(retryTid == InvalidThreadID);
     assert(!cacheBlocked);
     assert(!interruptPending);
+    assert(outstandingPrefetches == 0);
 
     for (ThreadID i = 0; i < numThreads; ++i) {
         assert(!memReq[i]);
@@ -419,7 +439,30 @@ Fetch::isDrained() const
      * cycle if the finish translation event is scheduled, so make
      * sure that's not the case.
      */
-    return !finishTranslationEvent.scheduled();
+    return !finishTranslationEvent.scheduled() && outstandingPrefetches == 0;
+}
+
+bool
+Fetch::isQuiescent() const
+{
+    for (ThreadID tid : *activeThreads) {
+        switch (fetchStatus[tid]) {
+          case Squashing:
+          case IcacheAccessComplete:
+            return false;
+          case Running:
+            // A running thread fetches unless something stalls it.
+            if (fetchQueue[tid].size() < fetchQueueSize &&
+                    !stalls[tid].decode && !stalls[tid].drain) {
+                return false;
+            }
+            break;
+          default:
+            break;
+        }
+    }
+
+    return true;
 }
 
 void
@@ -567,6 +610,9 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
 
     memReq[tid] = mem_req;
 
+    if (ftq)
+        ftq->advance(tid, vaddr);
+
     // Initiate translation of the icache block
     fetchStatus[tid] = ItlbWait;
     FetchTranslation *trans = new FetchTranslation(this);
@@ -575,6 +621,42 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     return true;
 }
 
+bool
+Fetch::prefetchLine(ThreadID tid, Addr vaddr)
+{
+    if (cacheBlocked || cpu->isDraining())
+        return false;
+
+    RequestPtr req = std::make_shared<Request>(
+        vaddr, cacheBlkSize, Request::INST_FETCH | Request::PREFETCH,
+        cpu->instRequestorId(), vaddr, cpu->thread[tid]->contextId());
+    req->taskId(cpu->taskId());
+
+    // The queued path is speculative, so a fault only drops the prefetch
+    Fault fault = cpu->mmu->translateFunctional(
+        req, cpu->thread[tid]->getTC(), BaseMMU::Execute);
+    if (fault != NoFault || !cpu->system->isMemAddr(req->getPaddr()) ||
+        req->isUncacheable()) {
+        return true;
+    }
+
+    PacketPtr pkt = Packet::createRead(req);
+    pkt->allocate();
+
+    if (!icachePort.sendTimingReq(pkt)) {
+        DPRINTF(Fetch, "[tid:%i] Can't prefetch %#x, cache blocked\n",
+                tid, vaddr);
+        delete pkt;
+        // The port owes fetch a retry, which unblocks the cache
+        cacheBlocked = true;
+        return false;
+    }
+
+    DPRINTF(Fetch, "[tid:%i] Prefetching cache line %#x\n", tid, vaddr);
+    ++outstandingPrefetches;
+    return true;
+}
+
 void
 Fetch::finishTranslation(const Fault &fault, const RequestPtr &mem_req)
 {
@@ -691,6 +773,8 @@ Fetch::doSquash(const PCStateBase &new_pc, const DynInstPtr squashInst,
 
     set(pc[tid], new_pc);
     fetchOffset[tid] = 0;
+    if (ftq)
+        ftq->squash(tid);
     if (squashInst && squashInst->pcState().instAddr() == new_pc.instAddr())
         macroop[tid] = squashInst->macroop;
     else
@@ -854,6 +938,16 @@ Fetch::tick()
     // Record number of instructions fetched this cycle for distribution.
     fetchStats.nisnDist.sample(numInst);
 
+    // Run the decoupled frontend ahead of fetch
+    if (ftq) {
+        if (numInst == 0)
+            ftq->stall();
+        for (auto tid : *activeThreads) {
+            ftq->fill(tid, [this, tid](Addr addr)
+                      { return prefetchLine(tid, addr); });
+        }
+    }
+
     if (status_change) {
         // Change the fetch stage status if there was a status change.
         _status = updateFetchStatus();
@@ -1026,6 +1120,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
     DynInst::Arrays arrays;
     arrays.numSrcs = staticInst->numSrcRegs();
     arrays.numDests = staticInst->numDestRegs();
+    arrays.pool = &cpu->dynInstPool;
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction = new (arrays) DynInst(
@@ -1051,7 +1146,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
 #endif
 
     // Add instruction to the CPU's list of instructions.
-    instruction->setInstListIt(cpu->addInst(instruction));
+    instruction->setInstListIdx(cpu->addInst(instruction));
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
@@ -1352,6 +1447,9 @@ Fetch::recvReqRetry()
         // the cache being blocked.
         cacheBlocked = false;
     }
+
+    // Fetch notices the retry on its next cycle.
+    cpu->wakeSkippedCPU();
 }
 
 ///////////////////////////////////////
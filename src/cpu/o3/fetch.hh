@@ -49,6 +49,7 @@
 #include "cpu/o3/limits.hh"
 #include "cpu/pc_event.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/ftq.hh"
 #include "cpu/timebuf.hh"
 #include "cpu/translation.hh"
 #include "enums/SMTFetchPolicy.hh"
@@ -241,6 +242,12 @@ class Fetch
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /**
+     * Can the stage make progress only after an event, such as an
+     * instruction cache response? Used by the CPU to skip stalled cycles.
+     */
+    bool isQuiescent() const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -297,6 +304,16 @@ class Fetch
      * @return Any fault that occured.
      */
     bool fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc);
+
+    /**
+     * Prefetches a cache line on the path queued by the fetch target
+     * queue. Prefetches that fault or target a non-memory address are
+     * dropped.
+     * @param tid Thread id.
+     * @param vaddr The address of the line.
+     * @return False if the icache could not accept the prefetch.
+     */
+    bool prefetchLine(ThreadID tid, Addr vaddr);
     void finishTranslation(const Fault &fault, const RequestPtr &mem_req);
 
 
@@ -576,6 +593,12 @@ class Fetch
         /** Rate of how often fetch was idle. */
         statistics::Formula idleRate;
     } fetchStats;
+
+    /** Fetch target queue of the decoupled frontend, if enabled. */
+    std::unique_ptr<branch_prediction::FetchTargetQueue> ftq;
+
+    /** Number of instruction prefetches waiting for a response. */
+    unsigned outstandingPrefetches;
 };
 
 } // namespace o3
@@ -340,6 +340,12 @@ IEW::isDrained() const
     return drained;
 }
 
+bool
+IEW::isQuiescent()
+{
+    return instQueue.isQuiescent() && !ldstQueue.willWB();
+}
+
 void
 IEW::drainSanityCheck() const
 {
@@ -162,6 +162,9 @@ class IEW
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Can the stage make progress only after an event? */
+    bool isQuiescent();
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
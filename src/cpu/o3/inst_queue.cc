@@ -41,9 +41,11 @@
 
 #include "cpu/o3/inst_queue.hh"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/fu_pool.hh"
@@ -89,6 +91,11 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      schedulerPolicy(params.iqScheduler),
+      // Cover enough sequence numbers for all the instructions in flight,
+      // including those fetched and squashed while older ones wait.
+      readyBitmap(size_t(1) << ceilLog2(std::max<size_t>(64,
+              4 * std::max(params.numIQEntries, params.numROBEntries)))),
       iqPolicy(params.smtIQPolicy),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
@@ -421,6 +428,7 @@ InstructionQueue::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
+    readyBitmap.clear();
     nonSpecInsts.clear();
     listOrder.clear();
     deferredMemInsts.clear();
@@ -461,6 +469,15 @@ InstructionQueue::isDrained() const
     return drained;
 }
 
+bool
+InstructionQueue::isQuiescent()
+{
+    // Deferred memory instructions are checked every cycle for the
+    // completion of their translation.
+    return !hasReadyInsts() && instsToExecute.empty() &&
+        deferredMemInsts.empty();
+}
+
 void
 InstructionQueue::drainSanityCheck() const
 {
@@ -546,6 +563,10 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
+    if (!readyBitmap.empty()) {
+        return true;
+    }
+
     if (!listOrder.empty()) {
         return true;
     }
@@ -725,6 +746,29 @@ InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
     readyIt[op_class] = listOrder.insert(next_it, queue_entry);
 }
 
+void
+InstructionQueue::addToReadyList(const DynInstPtr &ready_inst)
+{
+    if (schedulerPolicy == IQSchedulerPolicy::ReadyBitmap) {
+        readyBitmap.insert(ready_inst);
+        return;
+    }
+
+    OpClass op_class = ready_inst->opClass();
+
+    readyInsts[op_class].push(ready_inst);
+
+    // Will need to reorder the list if either a queue is not on the list,
+    // or it has an older instruction than last time.
+    if (!queueOnList[op_class]) {
+        addToOrderList(op_class);
+    } else if (readyInsts[op_class].top()->seqNum  <
+               (*readyIt[op_class]).oldestInst) {
+        listOrder.erase(readyIt[op_class]);
+        addToOrderList(op_class);
+    }
+}
+
 void
 InstructionQueue::processFUCompletion(const DynInstPtr &inst, int fu_idx)
 {
@@ -745,6 +789,141 @@ InstructionQueue::processFUCompletion(const DynInstPtr &inst, int fu_idx)
     instsToExecute.push_back(inst);
 }
 
+void
+InstructionQueue::countIQRead(const DynInstPtr &inst)
+{
+    if (inst->isFloating()) {
+        iqIOStats.fpInstQueueReads++;
+    } else if (inst->isVector()) {
+        iqIOStats.vecInstQueueReads++;
+    } else {
+        iqIOStats.intInstQueueReads++;
+    }
+}
+
+bool
+InstructionQueue::issueInst(const DynInstPtr &issuing_inst,
+                            IssueStruct *i2e_info)
+{
+    OpClass op_class = issuing_inst->opClass();
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            iqIOStats.fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            iqIOStats.vecAluAccesses++;
+        } else {
+            iqIOStats.intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    // If we have an instruction that doesn't require a FU, or a
+    // valid FU, then schedule for execution.
+    if (idx == FUPool::NoFreeFU) {
+        iqStats.statFuBusy[op_class]++;
+        iqStats.fuBusy[tid]++;
+        return false;
+    }
+
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
+    } else {
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
+    }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%llu]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (issuing_inst->firstIssue == -1)
+        issuing_inst->firstIssue = curTick();
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
+    }
+
+    iqStats.statIssuedInstType[tid][op_class]++;
+    return true;
+}
+
+int
+InstructionQueue::scheduleFromReadyBitmap(IssueStruct *i2e_info)
+{
+    // Same selection as the age order list: the oldest ready instruction
+    // is tried first, and an op class without a free FU is skipped for
+    // the rest of the cycle.
+    int total_issued = 0;
+
+    readyBitmap.startSelect();
+
+    while (total_issued < totalWidth) {
+        const DynInstPtr &oldest = readyBitmap.oldest();
+        if (!oldest)
+            break;
+
+        DynInstPtr issuing_inst = oldest;
+
+        countIQRead(issuing_inst);
+
+        if (issuing_inst->isSquashed()) {
+            readyBitmap.popOldest();
+            ++iqStats.squashedInstsIssued;
+            continue;
+        }
+
+        if (issueInst(issuing_inst, i2e_info)) {
+            readyBitmap.popOldest();
+            ++total_issued;
+        } else {
+            readyBitmap.blockClass(issuing_inst->opClass());
+        }
+    }
+
+    return total_issued;
+}
+
 // @todo: Figure out a better way to remove the squashed items from the
 // lists.  Checking the top item of each list to see if it's squashed
 // wastes time and forces jumps.
@@ -775,6 +954,11 @@ InstructionQueue::scheduleReadyInsts()
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
+
+    if (schedulerPolicy == IQSchedulerPolicy::ReadyBitmap) {
+        total_issued = scheduleFromReadyBitmap(i2e_info);
+    }
+
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
 
@@ -785,13 +969,7 @@ InstructionQueue::scheduleReadyInsts()
 
         DynInstPtr issuing_inst = readyInsts[op_class].top();
 
-        if (issuing_inst->isFloating()) {
-            iqIOStats.fpInstQueueReads++;
-        } else if (issuing_inst->isVector()) {
-            iqIOStats.vecInstQueueReads++;
-        } else {
-            iqIOStats.intInstQueueReads++;
-        }
+        countIQRead(issuing_inst);
 
         assert(issuing_inst->seqNum == (*order_it).oldestInst);
 
@@ -812,60 +990,7 @@ InstructionQueue::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                iqIOStats.fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                iqIOStats.vecAluAccesses++;
-            } else {
-                iqIOStats.intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%llu]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueInst(issuing_inst, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -875,31 +1000,10 @@ InstructionQueue::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
-
-            if (issuing_inst->firstIssue == -1)
-                issuing_inst->firstIssue = curTick();
-
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
-
             listOrder.erase(order_it++);
-            iqStats.statIssuedInstType[tid][op_class]++;
         } else {
-            iqStats.statFuBusy[op_class]++;
-            iqStats.fuBusy[tid]++;
             ++order_it;
         }
     }
@@ -1068,17 +1172,7 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    addToReadyList(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1437,17 +1531,7 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        addToReadyList(inst);
     }
 }
 
@@ -1461,7 +1545,9 @@ void
 InstructionQueue::dumpLists()
 {
     for (int i = 0; i < Num_OpClasses; ++i) {
-        cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
+        cprintf("Ready list %i size: %i\n", i,
+                schedulerPolicy == IQSchedulerPolicy::ReadyBitmap ?
+                readyBitmap.size(OpClass(i)) : readyInsts[i].size());
 
         cprintf("\n");
     }
@@ -1481,6 +1567,12 @@ InstructionQueue::dumpLists()
 
     cprintf("\n");
 
+    if (schedulerPolicy == IQSchedulerPolicy::ReadyBitmap) {
+        cprintf("Ready bitmap size: %i, outside of the window: %i\n",
+                readyBitmap.size(), readyBitmap.numOverflow());
+        return;
+    }
+
     ListOrderIt list_order_it = listOrder.begin();
     ListOrderIt list_order_end_it = listOrder.end();
     int i = 1;
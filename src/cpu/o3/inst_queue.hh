@@ -55,9 +55,11 @@
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
+#include "cpu/o3/ready_bitmap.hh"
 #include "cpu/o3/store_set.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQSchedulerPolicy.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -154,6 +156,11 @@ class InstructionQueue
     /** Determine if we are drained. */
     bool isDrained() const;
 
+    /** Determine if the IQ can issue only after an event, such as a
+     *  memory response or an FU completion.
+     */
+    bool isQuiescent();
+
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
 
@@ -402,6 +409,32 @@ class InstructionQueue
      */
     void moveToYoungerInst(ListOrderIt age_order_it);
 
+    /** How the oldest ready instructions are selected. */
+    IQSchedulerPolicy schedulerPolicy;
+
+    /** Ready instructions, used instead of the ready queues and the age
+     *  order list with the ReadyBitmap scheduler policy.
+     */
+    ReadyBitmap<DynInstPtr> readyBitmap;
+
+    /** Adds a ready instruction to the structures of the scheduler. */
+    void addToReadyList(const DynInstPtr &ready_inst);
+
+    /** Selects the instructions to issue with the ReadyBitmap scheduler
+     *  policy.
+     *  @return The number of instructions issued.
+     */
+    int scheduleFromReadyBitmap(IssueStruct *i2e_info);
+
+    /** Tries to issue an instruction by getting it a FU.
+     *  @return Whether the instruction was issued, false if no FU was
+     *  free for it.
+     */
+    bool issueInst(const DynInstPtr &issuing_inst, IssueStruct *i2e_info);
+
+    /** Counts the IQ read of an instruction in the IQ IO stats. */
+    void countIQRead(const DynInstPtr &inst);
+
     DependencyGraph<DynInstPtr> dependGraph;
 
     //////////////////////////////////////
@@ -0,0 +1,85 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_MEM_DEP_PRED_HH__
+#define __CPU_O3_MEM_DEP_PRED_HH__
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Interface of the memory dependence predictors used by the memory
+ * dependence unit. The unit tells the predictor about the memory
+ * instructions as they are dispatched, issued and squashed, and about
+ * the ordering violations, and asks it which store a memory instruction
+ * should wait for.
+ */
+class MemDepPredictor
+{
+  public:
+    virtual ~MemDepPredictor() = default;
+
+    /** Records a memory ordering violation between the younger load
+     * and the older store. */
+    virtual void violation(Addr store_PC, InstSeqNum store_seq_num,
+                           Addr load_PC, InstSeqNum load_seq_num) = 0;
+
+    /** Inserts a load into the predictor. */
+    virtual void insertLoad(Addr load_PC, InstSeqNum load_seq_num) = 0;
+
+    /** Inserts a store into the predictor. */
+    virtual void insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                             ThreadID tid) = 0;
+
+    /** Checks if the instruction with the given PC is dependent upon
+     * any store.  @return Returns the sequence number of the store
+     * instruction this PC is dependent upon.  Returns 0 if none.
+     */
+    virtual InstSeqNum checkInst(Addr PC) = 0;
+
+    /** Records this PC/sequence number as issued. */
+    virtual void issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                        bool is_store) = 0;
+
+    /** Squashes for a specific thread until the given sequence number. */
+    virtual void squash(InstSeqNum squashed_num, ThreadID tid) = 0;
+
+    /** Resets all tables. */
+    virtual void clear() = 0;
+
+    /** Debug function to dump the state of the predictor. */
+    virtual void dump() = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_MEM_DEP_PRED_HH__
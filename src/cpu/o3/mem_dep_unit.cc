@@ -28,7 +28,7 @@
 
 #include "cpu/o3/mem_dep_unit.hh"
 
-#include <map>
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -37,7 +37,10 @@
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/inst_queue.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/store_distance.hh"
+#include "cpu/o3/store_set.hh"
 #include "debug/MemDepUnit.hh"
+#include "enums/MemDepPredictorType.hh"
 #include "params/BaseO3CPU.hh"
 
 namespace gem5
@@ -56,8 +59,6 @@ MemDepUnit::MemDepUnit() : iqPtr(NULL), stats(nullptr) {}
 
 MemDepUnit::MemDepUnit(const BaseO3CPUParams &params)
     : _name(params.name + ".memdepunit"),
-      depPred(params.store_set_clear_period, params.SSITSize,
-              params.LFSTSize),
       iqPtr(NULL),
       stats(nullptr)
 {
@@ -67,19 +68,9 @@ MemDepUnit::MemDepUnit(const BaseO3CPUParams &params)
 MemDepUnit::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
-
-        ListIt inst_list_it = instList[tid].begin();
-
-        MemDepHashIt hash_it;
-
         while (!instList[tid].empty()) {
-            hash_it = memDepHash.find((*inst_list_it)->seqNum);
-
-            assert(hash_it != memDepHash.end());
-
-            memDepHash.erase(hash_it);
-
-            instList[tid].erase(inst_list_it++);
+            instList[tid].back().entry = nullptr;
+            instList[tid].pop_back();
         }
     }
 
@@ -96,8 +87,10 @@ MemDepUnit::init(const BaseO3CPUParams &params, ThreadID tid, CPU *cpu)
     _name = csprintf("%s.memDep%d", params.name, tid);
     id = tid;
 
-    depPred.init(params.store_set_clear_period, params.SSITSize,
-            params.LFSTSize);
+    depPred = createPredictor(params);
+
+    for (ThreadID i = 0; i < MaxThreads; ++i)
+        instList[i].grow(params.numIQEntries);
 
     std::string stats_group_name = csprintf("MemDepUnit__%i", tid);
     cpu->addStatGroup(stats_group_name.c_str(), &stats);
@@ -116,11 +109,27 @@ MemDepUnit::MemDepUnitStats::MemDepUnitStats(statistics::Group *parent)
 {
 }
 
+std::unique_ptr<MemDepPredictor>
+MemDepUnit::createPredictor(const BaseO3CPUParams &params)
+{
+    switch (params.memDepPredictor) {
+      case MemDepPredictorType::StoreSet:
+        return std::make_unique<StoreSet>(params.store_set_clear_period,
+                                          params.SSITSize, params.LFSTSize);
+      case MemDepPredictorType::StoreDistance:
+        return std::make_unique<StoreDistance>(
+                params.store_set_clear_period, params.SDTSize,
+                params.SQEntries);
+      default:
+        panic("Unknown memory dependence predictor.");
+    }
+}
+
 bool
 MemDepUnit::isDrained() const
 {
     bool drained = instsToReplay.empty()
-                 && memDepHash.empty()
+                 && numEntries == 0
                  && instsToReplay.empty();
     for (int i = 0; i < MaxThreads; ++i)
         drained = drained && instList[i].empty();
@@ -132,11 +141,9 @@ void
 MemDepUnit::drainSanityCheck() const
 {
     assert(instsToReplay.empty());
-    assert(memDepHash.empty());
+    assert(numEntries == 0);
     for (int i = 0; i < MaxThreads; ++i)
         assert(instList[i].empty());
-    assert(instsToReplay.empty());
-    assert(memDepHash.empty());
 }
 
 void
@@ -145,7 +152,7 @@ MemDepUnit::takeOverFrom()
     // Be sure to reset all state.
     loadBarrierSNs.clear();
     storeBarrierSNs.clear();
-    depPred.clear();
+    depPred->clear();
 }
 
 void
@@ -186,23 +193,54 @@ MemDepUnit::insertBarrierSN(const DynInstPtr &barr_inst)
     }
 }
 
-void
-MemDepUnit::insert(const DynInstPtr &inst)
+MemDepUnit::MemDepEntryPtr
+MemDepUnit::insertEntry(const DynInstPtr &inst)
 {
-    ThreadID tid = inst->threadNumber;
+    auto &list = instList[inst->threadNumber];
 
     MemDepEntryPtr inst_entry = std::make_shared<MemDepEntry>(inst);
 
-    // Add the MemDepEntry to the hash.
-    memDepHash.insert(
-        std::pair<InstSeqNum, MemDepEntryPtr>(inst->seqNum, inst_entry));
+    // Instructions are inserted in program order, which keeps the list
+    // sorted by sequence number.
+    assert(list.empty() || list.back().seqNum < inst->seqNum);
+    if (list.full())
+        list.grow(std::max<size_t>(16, 2 * list.capacity()));
+    list.push_back({inst->seqNum, inst_entry});
+    ++numEntries;
 #ifdef GEM5_DEBUG
     MemDepEntry::memdep_insert++;
 #endif
 
-    instList[tid].push_back(inst);
+    return inst_entry;
+}
+
+size_t
+MemDepUnit::findSlot(ThreadID tid, InstSeqNum seq_num)
+{
+    auto &list = instList[tid];
+    size_t lo = list.head();
+    size_t end = lo + list.size();
+    size_t hi = end;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (list[mid].seqNum < seq_num)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < end && list[lo].seqNum == seq_num && list[lo].entry)
+        return lo;
+    return 0;
+}
+
+void
+MemDepUnit::insert(const DynInstPtr &inst)
+{
+    ThreadID tid = inst->threadNumber;
 
-    inst_entry->listIt = --(instList[tid].end());
+    MemDepEntryPtr inst_entry = insertEntry(inst);
 
     // Check any barriers and the dependence predictor for any
     // producing memrefs/stores.
@@ -220,7 +258,7 @@ MemDepUnit::insert(const DynInstPtr &inst)
                                 std::begin(storeBarrierSNs),
                                 std::end(storeBarrierSNs));
     } else {
-        InstSeqNum dep = depPred.checkInst(inst->pcState().instAddr());
+        InstSeqNum dep = depPred->checkInst(inst->pcState().instAddr());
         if (dep != 0)
             producing_stores.push_back(dep);
     }
@@ -231,10 +269,10 @@ MemDepUnit::insert(const DynInstPtr &inst)
     for (auto producing_store : producing_stores) {
         DPRINTF(MemDepUnit, "Searching for producer [sn:%lli]\n",
                             producing_store);
-        MemDepHashIt hash_it = memDepHash.find(producing_store);
+        size_t store_idx = findSlot(tid, producing_store);
 
-        if (hash_it != memDepHash.end()) {
-            store_entries.push_back((*hash_it).second);
+        if (store_idx) {
+            store_entries.push_back(instList[tid][store_idx].entry);
             DPRINTF(MemDepUnit, "Producer found\n");
         }
     }
@@ -286,7 +324,7 @@ MemDepUnit::insert(const DynInstPtr &inst)
         DPRINTF(MemDepUnit, "Inserting store/atomic PC %s [sn:%lli].\n",
                 inst->pcState(), inst->seqNum);
 
-        depPred.insertStore(inst->pcState().instAddr(), inst->seqNum,
+        depPred->insertStore(inst->pcState().instAddr(), inst->seqNum,
                 inst->threadNumber);
 
         ++stats.insertedStores;
@@ -308,7 +346,7 @@ MemDepUnit::insertNonSpec(const DynInstPtr &inst)
         DPRINTF(MemDepUnit, "Inserting store/atomic PC %s [sn:%lli].\n",
                 inst->pcState(), inst->seqNum);
 
-        depPred.insertStore(inst->pcState().instAddr(), inst->seqNum,
+        depPred->insertStore(inst->pcState().instAddr(), inst->seqNum,
                 inst->threadNumber);
 
         ++stats.insertedStores;
@@ -322,21 +360,7 @@ MemDepUnit::insertNonSpec(const DynInstPtr &inst)
 void
 MemDepUnit::insertBarrier(const DynInstPtr &barr_inst)
 {
-    ThreadID tid = barr_inst->threadNumber;
-
-    MemDepEntryPtr inst_entry = std::make_shared<MemDepEntry>(barr_inst);
-
-    // Add the MemDepEntry to the hash.
-    memDepHash.insert(
-        std::pair<InstSeqNum, MemDepEntryPtr>(barr_inst->seqNum, inst_entry));
-#ifdef GEM5_DEBUG
-    MemDepEntry::memdep_insert++;
-#endif
-
-    // Add the instruction to the instruction list.
-    instList[tid].push_back(barr_inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    insertEntry(barr_inst);
 
     insertBarrierSN(barr_inst);
 }
@@ -348,7 +372,7 @@ MemDepUnit::regsReady(const DynInstPtr &inst)
             "instruction PC %s [sn:%lli].\n",
             inst->pcState(), inst->seqNum);
 
-    MemDepEntryPtr inst_entry = findInHash(inst);
+    MemDepEntryPtr inst_entry = findEntry(inst);
 
     inst_entry->regsReady = true;
 
@@ -370,7 +394,7 @@ MemDepUnit::nonSpecInstReady(const DynInstPtr &inst)
             "instruction PC %s as ready [sn:%lli].\n",
             inst->pcState(), inst->seqNum);
 
-    MemDepEntryPtr inst_entry = findInHash(inst);
+    MemDepEntryPtr inst_entry = findEntry(inst);
 
     moveToReady(inst_entry);
 }
@@ -390,7 +414,7 @@ MemDepUnit::replay()
     while (!instsToReplay.empty()) {
         temp_inst = instsToReplay.front();
 
-        MemDepEntryPtr inst_entry = findInHash(temp_inst);
+        MemDepEntryPtr inst_entry = findEntry(temp_inst);
 
         DPRINTF(MemDepUnit, "Replaying mem instruction PC %s [sn:%lli].\n",
                 temp_inst->pcState(), temp_inst->seqNum);
@@ -408,17 +432,21 @@ MemDepUnit::completed(const DynInstPtr &inst)
             inst->pcState(), inst->seqNum);
 
     ThreadID tid = inst->threadNumber;
+    auto &list = instList[tid];
 
-    // Remove the instruction from the hash and the list.
-    MemDepHashIt hash_it = memDepHash.find(inst->seqNum);
-
-    assert(hash_it != memDepHash.end());
+    // Clear the slot of the instruction, and drop the cleared slots at
+    // either end of the list.
+    size_t idx = findSlot(tid, inst->seqNum);
 
-    instList[tid].erase((*hash_it).second->listIt);
+    assert(idx);
 
-    (*hash_it).second = NULL;
+    list[idx].entry = nullptr;
+    --numEntries;
 
-    memDepHash.erase(hash_it);
+    while (!list.empty() && !list.front().entry)
+        list.pop_front();
+    while (!list.empty() && !list.back().entry)
+        list.pop_back();
 #ifdef GEM5_DEBUG
     MemDepEntry::memdep_erase++;
 #endif
@@ -464,7 +492,7 @@ MemDepUnit::wakeDependents(const DynInstPtr &inst)
         return;
     }
 
-    MemDepEntryPtr inst_entry = findInHash(inst);
+    MemDepEntryPtr inst_entry = findEntry(inst);
 
     for (int i = 0; i < inst_entry->dependInsts.size(); ++i ) {
         MemDepEntryPtr woken_inst = inst_entry->dependInsts[i];
@@ -532,39 +560,35 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         }
     }
 
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    // The squashed instructions are all at the tail of the list.
+    auto &list = instList[tid];
 
-    MemDepHashIt hash_it;
+    while (!list.empty() && list.back().seqNum > squashed_num) {
+        MemDepSlot &slot = list.back();
 
-    while (!instList[tid].empty() &&
-           (*squash_it)->seqNum > squashed_num) {
+        if (slot.entry) {
+            DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n",
+                    slot.seqNum);
 
-        DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n",
-                (*squash_it)->seqNum);
+            loadBarrierSNs.erase(slot.seqNum);
 
-        loadBarrierSNs.erase((*squash_it)->seqNum);
+            storeBarrierSNs.erase(slot.seqNum);
 
-        storeBarrierSNs.erase((*squash_it)->seqNum);
+            slot.entry->squashed = true;
 
-        hash_it = memDepHash.find((*squash_it)->seqNum);
+            slot.entry = nullptr;
 
-        assert(hash_it != memDepHash.end());
-
-        (*hash_it).second->squashed = true;
-
-        (*hash_it).second = NULL;
-
-        memDepHash.erase(hash_it);
+            --numEntries;
 #ifdef GEM5_DEBUG
-        MemDepEntry::memdep_erase++;
+            MemDepEntry::memdep_erase++;
 #endif
+        }
 
-        instList[tid].erase(squash_it--);
+        list.pop_back();
     }
 
     // Tell the dependency predictor to squash as well.
-    depPred.squash(squashed_num, tid);
+    depPred->squash(squashed_num, tid);
 }
 
 void
@@ -575,8 +599,8 @@ MemDepUnit::violation(const DynInstPtr &store_inst,
             " load: %#x, store: %#x\n", violating_load->pcState().instAddr(),
             store_inst->pcState().instAddr());
     // Tell the memory dependence unit of the violation.
-    depPred.violation(store_inst->pcState().instAddr(),
-            violating_load->pcState().instAddr());
+    depPred->violation(store_inst->pcState().instAddr(), store_inst->seqNum,
+            violating_load->pcState().instAddr(), violating_load->seqNum);
 }
 
 void
@@ -585,17 +609,18 @@ MemDepUnit::issue(const DynInstPtr &inst)
     DPRINTF(MemDepUnit, "Issuing instruction PC %#x [sn:%lli].\n",
             inst->pcState().instAddr(), inst->seqNum);
 
-    depPred.issued(inst->pcState().instAddr(), inst->seqNum, inst->isStore());
+    depPred->issued(inst->pcState().instAddr(), inst->seqNum,
+            inst->isStore());
 }
 
 MemDepUnit::MemDepEntryPtr &
-MemDepUnit::findInHash(const DynInstConstPtr &inst)
+MemDepUnit::findEntry(const DynInstConstPtr &inst)
 {
-    MemDepHashIt hash_it = memDepHash.find(inst->seqNum);
+    size_t idx = findSlot(inst->threadNumber, inst->seqNum);
 
-    assert(hash_it != memDepHash.end());
+    assert(idx);
 
-    return (*hash_it).second;
+    return instList[inst->threadNumber][idx].entry;
 }
 
 void
@@ -617,23 +642,24 @@ MemDepUnit::dumpLists()
         cprintf("Instruction list %i size: %i\n",
                 tid, instList[tid].size());
 
-        ListIt inst_list_it = instList[tid].begin();
         int num = 0;
 
-        while (inst_list_it != instList[tid].end()) {
+        for (const auto &slot : instList[tid]) {
+            if (!slot.entry)
+                continue;
+            const DynInstPtr &inst = slot.entry->inst;
             cprintf("Instruction:%i\nPC: %s\n[sn:%llu]\n[tid:%i]\nIssued:%i\n"
                     "Squashed:%i\n\n",
-                    num, (*inst_list_it)->pcState(),
-                    (*inst_list_it)->seqNum,
-                    (*inst_list_it)->threadNumber,
-                    (*inst_list_it)->isIssued(),
-                    (*inst_list_it)->isSquashed());
-            inst_list_it++;
+                    num, inst->pcState(),
+                    inst->seqNum,
+                    inst->threadNumber,
+                    inst->isIssued(),
+                    inst->isSquashed());
             ++num;
         }
     }
 
-    cprintf("Memory dependence hash size: %i\n", memDepHash.size());
+    cprintf("Memory dependence entries in flight: %i\n", numEntries);
 
 #ifdef GEM5_DEBUG
     cprintf("Memory dependence entries: %i\n", MemDepEntry::memdep_count);
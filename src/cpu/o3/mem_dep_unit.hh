@@ -44,30 +44,19 @@
 #include <list>
 #include <memory>
 #include <set>
-#include <unordered_map>
 #include <unordered_set>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
-#include "cpu/o3/store_set.hh"
+#include "cpu/o3/mem_dep_pred.hh"
 #include "debug/MemDepUnit.hh"
 
 namespace gem5
 {
 
-struct SNHash
-{
-    size_t
-    operator()(const InstSeqNum &seq_num) const
-    {
-        unsigned a = (unsigned)seq_num;
-        unsigned hash = (((a >> 14) ^ ((a >> 2) & 0xffff))) & 0x7FFFFFFF;
-        return hash;
-    }
-};
-
 struct BaseO3CPUParams;
 
 namespace o3
@@ -96,7 +85,9 @@ class MemDepUnit
     /** Empty constructor. Must call init() prior to using in this case. */
     MemDepUnit();
 
-    /** Constructs a MemDepUnit with given parameters. */
+    /** Constructs a MemDepUnit with given parameters. init() must still
+     *  be called, which creates the predictor.
+     */
     MemDepUnit(const BaseO3CPUParams &params);
 
     /** Frees up any memory allocated. */
@@ -194,9 +185,6 @@ class MemDepUnit
         /** The instruction being tracked. */
         DynInstPtr inst;
 
-        /** The iterator to the instruction's location inside the list. */
-        ListIt listIt;
-
         /** A vector of any dependent instructions. */
         std::vector<MemDepEntryPtr> dependInsts;
 
@@ -217,21 +205,44 @@ class MemDepUnit
 #endif
     };
 
-    /** Finds the memory dependence entry in the hash map. */
-    MemDepEntryPtr &findInHash(const DynInstConstPtr& inst);
+    /** Slot of the list of memory dependence entries. */
+    struct MemDepSlot
+    {
+        InstSeqNum seqNum;
+        /** Null once the instruction has completed. */
+        MemDepEntryPtr entry;
+    };
+
+    /** Finds the index of the slot of an instruction in the list of a
+     *  thread, 0 if it is not in the list.
+     */
+    size_t findSlot(ThreadID tid, InstSeqNum seq_num);
 
-    /** Moves an entry to the ready list. */
-    void moveToReady(MemDepEntryPtr &ready_inst_entry);
+    /** Finds the memory dependence entry of an instruction. */
+    MemDepEntryPtr &findEntry(const DynInstConstPtr& inst);
 
-    typedef std::unordered_map<InstSeqNum, MemDepEntryPtr, SNHash> MemDepHash;
+    /** Creates the memory dependence entry of an instruction. */
+    MemDepEntryPtr insertEntry(const DynInstPtr &inst);
 
-    typedef typename MemDepHash::iterator MemDepHashIt;
+    /** Moves an entry to the ready list. */
+    void moveToReady(MemDepEntryPtr &ready_inst_entry);
 
-    /** A hash map of all memory dependence entries. */
-    MemDepHash memDepHash;
+    /** Creates the memory dependence predictor selected by the
+     *  parameters.
+     */
+    static std::unique_ptr<MemDepPredictor> createPredictor(
+            const BaseO3CPUParams &params);
+
+    /** The memory dependence entries of each thread, in program order.
+     *  The slots of completed instructions are cleared, and dropped once
+     *  they reach either end of the list, so that entries are looked up
+     *  by a binary search on the sequence number, and squashed from the
+     *  tail of the list.
+     */
+    CircularQueue<MemDepSlot> instList[MaxThreads];
 
-    /** A list of all instructions in the memory dependence unit. */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** Number of entries in the memory dependence unit. */
+    size_t numEntries = 0;
 
     /** A list of all instructions that are going to be replayed. */
     std::list<DynInstPtr> instsToReplay;
@@ -241,7 +252,7 @@ class MemDepUnit
      *  this unit what instruction the newly added instruction is dependent
      *  upon.
      */
-    StoreSet depPred;
+    std::unique_ptr<MemDepPredictor> depPred;
 
     /** Sequence numbers of outstanding load barriers. */
     std::unordered_set<InstSeqNum> loadBarrierSNs;
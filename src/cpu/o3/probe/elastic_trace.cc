@@ -166,7 +166,7 @@ ElasticTrace::fetchReqTrace(const RequestPtr &req)
     inst_fetch_pkt.set_addr(req->getPaddr());
     inst_fetch_pkt.set_size(req->getSize());
     // Write the message to the stream.
-    instTraceStream->write(inst_fetch_pkt);
+    instTraceStream->write(inst_fetch_pkt, curTick());
 }
 
 void
@@ -867,7 +867,7 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 num_filtered_nodes = 0;
             }
             // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            dataTraceStream->write(dep_pkt, dep_pkt.seq_num());
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
@@ -0,0 +1,396 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_READY_BITMAP_HH__
+#define __CPU_O3_READY_BITMAP_HH__
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/op_class.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Set of the instructions that are ready to issue, selecting them
+ * oldest first. It is an alternative to the per op class ready queues
+ * and age ordered list of the instruction queue, with the same
+ * selection order.
+ *
+ * Instructions are kept in a dense bitmap indexed by their sequence
+ * number modulo the size of the bitmap, so that scanning the bitmap
+ * from the oldest sequence number visits the instructions in age
+ * order, and a bitmap per op class allows skipping the instructions
+ * of the op classes without a free FU a word at a time. The cost of a
+ * selection is thus proportional to the number of instructions issued
+ * rather than to the number of ready instructions. Instructions that
+ * do not fit in the window of sequence numbers covered by the bitmap,
+ * which only happens with a lot of squashed instructions in flight,
+ * are kept in per op class priority queues and merged in age order.
+ *
+ * @tparam InstPtr Pointer to an instruction, which has a seqNum member
+ * and an opClass() method
+ */
+template <class InstPtr>
+class ReadyBitmap
+{
+  public:
+    /**
+     * @param window Number of sequence numbers covered by the bitmap,
+     * a power of 2 multiple of 64
+     */
+    explicit ReadyBitmap(size_t window);
+
+    /** Remove all the instructions. */
+    void clear();
+
+    /** Add a ready instruction. */
+    void insert(const InstPtr &inst);
+
+    /** Number of ready instructions. */
+    size_t size() const { return numReady; }
+
+    /** Whether there are no ready instructions. */
+    bool empty() const { return numReady == 0; }
+
+    /** Number of instructions outside of the bitmap window. */
+    size_t numOverflow() const { return overflowCount; }
+
+    /** Number of ready instructions of an op class. */
+    size_t size(OpClass op_class) const { return classCount[op_class]; }
+
+    /**
+     * Start a selection, making all the op classes eligible. To be
+     * called once per cycle, before the first call to oldest().
+     */
+    void startSelect();
+
+    /**
+     * Get the oldest ready instruction of the eligible op classes.
+     *
+     * @return The instruction, or nullptr if there is none
+     */
+    const InstPtr &oldest();
+
+    /** Remove the instruction returned by the last call to oldest(). */
+    void popOldest();
+
+    /**
+     * Make an op class ineligible until the next selection, e.g.
+     * because no FU is available for it.
+     */
+    void blockClass(OpClass op_class);
+
+  private:
+    /** Position of a sequence number in the bitmap */
+    size_t pos(InstSeqNum seq_num) const { return seq_num & (window - 1); }
+
+    /**
+     * Find the first instruction in the window at or after a sequence
+     * number.
+     *
+     * @param seq_num Sequence number to start from, set to the one of
+     * the instruction found
+     * @param eligible_only Whether to skip the ineligible op classes
+     * @return Whether an instruction was found
+     */
+    bool findNext(InstSeqNum &seq_num, bool eligible_only) const;
+
+    /** Number of sequence numbers covered by the bitmap */
+    const size_t window;
+
+    /** First sequence number covered by the bitmap */
+    InstSeqNum base = 0;
+
+    /** Instructions in the bitmap, by position */
+    std::vector<InstPtr> slots;
+
+    /** Positions holding an instruction */
+    std::vector<uint64_t> ready;
+
+    /** Positions holding an instruction, per op class */
+    std::vector<std::vector<uint64_t>> classReady;
+
+    /** Positions of the instructions of ineligible op classes */
+    std::vector<uint64_t> blocked;
+
+    /** Ineligible op classes */
+    std::bitset<Num_OpClasses> classBlocked;
+
+    /** Number of instructions in the bitmap */
+    size_t numInWindow = 0;
+
+    struct SeqNumCompare
+    {
+        bool
+        operator()(const InstPtr &lhs, const InstPtr &rhs) const
+        {
+            return lhs->seqNum > rhs->seqNum;
+        }
+    };
+
+    /** Instructions outside of the window, per op class */
+    std::vector<std::priority_queue<InstPtr, std::vector<InstPtr>,
+                                    SeqNumCompare>> overflow;
+
+    /** Number of instructions outside of the window */
+    size_t overflowCount = 0;
+
+    /** Number of ready instructions */
+    size_t numReady = 0;
+
+    /** Number of ready instructions per op class */
+    std::vector<size_t> classCount;
+
+    /** Sequence number the scan of the bitmap continues from */
+    InstSeqNum scanSeqNum = 0;
+
+    /** Whether the oldest instruction is known */
+    bool haveOldest = false;
+
+    /** Whether the oldest instruction comes from the overflow queues */
+    bool oldestInOverflow = false;
+
+    /** Sequence number or op class of the oldest instruction */
+    InstSeqNum oldestSeqNum = 0;
+    OpClass oldestClass = No_OpClass;
+
+    /** Returned when there is no instruction */
+    const InstPtr noInst;
+};
+
+template <class InstPtr>
+ReadyBitmap<InstPtr>::ReadyBitmap(size_t window)
+    : window(window), slots(window), ready(window / 64),
+      classReady(Num_OpClasses, std::vector<uint64_t>(window / 64)),
+      blocked(window / 64), overflow(Num_OpClasses),
+      classCount(Num_OpClasses)
+{
+    fatal_if(window < 64 || (window & (window - 1)),
+             "The ready bitmap window must be a power of 2 of at least 64 "
+             "entries, got %d.", window);
+}
+
+template <class InstPtr>
+void
+ReadyBitmap<InstPtr>::clear()
+{
+    std::fill(slots.begin(), slots.end(), nullptr);
+    std::fill(ready.begin(), ready.end(), 0);
+    for (auto &bits : classReady)
+        std::fill(bits.begin(), bits.end(), 0);
+    std::fill(blocked.begin(), blocked.end(), 0);
+    classBlocked.reset();
+    for (auto &queue : overflow) {
+        while (!queue.empty())
+            queue.pop();
+    }
+    std::fill(classCount.begin(), classCount.end(), 0);
+    base = 0;
+    numInWindow = 0;
+    overflowCount = 0;
+    numReady = 0;
+    scanSeqNum = 0;
+    haveOldest = false;
+}
+
+template <class InstPtr>
+void
+ReadyBitmap<InstPtr>::insert(const InstPtr &inst)
+{
+    const InstSeqNum seq_num = inst->seqNum;
+    const OpClass op_class = inst->opClass();
+
+    if (numInWindow == 0) {
+        // Center the window on the instruction, so that both older
+        // and younger instructions can follow.
+        base = seq_num > window / 2 ? seq_num - window / 2 : 0;
+    } else if (seq_num >= base + window) {
+        // Slide the window forward if no instruction falls off.
+        InstSeqNum new_base = seq_num - window + 1;
+        InstSeqNum first = base;
+        [[maybe_unused]] bool found = findNext(first, false);
+        assert(found);
+        if (first >= new_base)
+            base = new_base;
+    }
+
+    ++numReady;
+    ++classCount[op_class];
+
+    if (seq_num < base || seq_num >= base + window) {
+        overflow[op_class].push(inst);
+        ++overflowCount;
+    } else {
+        const size_t p = pos(seq_num);
+        const uint64_t bit = 1ULL << (p % 64);
+        assert(!slots[p]);
+        slots[p] = inst;
+        ready[p / 64] |= bit;
+        classReady[op_class][p / 64] |= bit;
+        if (classBlocked[op_class])
+            blocked[p / 64] |= bit;
+        ++numInWindow;
+    }
+
+    // The instruction may be older than the ones left to select.
+    if (seq_num < scanSeqNum)
+        scanSeqNum = seq_num;
+    haveOldest = false;
+}
+
+template <class InstPtr>
+void
+ReadyBitmap<InstPtr>::startSelect()
+{
+    if (classBlocked.any()) {
+        std::fill(blocked.begin(), blocked.end(), 0);
+        classBlocked.reset();
+    }
+    scanSeqNum = 0;
+    haveOldest = false;
+}
+
+template <class InstPtr>
+bool
+ReadyBitmap<InstPtr>::findNext(InstSeqNum &seq_num, bool eligible_only) const
+{
+    const InstSeqNum end = base + window;
+    InstSeqNum cur = std::max(seq_num, base);
+
+    // The window is a multiple of 64 entries, so the positions in a
+    // word always hold consecutive sequence numbers.
+    while (cur < end) {
+        const size_t p = pos(cur);
+        const unsigned offset = p % 64;
+        uint64_t bits = ready[p / 64];
+        if (eligible_only)
+            bits &= ~blocked[p / 64];
+        bits >>= offset;
+        if (bits) {
+            const InstSeqNum found = cur + ctz64(bits);
+            if (found >= end)
+                return false;
+            seq_num = found;
+            return true;
+        }
+        cur += 64 - offset;
+    }
+    return false;
+}
+
+template <class InstPtr>
+const InstPtr &
+ReadyBitmap<InstPtr>::oldest()
+{
+    if (haveOldest) {
+        return oldestInOverflow ? overflow[oldestClass].top() :
+            slots[pos(oldestSeqNum)];
+    }
+
+    InstSeqNum seq_num = scanSeqNum;
+    bool found = numInWindow && findNext(seq_num, true);
+    oldestInOverflow = false;
+
+    if (overflowCount) {
+        for (int i = 0; i < Num_OpClasses; ++i) {
+            if (classBlocked[i] || overflow[i].empty())
+                continue;
+            const InstSeqNum top = overflow[i].top()->seqNum;
+            if (!found || top < seq_num) {
+                found = true;
+                seq_num = top;
+                oldestInOverflow = true;
+                oldestClass = (OpClass)i;
+            }
+        }
+    }
+
+    if (!found)
+        return noInst;
+
+    haveOldest = true;
+    oldestSeqNum = seq_num;
+    if (oldestInOverflow)
+        return overflow[oldestClass].top();
+
+    scanSeqNum = seq_num;
+    return slots[pos(seq_num)];
+}
+
+template <class InstPtr>
+void
+ReadyBitmap<InstPtr>::popOldest()
+{
+    assert(haveOldest);
+    haveOldest = false;
+    --numReady;
+
+    if (oldestInOverflow) {
+        --classCount[oldestClass];
+        overflow[oldestClass].pop();
+        --overflowCount;
+        return;
+    }
+
+    const size_t p = pos(oldestSeqNum);
+    const uint64_t bit = 1ULL << (p % 64);
+    const OpClass op_class = slots[p]->opClass();
+    --classCount[op_class];
+    slots[p] = nullptr;
+    ready[p / 64] &= ~bit;
+    classReady[op_class][p / 64] &= ~bit;
+    --numInWindow;
+    scanSeqNum = oldestSeqNum + 1;
+}
+
+template <class InstPtr>
+void
+ReadyBitmap<InstPtr>::blockClass(OpClass op_class)
+{
+    if (classBlocked[op_class])
+        return;
+    classBlocked.set(op_class);
+    const auto &bits = classReady[op_class];
+    for (size_t w = 0; w < blocked.size(); ++w)
+        blocked[w] |= bits[w];
+    haveOldest = false;
+}
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_READY_BITMAP_HH__
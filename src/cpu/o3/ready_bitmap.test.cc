@@ -0,0 +1,237 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/ready_bitmap.hh"
+#include "cpu/op_class.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** The part of a dynamic instruction the bitmap looks at */
+struct TestInst
+{
+    InstSeqNum seqNum;
+    OpClass op;
+
+    OpClass opClass() const { return op; }
+};
+
+typedef std::shared_ptr<TestInst> TestInstPtr;
+typedef o3::ReadyBitmap<TestInstPtr> TestBitmap;
+
+TestInstPtr
+makeInst(InstSeqNum seq_num, OpClass op_class = IntAluOp)
+{
+    return std::make_shared<TestInst>(TestInst{seq_num, op_class});
+}
+
+/** Select all the eligible instructions, oldest first. */
+std::vector<InstSeqNum>
+selectAll(TestBitmap &bitmap)
+{
+    std::vector<InstSeqNum> selected;
+    while (bitmap.oldest()) {
+        selected.push_back(bitmap.oldest()->seqNum);
+        bitmap.popOldest();
+    }
+    return selected;
+}
+
+} // anonymous namespace
+
+/** An empty bitmap has nothing to select. */
+TEST(ReadyBitmapTest, Empty)
+{
+    TestBitmap bitmap(64);
+    bitmap.startSelect();
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_EQ(bitmap.size(), 0);
+    EXPECT_FALSE(bitmap.oldest());
+}
+
+/**
+ * Instructions inserted out of order, in several words of the bitmap,
+ * are selected oldest first.
+ */
+TEST(ReadyBitmapTest, OldestFirstAcrossWords)
+{
+    // The window is centered on the first instruction, and covers the
+    // sequence numbers 936 to 1191
+    TestBitmap bitmap(256);
+    const std::vector<InstSeqNum> seq_nums =
+        {1064, 1130, 1000, 1063, 1001, 1127, 1128, 1065, 1191, 1126};
+    for (auto seq_num : seq_nums)
+        bitmap.insert(makeInst(seq_num));
+    EXPECT_EQ(bitmap.size(), seq_nums.size());
+    EXPECT_EQ(bitmap.numOverflow(), 0);
+
+    std::vector<InstSeqNum> expected = seq_nums;
+    std::sort(expected.begin(), expected.end());
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap), expected);
+    EXPECT_TRUE(bitmap.empty());
+}
+
+/**
+ * Clearing the last bit of a word and setting it again leaves the
+ * other words alone.
+ */
+TEST(ReadyBitmapTest, SetClearSet)
+{
+    TestBitmap bitmap(128);
+    bitmap.insert(makeInst(163));
+    bitmap.insert(makeInst(164));
+    bitmap.startSelect();
+    ASSERT_EQ(bitmap.oldest()->seqNum, 163);
+    bitmap.popOldest();
+    EXPECT_EQ(bitmap.size(), 1);
+
+    bitmap.insert(makeInst(163));
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({163, 164}));
+}
+
+/**
+ * An instruction older than the ones left to select, e.g. woken up by
+ * an instruction issued in the same cycle, is selected next.
+ */
+TEST(ReadyBitmapTest, InsertOlderDuringSelect)
+{
+    TestBitmap bitmap(128);
+    for (InstSeqNum seq_num : {100, 110, 120})
+        bitmap.insert(makeInst(seq_num));
+
+    bitmap.startSelect();
+    ASSERT_EQ(bitmap.oldest()->seqNum, 100);
+    bitmap.popOldest();
+    ASSERT_EQ(bitmap.oldest()->seqNum, 110);
+    bitmap.popOldest();
+
+    bitmap.insert(makeInst(105));
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({105, 120}));
+}
+
+/**
+ * Blocking an op class skips its instructions until the next
+ * selection, keeping the age order of the others.
+ */
+TEST(ReadyBitmapTest, BlockClass)
+{
+    TestBitmap bitmap(128);
+    bitmap.insert(makeInst(10, IntAluOp));
+    bitmap.insert(makeInst(11, FloatAddOp));
+    bitmap.insert(makeInst(12, IntAluOp));
+    bitmap.insert(makeInst(80, FloatAddOp));
+    EXPECT_EQ(bitmap.size(IntAluOp), 2);
+    EXPECT_EQ(bitmap.size(FloatAddOp), 2);
+
+    bitmap.startSelect();
+    ASSERT_EQ(bitmap.oldest()->seqNum, 10);
+    bitmap.blockClass(IntAluOp);
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({11, 80}));
+    EXPECT_EQ(bitmap.size(), 2);
+    EXPECT_EQ(bitmap.size(FloatAddOp), 0);
+
+    // A new instruction of a blocked class stays blocked
+    bitmap.insert(makeInst(9, IntAluOp));
+    EXPECT_FALSE(bitmap.oldest());
+
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({9, 10, 12}));
+}
+
+/**
+ * Instructions outside of the window are kept aside, and merged in age
+ * order with the ones in the window.
+ */
+TEST(ReadyBitmapTest, Overflow)
+{
+    TestBitmap bitmap(64);
+    bitmap.insert(makeInst(1000));
+    // Too young to slide the window without dropping 1000
+    bitmap.insert(makeInst(1200, FloatAddOp));
+    // Older than the start of the window
+    bitmap.insert(makeInst(10));
+    bitmap.insert(makeInst(1010));
+    EXPECT_EQ(bitmap.size(), 4);
+    EXPECT_EQ(bitmap.numOverflow(), 2);
+
+    bitmap.startSelect();
+    bitmap.blockClass(FloatAddOp);
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({10, 1000, 1010}));
+    EXPECT_EQ(bitmap.numOverflow(), 1);
+
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({1200}));
+    EXPECT_EQ(bitmap.numOverflow(), 0);
+}
+
+/**
+ * The window slides forward when no instruction falls off, and is
+ * moved to the next instruction once empty.
+ */
+TEST(ReadyBitmapTest, SlideWindow)
+{
+    TestBitmap bitmap(64);
+    bitmap.insert(makeInst(1000));
+    bitmap.insert(makeInst(1040));
+    bitmap.insert(makeInst(1050));
+    EXPECT_EQ(bitmap.numOverflow(), 0);
+
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap),
+              std::vector<InstSeqNum>({1000, 1040, 1050}));
+
+    bitmap.insert(makeInst(100000));
+    bitmap.insert(makeInst(99990));
+    EXPECT_EQ(bitmap.numOverflow(), 0);
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({99990, 100000}));
+}
+
+/** Clearing the bitmap drops all the instructions. */
+TEST(ReadyBitmapTest, Clear)
+{
+    TestBitmap bitmap(64);
+    bitmap.insert(makeInst(1000));
+    bitmap.insert(makeInst(5000));
+    bitmap.clear();
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_EQ(bitmap.numOverflow(), 0);
+    EXPECT_EQ(bitmap.size(IntAluOp), 0);
+
+    bitmap.insert(makeInst(7));
+    bitmap.startSelect();
+    EXPECT_EQ(selectAll(bitmap), std::vector<InstSeqNum>({7}));
+}
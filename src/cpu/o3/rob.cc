@@ -59,6 +59,7 @@ ROB::ROB(CPU *_cpu, const BaseO3CPUParams &params)
     : robPolicy(params.smtROBPolicy),
       cpu(_cpu),
       numEntries(params.numROBEntries),
+      instList(MaxThreads, CircularQueue<DynInstPtr>(params.numROBEntries)),
       squashWidth(params.squashWidth),
       numInstsInROB(0),
       numThreads(params.numThreads),
@@ -105,7 +106,7 @@ ROB::resetState()
 {
     for (ThreadID tid = 0; tid  < MaxThreads; tid++) {
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
+        squashIdx[tid] = InvalidIdx;
         squashedSeqNum[tid] = 0;
         doneSquashing[tid] = true;
     }
@@ -206,6 +207,7 @@ ROB::insertInst(const DynInstPtr &inst)
 
     ThreadID tid = inst->threadNumber;
 
+    assert(!instList[tid].full());
     instList[tid].push_back(inst);
 
     //Set Up head iterator if this is the 1st instruction in the ROB
@@ -214,10 +216,7 @@ ROB::insertInst(const DynInstPtr &inst)
         assert((*head) == inst);
     }
 
-    //Must Decrement for iterator to actually be valid  since __.end()
-    //actually points to 1 after the last inst
-    tail = instList[tid].end();
-    tail--;
+    tail = instList[tid].getIterator(instList[tid].tail());
 
     inst->setInROB();
 
@@ -237,11 +236,10 @@ ROB::retireHead(ThreadID tid)
 
     assert(numInstsInROB > 0);
 
-    // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Get the head ROB instruction by moving it out of the ring, which
+    // also releases the reference held by the slot, and remove it
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -312,13 +310,15 @@ ROB::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%i] Squashing instructions until [sn:%llu].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
+    CircularQueue<DynInstPtr> &insts = instList[tid];
+
+    assert(insts.isValidIdx(squashIdx[tid]));
 
-    if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
+    if (insts[squashIdx[tid]]->seqNum < squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIdx[tid] = InvalidIdx;
 
         doneSquashing[tid] = true;
         return;
@@ -338,49 +338,48 @@ ROB::doSquash(ThreadID tid)
 
     for (int numSquashed = 0;
          numSquashed < numInstsToSquash &&
-         squashIt[tid] != instList[tid].end() &&
-         (*squashIt[tid])->seqNum > squashedSeqNum[tid];
+         insts.isValidIdx(squashIdx[tid]) &&
+         insts[squashIdx[tid]]->seqNum > squashedSeqNum[tid];
          ++numSquashed)
     {
+        const DynInstPtr &inst = insts[squashIdx[tid]];
+
         DPRINTF(ROB, "[tid:%i] Squashing instruction PC %s, seq num %i.\n",
-                (*squashIt[tid])->threadNumber,
-                (*squashIt[tid])->pcState(),
-                (*squashIt[tid])->seqNum);
+                inst->threadNumber,
+                inst->pcState(),
+                inst->seqNum);
 
         // Mark the instruction as squashed, and ready to commit so that
         // it can drain out of the pipeline.
-        (*squashIt[tid])->setSquashed();
+        inst->setSquashed();
 
-        (*squashIt[tid])->setCanCommit();
+        inst->setCanCommit();
 
 
-        if (squashIt[tid] == instList[tid].begin()) {
+        if (squashIdx[tid] == insts.head()) {
             DPRINTF(ROB, "Reached head of instruction list while "
                     "squashing.\n");
 
-            squashIt[tid] = instList[tid].end();
+            squashIdx[tid] = InvalidIdx;
 
             doneSquashing[tid] = true;
 
             return;
         }
 
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*squashIt[tid]) == (*tail_thread))
+        if (squashIdx[tid] == insts.tail())
             robTailUpdate = true;
 
-        squashIt[tid]--;
+        squashIdx[tid]--;
     }
 
 
     // Check if ROB is done squashing.
-    if ((*squashIt[tid])->seqNum <= squashedSeqNum[tid]) {
+    if (insts[squashIdx[tid]]->seqNum <= squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIdx[tid] = InvalidIdx;
 
         doneSquashing[tid] = true;
     }
@@ -451,16 +450,14 @@ ROB::updateTail()
         // If this is the first valid then assign w/out
         // comparison
         if (first_valid) {
-            tail = instList[tid].end();
-            tail--;
+            tail = instList[tid].getIterator(instList[tid].tail());
             first_valid = false;
             continue;
         }
 
         // Assign new tail if this thread's tail is younger
         // than our current "tail high"
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
+        InstIt tail_thread = instList[tid].getIterator(instList[tid].tail());
 
         if ((*tail_thread)->seqNum > (*tail)->seqNum) {
             tail = tail_thread;
@@ -489,10 +486,7 @@ ROB::squash(InstSeqNum squash_num, ThreadID tid)
     squashedSeqNum[tid] = squash_num;
 
     if (!instList[tid].empty()) {
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        squashIt[tid] = tail_thread;
+        squashIdx[tid] = instList[tid].tail();
 
         doSquash(tid);
     }
@@ -502,11 +496,11 @@ const DynInstPtr&
 ROB::readHeadInst(ThreadID tid)
 {
     if (threadEntries[tid] != 0) {
-        InstIt head_thread = instList[tid].begin();
+        const DynInstPtr &head_inst = instList[tid].front();
 
-        assert((*head_thread)->isInROB());
+        assert(head_inst->isInROB());
 
-        return *head_thread;
+        return head_inst;
     } else {
         return dummyInst;
     }
@@ -515,10 +509,7 @@ ROB::readHeadInst(ThreadID tid)
 DynInstPtr
 ROB::readTailInst(ThreadID tid)
 {
-    InstIt tail_thread = instList[tid].end();
-    tail_thread--;
-
-    return *tail_thread;
+    return instList[tid].back();
 }
 
 ROB::ROBStats::ROBStats(statistics::Group *parent)
@@ -533,9 +524,10 @@ ROB::ROBStats::ROBStats(statistics::Group *parent)
 DynInstPtr
 ROB::findInst(ThreadID tid, InstSeqNum squash_inst)
 {
-    for (InstIt it = instList[tid].begin(); it != instList[tid].end(); it++) {
-        if ((*it)->seqNum == squash_inst) {
-            return *it;
+    CircularQueue<DynInstPtr> &insts = instList[tid];
+    for (size_t idx = insts.head(); insts.isValidIdx(idx); ++idx) {
+        if (insts[idx]->seqNum == squash_inst) {
+            return insts[idx];
         }
     }
     return NULL;
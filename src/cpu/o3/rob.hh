@@ -45,6 +45,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -72,7 +73,7 @@ class ROB
 {
   public:
     typedef std::pair<RegIndex, RegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status
@@ -285,8 +286,8 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** ROB List of Instructions, a ring buffer per thread */
+    std::vector<CircularQueue<DynInstPtr>> instList;
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -303,14 +304,18 @@ class ROB
     InstIt head;
 
   private:
-    /** Iterator used for walking through the list of instructions when
+    /** Index used for walking through the list of instructions when
      *  squashing.  Used so that there is persistent state between cycles;
      *  when squashing, the instructions are marked as squashed but not
-     *  immediately removed, meaning the tail iterator remains the same before
+     *  immediately removed, meaning the tail index remains the same before
      *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  This will always be set to InvalidIdx if it is invalid.
      */
-    InstIt squashIt[MaxThreads];
+    size_t squashIdx[MaxThreads];
+
+    /** Index that is never valid in the ring buffers, as they start
+     *  indexing from 1. */
+    static constexpr size_t InvalidIdx = 0;
 
   public:
     /** Number of instructions in the ROB. */
@@ -0,0 +1,180 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/store_distance.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/StoreSet.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+StoreDistance::StoreDistance(uint64_t clear_period, int table_size,
+                             int history_size)
+    : distances(table_size), recentStores(history_size),
+      clearPeriod(clear_period), indexMask(table_size - 1)
+{
+    fatal_if(!isPowerOf2(table_size),
+             "Invalid store distance table size %d!", table_size);
+    fatal_if(history_size <= 0 ||
+             history_size > std::numeric_limits<uint16_t>::max(),
+             "Invalid store distance history size %d!", history_size);
+}
+
+void
+StoreDistance::checkClear()
+{
+    memOpsPred++;
+    if (memOpsPred > clearPeriod) {
+        DPRINTF(StoreSet, "Wiping predictor state beacuse %d ld/st executed\n",
+                clearPeriod);
+        memOpsPred = 0;
+        std::fill(distances.begin(), distances.end(), 0);
+    }
+}
+
+void
+StoreDistance::violation(Addr store_PC, InstSeqNum store_seq_num,
+                         Addr load_PC, InstSeqNum load_seq_num)
+{
+    if (recentStores.empty())
+        return;
+
+    // Find the store in the history, and count the stores fetched
+    // between it and the load.
+    const size_t head = recentStores.head();
+    const size_t end = head + recentStores.size();
+    auto first_after = [&](InstSeqNum seq_num) {
+        size_t lo = head, hi = end;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (recentStores[mid] <= seq_num)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    };
+
+    const size_t store_idx = first_after(store_seq_num) - 1;
+    if (store_idx < head || recentStores[store_idx] != store_seq_num) {
+        DPRINTF(StoreSet, "StoreDistance: Store %#x [sn:%lli] is too far "
+                "from load %#x [sn:%lli]\n", store_PC, store_seq_num,
+                load_PC, load_seq_num);
+        return;
+    }
+
+    const uint16_t distance = first_after(load_seq_num) - store_idx;
+    uint16_t &entry = distances[calcIndex(load_PC)];
+
+    // Keep the closest store, which is the most recent conflict.
+    if (!entry || distance < entry)
+        entry = distance;
+
+    DPRINTF(StoreSet, "StoreDistance: Load %#x depends on the store %d "
+            "stores before it, store %#x\n", load_PC, entry, store_PC);
+}
+
+void
+StoreDistance::insertLoad(Addr load_PC, InstSeqNum load_seq_num)
+{
+    checkClear();
+}
+
+void
+StoreDistance::insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                           ThreadID tid)
+{
+    checkClear();
+
+    assert(recentStores.empty() || recentStores.back() < store_seq_num);
+    // The oldest store is dropped once the history is full.
+    recentStores.push_back(store_seq_num);
+}
+
+InstSeqNum
+StoreDistance::checkInst(Addr PC)
+{
+    const uint16_t distance = distances[calcIndex(PC)];
+
+    if (!distance || distance > recentStores.size()) {
+        DPRINTF(StoreSet, "Inst %#x had no dependency\n", PC);
+        return 0;
+    }
+
+    InstSeqNum store = recentStores[recentStores.tail() + 1 - distance];
+
+    DPRINTF(StoreSet, "Inst %#x with store distance %i depends on "
+            "[sn:%lli]\n", PC, distance, store);
+
+    return store;
+}
+
+void
+StoreDistance::issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                      bool is_store)
+{
+}
+
+void
+StoreDistance::squash(InstSeqNum squashed_num, ThreadID tid)
+{
+    DPRINTF(StoreSet, "StoreDistance: Squashing until inum %i\n",
+            squashed_num);
+
+    while (!recentStores.empty() && recentStores.back() > squashed_num)
+        recentStores.pop_back();
+}
+
+void
+StoreDistance::clear()
+{
+    std::fill(distances.begin(), distances.end(), 0);
+    recentStores.flush();
+}
+
+void
+StoreDistance::dump()
+{
+    cprintf("recentStores.size(): %i\n", recentStores.size());
+
+    int num = 0;
+
+    for (InstSeqNum store : recentStores) {
+        cprintf("%i: [sn:%lli]\n", num, store);
+        num++;
+    }
+}
+
+} // namespace o3
+} // namespace gem5
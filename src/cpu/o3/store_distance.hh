@@ -0,0 +1,117 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_STORE_DISTANCE_HH__
+#define __CPU_O3_STORE_DISTANCE_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/circular_queue.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/mem_dep_pred.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Implements a store distance memory dependence predictor, see "Speculation
+ * Techniques for Improving Load Related Instruction Scheduling" by Yoaz et
+ * al. Rather than grouping loads and stores in sets, it records for each
+ * load that violated memory ordering how many stores were fetched between
+ * the conflicting store and the load. A later instance of the load then
+ * waits for the store fetched that many stores earlier. It needs a single
+ * table indexed by the load PC, and handles loads which conflict with a
+ * different dynamic store each time, e.g. in loops, without serializing
+ * all the stores of a set.
+ */
+class StoreDistance : public MemDepPredictor
+{
+  public:
+    /**
+     * @param clear_period Number of memory instructions after which the
+     * table is cleared
+     * @param table_size Number of entries of the distance table
+     * @param history_size Number of recent stores tracked, which bounds
+     * the distances which can be recorded
+     */
+    StoreDistance(uint64_t clear_period, int table_size, int history_size);
+
+    void violation(Addr store_PC, InstSeqNum store_seq_num,
+                   Addr load_PC, InstSeqNum load_seq_num) override;
+
+    void insertLoad(Addr load_PC, InstSeqNum load_seq_num) override;
+
+    void insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                     ThreadID tid) override;
+
+    InstSeqNum checkInst(Addr PC) override;
+
+    void issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                bool is_store) override;
+
+    void squash(InstSeqNum squashed_num, ThreadID tid) override;
+
+    void clear() override;
+
+    void dump() override;
+
+  private:
+    /** Calculates the index into the distance table based on the PC. */
+    int calcIndex(Addr PC) const { return (PC >> offsetBits) & indexMask; }
+
+    /** Clears the table every clearPeriod memory instructions. */
+    void checkClear();
+
+    /** Store distance per load PC, 0 if none was recorded. */
+    std::vector<uint16_t> distances;
+
+    /** Sequence numbers of the most recently fetched stores, in program
+     * order. Stores stay in the history once issued, as the distances
+     * count all the fetched stores.
+     */
+    CircularQueue<InstSeqNum> recentStores;
+
+    /** Number of loads/stores to process before wiping the table */
+    uint64_t clearPeriod;
+
+    /** Mask to obtain the index. */
+    int indexMask;
+
+    /** Number of bits of the PC ignored when indexing the table. */
+    static constexpr int offsetBits = 2;
+
+    /** Number of memory operations predicted since last clear */
+    uint64_t memOpsPred = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_STORE_DISTANCE_HH__
@@ -0,0 +1,151 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/store_distance.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const Addr StorePC = 0x1000;
+const Addr LoadPC = 0x1040;
+
+} // anonymous namespace
+
+/** Nothing is predicted before a violation. */
+TEST(StoreDistanceTest, NoViolation)
+{
+    o3::StoreDistance predictor(1000000, 64, 16);
+    predictor.insertStore(StorePC, 1, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 0);
+}
+
+/**
+ * A load which violated against the store fetched N stores before it
+ * waits for the store N stores back.
+ */
+TEST(StoreDistanceTest, Distance)
+{
+    o3::StoreDistance predictor(1000000, 64, 16);
+    for (InstSeqNum seq_num : {10, 12, 14})
+        predictor.insertStore(StorePC, seq_num, 0);
+    predictor.insertLoad(LoadPC, 15);
+
+    // Store 10 is the third store before the load
+    predictor.violation(StorePC, 10, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 10);
+
+    for (InstSeqNum seq_num : {20, 22, 24, 26})
+        predictor.insertStore(StorePC, seq_num, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 22);
+
+    // Issuing stores does not change the distances
+    predictor.issued(StorePC, 22, true);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 22);
+}
+
+/** The closest conflicting store is kept. */
+TEST(StoreDistanceTest, ClosestStore)
+{
+    o3::StoreDistance predictor(1000000, 64, 16);
+    for (InstSeqNum seq_num : {10, 12, 14})
+        predictor.insertStore(StorePC, seq_num, 0);
+    predictor.violation(StorePC, 12, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 12);
+
+    // A further store does not replace the distance
+    predictor.violation(StorePC, 10, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 12);
+
+    predictor.violation(StorePC, 14, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 14);
+}
+
+/**
+ * Stores which left the history cannot be recorded, and distances
+ * beyond the stores in the history are not predicted.
+ */
+TEST(StoreDistanceTest, History)
+{
+    o3::StoreDistance predictor(1000000, 64, 2);
+    for (InstSeqNum seq_num : {10, 12, 14})
+        predictor.insertStore(StorePC, seq_num, 0);
+
+    predictor.violation(StorePC, 10, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 0);
+
+    predictor.violation(StorePC, 12, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 12);
+
+    // Squashing all the stores leaves none to wait for
+    predictor.squash(5, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 0);
+    predictor.insertStore(StorePC, 20, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 0);
+    predictor.insertStore(StorePC, 22, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 20);
+}
+
+/** Squashed stores are removed from the history. */
+TEST(StoreDistanceTest, Squash)
+{
+    o3::StoreDistance predictor(1000000, 64, 16);
+    for (InstSeqNum seq_num : {10, 12, 14})
+        predictor.insertStore(StorePC, seq_num, 0);
+    predictor.violation(StorePC, 14, LoadPC, 15);
+
+    predictor.squash(13, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 12);
+
+    // The violation against a squashed store is ignored
+    predictor.violation(StorePC, 14, LoadPC, 15);
+    predictor.insertStore(StorePC, 16, 0);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 16);
+}
+
+/** The table is cleared every clear period memory instructions. */
+TEST(StoreDistanceTest, Clear)
+{
+    o3::StoreDistance predictor(4, 64, 16);
+    predictor.insertStore(StorePC, 10, 0);
+    predictor.insertLoad(LoadPC, 11);
+    predictor.violation(StorePC, 10, LoadPC, 11);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 10);
+
+    predictor.insertLoad(LoadPC, 12);
+    predictor.insertLoad(LoadPC, 13);
+    predictor.insertLoad(LoadPC, 14);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 0);
+
+    predictor.violation(StorePC, 10, LoadPC, 15);
+    EXPECT_EQ(predictor.checkInst(LoadPC), 10);
+    predictor.clear();
+    EXPECT_EQ(predictor.checkInst(LoadPC), 0);
+}
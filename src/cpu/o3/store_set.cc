@@ -28,6 +28,8 @@
 
 #include "cpu/o3/store_set.hh"
 
+#include <algorithm>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -117,7 +119,8 @@ StoreSet::init(uint64_t clear_period, int _SSIT_size, int _LFST_size)
 
 
 void
-StoreSet::violation(Addr store_PC, Addr load_PC)
+StoreSet::violation(Addr store_PC, InstSeqNum store_seq_num,
+                    Addr load_PC, InstSeqNum load_seq_num)
 {
     int load_index = calcIndex(load_PC);
     int store_index = calcIndex(store_PC);
@@ -232,7 +235,11 @@ StoreSet::insertStore(Addr store_PC, InstSeqNum store_seq_num, ThreadID tid)
 
         validLFST[store_SSID] = 1;
 
-        storeList[store_seq_num] = store_SSID;
+        assert(storeList.empty() || storeList.back().seqNum < store_seq_num);
+        if (storeList.full())
+            storeList.grow(std::max<size_t>(64, 2 * storeList.capacity()));
+        storeList.push_back({store_seq_num, (SSID)store_SSID, true});
+        ++numStores;
 
         DPRINTF(StoreSet, "Store %#x updated the LFST, SSID: %i\n",
                 store_PC, store_SSID);
@@ -288,10 +295,14 @@ StoreSet::issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store)
 
     assert(index < SSITSize);
 
-    SeqNumMapIt store_list_it = storeList.find(issued_seq_num);
+    size_t store_idx = findStore(issued_seq_num);
+
+    if (store_idx) {
+        storeList[store_idx].valid = false;
+        --numStores;
 
-    if (store_list_it != storeList.end()) {
-        storeList.erase(store_list_it);
+        while (!storeList.empty() && !storeList.front().valid)
+            storeList.pop_front();
     }
 
     // Make sure the SSIT still has a valid entry for the issued store.
@@ -317,28 +328,45 @@ StoreSet::squash(InstSeqNum squashed_num, ThreadID tid)
     DPRINTF(StoreSet, "StoreSet: Squashing until inum %i\n",
             squashed_num);
 
-    int idx;
-    SeqNumMapIt store_list_it = storeList.begin();
+    // The store list is in program order, so the squashed stores are all
+    // at its tail.
+    while (!storeList.empty() && storeList.back().seqNum > squashed_num) {
+        const StoreListEntry &store = storeList.back();
 
-    //@todo:Fix to only delete from correct thread
-    while (!storeList.empty()) {
-        idx = (*store_list_it).second;
+        if (store.valid) {
+            SSID idx = store.ssid;
 
-        if ((*store_list_it).first <= squashed_num) {
-            break;
+            if (validLFST[idx] && LFST[idx] > squashed_num) {
+                DPRINTF(StoreSet, "Squashed [sn:%lli]\n", LFST[idx]);
+                validLFST[idx] = false;
+            }
+
+            --numStores;
         }
 
-        bool younger = LFST[idx] > squashed_num;
+        storeList.pop_back();
+    }
+}
 
-        if (validLFST[idx] && younger) {
-            DPRINTF(StoreSet, "Squashed [sn:%lli]\n", LFST[idx]);
-            validLFST[idx] = false;
+size_t
+StoreSet::findStore(InstSeqNum seq_num)
+{
+    size_t lo = storeList.head();
+    size_t hi = lo + storeList.size();
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (storeList[mid].seqNum < seq_num)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
 
-            storeList.erase(store_list_it++);
-        } else if (!validLFST[idx] && younger) {
-            storeList.erase(store_list_it++);
-        }
+    if (lo < storeList.head() + storeList.size() &&
+            storeList[lo].seqNum == seq_num && storeList[lo].valid) {
+        return lo;
     }
+    return 0;
 }
 
 void
@@ -352,22 +380,22 @@ StoreSet::clear()
         validLFST[i] = false;
     }
 
-    storeList.clear();
+    storeList.flush();
+    numStores = 0;
 }
 
 void
 StoreSet::dump()
 {
-    cprintf("storeList.size(): %i\n", storeList.size());
-    SeqNumMapIt store_list_it = storeList.begin();
+    cprintf("storeList.size(): %i\n", numStores);
 
     int num = 0;
 
-    while (store_list_it != storeList.end()) {
-        cprintf("%i: [sn:%lli] SSID:%i\n",
-                num, (*store_list_it).first, (*store_list_it).second);
+    for (const auto &store : storeList) {
+        if (!store.valid)
+            continue;
+        cprintf("%i: [sn:%lli] SSID:%i\n", num, store.seqNum, store.ssid);
         num++;
-        store_list_it++;
     }
 }
 
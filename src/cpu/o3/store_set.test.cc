@@ -0,0 +1,299 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/store_set.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * The store set predictor as it was when it kept its unissued stores in
+ * an std::map, used as a reference for the store list in program order
+ * which replaced the map.
+ */
+class MapStoreSet
+{
+  public:
+    MapStoreSet(uint64_t clear_period, int ssit_size, int lfst_size)
+        : SSIT(ssit_size), validSSIT(ssit_size), LFST(lfst_size),
+          validLFST(lfst_size), clearPeriod(clear_period),
+          SSITSize(ssit_size), LFSTSize(lfst_size)
+    {}
+
+    void
+    violation(Addr store_PC, Addr load_PC)
+    {
+        int load_index = calcIndex(load_PC);
+        int store_index = calcIndex(store_PC);
+        bool valid_load_SSID = validSSIT[load_index];
+        bool valid_store_SSID = validSSIT[store_index];
+
+        if (!valid_load_SSID && !valid_store_SSID) {
+            unsigned new_set = calcSSID(load_PC);
+            validSSIT[load_index] = true;
+            SSIT[load_index] = new_set;
+            validSSIT[store_index] = true;
+            SSIT[store_index] = new_set;
+        } else if (valid_load_SSID && !valid_store_SSID) {
+            validSSIT[store_index] = true;
+            SSIT[store_index] = SSIT[load_index];
+        } else if (!valid_load_SSID && valid_store_SSID) {
+            validSSIT[load_index] = true;
+            SSIT[load_index] = SSIT[store_index];
+        } else if (SSIT[store_index] > SSIT[load_index]) {
+            SSIT[store_index] = SSIT[load_index];
+        } else {
+            SSIT[load_index] = SSIT[store_index];
+        }
+    }
+
+    void insertLoad(Addr load_PC, InstSeqNum load_seq_num) { checkClear(); }
+
+    void
+    insertStore(Addr store_PC, InstSeqNum store_seq_num)
+    {
+        int index = calcIndex(store_PC);
+        checkClear();
+        if (!validSSIT[index])
+            return;
+        unsigned store_SSID = SSIT[index];
+        LFST[store_SSID] = store_seq_num;
+        validLFST[store_SSID] = true;
+        storeList[store_seq_num] = store_SSID;
+    }
+
+    InstSeqNum
+    checkInst(Addr PC)
+    {
+        int index = calcIndex(PC);
+        if (!validSSIT[index] || !validLFST[SSIT[index]])
+            return 0;
+        return LFST[SSIT[index]];
+    }
+
+    void
+    issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store)
+    {
+        if (!is_store)
+            return;
+        int index = calcIndex(issued_PC);
+        storeList.erase(issued_seq_num);
+        if (!validSSIT[index])
+            return;
+        unsigned store_SSID = SSIT[index];
+        if (validLFST[store_SSID] && LFST[store_SSID] == issued_seq_num)
+            validLFST[store_SSID] = false;
+    }
+
+    /** @return False if the squash would not have terminated */
+    bool
+    squash(InstSeqNum squashed_num)
+    {
+        auto store_list_it = storeList.begin();
+        while (!storeList.empty()) {
+            int idx = store_list_it->second;
+            if (store_list_it->first <= squashed_num)
+                break;
+            bool younger = LFST[idx] > squashed_num;
+            if (validLFST[idx] && younger) {
+                validLFST[idx] = false;
+                storeList.erase(store_list_it++);
+            } else if (!validLFST[idx] && younger) {
+                storeList.erase(store_list_it++);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void
+    clear()
+    {
+        std::fill(validSSIT.begin(), validSSIT.end(), false);
+        std::fill(validLFST.begin(), validLFST.end(), false);
+        storeList.clear();
+    }
+
+  private:
+    struct YoungestFirst
+    {
+        bool
+        operator()(const InstSeqNum &lhs, const InstSeqNum &rhs) const
+        {
+            return lhs > rhs;
+        }
+    };
+
+    int calcIndex(Addr PC) { return (PC >> 2) & (SSITSize - 1); }
+    unsigned calcSSID(Addr PC) { return (PC ^ (PC >> 10)) % LFSTSize; }
+
+    void
+    checkClear()
+    {
+        if (++memOpsPred > clearPeriod) {
+            memOpsPred = 0;
+            clear();
+        }
+    }
+
+    std::vector<unsigned> SSIT;
+    std::vector<bool> validSSIT;
+    std::vector<InstSeqNum> LFST;
+    std::vector<bool> validLFST;
+    std::map<InstSeqNum, int, YoungestFirst> storeList;
+    uint64_t clearPeriod;
+    int SSITSize;
+    int LFSTSize;
+    uint64_t memOpsPred = 0;
+};
+
+} // anonymous namespace
+
+/** A load which violated against a store waits for its last instance. */
+TEST(StoreSetTest, Violation)
+{
+    o3::StoreSet store_set(1000000, 64, 16);
+    const Addr store_pc = 0x1000;
+    const Addr load_pc = 0x1040;
+    EXPECT_EQ(store_set.checkInst(load_pc), 0);
+
+    store_set.violation(store_pc, 10, load_pc, 11);
+    store_set.insertStore(store_pc, 20, 0);
+    store_set.insertLoad(load_pc, 21);
+    EXPECT_EQ(store_set.checkInst(load_pc), 20);
+
+    store_set.insertStore(store_pc, 30, 0);
+    EXPECT_EQ(store_set.checkInst(load_pc), 30);
+
+    // Issuing an older store keeps the dependence on the last one
+    store_set.issued(store_pc, 20, true);
+    EXPECT_EQ(store_set.checkInst(load_pc), 30);
+    store_set.issued(store_pc, 30, true);
+    EXPECT_EQ(store_set.checkInst(load_pc), 0);
+}
+
+/** Squashing the last store of a set drops the dependence on it. */
+TEST(StoreSetTest, Squash)
+{
+    o3::StoreSet store_set(1000000, 64, 16);
+    const Addr store_pc = 0x1000;
+    const Addr load_pc = 0x1040;
+    store_set.violation(store_pc, 10, load_pc, 11);
+
+    store_set.insertStore(store_pc, 20, 0);
+    store_set.insertStore(store_pc, 30, 0);
+    store_set.squash(25, 0);
+    EXPECT_EQ(store_set.checkInst(load_pc), 0);
+
+    // The squashed store is gone, so issuing it has no effect
+    store_set.insertStore(store_pc, 40, 0);
+    store_set.issued(store_pc, 30, true);
+    EXPECT_EQ(store_set.checkInst(load_pc), 40);
+}
+
+/**
+ * Drive the store set and the map based reference with the same random
+ * stream of memory instructions, issues, squashes and violations, and
+ * check that they predict the same dependences.
+ */
+TEST(StoreSetTest, MatchesMapReference)
+{
+    const uint64_t clear_period = 5000;
+    o3::StoreSet store_set(clear_period, 64, 16);
+    MapStoreSet reference(clear_period, 64, 16);
+
+    std::mt19937 rng(1);
+    auto random_pc = [&]() { return Addr(0x1000 + 4 * (rng() % 96)); };
+
+    struct Store
+    {
+        Addr pc;
+        InstSeqNum seqNum;
+    };
+    // Stores in flight, in program order
+    std::vector<Store> stores;
+    InstSeqNum seq_num = 0;
+    unsigned num_checks = 0;
+    unsigned num_deps = 0;
+
+    for (int i = 0; i < 100000; ++i) {
+        const unsigned op = rng() % 100;
+        if (op < 30) {
+            const Addr pc = random_pc();
+            ++seq_num;
+            store_set.insertStore(pc, seq_num, 0);
+            reference.insertStore(pc, seq_num);
+            stores.push_back({pc, seq_num});
+        } else if (op < 60) {
+            const Addr pc = random_pc();
+            ++seq_num;
+            store_set.insertLoad(pc, seq_num);
+            reference.insertLoad(pc, seq_num);
+            const InstSeqNum dep = store_set.checkInst(pc);
+            ASSERT_EQ(dep, reference.checkInst(pc)) << "at step " << i;
+            ++num_checks;
+            num_deps += dep != 0;
+            // Loads issue right away, they do not change the store set
+            store_set.issued(pc, seq_num, false);
+            reference.issued(pc, seq_num, false);
+        } else if (op < 85) {
+            if (stores.empty())
+                continue;
+            // Issue a store, mostly the oldest ones
+            size_t idx = rng() % std::min<size_t>(stores.size(), 4);
+            store_set.issued(stores[idx].pc, stores[idx].seqNum, true);
+            reference.issued(stores[idx].pc, stores[idx].seqNum, true);
+            stores.erase(stores.begin() + idx);
+        } else if (op < 95) {
+            const Addr store_pc = random_pc();
+            const Addr load_pc = random_pc();
+            store_set.violation(store_pc, seq_num, load_pc, seq_num + 1);
+            reference.violation(store_pc, load_pc);
+        } else {
+            // Squash a few of the youngest instructions
+            const InstSeqNum squashed =
+                seq_num > 8 ? seq_num - rng() % 8 : seq_num;
+            store_set.squash(squashed, 0);
+            ASSERT_TRUE(reference.squash(squashed)) << "at step " << i;
+            while (!stores.empty() && stores.back().seqNum > squashed)
+                stores.pop_back();
+        }
+    }
+
+    // Make sure the stream exercised the predictions
+    EXPECT_GT(num_checks, 10000);
+    EXPECT_GT(num_deps, 1000);
+}
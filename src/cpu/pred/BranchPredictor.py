@@ -146,6 +146,13 @@ class BranchPredictor(SimObject):
         "Low-end CPUs predecoding might be used to identify branches. ",
     )
 
+    historyEntries = Param.Unsigned(
+        256,
+        "Number of in-flight branches the history of each thread holds. "
+        "It should cover the branches the CPU can have in flight, the "
+        "history grows if it fills up.",
+    )
+
     btb = Param.BranchTargetBuffer(SimpleBTB(), "Branch target buffer (BTB)")
     ras = Param.ReturnAddrStack(
         ReturnAddrStack(), "Return address stack, set to NULL to disable RAS."
@@ -66,6 +66,10 @@ BPredUnit::BPredUnit(const Params &params)
       iPred(params.indirectBranchPred),
       stats(this)
 {
+    fatal_if(params.historyEntries == 0, "%s: the branch history needs at "
+             "least one entry\n", name());
+    for (auto &ph : predHist)
+        ph.grow(params.historyEntries);
 }
 
 
@@ -99,17 +103,26 @@ bool
 BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
                    PCStateBase &pc, ThreadID tid)
 {
-    /** Perform the prediction. */
-    PredictorHistory* bpu_history = nullptr;
-    bool taken  = predict(inst, seqNum, pc, tid, bpu_history);
+    History &pred_hist = predHist[tid];
+
+    // The ring is meant to hold all the branches in flight. Keep every
+    // record if the CPU has more than that.
+    if (pred_hist.full()) {
+        DPRINTF(Branch, "[tid:%i] Growing the history to %i entries\n",
+                tid, 2 * pred_hist.capacity());
+        pred_hist.grow(2 * pred_hist.capacity());
+    }
 
-    assert(bpu_history!=nullptr);
+    /** Take the next record of the history buffer */
+    pred_hist.advance_tail();
+    PredictorHistory *bpu_history = &pred_hist.back();
+    bpu_history->reset(tid, seqNum, pc.instAddr(), inst);
 
-    /** Push the record into the history buffer */
-    predHist[tid].push_front(bpu_history);
+    /** Perform the prediction. */
+    bool taken  = predict(inst, seqNum, pc, tid, bpu_history);
 
     DPRINTF(Branch, "[tid:%i] [sn:%llu] History entry added. "
-            "predHist.size(): %i\n", tid, seqNum, predHist[tid].size());
+            "predHist.size(): %i\n", tid, seqNum, pred_hist.size());
 
     return taken;
 }
@@ -119,18 +132,14 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
 
 bool
 BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
-                   PCStateBase &pc, ThreadID tid, PredictorHistory* &hist)
+                   PCStateBase &pc, ThreadID tid, PredictorHistory *hist)
 {
-    assert(hist == nullptr);
-
-
     // See if branch predictor predicts taken.
     // If so, get its target addr either from the BTB or the RAS.
     // Save off branch stuff into `hist` so we can correct the predictor
     // if prediction was wrong.
 
-    BranchType brType = getBranchType(inst);
-    hist = new PredictorHistory(tid, seqNum, pc.instAddr(), inst);
+    BranchType brType = hist->type;
 
     stats.lookups[tid][brType]++;
     ppBranches->notify(1);
@@ -338,21 +347,20 @@ BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
             "[sn:%llu]\n", tid, done_sn);
 
     while (!predHist[tid].empty() &&
-            predHist[tid].back()->seqNum <= done_sn) {
+            predHist[tid].front().seqNum <= done_sn) {
 
-        // Iterate from the back to front. Least recent
+        // Iterate from the front to back. Least recent
         // sequence number until the most recent done number
-        commitBranch(tid, *predHist[tid].rbegin());
+        commitBranch(tid, &predHist[tid].front());
 
-        delete predHist[tid].back();
-        predHist[tid].pop_back();
+        predHist[tid].pop_front();
         DPRINTF(Branch, "[tid:%i] [commit sn:%llu] pred_hist.size(): %i\n",
                 tid, done_sn, predHist[tid].size());
     }
 }
 
 void
-BPredUnit::commitBranch(ThreadID tid, PredictorHistory* &hist)
+BPredUnit::commitBranch(ThreadID tid, PredictorHistory *hist)
 {
 
     stats.committed[tid][hist->type]++;
@@ -393,10 +401,12 @@ void
 BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 {
 
+    // The records are reused, nothing is freed. Only the predictors
+    // have to restore the state of each squashed branch.
     while (!predHist[tid].empty() &&
-            predHist[tid].front()->seqNum > squashed_sn) {
+            predHist[tid].back().seqNum > squashed_sn) {
 
-        auto hist = predHist[tid].front();
+        auto hist = &predHist[tid].back();
 
         squashHistory(tid, hist);
 
@@ -404,9 +414,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
                 "sn:%llu, PC:%#x\n", tid, squashed_sn, hist->seqNum,
                 hist->pc);
 
-
-        delete predHist[tid].front();
-        predHist[tid].pop_front();
+        predHist[tid].pop_back();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] pred_hist.size(): %i\n",
                 tid, squashed_sn, predHist[tid].size());
@@ -416,7 +424,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 
 
 void
-BPredUnit::squashHistory(ThreadID tid, PredictorHistory* &history)
+BPredUnit::squashHistory(ThreadID tid, PredictorHistory *history)
 {
 
     stats.squashes[tid][history->type]++;
@@ -482,7 +490,7 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
     // fix up the entry.
     if (!pred_hist.empty()) {
 
-        PredictorHistory* const hist = pred_hist.front();
+        PredictorHistory* const hist = &pred_hist.back();
 
         DPRINTF(Branch, "[tid:%i] [squash sn:%llu] Mispredicted: %s, PC:%#x\n",
                     tid, squashed_sn, toString(hist->type), hist->pc);
@@ -611,17 +619,14 @@ BPredUnit::dump()
     int i = 0;
     for (const auto& ph : predHist) {
         if (!ph.empty()) {
-            auto hist = ph.begin();
-
             cprintf("predHist[%i].size(): %i\n", i++, ph.size());
 
-            while (hist != ph.end()) {
+            for (const auto &hist : ph) {
                 cprintf("sn:%llu], PC:%#x, tid:%i, predTaken:%i, "
                         "bpHistory:%#x, rasHistory:%#x\n",
-                        (*hist)->seqNum, (*hist)->pc,
-                        (*hist)->tid, (*hist)->predTaken,
-                        (*hist)->bpHistory, (*hist)->rasHistory);
-                hist++;
+                        hist.seqNum, hist.pc,
+                        hist.tid, hist.predTaken,
+                        hist.bpHistory, hist.rasHistory);
             }
 
             cprintf("\n");
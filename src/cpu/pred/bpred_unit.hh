@@ -42,8 +42,8 @@
 #ifndef __CPU_PRED_BPRED_UNIT_HH__
 #define __CPU_PRED_BPRED_UNIT_HH__
 
-#include <deque>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -128,6 +128,20 @@ class BPredUnit : public SimObject
     void squash(const InstSeqNum &squashed_sn, const PCStateBase &corr_target,
                 bool actually_taken, ThreadID tid, bool from_commit=true);
 
+    /**
+     * Looks up a given PC in the BTB to get the predicted target without
+     * counting the access in the BTB statistics. This is meant for a
+     * decoupled frontend running ahead of fetch.
+     * @param tid The thread id.
+     * @param inst_PC The PC to look up.
+     * @return The target of the branch or nullptr on a BTB miss.
+     */
+    const PCStateBase *
+    BTBPeek(ThreadID tid, Addr instPC)
+    {
+        return btb->peek(tid, instPC);
+    }
+
   protected:
 
     /** *******************************************************
@@ -247,31 +261,42 @@ class BPredUnit : public SimObject
   private:
     struct PredictorHistory
     {
+        PredictorHistory() = default;
+
+        PredictorHistory (const PredictorHistory&) = delete;
+        PredictorHistory& operator= (const PredictorHistory&) = delete;
+        PredictorHistory (PredictorHistory&&) = default;
+        PredictorHistory& operator= (PredictorHistory&&) = default;
+
         /**
-         * Makes a predictor history struct that contains any
-         * information needed to update the predictor, BTB, and RAS.
+         * Makes the history record hold the information needed to
+         * update the predictor, BTB, and RAS for a new branch. Records
+         * are reused from branch to branch, and the predicted target
+         * keeps its storage.
          */
-        PredictorHistory(ThreadID _tid, InstSeqNum sn, Addr _pc,
-                         const StaticInstPtr & inst)
-            : seqNum(sn), tid(_tid), pc(_pc),
-              inst(inst), type(getBranchType(inst)),
-              call(inst->isCall()), uncond(inst->isUncondCtrl()),
-              predTaken(false), actuallyTaken(false), condPred(false),
-              btbHit(false), targetProvider(TargetProvider::NoTarget),
-              resteered(false), mispredict(false), target(nullptr),
-              bpHistory(nullptr),
-              indirectHistory(nullptr), rasHistory(nullptr)
-        { }
-
-        ~PredictorHistory()
+        void
+        reset(ThreadID _tid, InstSeqNum sn, Addr _pc,
+              const StaticInstPtr &_inst)
         {
             assert(bpHistory == nullptr);
             assert(indirectHistory == nullptr);
             assert(rasHistory == nullptr);
-        }
 
-        PredictorHistory (const PredictorHistory&) = delete;
-        PredictorHistory& operator= (const PredictorHistory&) = delete;
+            seqNum = sn;
+            tid = _tid;
+            pc = _pc;
+            inst = _inst;
+            type = getBranchType(inst);
+            call = inst->isCall();
+            uncond = inst->isUncondCtrl();
+            predTaken = false;
+            actuallyTaken = false;
+            condPred = false;
+            btbHit = false;
+            targetProvider = TargetProvider::NoTarget;
+            resteered = false;
+            mispredict = false;
+        }
 
         bool
         operator==(const PredictorHistory &entry) const
@@ -280,46 +305,46 @@ class BPredUnit : public SimObject
         }
 
         /** The sequence number for the predictor history entry. */
-        const InstSeqNum seqNum;
+        InstSeqNum seqNum = 0;
 
         /** The thread id. */
-        const ThreadID tid;
+        ThreadID tid = 0;
 
         /** The PC associated with the sequence number. */
-        const Addr pc;
+        Addr pc = 0;
 
         /** The branch instrction */
-        const StaticInstPtr inst;
+        StaticInstPtr inst;
 
         /** The type of the branch */
-        const BranchType type;
+        BranchType type = BranchType::NoBranch;
 
         /** Whether or not the instruction was a call. */
-        const bool call;
+        bool call = false;
 
         /** Was unconditional control */
-        const bool uncond;
+        bool uncond = false;
 
         /** Whether or not it was predicted taken. */
-        bool predTaken;
+        bool predTaken = false;
 
         /** To record the actual outcome of the branch */
-        bool actuallyTaken;
+        bool actuallyTaken = false;
 
         /** The prediction of the conditional predictor */
-        bool condPred;
+        bool condPred = false;
 
         /** Was BTB hit at prediction time */
-        bool btbHit;
+        bool btbHit = false;
 
         /** Which component provided the target */
-        TargetProvider targetProvider;
+        TargetProvider targetProvider = TargetProvider::NoTarget;
 
         /** Resteered */
-        bool resteered;
+        bool resteered = false;
 
         /** The branch was corrected hence was mispredicted. */
-        bool mispredict;
+        bool mispredict = false;
 
         /** The predicted target */
         std::unique_ptr<PCStateBase> target;
@@ -338,21 +363,26 @@ class BPredUnit : public SimObject
 
     };
 
-    typedef std::deque<PredictorHistory*> History;
+    /**
+     * In-flight branches of a thread, oldest first. The records are
+     * stored inline and reused, so predicting, committing and squashing
+     * a branch does not allocate.
+     */
+    typedef CircularQueue<PredictorHistory> History;
 
 
     /**
      * Internal prediction function.
     */
     bool predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
-               PCStateBase &pc, ThreadID tid, PredictorHistory* &bpu_history);
+               PCStateBase &pc, ThreadID tid, PredictorHistory *hist);
 
     /**
      * Squashes a particular branch instance
      * @param tid The thread id.
      * @param bpu_history The history to be squashed.
      */
-    void squashHistory(ThreadID tid, PredictorHistory* &bpu_history);
+    void squashHistory(ThreadID tid, PredictorHistory *bpu_history);
 
 
     /**
@@ -360,7 +390,7 @@ class BPredUnit : public SimObject
      * @param tid The thread id.
      * @param bpu_history The history of the branch to be commited.
      */
-    void commitBranch(ThreadID tid, PredictorHistory* &bpu_history);
+    void commitBranch(ThreadID tid, PredictorHistory *bpu_history);
 
 
 
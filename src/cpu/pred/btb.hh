@@ -81,6 +81,14 @@ class BranchTargetBuffer : public ClockedObject
     virtual const PCStateBase *lookup(ThreadID tid, Addr instPC,
                             BranchType type = BranchType::NoBranch) = 0;
 
+    /** Looks up an address in the BTB to get the target of the branch
+     *  without updating statistics, e.g. to run ahead of fetch.
+     *  @param inst_PC The address of the branch to look up.
+     *  @return The target of the branch or nullptr if the branch is not
+     *          in the BTB.
+     */
+    virtual const PCStateBase *peek(ThreadID tid, Addr instPC) = 0;
+
     /** Looks up an address in the BTB and return the instruction
      * information if existant. Does not update statistics.
      *  @param inst_PC The address of the branch to look up.
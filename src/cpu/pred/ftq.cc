@@ -0,0 +1,177 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/ftq.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "cpu/pred/bpred_unit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+FetchTargetQueue::FetchTargetQueue(statistics::Group *parent,
+                                   BPredUnit *bpu, ThreadID num_threads,
+                                   unsigned size, unsigned block_size,
+                                   unsigned inst_size)
+    : FetchTargetQueue(parent,
+            [bpu](ThreadID tid, Addr pc, Addr &target)
+            {
+                const PCStateBase *t = bpu->BTBPeek(tid, pc);
+                if (t)
+                    target = t->instAddr();
+                return t != nullptr;
+            },
+            num_threads, size, block_size, inst_size)
+{
+    fatal_if(!bpu, "A fetch target queue needs a branch predictor.");
+}
+
+FetchTargetQueue::FetchTargetQueue(statistics::Group *parent,
+                                   BTBLookupFn btb_lookup,
+                                   ThreadID num_threads, unsigned _size,
+                                   unsigned block_size, unsigned inst_size)
+    : btbLookup(std::move(btb_lookup)), size(_size), blockSize(block_size),
+      instSize(inst_size), threads(num_threads), stats(parent, _size)
+{
+    fatal_if(!isPowerOf2(blockSize),
+             "Fetch target queue block size (%u) must be a power of 2.",
+             blockSize);
+    fatal_if(!instSize || blockSize % instSize,
+             "Fetch target queue block size (%u) must be a multiple of "
+             "the instruction size (%u).", blockSize, instSize);
+}
+
+void
+FetchTargetQueue::squash(ThreadID tid)
+{
+    ThreadState &thread = threads[tid];
+    thread.targets.clear();
+    thread.valid = false;
+}
+
+void
+FetchTargetQueue::advance(ThreadID tid, Addr pc)
+{
+    ThreadState &thread = threads[tid];
+    const Addr block = blockAlign(pc);
+
+    if (thread.valid && block == thread.current) {
+        return;
+    }
+    thread.current = block;
+
+    if (thread.valid) {
+        auto it = std::find_if(thread.targets.begin(), thread.targets.end(),
+                [block](const Target &t) { return t.block == block; });
+        if (it != thread.targets.end()) {
+            ++stats.hits;
+            thread.targets.erase(thread.targets.begin(), it + 1);
+            return;
+        }
+        ++stats.redirects;
+    }
+
+    // Fetch is off the queued path, restart the run-ahead from the
+    // block it is reading now
+    thread.targets.clear();
+    thread.valid = true;
+    thread.next = nextTarget(tid, pc);
+}
+
+void
+FetchTargetQueue::fill(ThreadID tid, const PrefetchFn &prefetch)
+{
+    ThreadState &thread = threads[tid];
+
+    stats.occupancy.sample(thread.targets.size());
+
+    if (!thread.valid) {
+        return;
+    }
+
+    if (thread.targets.size() < size) {
+        const Addr block = blockAlign(thread.next);
+        const Addr last = thread.targets.empty() ?
+            thread.current : thread.targets.back().block;
+        // A block looping onto itself needs no second prefetch
+        thread.targets.push_back({block, block == last});
+        thread.next = nextTarget(tid, thread.next);
+        ++stats.targets;
+    }
+
+    for (auto &target : thread.targets) {
+        if (!target.prefetched) {
+            if (prefetch(target.block)) {
+                target.prefetched = true;
+                ++stats.prefetches;
+            }
+            break;
+        }
+    }
+}
+
+Addr
+FetchTargetQueue::nextTarget(ThreadID tid, Addr pc) const
+{
+    const Addr end = blockAlign(pc) + blockSize;
+    for (Addr addr = roundDown(pc, instSize); addr < end; addr += instSize) {
+        Addr target;
+        if (btbLookup(tid, addr, target)) {
+            return target;
+        }
+    }
+    return end;
+}
+
+FetchTargetQueue::FetchTargetQueueStats::FetchTargetQueueStats(
+        statistics::Group *parent, unsigned size)
+    : statistics::Group(parent, "ftq"),
+      ADD_STAT(occupancy, statistics::units::Count::get(),
+               "Number of fetch blocks queued ahead of fetch, per cycle"),
+      ADD_STAT(targets, statistics::units::Count::get(),
+               "Number of fetch blocks predicted ahead of fetch"),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of fetch blocks that fetch found in the queue"),
+      ADD_STAT(redirects, statistics::units::Count::get(),
+               "Number of times fetch left the queued path"),
+      ADD_STAT(prefetches, statistics::units::Count::get(),
+               "Number of instruction prefetches issued for queued blocks"),
+      ADD_STAT(stallCycles, statistics::units::Cycle::get(),
+               "Number of cycles fetch passed nothing to the next stage")
+{
+    occupancy
+        .init(0, size, 1)
+        .flags(statistics::pdf);
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,167 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_FTQ_HH__
+#define __CPU_PRED_FTQ_HH__
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+class BPredUnit;
+
+/**
+ * Fetch target queue of a decoupled frontend. The queue runs the BTB
+ * ahead of fetch, one fetch block per cycle, following every BTB hit as
+ * a taken branch and falling through to the next block otherwise. Each
+ * queued block is handed to the owning fetch stage to be prefetched
+ * into the instruction cache, so that the misses on the predicted path
+ * overlap with the fetch of the current block.
+ *
+ * The queue does not steer fetch: the fetch stage keeps predicting and
+ * redirecting as before, and tells the queue which block it reads next.
+ * Whenever fetch leaves the queued path the queue is flushed and the
+ * run-ahead restarts from the new fetch address.
+ */
+class FetchTargetQueue
+{
+  public:
+    /**
+     * Sends a prefetch of the block starting at the given address.
+     * @return False if the memory system cannot accept it this cycle.
+     */
+    typedef std::function<bool(Addr)> PrefetchFn;
+
+    /**
+     * Looks up an instruction address in the BTB without updating it.
+     * @return False on a miss, otherwise the target is written to target.
+     */
+    typedef std::function<bool(ThreadID, Addr, Addr &target)> BTBLookupFn;
+
+    /**
+     * @param parent Statistics group the queue statistics belong to.
+     * @param bpu Branch predictor whose BTB drives the run-ahead.
+     * @param num_threads Number of hardware threads.
+     * @param size Maximum number of fetch blocks queued per thread.
+     * @param block_size Size of a fetch block in bytes.
+     * @param inst_size Granularity at which a block is looked up in the
+     * BTB.
+     */
+    FetchTargetQueue(statistics::Group *parent, BPredUnit *bpu,
+                     ThreadID num_threads, unsigned size,
+                     unsigned block_size, unsigned inst_size);
+
+    /** As above, with the BTB looked up through btb_lookup */
+    FetchTargetQueue(statistics::Group *parent, BTBLookupFn btb_lookup,
+                     ThreadID num_threads, unsigned size,
+                     unsigned block_size, unsigned inst_size);
+
+    /** Drops the queued blocks of a thread, e.g. when fetch squashes. */
+    void squash(ThreadID tid);
+
+    /**
+     * Tells the queue that fetch reads the block holding pc. Queued
+     * blocks up to that one are consumed. If the block was not queued,
+     * fetch has been redirected and the run-ahead restarts from pc.
+     */
+    void advance(ThreadID tid, Addr pc);
+
+    /**
+     * Queues the next predicted block of a thread, if there is room, and
+     * issues the oldest pending prefetch. Called once per cycle.
+     */
+    void fill(ThreadID tid, const PrefetchFn &prefetch);
+
+    /** Counts a cycle in which the frontend delivered nothing. */
+    void stall() { ++stats.stallCycles; }
+
+    /** Number of blocks queued for a thread. */
+    size_t occupancy(ThreadID tid) const
+    {
+        return threads[tid].targets.size();
+    }
+
+  private:
+    /** Returns the start of the fetch block holding addr. */
+    Addr blockAlign(Addr addr) const { return addr & ~(blockSize - 1); }
+
+    /**
+     * Looks up the rest of the block starting at pc in the BTB.
+     * @return The target of the first branch found, or the start of the
+     * next block if there is none.
+     */
+    Addr nextTarget(ThreadID tid, Addr pc) const;
+
+    struct Target
+    {
+        /** Start address of the fetch block */
+        Addr block;
+        /** Whether a prefetch has been issued for the block */
+        bool prefetched;
+    };
+
+    struct ThreadState
+    {
+        std::deque<Target> targets;
+        /** Block fetch is currently reading */
+        Addr current = 0;
+        /** Address the run-ahead continues from */
+        Addr next = 0;
+        /** Whether the run-ahead has a starting point */
+        bool valid = false;
+    };
+
+    BTBLookupFn btbLookup;
+    const unsigned size;
+    const Addr blockSize;
+    const unsigned instSize;
+    std::vector<ThreadState> threads;
+
+    struct FetchTargetQueueStats : public statistics::Group
+    {
+        FetchTargetQueueStats(statistics::Group *parent, unsigned size);
+
+        statistics::Distribution occupancy;
+        statistics::Scalar targets;
+        statistics::Scalar hits;
+        statistics::Scalar redirects;
+        statistics::Scalar prefetches;
+        statistics::Scalar stallCycles;
+    } stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_FTQ_HH__
@@ -0,0 +1,218 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "cpu/pred/ftq.hh"
+#include "sim/root.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace gem5
+{
+
+// The statistics of the queue need statistics.cc, which resolves stats
+// by name through the Root object. There is none in this test.
+Root *Root::_root = nullptr;
+
+} // namespace gem5
+
+namespace
+{
+
+constexpr unsigned blockSize = 64;
+constexpr unsigned instSize = 4;
+
+/** A fetch target queue run ahead by a fixed set of taken branches */
+class FetchTargetQueueTest : public ::testing::Test
+{
+  protected:
+    statistics::Group root{nullptr};
+    std::map<Addr, Addr> btb;
+    /** Blocks offered for prefetching, in order */
+    std::vector<Addr> prefetched;
+    /** Whether the icache takes the prefetches */
+    bool accept = true;
+
+    FetchTargetQueue
+    makeQueue(unsigned size)
+    {
+        return FetchTargetQueue(&root,
+            [this](ThreadID tid, Addr pc, Addr &target)
+            {
+                auto it = btb.find(pc);
+                if (it == btb.end())
+                    return false;
+                target = it->second;
+                return true;
+            },
+            1, size, blockSize, instSize);
+    }
+
+    void
+    fill(FetchTargetQueue &ftq)
+    {
+        ftq.fill(0, [this](Addr addr)
+            {
+                prefetched.push_back(addr);
+                return accept;
+            });
+    }
+};
+
+} // anonymous namespace
+
+/** Nothing is queued before fetch says where it is */
+TEST_F(FetchTargetQueueTest, WaitsForFetch)
+{
+    auto ftq = makeQueue(4);
+    fill(ftq);
+    EXPECT_EQ(ftq.occupancy(0), 0);
+    EXPECT_TRUE(prefetched.empty());
+}
+
+/** The queue follows BTB hits and falls through to the next block */
+TEST_F(FetchTargetQueueTest, Fill)
+{
+    btb[0x1010] = 0x2000;
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1008);
+
+    fill(ftq);
+    fill(ftq);
+    fill(ftq);
+    EXPECT_EQ(ftq.occupancy(0), 3);
+    EXPECT_EQ(prefetched, (std::vector<Addr>{0x2000, 0x2040, 0x2080}));
+}
+
+/** A branch before fetch's position in the block is not followed */
+TEST_F(FetchTargetQueueTest, StartsFromFetchPC)
+{
+    btb[0x1010] = 0x2000;
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1014);
+
+    fill(ftq);
+    EXPECT_EQ(prefetched, (std::vector<Addr>{0x1040}));
+}
+
+/** The queue stops filling when it is full */
+TEST_F(FetchTargetQueueTest, Full)
+{
+    auto ftq = makeQueue(2);
+    ftq.advance(0, 0x1000);
+
+    for (int i = 0; i < 5; i++)
+        fill(ftq);
+    EXPECT_EQ(ftq.occupancy(0), 2);
+    EXPECT_EQ(prefetched, (std::vector<Addr>{0x1040, 0x1080}));
+}
+
+/** Fetch reaching a queued block consumes the blocks up to it */
+TEST_F(FetchTargetQueueTest, Advance)
+{
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1000);
+    for (int i = 0; i < 3; i++)
+        fill(ftq);
+    ASSERT_EQ(ftq.occupancy(0), 3);
+
+    // Staying in the current block changes nothing
+    ftq.advance(0, 0x1030);
+    EXPECT_EQ(ftq.occupancy(0), 3);
+
+    ftq.advance(0, 0x1084);
+    EXPECT_EQ(ftq.occupancy(0), 1);
+
+    // The run-ahead carries on after the last queued block
+    fill(ftq);
+    EXPECT_EQ(prefetched.back(), 0x1100);
+}
+
+/** Fetch leaving the queued path restarts the run-ahead from it */
+TEST_F(FetchTargetQueueTest, Redirect)
+{
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1000);
+    fill(ftq);
+    fill(ftq);
+    ASSERT_EQ(ftq.occupancy(0), 2);
+
+    ftq.advance(0, 0x5008);
+    EXPECT_EQ(ftq.occupancy(0), 0);
+    fill(ftq);
+    EXPECT_EQ(ftq.occupancy(0), 1);
+    EXPECT_EQ(prefetched.back(), 0x5040);
+}
+
+/** A squash empties the queue until fetch says where it restarts */
+TEST_F(FetchTargetQueueTest, Squash)
+{
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1000);
+    fill(ftq);
+    ftq.squash(0);
+    EXPECT_EQ(ftq.occupancy(0), 0);
+
+    fill(ftq);
+    EXPECT_EQ(ftq.occupancy(0), 0);
+    EXPECT_EQ(prefetched.size(), 1);
+
+    ftq.advance(0, 0x3000);
+    fill(ftq);
+    EXPECT_EQ(prefetched.back(), 0x3040);
+}
+
+/** A refused prefetch is offered again on the next fill */
+TEST_F(FetchTargetQueueTest, RefusedPrefetch)
+{
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1000);
+
+    accept = false;
+    fill(ftq);
+    accept = true;
+    fill(ftq);
+    fill(ftq);
+    EXPECT_EQ(prefetched, (std::vector<Addr>{0x1040, 0x1040, 0x1080}));
+}
+
+/** A block branching back onto itself is not prefetched again */
+TEST_F(FetchTargetQueueTest, Loop)
+{
+    btb[0x1020] = 0x1000;
+    auto ftq = makeQueue(4);
+    ftq.advance(0, 0x1000);
+
+    fill(ftq);
+    fill(ftq);
+    EXPECT_EQ(ftq.occupancy(0), 2);
+    EXPECT_TRUE(prefetched.empty());
+}
@@ -153,9 +153,17 @@ class LoopPredictor : public SimObject
         BranchInfo()
             : loopTag(0), currentIter(0),
               loopPred(false),
-              loopPredValid(false), loopIndex(0), loopIndexB(0), loopHit(0),
+              loopPredValid(false), loopPredUsed(false),
+              loopIndex(0), loopIndexB(0), loopHit(0),
               predTaken(false)
         {}
+
+        /** Restore the state of a new branch info, for reuse */
+        void
+        reset()
+        {
+            *this = BranchInfo();
+        }
     };
 
     /**
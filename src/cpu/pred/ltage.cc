@@ -77,7 +77,8 @@ LTAGE::init()
 bool
 LTAGE::predict(ThreadID tid, Addr branch_pc, bool cond_branch, void* &b)
 {
-    LTageBranchInfo *bi = new LTageBranchInfo(*tage, *loopPredictor);
+    LTageBranchInfo *bi =
+        allocBranchInfo<LTageBranchInfo>(*tage, *loopPredictor);
     b = (void*)(bi);
 
     bool pred_taken = tage->tagePredict(tid, branch_pc, cond_branch,
@@ -144,8 +145,7 @@ LTAGE::update(ThreadID tid, Addr pc, bool taken, void * &bp_history,
     tage->updateHistories(tid, pc, taken, bi->tageBranchInfo, false,
                           inst, target);
 
-    delete bi;
-    bp_history = nullptr;
+    freeBranchInfo(bp_history);
 }
 
 void
@@ -112,6 +112,13 @@ class LTAGE : public TAGE
             delete lpBranchInfo;
             lpBranchInfo = nullptr;
         }
+
+        void
+        reset() override
+        {
+            TageBranchInfo::reset();
+            lpBranchInfo->reset();
+        }
     };
 
     /**
@@ -83,7 +83,8 @@ MultiperspectivePerceptron::ThreadData::ThreadData(int num_filters,
         ghist_words(ghist_length/block_size+1, 0),
         path_history(path_length, 0), imli_counter(4,0),
         localHistories(n_local_histories, local_history_length),
-        recency_stack(assoc), last_ghist_bit(false), occupancy(0)
+        recency_stack(assoc), last_ghist_bit(false), occupancy(0),
+        weights(table_sizes)
 {
     for (int i = 0; i < blurrypath_bits.size(); i+= 1) {
         blurrypath_histories[i].resize(blurrypath_bits[i].size());
@@ -118,11 +119,9 @@ MultiperspectivePerceptron::ThreadData::ThreadData(int num_filters,
 
     for (int i = 0; i < table_sizes.size(); i += 1) {
         mpreds.push_back(0);
-        tables.push_back(std::vector<short int>(table_sizes[i]));
-        sign_bits.push_back(std::vector<std::array<bool, 2>>(table_sizes[i]));
         for (int j = 0; j < table_sizes[i]; j += 1) {
             for (int k = 0; k < n_sign_bits; k += 1) {
-                sign_bits[i][j][k] = (i & 1) | (k & 1);
+                weight(i, j).setSign(k, (i & 1) | (k & 1));
             }
         }
     }
@@ -142,8 +141,9 @@ MultiperspectivePerceptron::MultiperspectivePerceptron(
     threadData(p.numThreads, nullptr), doing_local(false),
     doing_recency(false), assoc(0), ghist_length(p.initial_ghist_length),
     modghist_length(1), path_length(1), thresholdCounter(0),
-    theta(p.initial_theta), extrabits(0), imli_counter_bits(4),
-    modhist_indices(), modhist_lengths(), modpath_indices(), modpath_lengths()
+    theta(p.initial_theta), extrabits(0), total_bits(0),
+    imli_counter_bits(4), modhist_indices(), modhist_lengths(),
+    modpath_indices(), modpath_lengths(), mppStats(*this)
 {
     fatal_if(speculative_update, "Speculative update not implemented");
 }
@@ -186,6 +186,30 @@ MultiperspectivePerceptron::init()
     }
 }
 
+size_t
+MultiperspectivePerceptron::getHostBytes() const
+{
+    size_t bytes = 0;
+    for (auto *td : threadData) {
+        if (td) {
+            bytes += td->weights.hostBytes();
+        }
+    }
+    return bytes;
+}
+
+MultiperspectivePerceptron::MultiperspectivePerceptronStats::
+MultiperspectivePerceptronStats(MultiperspectivePerceptron &mpp)
+    : statistics::Group(&mpp),
+      ADD_STAT(storageBits, statistics::units::Bit::get(),
+               "Storage budget of the modelled predictor"),
+      ADD_STAT(hostBytes, statistics::units::Byte::get(),
+               "Host memory used by the feature tables")
+{
+    storageBits.functor([&mpp]() { return mpp.total_bits; });
+    hostBytes.functor([&mpp]() { return mpp.getHostBytes(); });
+}
+
 void
 MultiperspectivePerceptron::computeBits(int num_filter_entries,
         int nlocal_histories, int local_history_length, bool ignore_path_size)
@@ -258,6 +282,7 @@ MultiperspectivePerceptron::computeBits(int num_filter_entries,
             table_size_bits / (6 + (n_sign_bits - 1)));
     DPRINTF(Branch, "%d total bits (%0.2fKB)\n", totalbits,
             totalbits / 8192.0);
+    total_bits = totalbits;
 }
 
 void
@@ -347,15 +372,17 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
 
+    ThreadData &td = *threadData[tid];
+    const int sign_idx = bi.getHPC() % n_sign_bits;
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the hash to index the table
         unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        const ThreadData::Weight &w = td.weight(i, hashed_idx);
         // add the weight; first get the weight's magnitude
-        int counter = threadData[tid]->tables[i][hashed_idx];
+        int counter = w.magnitude;
         // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = w.sign(sign_idx);
         // apply the transfer function and multiply by a coefficient
         int weight = spec.coeff * ((spec.width == 5) ?
                                    xlat4[counter] : xlat[counter]);
@@ -421,10 +448,9 @@ MultiperspectivePerceptron::satIncDec(bool taken, bool &sign, int &counter,
 void
 MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
 {
-    std::vector<std::vector<short int>> &tables = threadData[tid]->tables;
-    std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
-            threadData[tid]->sign_bits;
-    std::vector<int> &mpreds = threadData[tid]->mpreds;
+    ThreadData &td = *threadData[tid];
+    const int sign_idx = bi.getHPC() % n_sign_bits;
+    std::vector<int> &mpreds = td.mpreds;
     // was the prediction correct?
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
@@ -438,8 +464,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             HistorySpec const &spec = *specs[i];
             // get the hash to index the table
             unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-            bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-            int counter = tables[i][hashed_idx];
+            const ThreadData::Weight &w = td.weight(i, hashed_idx);
+            bool sign = w.sign(sign_idx);
+            int counter = w.magnitude;
             int weight = spec.coeff * ((spec.width == 5) ?
                                        xlat4[counter] : xlat[counter]);
             if (sign) weight = -weight;
@@ -486,14 +513,15 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
         HistorySpec const &spec = *specs[i];
         // get the magnitude
         unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-        int counter = tables[i][hashed_idx];
+        ThreadData::Weight &w = td.weight(i, hashed_idx);
+        int counter = w.magnitude;
         // get the sign
-        bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = w.sign(sign_idx);
         // increment/decrement if taken/not taken
         satIncDec(taken, sign, counter, (1 << (spec.width - 1)) - 1);
         // update the magnitude and sign
-        tables[i][hashed_idx] = counter;
-        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
+        w.magnitude = counter;
+        w.setSign(sign_idx, sign);
         int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
         // update the new version of yout
         if (sign) {
@@ -520,9 +548,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                     int i = (nrand + j) % specs.size();
                     HistorySpec const &spec = *specs[i];
                     unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-                    int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    const ThreadData::Weight &w = td.weight(i, hashed_idx);
+                    int counter = w.magnitude;
+                    bool sign = w.sign(sign_idx);
                     int weight = ((spec.width == 5) ?
                             xlat4[counter] : xlat[counter]);
                     int signed_weight = sign ? -weight : weight;
@@ -538,12 +566,12 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                     int i = besti;
                     HistorySpec const &spec = *specs[i];
                     unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-                    int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    ThreadData::Weight &w = td.weight(i, hashed_idx);
+                    int counter = w.magnitude;
+                    bool sign = w.sign(sign_idx);
                     if (counter > 1) {
                         counter--;
-                        tables[i][hashed_idx] = counter;
+                        w.magnitude = counter;
                     }
                     int weight = ((spec.width == 5) ?
                             xlat4[counter] : xlat[counter]);
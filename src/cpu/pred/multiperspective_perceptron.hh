@@ -51,10 +51,10 @@
 #ifndef __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 #define __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 
-#include <array>
 #include <vector>
 
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/perceptron_weights.hh"
 #include "params/MultiperspectivePerceptron.hh"
 
 namespace gem5
@@ -365,8 +365,14 @@ class MultiperspectivePerceptron : public BPredUnit
         int occupancy;
 
         std::vector<int> mpreds;
-        std::vector<std::vector<short int>> tables;
-        std::vector<std::vector<std::array<bool, 2>>> sign_bits;
+
+        using Weight = PerceptronWeights::Weight;
+        PerceptronWeights weights;
+
+        Weight &weight(int table, unsigned int idx)
+        {
+            return weights.get(table, idx);
+        }
     };
     std::vector<ThreadData *> threadData;
 
@@ -384,6 +390,8 @@ class MultiperspectivePerceptron : public BPredUnit
     int thresholdCounter;
     int theta;
     int extrabits;
+    /** storage budget used by the predictor, computed by computeBits */
+    int total_bits;
     std::vector<int> imli_counter_bits;
     std::vector<int> modhist_indices;
     std::vector<int> modhist_lengths;
@@ -392,6 +400,16 @@ class MultiperspectivePerceptron : public BPredUnit
     std::vector<std::vector<int>> blurrypath_bits;
     std::vector<std::vector<std::vector<bool>>> acyclic_bits;
 
+    struct MultiperspectivePerceptronStats : public statistics::Group
+    {
+        MultiperspectivePerceptronStats(MultiperspectivePerceptron &mpp);
+
+        /** Storage budget of the modelled predictor */
+        statistics::Value storageBits;
+        /** Host memory used by the feature tables of all threads */
+        statistics::Value hostBytes;
+    } mppStats;
+
     /** Auxiliary function for MODHIST and GHISTMODPATH features */
     void insertModhistSpec(int p1, int p2) {
         int j = insert(modhist_indices, p1);
@@ -1060,6 +1078,9 @@ class MultiperspectivePerceptron : public BPredUnit
 
     void init() override;
 
+    /** Host memory used by the feature tables of all threads */
+    size_t getHostBytes() const;
+
     // Base class methods.
     bool lookup(ThreadID tid, Addr branch_addr, void* &bp_history) override;
     void updateHistories(ThreadID tid, Addr pc, bool uncond, bool taken,
@@ -440,8 +440,8 @@ MultiperspectivePerceptronTAGE::computePartialSum(ThreadID tid,
 {
     int yout = 0;
     for (int i = 0; i < specs.size(); i += 1) {
-        yout += specs[i]->coeff *
-            threadData[tid]->tables[i][getIndex(tid, bi, *specs[i], i)];
+        yout += specs[i]->coeff * threadData[tid]->weight(
+            i, getIndex(tid, bi, *specs[i], i)).magnitude;
     }
     return yout;
 }
@@ -454,8 +454,7 @@ MultiperspectivePerceptronTAGE::updatePartial(ThreadID tid,
     // update tables
     for (int i = 0; i < specs.size(); i += 1) {
         unsigned int idx = getIndex(tid, bi, *specs[i], i);
-        short int *c =
-            &threadData[tid]->tables[i][idx];
+        short int *c = &threadData[tid]->weight(i, idx).magnitude;
         short int max_weight = (1 << (specs[i]->width - 1)) - 1;
         short int min_weight = -(1 << (specs[i]->width - 1));
         if (taken) {
@@ -0,0 +1,119 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_PERCEPTRON_WEIGHTS_HH__
+#define __CPU_PRED_PERCEPTRON_WEIGHTS_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * The weights of the feature tables of a perceptron predictor. The tables
+ * are stored back to back in a single array aligned to a cache line, and
+ * each table starts on a cache line boundary. A weight never straddles two
+ * lines, so reading a weight of a table touches a single line.
+ */
+class PerceptronWeights
+{
+  public:
+    /** A weight of a feature table: its magnitude and its sign bits */
+    struct Weight
+    {
+        short int magnitude;
+        uint8_t signs;
+
+        bool sign(int k) const { return (signs >> k) & 1; }
+        void setSign(int k, bool s)
+        {
+            signs = s ? (signs | (1 << k)) : (signs & ~(1 << k));
+        }
+    };
+
+    static constexpr size_t lineBytes = 64;
+    static constexpr size_t weightsPerLine = lineBytes / sizeof(Weight);
+    static_assert(lineBytes % sizeof(Weight) == 0,
+                  "A weight must not straddle two cache lines");
+
+    /**
+     * @param table_sizes Number of weights of each table, which all start
+     * with a zero magnitude and clear sign bits
+     */
+    explicit PerceptronWeights(const std::vector<int> &table_sizes)
+    {
+        for (int size : table_sizes) {
+            tableOffsets.push_back(numWeights);
+            numWeights += roundUp(size, weightsPerLine);
+        }
+        auto *raw = static_cast<Weight *>(::operator new[](
+                numWeights * sizeof(Weight), std::align_val_t(lineBytes)));
+        std::uninitialized_fill_n(raw, numWeights, Weight{0, 0});
+        weights.reset(raw);
+    }
+
+    Weight &
+    get(int table, unsigned int idx)
+    {
+        return weights[tableOffsets[table] + idx];
+    }
+
+    const Weight &
+    get(int table, unsigned int idx) const
+    {
+        return weights[tableOffsets[table] + idx];
+    }
+
+    /** Host memory used by the tables, padding included */
+    size_t hostBytes() const { return numWeights * sizeof(Weight); }
+
+  private:
+    struct Deleter
+    {
+        void
+        operator()(Weight *w) const
+        {
+            ::operator delete[](w, std::align_val_t(lineBytes));
+        }
+    };
+
+    std::unique_ptr<Weight[], Deleter> weights;
+    std::vector<size_t> tableOffsets;
+    size_t numWeights = 0;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_PERCEPTRON_WEIGHTS_HH__
@@ -0,0 +1,209 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/perceptron_weights.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/** The saturating sign/magnitude update of the perceptron predictor */
+void
+satIncDec(bool taken, bool &sign, int &counter, int max_weight)
+{
+    if (taken == sign) {
+        if (counter == 0) {
+            sign = !sign;
+        } else {
+            counter -= 1;
+        }
+    } else if (counter < max_weight) {
+        counter += 1;
+    }
+}
+
+/**
+ * The feature tables as the predictor kept them before they were packed:
+ * a vector of magnitudes and a vector of sign bits per table.
+ */
+struct VectorTables
+{
+    std::vector<std::vector<short int>> tables;
+    std::vector<std::vector<std::array<bool, 2>>> sign_bits;
+
+    explicit VectorTables(const std::vector<int> &table_sizes)
+    {
+        for (int size : table_sizes) {
+            tables.push_back(std::vector<short int>(size));
+            sign_bits.push_back(std::vector<std::array<bool, 2>>(size));
+        }
+    }
+};
+
+const std::vector<int> tableSizes = {512, 100, 1024, 37, 2048, 1};
+
+} // anonymous namespace
+
+TEST(PerceptronWeightsTest, Zeroed)
+{
+    PerceptronWeights weights(tableSizes);
+    for (int i = 0; i < tableSizes.size(); i++) {
+        for (int j = 0; j < tableSizes[i]; j++) {
+            EXPECT_EQ(weights.get(i, j).magnitude, 0);
+            EXPECT_EQ(weights.get(i, j).signs, 0);
+        }
+    }
+}
+
+TEST(PerceptronWeightsTest, TablesStartOnCacheLines)
+{
+    PerceptronWeights weights(tableSizes);
+    for (int i = 0; i < tableSizes.size(); i++) {
+        auto addr = reinterpret_cast<uintptr_t>(&weights.get(i, 0));
+        EXPECT_EQ(addr % PerceptronWeights::lineBytes, 0) << "table " << i;
+    }
+}
+
+TEST(PerceptronWeightsTest, TablesDoNotOverlap)
+{
+    PerceptronWeights weights(tableSizes);
+    for (int i = 0; i < tableSizes.size(); i++) {
+        for (int j = 0; j < tableSizes[i]; j++) {
+            weights.get(i, j).magnitude = i;
+        }
+    }
+    for (int i = 0; i < tableSizes.size(); i++) {
+        for (int j = 0; j < tableSizes[i]; j++) {
+            ASSERT_EQ(weights.get(i, j).magnitude, i);
+        }
+    }
+    size_t padded = 0;
+    for (int size : tableSizes) {
+        padded += roundUp(size, PerceptronWeights::weightsPerLine);
+    }
+    EXPECT_EQ(weights.hostBytes(),
+              padded * sizeof(PerceptronWeights::Weight));
+}
+
+TEST(PerceptronWeightsTest, SignBits)
+{
+    PerceptronWeights weights({1});
+    PerceptronWeights::Weight &w = weights.get(0, 0);
+    w.setSign(1, true);
+    EXPECT_FALSE(w.sign(0));
+    EXPECT_TRUE(w.sign(1));
+    w.setSign(0, true);
+    w.setSign(1, false);
+    EXPECT_TRUE(w.sign(0));
+    EXPECT_FALSE(w.sign(1));
+}
+
+/**
+ * Predict and train a stream of branches with both layouts, the way the
+ * predictor reads and updates its weights, and check that they predict
+ * the same outputs and end with the same weights.
+ */
+TEST(PerceptronWeightsTest, MatchesVectorTables)
+{
+    constexpr int n_sign_bits = 2;
+    constexpr int max_weight = (1 << 5) - 1;
+    constexpr int theta = 10;
+
+    PerceptronWeights packed(tableSizes);
+    VectorTables reference(tableSizes);
+    for (int i = 0; i < tableSizes.size(); i++) {
+        for (int j = 0; j < tableSizes[i]; j++) {
+            for (int k = 0; k < n_sign_bits; k++) {
+                bool sign = (i & 1) | (k & 1);
+                packed.get(i, j).setSign(k, sign);
+                reference.sign_bits[i][j][k] = sign;
+            }
+        }
+    }
+
+    std::mt19937 rng(1);
+    uint64_t history = 0;
+    std::vector<unsigned int> indices(tableSizes.size());
+    for (int n = 0; n < 200000; n++) {
+        // A few branches whose outcome depends on the global history
+        const unsigned int pc = rng() % 64;
+        const bool taken = ((history >> (pc % 8)) ^ pc) & 1 ||
+                           rng() % 16 == 0;
+        const int sign_idx = pc % n_sign_bits;
+        for (int i = 0; i < tableSizes.size(); i++) {
+            indices[i] = (pc * 7919 + (history & ((1 << i) - 1)) * 31) %
+                         tableSizes[i];
+        }
+
+        int packed_out = 0;
+        int reference_out = 0;
+        for (int i = 0; i < tableSizes.size(); i++) {
+            const auto &w = packed.get(i, indices[i]);
+            packed_out += w.sign(sign_idx) ? -w.magnitude : w.magnitude;
+            int counter = reference.tables[i][indices[i]];
+            bool sign = reference.sign_bits[i][indices[i]][sign_idx];
+            reference_out += sign ? -counter : counter;
+        }
+        ASSERT_EQ(packed_out, reference_out) << "branch " << n;
+
+        if ((packed_out >= 1) != taken || std::abs(packed_out) <= theta) {
+            for (int i = 0; i < tableSizes.size(); i++) {
+                auto &w = packed.get(i, indices[i]);
+                int counter = w.magnitude;
+                bool sign = w.sign(sign_idx);
+                satIncDec(taken, sign, counter, max_weight);
+                w.magnitude = counter;
+                w.setSign(sign_idx, sign);
+
+                counter = reference.tables[i][indices[i]];
+                sign = reference.sign_bits[i][indices[i]][sign_idx];
+                satIncDec(taken, sign, counter, max_weight);
+                reference.tables[i][indices[i]] = counter;
+                reference.sign_bits[i][indices[i]][sign_idx] = sign;
+            }
+        }
+        history = (history << 1) | taken;
+    }
+
+    for (int i = 0; i < tableSizes.size(); i++) {
+        for (int j = 0; j < tableSizes[i]; j++) {
+            ASSERT_EQ(packed.get(i, j).magnitude, reference.tables[i][j]);
+            for (int k = 0; k < n_sign_bits; k++) {
+                ASSERT_EQ(packed.get(i, j).sign(k),
+                          reference.sign_bits[i][j][k]);
+            }
+        }
+    }
+}
@@ -143,6 +143,14 @@ SimpleBTB::lookup(ThreadID tid, Addr instPC, BranchType type)
     return nullptr;
 }
 
+const PCStateBase *
+SimpleBTB::peek(ThreadID tid, Addr instPC)
+{
+    BTBEntry *entry = findEntry(instPC, tid);
+
+    return entry ? entry->target.get() : nullptr;
+}
+
 const StaticInstPtr
 SimpleBTB::getInst(ThreadID tid, Addr instPC)
 {
@@ -61,6 +61,7 @@ class SimpleBTB : public BranchTargetBuffer
     bool valid(ThreadID tid, Addr instPC) override;
     const PCStateBase *lookup(ThreadID tid, Addr instPC,
                            BranchType type = BranchType::NoBranch) override;
+    const PCStateBase *peek(ThreadID tid, Addr instPC) override;
     void update(ThreadID tid, Addr instPC, const PCStateBase &target_pc,
                            BranchType type = BranchType::NoBranch,
                            StaticInstPtr inst = nullptr) override;
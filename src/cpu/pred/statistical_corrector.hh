@@ -204,6 +204,13 @@ class StatisticalCorrector : public SimObject
               predBeforeSC(false), usedScPred(false)
         {}
 
+        /** Restore the state of a new branch info, for reuse */
+        void
+        reset()
+        {
+            *this = BranchInfo();
+        }
+
         // confidences calculated on tage and used on the statistical
         // correction
         bool lowConf;
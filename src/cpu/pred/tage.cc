@@ -66,6 +66,12 @@ TAGE::TAGE(const TAGEParams &params) : BPredUnit(params), tage(params.tage)
 {
 }
 
+TAGE::~TAGE()
+{
+    for (auto *bi : freeBranchInfos)
+        delete bi;
+}
+
 // PREDICTOR UPDATE
 void
 TAGE::update(ThreadID tid, Addr pc, bool taken, void * &bp_history,
@@ -94,23 +100,21 @@ TAGE::update(ThreadID tid, Addr pc, bool taken, void * &bp_history,
 
     // optional non speculative update of the histories
     tage->updateHistories(tid, pc, taken, tage_bi, false, inst, target);
-    delete bi;
-    bp_history = nullptr;
+    freeBranchInfo(bp_history);
 }
 
 void
 TAGE::squash(ThreadID tid, void * &bp_history)
 {
     TageBranchInfo *bi = static_cast<TageBranchInfo*>(bp_history);
-    DPRINTF(Tage, "Deleting branch info: %lx\n", bi->tageBranchInfo->branchPC);
-    delete bi;
-    bp_history = nullptr;
+    DPRINTF(Tage, "Freeing branch info: %lx\n", bi->tageBranchInfo->branchPC);
+    freeBranchInfo(bp_history);
 }
 
 bool
 TAGE::predict(ThreadID tid, Addr pc, bool cond_branch, void* &b)
 {
-    TageBranchInfo *bi = new TageBranchInfo(*tage);//nHistoryTables+1);
+    TageBranchInfo *bi = allocBranchInfo<TageBranchInfo>(*tage);
     b = (void*)(bi);
     return tage->tagePredict(tid, pc, cond_branch, bi->tageBranchInfo);
 }
@@ -60,6 +60,8 @@
 #ifndef __CPU_PRED_TAGE_HH__
 #define __CPU_PRED_TAGE_HH__
 
+#include <cassert>
+#include <utility>
 #include <vector>
 
 #include "base/types.hh"
@@ -89,14 +91,54 @@ class TAGE: public BPredUnit
         {
             delete tageBranchInfo;
         }
+
+        /** Restore the state of a new branch info, for reuse */
+        virtual void
+        reset()
+        {
+            tageBranchInfo->reset();
+        }
     };
 
+    /**
+     * Branch infos of the committed and squashed branches. They are
+     * handed out again to the next predicted branches, so the
+     * predictor does not allocate once it has seen as many branches in
+     * flight as the CPU can hold. A predictor always makes branch infos
+     * of the same type.
+     */
+    std::vector<TageBranchInfo *> freeBranchInfos;
+
+    /** Get a branch info, reused from a past branch if possible */
+    template <class Info, class... Args>
+    Info *
+    allocBranchInfo(Args&&... args)
+    {
+        if (freeBranchInfos.empty())
+            return new Info(std::forward<Args>(args)...);
+
+        TageBranchInfo *bi = freeBranchInfos.back();
+        freeBranchInfos.pop_back();
+        assert(dynamic_cast<Info *>(bi));
+        bi->reset();
+        return static_cast<Info *>(bi);
+    }
+
+    /** Give back the branch info of a committed or squashed branch */
+    void
+    freeBranchInfo(void * &bp_history)
+    {
+        freeBranchInfos.push_back(static_cast<TageBranchInfo *>(bp_history));
+        bp_history = nullptr;
+    }
+
     virtual bool predict(ThreadID tid, Addr branch_pc, bool cond_branch,
                          void* &b);
 
   public:
 
     TAGE(const TAGEParams &params);
+    ~TAGE();
 
     // Base class methods.
     bool lookup(ThreadID tid, Addr pc, void* &bp_history) override;
@@ -37,6 +37,8 @@
 
 #include "cpu/pred/tage_base.hh"
 
+#include <new>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/Fetch.hh"
@@ -70,7 +72,7 @@ TAGEBase::TAGEBase(const TAGEBaseParams &p)
      speculativeHistUpdate(p.speculativeHistUpdate),
      instShiftAmt(p.instShiftAmt),
      initialized(false),
-     stats(this, nHistoryTables)
+     stats(*this, nHistoryTables)
 {
     if (noSkip.empty()) {
         // Set all the table to enabled by default
@@ -140,6 +142,7 @@ TAGEBase::init()
                             true);
 
     gtable = new TageEntry*[nHistoryTables + 1];
+    gtableBytes = 0;
     buildTageTables();
 
     tableIndices = new int [nHistoryTables+1];
@@ -166,10 +169,17 @@ void
 TAGEBase::buildTageTables()
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        gtable[i] = new TageEntry[1<<(logTagTableSizes[i])];
+        gtable[i] = allocTageTable(1<<(logTagTableSizes[i]));
     }
 }
 
+TAGEBase::TageEntry *
+TAGEBase::allocTageTable(size_t entries)
+{
+    gtableBytes += entries * sizeof(TageEntry);
+    return new (std::align_val_t(tableAlignment)) TageEntry[entries];
+}
+
 void
 TAGEBase::calculateParameters()
 {
@@ -723,8 +733,8 @@ TAGEBase::getGHR(ThreadID tid, BranchInfo *bi) const
 }
 
 TAGEBase::TAGEBaseStats::TAGEBaseStats(
-    statistics::Group *parent, unsigned nHistoryTables)
-    : statistics::Group(parent),
+    TAGEBase &tage, unsigned nHistoryTables)
+    : statistics::Group(&tage),
       ADD_STAT(longestMatchProviderCorrect, statistics::units::Count::get(),
                "Number of times TAGE Longest Match is the provider and the "
                "prediction is correct"),
@@ -758,10 +768,17 @@ TAGEBase::TAGEBaseStats::TAGEBaseStats(
       ADD_STAT(longestMatchProvider, statistics::units::Count::get(),
                "TAGE provider for longest match"),
       ADD_STAT(altMatchProvider, statistics::units::Count::get(),
-               "TAGE provider for alt match")
+               "TAGE provider for alt match"),
+      ADD_STAT(storageBits, statistics::units::Bit::get(),
+               "Storage budget of the modelled TAGE"),
+      ADD_STAT(hostBytes, statistics::units::Byte::get(),
+               "Host memory used by the TAGE tables")
 {
     longestMatchProvider.init(nHistoryTables + 1);
     altMatchProvider.init(nHistoryTables + 1);
+
+    storageBits.functor([&tage]() { return tage.getSizeInBits(); });
+    hostBytes.functor([&tage]() { return tage.getHostBytes(); });
 }
 
 int8_t
@@ -805,5 +822,16 @@ TAGEBase::getSizeInBits() const {
     return bits;
 }
 
+size_t
+TAGEBase::getHostBytes() const
+{
+    if (!initialized) {
+        return 0;
+    }
+    // std::vector<bool> keeps one bit per entry
+    return gtableBytes + (btablePrediction.size() + 7) / 8 +
+        (btableHysteresis.size() + 7) / 8;
+}
+
 } // namespace branch_prediction
 } // namespace gem5
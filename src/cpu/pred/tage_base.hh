@@ -71,14 +71,19 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
+    // Tage Entry, laid out without padding so that an entry takes 4
+    // bytes and 16 entries share a cache line
     struct TageEntry
     {
-        int8_t ctr;
         uint16_t tag;
+        int8_t ctr;
         uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        TageEntry() : tag(0), ctr(0), u(0) { }
     };
+    static_assert(sizeof(TageEntry) == 4, "TageEntry must stay packed");
+
+    /** Alignment of the tagged tables in host memory */
+    static constexpr size_t tableAlignment = 64;
 
     // Folded History Table - compressed history
     // to mix with instruction PC to index partially
@@ -159,14 +164,6 @@ class TAGEBase : public SimObject
         unsigned provider;
 
         BranchInfo(const TAGEBase &tage)
-            : pathHist(0), ptGhist(0),
-              hitBank(0), hitBankIndex(0),
-              altBank(0), altBankIndex(0),
-              bimodalIndex(0),
-              tagePred(false), altTaken(false),
-              condBranch(false), longestMatchPred(false),
-              pseudoNewAlloc(false), branchPC(0),
-              provider(-1)
         {
             int sz = tage.nHistoryTables + 1;
             storage = new int [sz * 5];
@@ -175,6 +172,30 @@ class TAGEBase : public SimObject
             ci = tableTags + sz;
             ct0 = ci + sz;
             ct1 = ct0 + sz;
+            BranchInfo::reset();
+        }
+
+        /**
+         * Restore the state of a new branch info, so that the object
+         * and its storage can be reused for another branch.
+         */
+        virtual void
+        reset()
+        {
+            pathHist = 0;
+            ptGhist = 0;
+            hitBank = 0;
+            hitBankIndex = 0;
+            altBank = 0;
+            altBankIndex = 0;
+            bimodalIndex = 0;
+            tagePred = false;
+            altTaken = false;
+            condBranch = false;
+            longestMatchPred = false;
+            pseudoNewAlloc = false;
+            branchPC = 0;
+            provider = -1;
         }
 
         virtual ~BranchInfo()
@@ -353,6 +374,13 @@ class TAGEBase : public SimObject
      */
     virtual void buildTageTables();
 
+    /**
+     * Allocates a tagged table aligned to a cache line, accounting its
+     * size in gtableBytes
+     * @param entries Number of entries of the table
+     */
+    TageEntry *allocTageTable(size_t entries);
+
     /**
      * Calculates the history lengths
      * and some other paramters in derived classes
@@ -419,6 +447,7 @@ class TAGEBase : public SimObject
     int getPathHist(ThreadID tid) const;
     bool isSpeculativeUpdateEnabled() const;
     size_t getSizeInBits() const;
+    size_t getHostBytes() const;
 
   protected:
     const unsigned logRatioBiModalHystEntries;
@@ -436,6 +465,8 @@ class TAGEBase : public SimObject
     std::vector<bool> btablePrediction;
     std::vector<bool> btableHysteresis;
     TageEntry **gtable;
+    /** Host memory allocated for the tagged tables, in bytes */
+    size_t gtableBytes;
 
     // Keep per-thread histories to
     // support SMT.
@@ -493,7 +524,7 @@ class TAGEBase : public SimObject
 
     struct TAGEBaseStats : public statistics::Group
     {
-        TAGEBaseStats(statistics::Group *parent, unsigned nHistoryTables);
+        TAGEBaseStats(TAGEBase &tage, unsigned nHistoryTables);
         // stats
         statistics::Scalar longestMatchProviderCorrect;
         statistics::Scalar altMatchProviderCorrect;
@@ -508,6 +539,9 @@ class TAGEBase : public SimObject
 
         statistics::Vector longestMatchProvider;
         statistics::Vector altMatchProvider;
+
+        statistics::Value storageBits;
+        statistics::Value hostBytes;
     } stats;
 };
 
@@ -0,0 +1,184 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/tage_base.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/** Exposes the tagged table layout of TAGE, it is never instantiated */
+class TageLayout : public TAGEBase
+{
+  public:
+    using TAGEBase::TageEntry;
+    using TAGEBase::tableAlignment;
+};
+
+using TageEntry = TageLayout::TageEntry;
+
+/** The tagged table entry as it was laid out before it was packed */
+struct PaddedTageEntry
+{
+    int8_t ctr;
+    uint16_t tag;
+    uint8_t u;
+    PaddedTageEntry() : ctr(0), tag(0), u(0) { }
+};
+
+template <class T>
+void
+ctrUpdate(T &ctr, bool taken, int nbits)
+{
+    if (taken) {
+        if (ctr < ((1 << (nbits - 1)) - 1))
+            ctr++;
+    } else {
+        if (ctr > -(1 << (nbits - 1)))
+            ctr--;
+    }
+}
+
+void
+unsignedCtrUpdate(uint8_t &ctr, bool up, unsigned nbits)
+{
+    if (up) {
+        if (ctr < ((1 << nbits) - 1))
+            ctr++;
+    } else {
+        if (ctr)
+            ctr--;
+    }
+}
+
+/**
+ * A single tagged table, predicting and updating its entries the way
+ * TAGE does for its longest match.
+ */
+template <class Entry>
+struct TaggedTable
+{
+    Entry *entries;
+
+    explicit TaggedTable(Entry *e) : entries(e) {}
+
+    /** @return the predicted direction, or -1 on a tag miss */
+    int
+    predict(unsigned int idx, uint16_t tag) const
+    {
+        const Entry &e = entries[idx];
+        return e.tag == tag ? e.ctr >= 0 : -1;
+    }
+
+    void
+    update(unsigned int idx, uint16_t tag, bool taken)
+    {
+        Entry &e = entries[idx];
+        if (e.tag == tag) {
+            unsignedCtrUpdate(e.u, (e.ctr >= 0) == taken, 2);
+            ctrUpdate(e.ctr, taken, 3);
+        } else if (e.u == 0) {
+            e.tag = tag;
+            e.ctr = taken ? 0 : -1;
+        } else {
+            e.u--;
+        }
+    }
+};
+
+} // anonymous namespace
+
+TEST(TageBaseTest, EntriesArePacked)
+{
+    EXPECT_EQ(sizeof(TageEntry), 4);
+    EXPECT_EQ(TageLayout::tableAlignment % sizeof(TageEntry), 0);
+
+    TageEntry e;
+    EXPECT_EQ(e.tag, 0);
+    EXPECT_EQ(e.ctr, 0);
+    EXPECT_EQ(e.u, 0);
+}
+
+TEST(TageBaseTest, TablesAreAligned)
+{
+    auto *table = new (std::align_val_t(TageLayout::tableAlignment))
+        TageEntry[1024];
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(table) %
+              TageLayout::tableAlignment, 0);
+    for (int i = 0; i < 1024; i++) {
+        ASSERT_EQ(table[i].tag, 0);
+        ASSERT_EQ(table[i].ctr, 0);
+        ASSERT_EQ(table[i].u, 0);
+    }
+    ::operator delete[](table, std::align_val_t(TageLayout::tableAlignment));
+}
+
+/**
+ * Predict and train a stream of branches on a table of packed entries and
+ * on one of the entries laid out as before, and check that they predict
+ * the same directions and end with the same entries.
+ */
+TEST(TageBaseTest, MatchesPaddedEntries)
+{
+    constexpr int log_size = 10;
+    constexpr int tag_bits = 11;
+    std::vector<TageEntry> packed_entries(1 << log_size);
+    std::vector<PaddedTageEntry> padded_entries(1 << log_size);
+    TaggedTable<TageEntry> packed(packed_entries.data());
+    TaggedTable<PaddedTageEntry> padded(padded_entries.data());
+
+    std::mt19937 rng(1);
+    uint64_t history = 0;
+    for (int n = 0; n < 200000; n++) {
+        const unsigned int pc = rng() % 4096;
+        const bool taken = ((history >> (pc % 12)) ^ pc) & 1 ||
+                           rng() % 16 == 0;
+        const unsigned int idx =
+            (pc ^ (history & ((1 << log_size) - 1))) % (1 << log_size);
+        const uint16_t tag = ((pc >> 2) ^ (history * 3)) &
+                             ((1 << tag_bits) - 1);
+
+        ASSERT_EQ(packed.predict(idx, tag), padded.predict(idx, tag))
+            << "branch " << n;
+        packed.update(idx, tag, taken);
+        padded.update(idx, tag, taken);
+        history = (history << 1) | taken;
+    }
+
+    for (int i = 0; i < (1 << log_size); i++) {
+        ASSERT_EQ(packed_entries[i].tag, padded_entries[i].tag);
+        ASSERT_EQ(packed_entries[i].ctr, padded_entries[i].ctr);
+        ASSERT_EQ(packed_entries[i].u, padded_entries[i].u);
+    }
+}
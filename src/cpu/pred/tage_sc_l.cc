@@ -125,9 +125,9 @@ TAGE_SC_L_TAGE::buildTageTables()
     // Trick! We only allocate entries for tables 1 and firstLongTagTable and
     // make the other tables point to these allocated entries
 
-    gtable[1] = new TageEntry[shortTagsTageFactor * (1 << logTagTableSize)];
+    gtable[1] = allocTageTable(shortTagsTageFactor * (1 << logTagTableSize));
     gtable[firstLongTagTable] =
-        new TageEntry[longTagsTageFactor * (1 << logTagTableSize)];
+        allocTageTable(longTagsTageFactor * (1 << logTagTableSize));
     for (int i = 2; i < firstLongTagTable; ++i) {
         gtable[i] = gtable[1];
     }
@@ -376,9 +376,8 @@ TAGE_SC_L_TAGE::extraAltCalc(TAGEBase::BranchInfo* bi)
 bool
 TAGE_SC_L::predict(ThreadID tid, Addr pc, bool cond_branch, void* &b)
 {
-    TageSCLBranchInfo *bi = new TageSCLBranchInfo(*tage,
-                                                  *statisticalCorrector,
-                                                  *loopPredictor);
+    TageSCLBranchInfo *bi = allocBranchInfo<TageSCLBranchInfo>(
+        *tage, *statisticalCorrector, *loopPredictor);
     b = (void*)(bi);
 
     bool pred_taken = tage->tagePredict(tid, pc, cond_branch,
@@ -474,8 +473,7 @@ TAGE_SC_L::update(ThreadID tid, Addr pc, bool taken, void *&bp_history,
                               inst, target);
     }
 
-    delete bi;
-    bp_history = nullptr;
+    freeBranchInfo(bp_history);
 }
 
 } // namespace branch_prediction
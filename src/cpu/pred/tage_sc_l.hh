@@ -90,6 +90,16 @@ class TAGE_SC_L_TAGE : public TAGEBase
         BranchInfo(TAGEBase &tage) : TAGEBase::BranchInfo(tage),
             lowConf(false), highConf(false), altConf(false), medConf(false)
         {}
+
+        void
+        reset() override
+        {
+            TAGEBase::BranchInfo::reset();
+            lowConf = false;
+            highConf = false;
+            altConf = false;
+            medConf = false;
+        }
         virtual ~BranchInfo()
         {}
     };
@@ -188,6 +198,13 @@ class TAGE_SC_L: public LTAGE
           : LTageBranchInfo(tage, lp), scBranchInfo(sc.makeBranchInfo())
         {}
 
+        void
+        reset() override
+        {
+            LTageBranchInfo::reset();
+            scBranchInfo->reset();
+        }
+
         virtual ~TageSCLBranchInfo()
         {
             delete scBranchInfo;
@@ -0,0 +1,249 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/trace_replay.hh"
+
+#include <memory>
+#include <string>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/Branch.hh"
+#include "proto/branch.pb.h"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/**
+ * Stands in for a recorded branch. It only carries what the branch
+ * predictors look at: the control flags and the size of the branch.
+ */
+class ReplayBranchInst : public StaticInst
+{
+  public:
+    ReplayBranchInst(BranchType type, bool cond, unsigned size)
+        : StaticInst(enums::BranchTypeStrings[type], No_OpClass)
+    {
+        flags[IsControl] = true;
+        flags[IsCall] = type == BranchType::CallDirect ||
+                        type == BranchType::CallIndirect;
+        flags[IsReturn] = type == BranchType::Return;
+        flags[IsDirectControl] = type == BranchType::CallDirect ||
+                                 type == BranchType::DirectCond ||
+                                 type == BranchType::DirectUncond;
+        flags[IsIndirectControl] = !flags[IsDirectControl];
+        flags[IsCondControl] = cond;
+        flags[IsUncondControl] = !cond;
+        StaticInst::size(size);
+    }
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        panic("Replayed branches are never executed\n");
+    }
+
+    void
+    advancePC(PCStateBase &pc) const override
+    {
+        pc.set(pc.instAddr() + size());
+    }
+
+    std::unique_ptr<PCStateBase>
+    buildRetPC(const PCStateBase &cur_pc,
+               const PCStateBase &call_pc) const override
+    {
+        std::unique_ptr<PCStateBase> ret_pc(call_pc.clone());
+        ret_pc->set(call_pc.instAddr() + size());
+        return ret_pc;
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+                        const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+TraceReplay::TraceReplay(statistics::Group *parent, const std::string &name,
+                         const std::string &filename, PredictFn predict,
+                         SquashFn squash, UpdateFn update,
+                         ThreadID num_threads, unsigned inst_size)
+    : _name(name), predictFn(predict), squashFn(squash), updateFn(update),
+      numThreads(num_threads), defaultInstSize(inst_size), trace(filename),
+      lastTarget(0), seqNum(0), stats(parent)
+{
+    fatal_if(defaultInstSize == 0, "%s: the instruction size cannot be "
+             "zero\n", name);
+
+    ProtoMessage::BranchHeader header_msg;
+    if (!trace.read(header_msg)) {
+        fatal("%s: failed to read the branch header from %s\n", name,
+              filename);
+    }
+}
+
+TraceReplay::ReplayStats::ReplayStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(insts, statistics::units::Count::get(),
+             "number of instructions retired by the recorded CPU"),
+    ADD_STAT(branches, statistics::units::Count::get(),
+             "number of branches replayed"),
+    ADD_STAT(mispredicts, statistics::units::Count::get(),
+             "number of branches mispredicted"),
+    ADD_STAT(mpki, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Count>::get(),
+             "mispredicts per thousand instructions"),
+    ADD_STAT(accuracy, statistics::units::Ratio::get(),
+             "fraction of the branches correctly predicted"),
+    ADD_STAT(condBranches, statistics::units::Count::get(),
+             "number of conditional branches replayed"),
+    ADD_STAT(condMispredicts, statistics::units::Count::get(),
+             "number of conditional branches with a mispredicted "
+             "direction"),
+    ADD_STAT(condAccuracy, statistics::units::Ratio::get(),
+             "fraction of the conditional branches with a correctly "
+             "predicted direction"),
+    ADD_STAT(takenBranches, statistics::units::Count::get(),
+             "number of taken branches replayed, returns excluded"),
+    ADD_STAT(targetMispredicts, statistics::units::Count::get(),
+             "number of taken branches predicted taken to a wrong "
+             "target, returns excluded"),
+    ADD_STAT(targetAccuracy, statistics::units::Ratio::get(),
+             "fraction of the taken branches predicted taken with a "
+             "correct target from the BTB or the indirect predictor"),
+    ADD_STAT(returns, statistics::units::Count::get(),
+             "number of returns replayed"),
+    ADD_STAT(returnMispredicts, statistics::units::Count::get(),
+             "number of returns mispredicted"),
+    ADD_STAT(returnAccuracy, statistics::units::Ratio::get(),
+             "fraction of the returns correctly predicted by the RAS")
+{
+    mpki = mispredicts * 1000 / insts;
+    accuracy = 1 - mispredicts / branches;
+    condAccuracy = 1 - condMispredicts / condBranches;
+    targetAccuracy = 1 - targetMispredicts / takenBranches;
+    returnAccuracy = 1 - returnMispredicts / returns;
+}
+
+const StaticInstPtr &
+TraceReplay::getInst(BranchType type, bool cond, unsigned size)
+{
+    const uint32_t key = (size << 5) | (cond << 4) | type;
+    auto it = insts.find(key);
+    if (it == insts.end()) {
+        it = insts.emplace(key,
+                           new ReplayBranchInst(type, cond, size)).first;
+    }
+    return it->second;
+}
+
+bool
+TraceReplay::replayNext()
+{
+    ProtoMessage::Branch branch_msg;
+    if (!trace.read(branch_msg))
+        return false;
+
+    Branch branch;
+    branch.pc = lastTarget + branch_msg.pc_delta();
+    branch.target = branch.pc + branch_msg.target_delta();
+    lastTarget = branch.target;
+
+    branch.type = BranchType(branch_msg.type());
+    fatal_if(branch.type >= enums::Num_BranchType ||
+             branch.type == BranchType::NoBranch,
+             "%s: invalid branch type %d\n", name(), branch_msg.type());
+    branch.tid = branch_msg.tid();
+    fatal_if(branch.tid >= numThreads, "%s: the trace has branches of "
+             "thread %d, but the predictor only has %d threads\n", name(),
+             branch.tid, numThreads);
+
+    branch.taken = branch_msg.taken();
+    branch.cond = branch_msg.cond() ||
+                  branch.type == BranchType::DirectCond ||
+                  branch.type == BranchType::IndirectCond;
+    const unsigned size = branch_msg.has_size() ? branch_msg.size() :
+                          defaultInstSize;
+    const StaticInstPtr &inst = getInst(branch.type, branch.cond, size);
+
+    // Predict, resolve and commit the branch before replaying the next.
+    // The next record is relative to the recorded target, not to the
+    // predicted one, so a wrong target never shifts the replay.
+    PCState pc_state(branch.pc);
+    branch.seqNum = ++seqNum;
+    branch.predTaken = predictFn(inst, seqNum, pc_state, branch.tid);
+    branch.predTarget = pc_state.instAddr();
+    branch.mispredict = branch.predTaken != branch.taken ||
+                        (branch.taken && branch.predTarget != branch.target);
+
+    DPRINTF(Branch, "Replaying %s PC:%#x -> %#x taken:%i, predicted "
+            "taken:%i -> %#x\n", toString(branch.type), branch.pc,
+            branch.target, branch.taken, branch.predTaken,
+            branch.predTarget);
+
+    if (branch.mispredict) {
+        PCState corr_target(branch.target);
+        squashFn(seqNum, corr_target, branch.taken, branch.tid);
+    }
+    updateFn(seqNum, branch.tid);
+
+    stats.insts += branch_msg.has_inst_count() ?
+                   branch_msg.inst_count() : 1;
+    stats.branches++;
+    if (branch.mispredict)
+        stats.mispredicts++;
+
+    if (branch.cond) {
+        stats.condBranches++;
+        if (branch.predTaken != branch.taken)
+            stats.condMispredicts++;
+    }
+
+    if (branch.type == BranchType::Return) {
+        stats.returns++;
+        if (branch.mispredict)
+            stats.returnMispredicts++;
+    } else if (branch.taken) {
+        stats.takenBranches++;
+        if (branch.predTaken && branch.mispredict)
+            stats.targetMispredicts++;
+    }
+
+    last = branch;
+    return true;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,191 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Replay of the records of a branch trace into a branch predictor.
+ */
+
+#ifndef __CPU_PRED_TRACE_REPLAY_HH__
+#define __CPU_PRED_TRACE_REPLAY_HH__
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "arch/generic/pcstate.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/pred/branch_type.hh"
+#include "cpu/static_inst.hh"
+#include "proto/protoio.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Replays the records of a branch trace, one at a time, into a branch
+ * predictor. The predictor is only reached through callbacks, to
+ * predict, correct and commit the branches.
+ *
+ * Every branch is predicted, corrected if it was mispredicted and
+ * committed before the next one is predicted, as if an in-order core
+ * resolved each branch before fetching past it. The recorded PCs are
+ * the truth, a branch predicted to a wrong target is a misprediction
+ * and the replay goes on from the recorded target. The instructions
+ * are stood in for by synthetic ones carrying the branch type and
+ * size, and the PCs by generic PC states, so a trace can be replayed
+ * in a build of any ISA.
+ */
+class TraceReplay
+{
+  public:
+    typedef GenericISA::SimplePCState<4> PCState;
+
+    /**
+     * Predict a branch, as BPredUnit::predict(). The PC is updated to
+     * the predicted target and the predicted direction is returned.
+     */
+    typedef std::function<bool(const StaticInstPtr &inst,
+                               InstSeqNum seq_num, PCStateBase &pc,
+                               ThreadID tid)> PredictFn;
+
+    /** Correct a mispredicted branch, as BPredUnit::squash() */
+    typedef std::function<void(InstSeqNum seq_num,
+                               const PCStateBase &corr_target,
+                               bool taken, ThreadID tid)> SquashFn;
+
+    /** Commit a branch, as BPredUnit::update() */
+    typedef std::function<void(InstSeqNum seq_num, ThreadID tid)> UpdateFn;
+
+    /** A branch replayed, as recorded and as predicted */
+    struct Branch
+    {
+        Addr pc = 0;
+        Addr target = 0;
+        BranchType type = BranchType::NoBranch;
+        bool cond = false;
+        bool taken = false;
+        ThreadID tid = 0;
+        InstSeqNum seqNum = 0;
+
+        bool predTaken = false;
+        Addr predTarget = 0;
+        bool mispredict = false;
+    };
+
+  private:
+    /** Name used in the messages, the one of the owner */
+    const std::string _name;
+
+    PredictFn predictFn;
+    SquashFn squashFn;
+    UpdateFn updateFn;
+
+    /** Number of threads of the branch predictor */
+    const ThreadID numThreads;
+
+    /** Size assumed for the instructions the trace has no size for */
+    const unsigned defaultInstSize;
+
+    ProtoInputStream trace;
+
+    /** Target of the previous record, the PCs are relative to it */
+    Addr lastTarget;
+
+    /** Sequence number of the last branch replayed */
+    InstSeqNum seqNum;
+
+    /** Synthetic instructions, by type, direction and size */
+    std::unordered_map<uint32_t, StaticInstPtr> insts;
+
+    /** The last branch replayed */
+    Branch last;
+
+    struct ReplayStats : public statistics::Group
+    {
+        ReplayStats(statistics::Group *parent);
+
+        statistics::Scalar insts;
+        statistics::Scalar branches;
+        statistics::Scalar mispredicts;
+        statistics::Formula mpki;
+        statistics::Formula accuracy;
+
+        statistics::Scalar condBranches;
+        statistics::Scalar condMispredicts;
+        statistics::Formula condAccuracy;
+
+        statistics::Scalar takenBranches;
+        statistics::Scalar targetMispredicts;
+        statistics::Formula targetAccuracy;
+
+        statistics::Scalar returns;
+        statistics::Scalar returnMispredicts;
+        statistics::Formula returnAccuracy;
+    };
+
+    /** The synthetic instruction standing in for a branch */
+    const StaticInstPtr &getInst(BranchType type, bool cond, unsigned size);
+
+  public:
+    /**
+     * Open a trace and read its header, fatal if it has none.
+     *
+     * @param parent Group the statistics of the replay are added to
+     * @param name Name used in the messages
+     * @param filename Path of the trace
+     * @param num_threads Number of threads of the branch predictor
+     * @param inst_size Size of the branches the trace has no size for
+     */
+    TraceReplay(statistics::Group *parent, const std::string &name,
+                const std::string &filename, PredictFn predict,
+                SquashFn squash, UpdateFn update, ThreadID num_threads,
+                unsigned inst_size);
+
+    const std::string &name() const { return _name; }
+
+    /**
+     * Read and replay the next record of the trace.
+     *
+     * @return False at the end of the trace, and on every call after
+     */
+    bool replayNext();
+
+    /** The last branch replayed */
+    const Branch &lastBranch() const { return last; }
+
+    ReplayStats stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif //__CPU_PRED_TRACE_REPLAY_HH__
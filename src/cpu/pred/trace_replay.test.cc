@@ -0,0 +1,310 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "base/statistics.hh"
+#include "cpu/pred/trace_replay.hh"
+#include "proto/branch.pb.h"
+#include "proto/protoio.hh"
+#include "sim/root.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace gem5
+{
+
+// statistics.cc resolves stats by name through the Root object, there is
+// none in this test
+Root *Root::_root = nullptr;
+
+// The names of the StaticInst flags and of the branch types are generated
+// with the Python bindings, which this test doesn't link
+const char *StaticInstFlags::FlagsStrings[StaticInstFlags::Num_Flags] = {};
+const char *enums::BranchTypeStrings[enums::Num_BranchType] = {
+    "NoBranch", "Return", "CallDirect", "CallIndirect", "DirectCond",
+    "DirectUncond", "IndirectCond", "IndirectUncond"
+};
+
+} // namespace gem5
+
+namespace
+{
+
+/** A branch as written to the trace, with absolute PCs */
+struct Recorded
+{
+    Addr pc;
+    Addr target;
+    BranchType type;
+    bool taken;
+    ThreadID tid = 0;
+};
+
+/**
+ * Replays traces into a scripted predictor, which predicts the branches
+ * it was given a prediction for and predicts the others not taken.
+ */
+class TraceReplayTest : public ::testing::Test
+{
+  protected:
+    statistics::Group root{nullptr};
+    std::string filename;
+
+    /** Predicted direction and target, by PC */
+    std::map<Addr, std::pair<bool, Addr>> predictions;
+
+    /** Branches predicted, as (sequence number, PC) */
+    std::vector<std::pair<InstSeqNum, Addr>> predicted;
+    /** Branches squashed, as (sequence number, target, taken) */
+    std::vector<std::tuple<InstSeqNum, Addr, bool>> squashed;
+    /** Branches committed */
+    std::vector<InstSeqNum> updated;
+
+    void
+    SetUp() override
+    {
+        filename = ::testing::TempDir() + "trace_replay_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".trc";
+    }
+
+    void TearDown() override { std::remove(filename.c_str()); }
+
+    /** Write a trace the way the recorder does, relative PCs included */
+    void
+    write(const std::vector<Recorded> &branches, bool header=true)
+    {
+        ProtoOutputStream out(filename);
+        if (header) {
+            ProtoMessage::BranchHeader header_msg;
+            header_msg.set_obj_id("test");
+            out.write(header_msg);
+        }
+        Addr last_target = 0;
+        for (const auto &branch: branches) {
+            ProtoMessage::Branch branch_msg;
+            branch_msg.set_pc_delta(branch.pc - last_target);
+            branch_msg.set_target_delta(branch.target - branch.pc);
+            branch_msg.set_type(branch.type);
+            branch_msg.set_taken(branch.taken);
+            branch_msg.set_tid(branch.tid);
+            out.write(branch_msg);
+            last_target = branch.target;
+        }
+    }
+
+    TraceReplay
+    makeReplay(ThreadID num_threads=1)
+    {
+        return TraceReplay(&root, "replay", filename,
+            [this](const StaticInstPtr &inst, InstSeqNum seq_num,
+                   PCStateBase &pc, ThreadID tid)
+            {
+                predicted.emplace_back(seq_num, pc.instAddr());
+                auto it = predictions.find(pc.instAddr());
+                if (it == predictions.end() || !it->second.first) {
+                    inst->advancePC(pc);
+                    return false;
+                }
+                pc.set(it->second.second);
+                return true;
+            },
+            [this](InstSeqNum seq_num, const PCStateBase &corr_target,
+                   bool taken, ThreadID tid)
+            {
+                squashed.emplace_back(seq_num, corr_target.instAddr(),
+                                      taken);
+            },
+            [this](InstSeqNum seq_num, ThreadID tid)
+            {
+                updated.push_back(seq_num);
+            },
+            num_threads, 4);
+    }
+};
+
+} // anonymous namespace
+
+// The branches are replayed in the order they were recorded, with their
+// recorded PCs, directions and targets
+TEST_F(TraceReplayTest, RecordedOrder)
+{
+    const std::vector<Recorded> branches = {
+        {0x1000, 0x2000, BranchType::DirectCond, true},
+        {0x2010, 0x2014, BranchType::DirectCond, false},
+        {0x2020, 0x3000, BranchType::CallDirect, true},
+        {0x3008, 0x2024, BranchType::Return, true},
+        {0x2030, 0x2034, BranchType::DirectCond, false},
+    };
+    write(branches);
+    // Predict them all correctly
+    for (const auto &branch: branches)
+        predictions[branch.pc] = {branch.taken, branch.target};
+
+    TraceReplay replay = makeReplay();
+    for (size_t i = 0; i < branches.size(); i++) {
+        ASSERT_TRUE(replay.replayNext());
+        const TraceReplay::Branch &branch = replay.lastBranch();
+        EXPECT_EQ(branch.pc, branches[i].pc);
+        EXPECT_EQ(branch.target, branches[i].target);
+        EXPECT_EQ(branch.type, branches[i].type);
+        EXPECT_EQ(branch.taken, branches[i].taken);
+        EXPECT_EQ(branch.seqNum, i + 1);
+        EXPECT_FALSE(branch.mispredict);
+
+        ASSERT_EQ(predicted.size(), i + 1);
+        EXPECT_EQ(predicted[i], std::make_pair(InstSeqNum(i + 1),
+                                               branches[i].pc));
+    }
+    EXPECT_TRUE(squashed.empty());
+    EXPECT_EQ(updated, std::vector<InstSeqNum>({1, 2, 3, 4, 5}));
+
+    EXPECT_EQ(replay.stats.branches.value(), 5);
+    EXPECT_EQ(replay.stats.mispredicts.value(), 0);
+    EXPECT_EQ(replay.stats.condBranches.value(), 3);
+    EXPECT_EQ(replay.stats.returns.value(), 1);
+}
+
+// Wrong directions and targets are mispredictions, corrected with the
+// recorded outcome
+TEST_F(TraceReplayTest, Mispredictions)
+{
+    write({
+        {0x1000, 0x1004, BranchType::DirectCond, false},
+        {0x1010, 0x2000, BranchType::DirectCond, true},
+        {0x2000, 0x3000, BranchType::IndirectUncond, true},
+    });
+    predictions[0x1000] = {true, 0x5000};
+    predictions[0x2000] = {true, 0x4000};
+
+    TraceReplay replay = makeReplay();
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(replay.replayNext());
+        EXPECT_TRUE(replay.lastBranch().mispredict);
+    }
+    EXPECT_EQ(replay.lastBranch().predTarget, 0x4000);
+
+    using Squash = std::tuple<InstSeqNum, Addr, bool>;
+    EXPECT_EQ(squashed, std::vector<Squash>({{1, 0x1004, false},
+                                             {2, 0x2000, true},
+                                             {3, 0x3000, true}}));
+    EXPECT_EQ(updated, std::vector<InstSeqNum>({1, 2, 3}));
+
+    EXPECT_EQ(replay.stats.mispredicts.value(), 3);
+    EXPECT_EQ(replay.stats.condMispredicts.value(), 2);
+    EXPECT_EQ(replay.stats.targetMispredicts.value(), 1);
+}
+
+// A branch predicted to another target than the recorded one is a
+// misprediction, and the replay goes on from the recorded target rather
+// than from the predicted one
+TEST_F(TraceReplayTest, MismatchedTarget)
+{
+    write({
+        {0x1000, 0x2000, BranchType::DirectUncond, true},
+        {0x2008, 0x3000, BranchType::DirectUncond, true},
+    });
+    predictions[0x1000] = {true, 0x4000};
+    predictions[0x2008] = {true, 0x3000};
+
+    TraceReplay replay = makeReplay();
+    ASSERT_TRUE(replay.replayNext());
+    EXPECT_TRUE(replay.lastBranch().predTaken);
+    EXPECT_EQ(replay.lastBranch().predTarget, 0x4000);
+    EXPECT_TRUE(replay.lastBranch().mispredict);
+
+    ASSERT_TRUE(replay.replayNext());
+    EXPECT_EQ(replay.lastBranch().pc, 0x2008);
+    EXPECT_FALSE(replay.lastBranch().mispredict);
+
+    using Squash = std::tuple<InstSeqNum, Addr, bool>;
+    EXPECT_EQ(squashed, std::vector<Squash>({{1, 0x2000, true}}));
+    EXPECT_EQ(replay.stats.mispredicts.value(), 1);
+    EXPECT_EQ(replay.stats.targetMispredicts.value(), 1);
+}
+
+// Running past the end of the trace replays nothing, however many times
+// it is tried
+TEST_F(TraceReplayTest, PastTheEnd)
+{
+    write({{0x1000, 0x2000, BranchType::DirectUncond, true}});
+
+    TraceReplay replay = makeReplay();
+    ASSERT_TRUE(replay.replayNext());
+    for (int i = 0; i < 3; i++)
+        EXPECT_FALSE(replay.replayNext());
+
+    EXPECT_EQ(predicted.size(), 1);
+    EXPECT_EQ(updated.size(), 1);
+    EXPECT_EQ(replay.lastBranch().seqNum, 1);
+    EXPECT_EQ(replay.stats.branches.value(), 1);
+}
+
+// An empty trace has nothing to replay
+TEST_F(TraceReplayTest, Empty)
+{
+    write({});
+
+    TraceReplay replay = makeReplay();
+    EXPECT_FALSE(replay.replayNext());
+    EXPECT_TRUE(predicted.empty());
+    EXPECT_EQ(replay.stats.branches.value(), 0);
+}
+
+// A trace without a header is rejected
+TEST_F(TraceReplayTest, NoHeader)
+{
+    write({}, false);
+
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(makeReplay());
+    EXPECT_NE(gtestLogOutput.str().find("failed to read the branch header"),
+              std::string::npos);
+}
+
+// Branches of a thread the predictor doesn't have are rejected
+TEST_F(TraceReplayTest, UnknownThread)
+{
+    Recorded branch = {0x1000, 0x2000, BranchType::DirectUncond, true};
+    branch.tid = 1;
+    write({branch});
+
+    TraceReplay replay = makeReplay(1);
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(replay.replayNext());
+    EXPECT_NE(gtestLogOutput.str().find("only has 1 threads"),
+              std::string::npos);
+    EXPECT_TRUE(predicted.empty());
+}
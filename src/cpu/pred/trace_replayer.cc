@@ -0,0 +1,79 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/trace_replayer.hh"
+
+#include "base/logging.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "params/BranchTraceReplayer.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+TraceReplayer::TraceReplayer(const BranchTraceReplayerParams &p)
+    : ClockedObject(p), bpred(p.bpred), batchSize(p.batch_size),
+      exitOnEnd(p.exit_on_end),
+      trace(this, name(), p.trace_file,
+            [this](const StaticInstPtr &inst, InstSeqNum seq_num,
+                   PCStateBase &pc, ThreadID tid)
+            { return bpred->predict(inst, seq_num, pc, tid); },
+            [this](InstSeqNum seq_num, const PCStateBase &corr_target,
+                   bool taken, ThreadID tid)
+            { bpred->squash(seq_num, corr_target, taken, tid); },
+            [this](InstSeqNum seq_num, ThreadID tid)
+            { bpred->update(seq_num, tid); },
+            p.numThreads, p.inst_size),
+      replayEvent([this]{ replay(); }, name())
+{
+    fatal_if(batchSize == 0, "%s: at least one branch must be replayed "
+             "at a time\n", name());
+}
+
+void
+TraceReplayer::startup()
+{
+    schedule(replayEvent, clockEdge());
+}
+
+void
+TraceReplayer::replay()
+{
+    for (unsigned i = 0; i < batchSize; i++) {
+        if (!trace.replayNext()) {
+            if (exitOnEnd)
+                exitSimLoop("branch trace replay complete");
+            return;
+        }
+    }
+
+    schedule(replayEvent, clockEdge(Cycles(1)));
+}
+
+} // namespace branch_prediction
+} // namespace gem5
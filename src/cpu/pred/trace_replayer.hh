@@ -0,0 +1,84 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Offline harness replaying a recorded branch trace into a branch
+ * predictor.
+ */
+
+#ifndef __CPU_PRED_TRACE_REPLAYER_HH__
+#define __CPU_PRED_TRACE_REPLAYER_HH__
+
+#include "cpu/pred/trace_replay.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+struct BranchTraceReplayerParams;
+
+namespace branch_prediction
+{
+
+class BPredUnit;
+
+/**
+ * Replays a branch trace, as recorded by a BranchTraceRecorder, into a
+ * branch predictor without simulating the CPU around it. Only the
+ * replayer schedules events, which makes it possible to sweep predictor
+ * configurations at a fraction of the cost of the simulation the trace
+ * was recorded from.
+ */
+class TraceReplayer : public ClockedObject
+{
+  private:
+    /** Branch predictor the trace is replayed into */
+    BPredUnit *bpred;
+
+    /** Number of records replayed by an event */
+    const unsigned batchSize;
+
+    /** Whether to exit the simulation loop at the end of the trace */
+    const bool exitOnEnd;
+
+    TraceReplay trace;
+
+    EventFunctionWrapper replayEvent;
+
+    /** Replay a batch of records */
+    void replay();
+
+  public:
+    TraceReplayer(const BranchTraceReplayerParams &p);
+
+    void startup() override;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif //__CPU_PRED_TRACE_REPLAYER_HH__
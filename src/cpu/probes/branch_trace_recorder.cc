@@ -0,0 +1,147 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/branch_trace_recorder.hh"
+
+#include <memory>
+
+#include "base/output.hh"
+#include "cpu/pred/branch_type.hh"
+#include "params/BranchTraceRecorder.hh"
+#include "proto/branch.pb.h"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+BranchTraceRecorder::BranchTraceRecorder(const BranchTraceRecorderParams &p)
+    : ProbeListenerObject(p),
+      traceStream(new ProtoOutputStream(simout.resolve(p.trace_file))),
+      lastTarget(0), instCount(0), stats(this)
+{
+    // The destructor is not guaranteed to run, make sure the trace is
+    // flushed on exit.
+    registerExitCallback([this]() { closeStreams(); });
+}
+
+BranchTraceRecorder::~BranchTraceRecorder()
+{
+    closeStreams();
+}
+
+void
+BranchTraceRecorder::closeStreams()
+{
+    delete traceStream;
+    traceStream = nullptr;
+}
+
+BranchTraceRecorder::RecorderStats::RecorderStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(branches, statistics::units::Count::get(),
+             "number of control instructions recorded"),
+    ADD_STAT(taken, statistics::units::Count::get(),
+             "number of taken control instructions recorded"),
+    ADD_STAT(unknownSize, statistics::units::Count::get(),
+             "number of records without an instruction size")
+{
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceRecorder, uint64_t> InstListener;
+    typedef ProbeListenerArg<BranchTraceRecorder, BaseCPU::RetiredCtrl>
+        CtrlListener;
+
+    // RetiredInsts is notified before RetiredCtrl for a control
+    // instruction, the count of a record includes the branch itself.
+    listeners.push_back(new InstListener(this, "RetiredInsts",
+                                         &BranchTraceRecorder::countInsts));
+    listeners.push_back(new CtrlListener(this, "RetiredCtrl",
+                                         &BranchTraceRecorder::record));
+}
+
+void
+BranchTraceRecorder::startup()
+{
+    ProtoMessage::BranchHeader header_msg;
+    header_msg.set_obj_id(name());
+    traceStream->write(header_msg);
+}
+
+void
+BranchTraceRecorder::record(const BaseCPU::RetiredCtrl &ctrl)
+{
+    const StaticInstPtr &inst = ctrl.inst;
+
+    // Branches between the microops of a macroop never leave it, the
+    // whole macroop is recorded once its last microop retires.
+    if (inst->isMicroop() && !inst->isLastMicroop())
+        return;
+
+    if (!traceStream)
+        return;
+
+    const Addr pc = ctrl.pc.instAddr();
+    std::unique_ptr<PCStateBase> next(ctrl.pc.clone());
+    inst->advancePC(*next);
+    const Addr target = next->instAddr();
+    const bool taken = ctrl.pc.branching();
+
+    // The fall-through PC is needed to replay calls and predicted not
+    // taken branches. Not every ISA sets the instruction size, but the
+    // PC of the next instruction gives it away for not taken branches.
+    unsigned size = 0;
+    if (inst->hasSize())
+        size = inst->size();
+    else if (!taken)
+        size = target - pc;
+    else
+        stats.unknownSize++;
+
+    ProtoMessage::Branch branch_msg;
+    branch_msg.set_pc_delta(pc - lastTarget);
+    branch_msg.set_target_delta(target - pc);
+    branch_msg.set_type(branch_prediction::getBranchType(inst));
+    branch_msg.set_taken(taken);
+    if (inst->isCondCtrl())
+        branch_msg.set_cond(true);
+    if (size)
+        branch_msg.set_size(size);
+    branch_msg.set_inst_count(instCount);
+    if (ctrl.tid)
+        branch_msg.set_tid(ctrl.tid);
+    traceStream->write(branch_msg, curTick());
+
+    lastTarget = target;
+    instCount = 0;
+
+    stats.branches++;
+    if (taken)
+        stats.taken++;
+}
+
+} // namespace gem5
@@ -0,0 +1,94 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Probe listener recording the retired control instructions of a CPU.
+ */
+
+#ifndef __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+
+#include <cstdint>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/base.hh"
+#include "proto/protoio.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+struct BranchTraceRecorderParams;
+
+/**
+ * Writes the control instructions retired by a CPU to a branch trace:
+ * their PC, the PC of the instruction retired after them, their type
+ * and whether they were taken. The instructions are observed through
+ * the RetiredCtrl probe point every CPU model notifies at commit, so
+ * the trace does not depend on the branch predictor of the CPU, if it
+ * has one. The trace can be replayed into any branch predictor
+ * configuration with a BranchTraceReplayer.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  private:
+    ProtoOutputStream *traceStream;
+
+    /** Target of the previous record, the PCs are relative to it */
+    Addr lastTarget;
+
+    /** Instructions retired since the previous record */
+    uint64_t instCount;
+
+    struct RecorderStats : public statistics::Group
+    {
+        RecorderStats(statistics::Group *parent);
+
+        statistics::Scalar branches;
+        statistics::Scalar taken;
+        statistics::Scalar unknownSize;
+    } stats;
+
+    /** Count the retired instructions */
+    void countInsts(const uint64_t &count) { instCount += count; }
+
+    /** Write a retired control instruction to the trace */
+    void record(const BaseCPU::RetiredCtrl &ctrl);
+
+    void closeStreams();
+
+  public:
+    BranchTraceRecorder(const BranchTraceRecorderParams &p);
+    ~BranchTraceRecorder();
+
+    void regProbeListeners() override;
+    void startup() override;
+};
+
+} // namespace gem5
+
+#endif //__CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
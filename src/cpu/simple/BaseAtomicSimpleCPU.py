@@ -61,6 +61,25 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    fast_functional = Param.Bool(
+        False,
+        "Execute instructions back to back within a tick event, and "
+        "reschedule the tick event after their cycles. A batch ends before "
+        "the cycle of the next event, after a data access that is not "
+        "served through a memory backdoor (i.e. that reaches the memory "
+        "system or a device, which then sees the time its batch started), "
+        "on a stall, when draining, or after fast_functional_max_insts "
+        "instructions. Used with the NonCachingSimpleCPU, plain memory "
+        "accesses go through backdoors and don't end batches. Instructions "
+        "reading the simulated time see the time of the start of their "
+        "batch. numCycles is updated once per batch, the other statistics "
+        "once per instruction.",
+    )
+    fast_functional_max_insts = Param.Unsigned(
+        4096,
+        "Maximum number of instructions executed per tick event in the "
+        "fast functional mode",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
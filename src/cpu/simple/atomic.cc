@@ -78,11 +78,21 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      fastFunctional(p.fast_functional),
+      fastFunctionalMaxInsts(p.fast_functional_max_insts),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
+    fatal_if(fastFunctional && (simulate_data_stalls || simulate_inst_stalls),
+             "%s: The fast functional mode doesn't simulate stalls.", name());
+    fatal_if(fastFunctional && numThreads > 1,
+             "%s: The fast functional mode supports a single thread.",
+             name());
+    fatal_if(fastFunctional && fastFunctionalMaxInsts == 0,
+             "%s: fast_functional_max_insts must be at least 1.", name());
+
     _status = Idle;
     ifetch_req = std::make_shared<Request>();
     data_read_req = std::make_shared<Request>();
@@ -271,6 +281,8 @@ AtomicSimpleCPU::suspendContext(ThreadID thread_num)
 Tick
 AtomicSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
+    if (&port == &dcachePort)
+        dcache_sync = true;
     return port.sendAtomic(pkt);
 }
 
@@ -397,6 +409,7 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
 
             if (req->isLocalAccess()) {
                 dcache_latency += req->localAccessor(thread->getTC(), &pkt);
+                dcache_sync = true;
             } else {
                 dcache_latency += sendPacket(dcachePort, &pkt);
             }
@@ -498,6 +511,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 if (req->isLocalAccess()) {
                     dcache_latency +=
                         req->localAccessor(thread->getTC(), &pkt);
+                    dcache_sync = true;
                 } else {
                     dcache_latency += sendPacket(dcachePort, &pkt);
 
@@ -588,6 +602,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
 
         if (req->isLocalAccess()) {
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
+            dcache_sync = true;
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
         }
@@ -625,117 +640,185 @@ AtomicSimpleCPU::tick()
         data_amo_req->setContext(cid);
     }
 
+    Tick latency = 0;
+
+    if (fastFunctional) {
+        if (!tickFastFunctional(latency))
+            return;
+    } else {
+        for (int i = 0; i < width || locked; ++i) {
+            baseStats.numCycles++;
+            updateCycleCounters(BaseCPU::CPU_STATE_ON);
+
+            if (!tickInst(latency))
+                return;
+        }
+    }
+
+    if (tryCompleteDrain())
+        return;
+
+    // instruction takes at least one cycle
+    if (latency < clockPeriod())
+        latency = clockPeriod();
+
+    if (_status != Idle)
+        reschedule(tickEvent, curTick() + latency, true);
+}
+
+bool
+AtomicSimpleCPU::tickInst(Tick &latency)
+{
     SimpleExecContext &t_info = *threadInfo[curThread];
     SimpleThread *thread = t_info.thread;
 
-    Tick latency = 0;
+    if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
+        checkForInterrupts();
+        checkPcEventQueue();
+    }
 
-    for (int i = 0; i < width || locked; ++i) {
-        baseStats.numCycles++;
-        updateCycleCounters(BaseCPU::CPU_STATE_ON);
+    // We must have just got suspended by a PC event
+    if (_status == Idle) {
+        tryCompleteDrain();
+        return false;
+    }
 
-        if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
-            checkForInterrupts();
-            checkPcEventQueue();
-        }
+    serviceInstCountEvents();
 
-        // We must have just got suspended by a PC event
-        if (_status == Idle) {
-            tryCompleteDrain();
-            return;
-        }
+    Fault fault = NoFault;
 
-        serviceInstCountEvents();
+    const PCStateBase &pc = thread->pcState();
 
-        Fault fault = NoFault;
+    bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+    if (needToFetch) {
+        ifetch_req->taskId(taskId());
+        setupFetchRequest(ifetch_req);
+        fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
+                                             BaseMMU::Execute);
+    }
 
-        const PCStateBase &pc = thread->pcState();
+    if (fault == NoFault) {
+        Tick icache_latency = 0;
+        bool icache_access = false;
+        dcache_access = false; // assume no dcache access
 
-        bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
         if (needToFetch) {
-            ifetch_req->taskId(taskId());
-            setupFetchRequest(ifetch_req);
-            fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
-                                                 BaseMMU::Execute);
+            // This is commented out because the decoder would act like
+            // a tiny cache otherwise. It wouldn't be flushed when needed
+            // like the I cache. It should be flushed, and when that works
+            // this code should be uncommented.
+            //Fetch more instruction memory if necessary
+            //if (decoder.needMoreBytes())
+            //{
+                icache_access = true;
+                icache_latency = fetchInstMem();
+            //}
         }
 
-        if (fault == NoFault) {
-            Tick icache_latency = 0;
-            bool icache_access = false;
-            dcache_access = false; // assume no dcache access
-
-            if (needToFetch) {
-                // This is commented out because the decoder would act like
-                // a tiny cache otherwise. It wouldn't be flushed when needed
-                // like the I cache. It should be flushed, and when that works
-                // this code should be uncommented.
-                //Fetch more instruction memory if necessary
-                //if (decoder.needMoreBytes())
-                //{
-                    icache_access = true;
-                    icache_latency = fetchInstMem();
-                //}
+        preExecute();
+
+        Tick stall_ticks = 0;
+        if (curStaticInst) {
+            fault = curStaticInst->execute(&t_info, traceData);
+
+            // keep an instruction count
+            if (fault == NoFault) {
+                countInst();
+                ppCommit->notify(std::make_pair(thread, curStaticInst));
+            } else if (traceData) {
+                traceFault();
             }
 
-            preExecute();
+            if (fault != NoFault &&
+                std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
+                // Retry execution of system calls after a delay.
+                // Prevents immediate re-execution since conditions which
+                // caused the retry are unlikely to change every tick.
+                stall_ticks += clockEdge(syscallRetryLatency) - curTick();
+            }
 
-            Tick stall_ticks = 0;
-            if (curStaticInst) {
-                fault = curStaticInst->execute(&t_info, traceData);
+            postExecute();
+        }
 
-                // keep an instruction count
-                if (fault == NoFault) {
-                    countInst();
-                    ppCommit->notify(std::make_pair(thread, curStaticInst));
-                } else if (traceData) {
-                    traceFault();
-                }
+        // @todo remove me after debugging with legion done
+        if (curStaticInst && (!curStaticInst->isMicroop() ||
+                    curStaticInst->isFirstMicroop())) {
+            instCnt++;
+        }
 
-                if (fault != NoFault &&
-                    std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
-                    // Retry execution of system calls after a delay.
-                    // Prevents immediate re-execution since conditions which
-                    // caused the retry are unlikely to change every tick.
-                    stall_ticks += clockEdge(syscallRetryLatency) - curTick();
-                }
+        if (simulate_inst_stalls && icache_access)
+            stall_ticks += icache_latency;
 
-                postExecute();
-            }
+        if (simulate_data_stalls && dcache_access)
+            stall_ticks += dcache_latency;
 
-            // @todo remove me after debugging with legion done
-            if (curStaticInst && (!curStaticInst->isMicroop() ||
-                        curStaticInst->isFirstMicroop())) {
-                instCnt++;
-            }
+        if (stall_ticks) {
+            // the atomic cpu does its accounting in ticks, so
+            // keep counting in ticks but round to the clock
+            // period
+            latency += divCeil(stall_ticks, clockPeriod()) *
+                clockPeriod();
+        }
 
-            if (simulate_inst_stalls && icache_access)
-                stall_ticks += icache_latency;
+    }
+    if (fault != NoFault || !t_info.stayAtPC)
+        advancePC(fault);
 
-            if (simulate_data_stalls && dcache_access)
-                stall_ticks += dcache_latency;
+    return true;
+}
 
-            if (stall_ticks) {
-                // the atomic cpu does its accounting in ticks, so
-                // keep counting in ticks but round to the clock
-                // period
-                latency += divCeil(stall_ticks, clockPeriod()) *
-                    clockPeriod();
+bool
+AtomicSimpleCPU::tickFastFunctional(Tick &latency)
+{
+    const EventQueue *eventq = eventQueue();
+    const Tick start = curTick();
+    // Ticks from the start of the batch to the cycle of the current
+    // instruction, which the tick event is rescheduled after.
+    Tick elapsed = 0;
+    Counter cycles = 0;
+    bool running = true;
+    int issued = 0;
+
+    updateCycleCounters(BaseCPU::CPU_STATE_ON);
+
+    for (unsigned n = 0; n < fastFunctionalMaxInsts || locked; ++n) {
+        if (issued >= width && !locked) {
+            // The next instruction is in the next cycle. Leave it to the
+            // next tick if an event is due by then, as the event may
+            // observe or change the state of this CPU.
+            const Tick next_cycle = start + elapsed + clockPeriod();
+            if (_status == Idle || drainState() == DrainState::Draining ||
+                (!eventq->empty() && eventq->nextTick() <= next_cycle)) {
+                break;
             }
+            elapsed += clockPeriod();
+            issued = 0;
+        }
+
+        ++issued;
+        ++cycles;
+        dcache_sync = false;
 
+        if (!tickInst(latency)) {
+            running = false;
+            break;
         }
-        if (fault != NoFault || !t_info.stayAtPC)
-            advancePC(fault);
+
+        // Stalls, like system call retries, are left to the tick event.
+        // So are the instructions after an access that the memory system
+        // or a device saw, as it may have scheduled events relative to
+        // the current time, which has to move on before they execute. A
+        // locked RMW still completes within the tick, as in tick().
+        if (latency || (dcache_sync && !locked))
+            break;
     }
 
-    if (tryCompleteDrain())
-        return;
+    baseStats.numCycles += cycles;
 
-    // instruction takes at least one cycle
-    if (latency < clockPeriod())
-        latency = clockPeriod();
+    // As in tick(), the last cycle takes at least a clock period.
+    latency = elapsed + std::max(latency, clockPeriod());
 
-    if (_status != Idle)
-        reschedule(tickEvent, curTick() + latency, true);
+    return running;
 }
 
 Tick
@@ -67,9 +67,42 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Execute up to fastFunctionalMaxInsts instructions per tick event,
+     * moving time along with them, until the next event is due.
+     */
+    const bool fastFunctional;
+    const unsigned fastFunctionalMaxInsts;
+
     // main simulation loop (one cycle)
     void tick();
 
+    /**
+     * Fetch and execute one instruction, or micro-op, of the current
+     * thread.
+     *
+     * @param latency Accumulates the stall latency of the instruction.
+     * @return false if the thread was suspended and the tick is over.
+     */
+    bool tickInst(Tick &latency);
+
+    /**
+     * Execute instructions back to back in fast functional mode, one
+     * cycle every width instructions. The batch ends before the cycle of
+     * the next event in the queue (which covers interrupts and the other
+     * CPUs), after a data access that the memory system or a device saw
+     * (see dcache_sync), when draining, on a stall or after
+     * fastFunctionalMaxInsts instructions. The cycles of the batch are
+     * accounted for in the returned latency, which the tick event is
+     * rescheduled after, so the instructions of a batch all see the
+     * simulated time of its start.
+     *
+     * @param latency Accumulates the stall latency of the last
+     * instruction, and returns the latency of the whole batch.
+     * @return false if the thread was suspended and the tick is over.
+     */
+    bool tickFastFunctional(Tick &latency);
+
     /**
      * Check if a system is in a drained state.
      *
@@ -169,6 +202,10 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     bool dcache_access;
     Tick dcache_latency;
+    /// Set when a data access went to the memory system or to a device
+    /// rather than through a memory backdoor, which ends a fast
+    /// functional batch
+    bool dcache_sync = false;
 
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread *, const StaticInstPtr>> *ppCommit;
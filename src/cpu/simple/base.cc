@@ -178,11 +178,11 @@ BaseSimpleCPU::countCommitInst()
 
     if (!curStaticInst->isMicroop() || curStaticInst->isLastMicroop()) {
         // increment thread level and core level numInsts count
-        commitStats[t_info.thread->threadId()]->numInsts++;
-        baseStats.numInsts++;
+        commitStats[t_info.thread->threadId()]->counts.numInsts++;
+        baseStats.counts.numInsts++;
     }
     // increment thread level numOps count
-    commitStats[t_info.thread->threadId()]->numOps++;
+    commitStats[t_info.thread->threadId()]->counts.numOps++;
 }
 
 Counter
@@ -433,19 +433,19 @@ BaseSimpleCPU::postExecute()
     //integer alu accesses
     if (curStaticInst->isInteger()){
         executeStats[t_info.thread->threadId()]->numIntAluAccesses++;
-        commitStats[t_info.thread->threadId()]->numIntInsts++;
+        commitStats[t_info.thread->threadId()]->counts.numIntInsts++;
     }
 
     //float alu accesses
     if (curStaticInst->isFloating()){
         executeStats[t_info.thread->threadId()]->numFpAluAccesses++;
-        commitStats[t_info.thread->threadId()]->numFpInsts++;
+        commitStats[t_info.thread->threadId()]->counts.numFpInsts++;
     }
 
     //vector alu accesses
     if (curStaticInst->isVector()){
         executeStats[t_info.thread->threadId()]->numVecAluAccesses++;
-        commitStats[t_info.thread->threadId()]->numVecInsts++;
+        commitStats[t_info.thread->threadId()]->counts.numVecInsts++;
     }
 
     //Matrix alu accesses
@@ -461,16 +461,16 @@ BaseSimpleCPU::postExecute()
 
     //result bus acceses
     if (curStaticInst->isLoad()){
-        commitStats[t_info.thread->threadId()]->numLoadInsts++;
+        commitStats[t_info.thread->threadId()]->counts.numLoadInsts++;
     }
 
     if (curStaticInst->isStore() || curStaticInst->isAtomic()){
-        commitStats[t_info.thread->threadId()]->numStoreInsts++;
+        commitStats[t_info.thread->threadId()]->counts.numStoreInsts++;
     }
     /* End power model statistics */
 
     commitStats[t_info.thread->threadId()]
-        ->committedInstType[curStaticInst->opClass()]++;
+        ->counts.committedInstType[curStaticInst->opClass()]++;
     commitStats[t_info.thread->threadId()]->updateComCtrlStats(curStaticInst);
 
     /* increment the committed numInsts and numOps stats */
@@ -486,7 +486,8 @@ BaseSimpleCPU::postExecute()
     }
 
     // Call CPU instruction commit probes
-    probeInstCommit(curStaticInst, instAddr);
+    probeInstCommit(curStaticInst, threadContexts[curThread]->pcState(),
+                    curThread);
 }
 
 void
@@ -40,6 +40,8 @@
 #include <cassert>
 
 #include "arch/generic/decoder.hh"
+#include "mem/packet.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -62,9 +64,51 @@ NonCachingSimpleCPU::verifyMemoryMode() const
     }
 }
 
+bool
+NonCachingSimpleCPU::accessDataBackdoor(const PacketPtr &pkt)
+{
+    const RequestPtr &req = pkt->req;
+
+    // Memories stop handing out backdoors while they track LL/SC
+    // reservations, but a locked RMW must still go through the crossbar.
+    if (req->isLLSC() || req->isLockedRMW())
+        return false;
+
+    bool write;
+    if (pkt->cmd == MemCmd::ReadReq) {
+        write = false;
+    } else if (pkt->cmd == MemCmd::WriteReq && system->threads.size() == 1) {
+        write = true;
+    } else {
+        return false;
+    }
+
+    auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+    if (bd_it == memBackdoors.end())
+        return false;
+
+    auto *bd = bd_it->second;
+    if (write ? !bd->writeable() : !bd->readable())
+        return false;
+
+    uint8_t *host_addr = bd->ptr() + (pkt->getAddr() - bd->range().start());
+    if (write)
+        pkt->writeData(host_addr);
+    else
+        pkt->setData(host_addr);
+    pkt->makeResponse();
+    return true;
+}
+
 Tick
 NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
+    if (&port == &dcachePort) {
+        if (fastFunctional && accessDataBackdoor(pkt))
+            return 0;
+        dcache_sync = true;
+    }
+
     MemBackdoorPtr bd = nullptr;
     Tick latency = port.sendAtomicBackdoor(pkt, bd);
 
@@ -60,6 +60,15 @@ class NonCachingSimpleCPU : public AtomicSimpleCPU
   protected:
     AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
 
+    /**
+     * Serve a data access through a memory backdoor, in fast functional
+     * mode. Only plain reads, and plain writes when no other thread in the
+     * system could snoop them, bypass the memory system.
+     *
+     * @return true if the access was served and pkt is a response.
+     */
+    bool accessDataBackdoor(const PacketPtr &pkt);
+
     Tick sendPacket(RequestPort &port, const PacketPtr &pkt) override;
     Tick fetchInstMem() override;
 };
@@ -325,6 +325,9 @@ class StaticInst : public RefCounted, public StaticInstFlags
     }
     virtual void size(size_t newSize) { _size = newSize; }
 
+    /** Whether the decoder set the size of this instruction */
+    bool hasSize() const { return _size != 0; }
+
     /**
      * Return the microop that goes with a particular micropc. This should
      * only be defined/used in macroops which will contain microops
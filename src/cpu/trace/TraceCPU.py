@@ -36,6 +36,7 @@
 from m5.objects.ClockedObject import ClockedObject
 from m5.params import *
 from m5.proxy import *
+from m5.util.pybind import *
 
 
 class TraceCPU(ClockedObject):
@@ -47,6 +48,8 @@ class TraceCPU(ClockedObject):
     cxx_header = "cpu/trace/trace_cpu.hh"
     cxx_class = "gem5::TraceCPU"
 
+    cxx_exports = [PyBindMethod("totalOps")]
+
     @classmethod
     def memory_mode(cls):
         return "timing"
@@ -75,6 +78,14 @@ class TraceCPU(ClockedObject):
         1.0, "Multiplier scale the Trace CPU frequency up or down"
     )
 
+    # Number of batches of data dependency records decoded ahead of the
+    # replay by a background thread. Decoding overlaps with the simulation
+    # and the result is identical to decoding on demand, which a value of 0
+    # selects.
+    elasticReadAhead = Param.Unsigned(
+        4, "Batches of dependency records decoded ahead in the background"
+    )
+
     # Enable exiting when any one Trace CPU completes execution which is set to
     # false by default
     enableEarlyExit = Param.Bool(
@@ -305,14 +305,15 @@ TraceCPU::ElasticDataGen::readNextWindow()
     uint32_t num_read = 0;
     while (num_read != windowSize) {
 
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
+        // Take a graph node from the pool
+        GraphNode* new_node = allocNode();
 
         // Read the next line to get the next record. If that fails then end of
         // trace has been reached and traceComplete needs to be set in addition
         // to returning false.
         if (!trace.read(new_node)) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
+            freeNode(new_node);
             traceComplete = true;
             return false;
         }
@@ -339,6 +340,28 @@ TraceCPU::ElasticDataGen::readNextWindow()
     return true;
 }
 
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::allocNode()
+{
+    if (freeNodes.empty()) {
+        nodeChunks.emplace_back(new GraphNode[nodesPerChunk]);
+        GraphNode *chunk = nodeChunks.back().get();
+        for (size_t i = nodesPerChunk; i > 0; i--)
+            freeNodes.push_back(&chunk[i - 1]);
+    }
+    GraphNode *node = freeNodes.back();
+    freeNodes.pop_back();
+    return node;
+}
+
+void
+TraceCPU::ElasticDataGen::freeNode(GraphNode *node)
+{
+    // Keep the storage of the lists, the next read overwrites the rest
+    node->dependents.clear();
+    freeNodes.push_back(node);
+}
+
 template<typename T>
 void
 TraceCPU::ElasticDataGen::addDepsOnParent(GraphNode *new_node, T& dep_list)
@@ -503,8 +526,8 @@ TraceCPU::ElasticDataGen::execute()
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
             owner.updateNumOps(node_ptr->robNum);
-            // delete node
-            delete node_ptr;
+            // return node to the pool
+            freeNode(node_ptr);
             // remove from graph
             depGraph.erase(graph_itr);
         }
@@ -711,8 +734,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         (node_ptr->dependents).clear();
         // Update the stat for numOps completed
         owner.updateNumOps(node_ptr->robNum);
-        // delete node
-        delete node_ptr;
+        // return node to the pool
+        freeNode(node_ptr);
         // remove from graph
         depGraph.erase(graph_itr);
     }
@@ -1203,10 +1226,16 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
+        const std::string& filename, const double time_multiplier,
+        unsigned read_ahead) :
     trace(filename),
     timeMultiplier(time_multiplier),
-    microOpCount(0)
+    microOpCount(0),
+    decodedOpCount(0),
+    readAhead(read_ahead),
+    current(new Batch),
+    nextRecord(0),
+    stopReading(false)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
@@ -1222,82 +1251,196 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    current->records.reserve(batchRecords);
+    for (unsigned i = 0; i < readAhead; i++) {
+        freeBatches.emplace_back(new Batch);
+        freeBatches.back()->records.reserve(batchRecords);
+    }
+    startReader();
+}
+
+TraceCPU::ElasticDataGen::InputStream::~InputStream()
+{
+    stopReader();
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::startReader()
+{
+    if (readAhead)
+        reader = std::thread(&InputStream::readBatches, this);
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::stopReader()
+{
+    if (!reader.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopReading = true;
+    }
+    cond.notify_all();
+    reader.join();
+
+    // Drop whatever was decoded ahead, the trace is about to be rewound
+    stopReading = false;
+    while (!fullBatches.empty()) {
+        freeBatches.push_back(std::move(fullBatches.front()));
+        fullBatches.pop_front();
+    }
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
+    stopReader();
     trace.reset();
+    current->records.clear();
+    current->last = false;
+    nextRecord = 0;
+    decodedOpCount = microOpCount;
+    startReader();
 }
 
-bool
-TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+void
+TraceCPU::ElasticDataGen::InputStream::decode(Batch &batch)
 {
+    batch.records.clear();
+    batch.deps.clear();
+    batch.last = false;
+
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (batch.records.size() < batchRecords) {
+        if (!trace.read(pkt_msg)) {
+            // We have reached the end of the file
+            batch.last = true;
+            return;
+        }
+
+        DecodedRecord &record = batch.records.emplace_back();
         // Required fields
-        element->seqNum = pkt_msg.seq_num();
-        element->type = pkt_msg.type();
+        record.seqNum = pkt_msg.seq_num();
+        record.type = pkt_msg.type();
         // Scale the compute delay to effectively scale the Trace CPU frequency
-        element->compDelay = pkt_msg.comp_delay() * timeMultiplier;
+        record.compDelay = pkt_msg.comp_delay() * timeMultiplier;
 
         // Repeated field robDepList
-        element->robDep.clear();
+        record.depBegin = batch.deps.size();
         for (int i = 0; i < (pkt_msg.rob_dep()).size(); i++) {
-            element->robDep.push_back(pkt_msg.rob_dep(i));
+            batch.deps.push_back(pkt_msg.rob_dep(i));
         }
+        record.numRobDeps = pkt_msg.rob_dep().size();
 
         // Repeated field
-        element->regDep.clear();
+        const auto rob_deps_end = batch.deps.size();
         for (int i = 0; i < (pkt_msg.reg_dep()).size(); i++) {
             // There is a possibility that an instruction has both, a register
             // and order dependency on an instruction. In such a case, the
             // register dependency is omitted
             bool duplicate = false;
-            for (auto &dep: element->robDep) {
-                duplicate |= (pkt_msg.reg_dep(i) == dep);
+            for (auto j = record.depBegin; j < rob_deps_end; j++) {
+                duplicate |= (pkt_msg.reg_dep(i) == batch.deps[j]);
             }
             if (!duplicate)
-                element->regDep.push_back(pkt_msg.reg_dep(i));
+                batch.deps.push_back(pkt_msg.reg_dep(i));
         }
+        record.numRegDeps = batch.deps.size() - rob_deps_end;
 
         // Optional fields
-        if (pkt_msg.has_p_addr())
-            element->physAddr = pkt_msg.p_addr();
-        else
-            element->physAddr = 0;
-
-        if (pkt_msg.has_v_addr())
-            element->virtAddr = pkt_msg.v_addr();
-        else
-            element->virtAddr = 0;
-
-        if (pkt_msg.has_size())
-            element->size = pkt_msg.size();
-        else
-            element->size = 0;
-
-        if (pkt_msg.has_flags())
-            element->flags = pkt_msg.flags();
-        else
-            element->flags = 0;
-
-        if (pkt_msg.has_pc())
-            element->pc = pkt_msg.pc();
-        else
-            element->pc = 0;
+        record.physAddr = pkt_msg.has_p_addr() ? pkt_msg.p_addr() : 0;
+        record.virtAddr = pkt_msg.has_v_addr() ? pkt_msg.v_addr() : 0;
+        record.size = pkt_msg.has_size() ? pkt_msg.size() : 0;
+        record.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+        record.pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
 
         // ROB occupancy number
-        ++microOpCount;
+        ++decodedOpCount;
         if (pkt_msg.has_weight()) {
-            microOpCount += pkt_msg.weight();
+            decodedOpCount += pkt_msg.weight();
         }
-        element->robNum = microOpCount;
-        return true;
+        record.robNum = decodedOpCount;
     }
+}
 
-    // We have reached the end of the file
-    return false;
+void
+TraceCPU::ElasticDataGen::InputStream::readBatches()
+{
+    while (true) {
+        std::unique_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] {
+                return stopReading || !freeBatches.empty();
+            });
+            if (stopReading)
+                return;
+            batch = std::move(freeBatches.back());
+            freeBatches.pop_back();
+        }
+
+        decode(*batch);
+        const bool last = batch->last;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            fullBatches.push_back(std::move(batch));
+        }
+        cond.notify_all();
+
+        if (last)
+            return;
+    }
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::nextBatch()
+{
+    nextRecord = 0;
+    if (!readAhead) {
+        decode(*current);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    freeBatches.push_back(std::move(current));
+    cond.notify_all();
+    cond.wait(lock, [this] { return !fullBatches.empty(); });
+    current = std::move(fullBatches.front());
+    fullBatches.pop_front();
+}
+
+bool
+TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+{
+    while (nextRecord == current->records.size()) {
+        // We have reached the end of the file
+        if (current->last)
+            return false;
+        nextBatch();
+    }
+
+    const DecodedRecord &record = current->records[nextRecord++];
+    element->seqNum = record.seqNum;
+    element->type = record.type;
+    element->compDelay = record.compDelay;
+
+    auto deps = current->deps.begin() + record.depBegin;
+    element->robDep.assign(deps, deps + record.numRobDeps);
+    deps += record.numRobDeps;
+    element->regDep.assign(deps, deps + record.numRegDeps);
+
+    element->physAddr = record.physAddr;
+    element->virtAddr = record.virtAddr;
+    element->size = record.size;
+    element->flags = record.flags;
+    element->pc = record.pc;
+
+    microOpCount = record.robNum;
+    element->robNum = record.robNum;
+    return true;
 }
 
 bool
@@ -38,11 +38,17 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "debug/TraceCPUData.hh"
@@ -542,11 +548,15 @@ class TraceCPU : public ClockedObject
         class GraphNode
         {
           public:
-            /** Typedef for the list containing the ROB dependencies */
-            typedef std::list<NodeSeqNum> RobDepList;
+            /**
+             * Typedef for the list containing the ROB dependencies. Nodes
+             * are pooled, so the vector keeps its storage from one node to
+             * the next and reading a node does not allocate.
+             */
+            typedef std::vector<NodeSeqNum> RobDepList;
 
             /** Typedef for the list containing the register dependencies */
-            typedef std::list<NodeSeqNum> RegDepList;
+            typedef std::vector<NodeSeqNum> RegDepList;
 
             /** Instruction sequence number */
             NodeSeqNum seqNum;
@@ -742,10 +752,47 @@ class TraceCPU : public ClockedObject
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
          * the input.
+         *
+         * Records are decoded in batches. With read ahead enabled, a
+         * background thread decodes the batches ahead of the replay and
+         * hands them over through a bounded queue, so that decompressing
+         * and parsing the trace overlaps with the simulation. The batches
+         * are recycled, so a steady state replay does not allocate.
          */
         class InputStream
         {
           private:
+            /** A decoded record, its dependencies are kept in the batch */
+            struct DecodedRecord
+            {
+                NodeSeqNum seqNum;
+                NodeRobNum robNum;
+                RecordType type;
+                uint64_t compDelay;
+                Addr physAddr;
+                Addr virtAddr;
+                uint32_t size;
+                Request::FlagsType flags;
+                Addr pc;
+                /** Index of the first dependency in the batch */
+                uint32_t depBegin;
+                uint16_t numRobDeps;
+                uint16_t numRegDeps;
+            };
+
+            /** Consecutive records decoded together */
+            struct Batch
+            {
+                std::vector<DecodedRecord> records;
+                /** Order then register dependencies of all the records */
+                std::vector<NodeSeqNum> deps;
+                /** Whether the trace ends with this batch */
+                bool last = false;
+            };
+
+            /** Number of records in a batch */
+            static constexpr size_t batchRecords = 4096;
+
             /** Input file stream for the protobuf trace */
             ProtoInputStream trace;
 
@@ -760,21 +807,56 @@ class TraceCPU : public ClockedObject
             /** Count of committed ops read from trace plus the filtered ops */
             uint64_t microOpCount;
 
+            /** Count of ops decoded, which may run ahead of microOpCount */
+            uint64_t decodedOpCount;
+
             /**
              * The window size that is read from the header of the protobuf
              * trace and used to process the dependency trace
              */
             uint32_t windowSize;
 
+            /** Number of batches decoded ahead, 0 to decode on demand */
+            const unsigned readAhead;
+
+            /** Batch being consumed and the next record in it */
+            std::unique_ptr<Batch> current;
+            size_t nextRecord;
+
+            /** Background reader and the queues shared with it */
+            std::thread reader;
+            std::mutex mutex;
+            std::condition_variable cond;
+            std::deque<std::unique_ptr<Batch>> fullBatches;
+            std::vector<std::unique_ptr<Batch>> freeBatches;
+            bool stopReading;
+
+            /** Decode the next batch of records from the trace */
+            void decode(Batch &batch);
+
+            /** Make the next decoded batch the current one */
+            void nextBatch();
+
+            /** Body of the background reader */
+            void readBatches();
+
+            void startReader();
+            void stopReader();
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param read_ahead number of batches to decode ahead in a
+             *                   background thread, 0 to decode on demand
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        unsigned read_ahead);
+
+            ~InputStream();
 
             /**
              * Reset the stream such that it can be played once
@@ -809,7 +891,8 @@ class TraceCPU : public ClockedObject
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.elasticReadAhead),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
@@ -978,6 +1061,21 @@ class TraceCPU : public ClockedObject
         /** Store the depGraph of GraphNodes */
         std::unordered_map<NodeSeqNum, GraphNode*> depGraph;
 
+        /** Number of graph nodes allocated at once by the node pool */
+        static constexpr size_t nodesPerChunk = 1024;
+
+        /** Storage of the graph nodes, which are recycled by the pool */
+        std::vector<std::unique_ptr<GraphNode[]>> nodeChunks;
+
+        /** Graph nodes not in the depGraph */
+        std::vector<GraphNode *> freeNodes;
+
+        /** Take a graph node from the pool, growing it if needed */
+        GraphNode *allocNode();
+
+        /** Return a completed graph node to the pool */
+        void freeNode(GraphNode *node);
+
         /**
          * Queue of dependency-free nodes that are pending issue because
          * resources are not available. This is chosen to be FIFO so that
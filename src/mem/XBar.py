@@ -151,9 +151,17 @@ class SnoopFilter(SimObject):
 
     system = Param.System(Parent.any, "System that the crossbar belongs to.")
 
-    # Sanity check on max capacity to track, adjust if needed.
+    # Sanity check on max capacity to track, adjust if needed. For a
+    # bounded snoop filter this is the capacity it is sized for.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # A bounded snoop filter is set associative, and back-invalidates
+    # the caches holding the lines it evicts to make room for new ones
+    bounded = Param.Bool(
+        False, "Model a set-associative, capacity-bounded snoop filter"
+    )
+    assoc = Param.Unsigned(8, "Associativity of a bounded snoop filter")
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
@@ -58,6 +58,19 @@ class HWPProbeEvent:
                 )
 
 
+class PrefetchAccessHistory(SimObject):
+    type = "PrefetchAccessHistory"
+    cxx_class = "gem5::prefetch::AccessHistory"
+    cxx_header = "mem/cache/prefetch/access_history.hh"
+
+    entries = Param.Unsigned(256, "Number of accesses kept in the history")
+    trace_file = Param.String(
+        "",
+        "If set, also write the observed accesses to this packet trace "
+        "(requires protobuf support)",
+    )
+
+
 class BasePrefetcher(ClockedObject):
     type = "BasePrefetcher"
     abstract = True
@@ -88,6 +101,11 @@ class BasePrefetcher(ClockedObject):
     page_bytes = Param.MemorySize(
         "4KiB", "Size of pages for virtual addresses"
     )
+    access_history = Param.PrefetchAccessHistory(
+        NULL,
+        "Access history of the parent cache, shared by all the prefetchers "
+        "attached to it",
+    )
 
     def __init__(self, **kwargs):
         super().__init__(**kwargs)
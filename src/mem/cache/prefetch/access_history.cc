@@ -0,0 +1,189 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/prefetch/access_history.hh"
+
+#include "base/output.hh"
+#include "config/have_protobuf.hh"
+#include "mem/cache/prefetch/base.hh"
+#include "params/PrefetchAccessHistory.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+
+#if HAVE_PROTOBUF
+#include "proto/packet.pb.h"
+#include "proto/protoio.hh"
+#endif
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+void
+AccessHistory::AccessListener::notify(const CacheAccessProbeArg &arg)
+{
+    parent.record(arg, miss);
+}
+
+AccessHistory::AccessHistory(const PrefetchAccessHistoryParams &p)
+    : SimObject(p), probeManager(nullptr), records(p.entries),
+      traceStream(nullptr), stats(this)
+{
+    fatal_if(p.entries == 0, "%s: the access history needs at least one "
+             "entry\n", name());
+
+    if (!p.trace_file.empty()) {
+#if HAVE_PROTOBUF
+        traceStream = new ProtoOutputStream(simout.resolve(p.trace_file));
+        // The destructor is not guaranteed to run, make sure the trace
+        // is flushed on exit.
+        registerExitCallback([this]() { closeStreams(); });
+#else
+        fatal("%s: tracing the access history requires protobuf support\n",
+              name());
+#endif
+    }
+}
+
+AccessHistory::~AccessHistory()
+{
+    closeStreams();
+}
+
+void
+AccessHistory::closeStreams()
+{
+#if HAVE_PROTOBUF
+    delete traceStream;
+#endif
+    traceStream = nullptr;
+}
+
+AccessHistory::AccessHistoryStats::AccessHistoryStats(
+    statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(recorded, statistics::units::Count::get(),
+             "number of accesses recorded"),
+    ADD_STAT(overwritten, statistics::units::Count::get(),
+             "number of records dropped because the history was full")
+{
+}
+
+void
+AccessHistory::setParentInfo(ProbeManager *pm)
+{
+    fatal_if(probeManager && probeManager != pm,
+             "%s: an access history can only be shared by the prefetchers "
+             "of a single cache\n", name());
+    probeManager = pm;
+}
+
+void
+AccessHistory::subscribe(Base *pf)
+{
+    readers.push_back(pf);
+}
+
+void
+AccessHistory::regProbeListeners()
+{
+    if (!probeManager || !listeners.empty())
+        return;
+
+    listeners.emplace_back(
+        new AccessListener(*this, probeManager, "Miss", true));
+    listeners.emplace_back(
+        new AccessListener(*this, probeManager, "Hit", false));
+}
+
+void
+AccessHistory::startup()
+{
+#if HAVE_PROTOBUF
+    if (traceStream) {
+        ProtoMessage::PacketHeader header_msg;
+        header_msg.set_obj_id(name());
+        header_msg.set_tick_freq(sim_clock::Frequency);
+        traceStream->write(header_msg);
+    }
+#endif
+}
+
+void
+AccessHistory::record(const CacheAccessProbeArg &acc, bool miss)
+{
+    const PacketPtr pkt = acc.pkt;
+
+    // Only keep the demand stream, this is what prefetchers train on
+    if (pkt->cmd.isSWPrefetch() || pkt->req->isCacheMaintenance() ||
+        (pkt->isWrite() && acc.cache.coalesce()) || !pkt->req->hasPaddr())
+        return;
+
+    Record rec;
+    rec.addr = pkt->req->getPaddr();
+    rec.when = curTick();
+    rec.requestorId = pkt->req->requestorId();
+    if (pkt->req->hasPC()) {
+        rec.pc = pkt->req->getPC();
+        rec.flags |= Record::HAS_PC;
+    }
+    if (miss)
+        rec.flags |= Record::MISS;
+    if (pkt->isWrite())
+        rec.flags |= Record::WRITE;
+    if (pkt->req->isInstFetch())
+        rec.flags |= Record::INST_FETCH;
+    if (pkt->isSecure())
+        rec.flags |= Record::SECURE;
+    if (acc.cache.hasBeenPrefetched(pkt->getAddr(), pkt->isSecure()))
+        rec.flags |= Record::PREFETCHED;
+
+    if (records.push(rec))
+        stats.overwritten++;
+    stats.recorded++;
+
+#if HAVE_PROTOBUF
+    if (traceStream) {
+        ProtoMessage::Packet pkt_msg;
+        pkt_msg.set_tick(rec.when);
+        pkt_msg.set_cmd(pkt->cmd.toInt());
+        pkt_msg.set_flags(pkt->req->getFlags());
+        pkt_msg.set_addr(pkt->req->getPaddr());
+        pkt_msg.set_size(pkt->req->getSize());
+        pkt_msg.set_pkt_id(rec.requestorId);
+        if (rec.hasPC())
+            pkt_msg.set_pc(rec.pc);
+        traceStream->write(pkt_msg);
+    }
+#endif
+
+    for (auto pf : readers)
+        pf->probeNotify(acc, miss);
+}
+
+} // namespace prefetch
+} // namespace gem5
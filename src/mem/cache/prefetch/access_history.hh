@@ -0,0 +1,150 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Per-cache access history shared by all the prefetchers attached to a
+ * cache.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_ACCESS_HISTORY_HH__
+#define __MEM_CACHE_PREFETCH_ACCESS_HISTORY_HH__
+
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/cache/cache_probe_arg.hh"
+#include "mem/cache/prefetch/access_ring.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+class ProtoOutputStream;
+
+namespace gem5
+{
+
+struct PrefetchAccessHistoryParams;
+class ProbeManager;
+
+namespace prefetch
+{
+
+class Base;
+
+/**
+ * Access history shared by all the prefetchers attached to a cache.
+ *
+ * Instead of having each prefetcher snoop its cache, the history is the
+ * only listener of the accesses to the cache. It records each access in
+ * an AccessRing and then notifies the prefetchers that read from it
+ * (including the sub-prefetchers of a Multi prefetcher), which can look
+ * at the recorded stream, not only at the access being notified.
+ *
+ * Optionally, the observed stream is written to a packet trace that can
+ * be replayed offline into a prefetcher by the PrefetchTraceReplayer.
+ */
+class AccessHistory : public SimObject
+{
+  public:
+    using Record = AccessRing::Record;
+
+  private:
+    class AccessListener : public ProbeListenerArgBase<CacheAccessProbeArg>
+    {
+      public:
+        AccessListener(AccessHistory &_parent, ProbeManager *pm,
+                       const std::string &name, bool _miss)
+            : ProbeListenerArgBase(pm, name), parent(_parent), miss(_miss)
+        {}
+        void notify(const CacheAccessProbeArg &arg) override;
+      protected:
+        AccessHistory &parent;
+        const bool miss;
+    };
+
+    std::vector<std::unique_ptr<AccessListener>> listeners;
+
+    /** Probe manager of the cache being observed */
+    ProbeManager *probeManager;
+
+    /** The recorded accesses */
+    AccessRing records;
+
+    /** The prefetchers notified of each recorded access */
+    std::vector<Base *> readers;
+
+    /** Optional output stream of the observed accesses */
+    ProtoOutputStream *traceStream;
+
+    struct AccessHistoryStats : public statistics::Group
+    {
+        AccessHistoryStats(statistics::Group *parent);
+
+        /** Number of accesses recorded */
+        statistics::Scalar recorded;
+        /** Number of records overwritten to make room for new ones */
+        statistics::Scalar overwritten;
+    } stats;
+
+    void closeStreams();
+
+  public:
+    AccessHistory(const PrefetchAccessHistoryParams &p);
+    ~AccessHistory();
+
+    /**
+     * Bind the history to the cache it observes. Every prefetcher
+     * sharing the history calls this, so it is idempotent as long as
+     * all of them are attached to the same cache.
+     */
+    void setParentInfo(ProbeManager *pm);
+
+    /**
+     * Notify a prefetcher of every access recorded from now on, in
+     * place of the probes it would otherwise listen to.
+     */
+    void subscribe(Base *pf);
+
+    void regProbeListeners() override;
+    void startup() override;
+
+    /**
+     * Record an access and notify the readers of the history. Called
+     * from the probe listeners, but public so that replay harnesses can
+     * feed the history directly.
+     * @param acc probe arg encapsulating the memory request
+     * @param miss whether the access missed in the cache
+     */
+    void record(const CacheAccessProbeArg &acc, bool miss);
+
+    /** The recorded accesses, the most recent being the one notified */
+    const AccessRing &ring() const { return records; }
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif //__MEM_CACHE_PREFETCH_ACCESS_HISTORY_HH__
@@ -0,0 +1,186 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Ring buffer of the accesses observed by a cache, indexed by sequence
+ * number.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_ACCESS_RING_HH__
+#define __MEM_CACHE_PREFETCH_ACCESS_RING_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "base/circular_queue.hh"
+#include "base/types.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+/**
+ * Compact ring buffer of the most recent accesses observed by a cache.
+ *
+ * Each record is tagged with a monotonically increasing sequence number,
+ * so readers can consume the accesses they have not seen yet without any
+ * per-reader state in the ring itself. Once the ring is full, every new
+ * record overwrites the oldest one.
+ */
+class AccessRing
+{
+  public:
+    /** A single access, kept as small as possible. */
+    struct Record
+    {
+        /** Physical address of the access */
+        Addr addr = 0;
+        /** PC of the instruction causing the access, if any */
+        Addr pc = 0;
+        /** Tick at which the cache observed the access */
+        Tick when = 0;
+        /** Requestor ID of the access */
+        RequestorID requestorId = 0;
+        /** Combination of the Flag bits */
+        uint8_t flags = 0;
+
+        enum Flag : uint8_t
+        {
+            MISS = 0x01,
+            WRITE = 0x02,
+            INST_FETCH = 0x04,
+            SECURE = 0x08,
+            HAS_PC = 0x10,
+            PREFETCHED = 0x20,
+        };
+
+        bool isMiss() const { return flags & MISS; }
+        bool isWrite() const { return flags & WRITE; }
+        bool isInstFetch() const { return flags & INST_FETCH; }
+        bool isSecure() const { return flags & SECURE; }
+        bool hasPC() const { return flags & HAS_PC; }
+        /** The access hit on a block brought in by a prefetch */
+        bool isPrefetched() const { return flags & PREFETCHED; }
+    };
+
+  private:
+    /** The records, indexed by sequence number */
+    CircularQueue<Record> records;
+
+  public:
+    explicit AccessRing(size_t entries) : records(entries) {}
+
+    /**
+     * Add a record after the most recent one.
+     * @param rec the record to add
+     * @return whether the oldest record was overwritten to make room
+     */
+    bool
+    push(const Record &rec)
+    {
+        const bool overwrite = records.full();
+        records.push_back(rec);
+        return overwrite;
+    }
+
+    /** Number of valid records currently held */
+    size_t size() const { return records.size(); }
+
+    /** Maximum number of records held */
+    size_t capacity() const { return records.capacity(); }
+
+    /** Sequence number of the oldest record still held */
+    uint64_t oldestSeqNum() const { return records.head(); }
+
+    /** Sequence number the next record will get */
+    uint64_t nextSeqNum() const { return records.head() + records.size(); }
+
+    /** Whether the record with the given sequence number is still held */
+    bool
+    isValid(uint64_t seq_num) const
+    {
+        return records.isValidIdx(seq_num);
+    }
+
+    /**
+     * Get a record by sequence number.
+     * @param seq_num sequence number, must satisfy isValid()
+     */
+    const Record &
+    get(uint64_t seq_num) const
+    {
+        assert(isValid(seq_num));
+        return records[seq_num];
+    }
+
+    /**
+     * Get a record by age.
+     * @param age 0 is the most recent record, must be smaller than size()
+     */
+    const Record &
+    recent(size_t age) const
+    {
+        assert(age < records.size());
+        return get(records.tail() - age);
+    }
+
+    /**
+     * Visit, oldest first, the records from a given sequence number up to
+     * (excluding) another one, and update the first to point past the last
+     * record visited. Records that have already been overwritten are
+     * skipped.
+     * @param seq_num the first sequence number not yet seen by the caller
+     * @param end the sequence number to stop at
+     * @param visit callable invoked with each record
+     */
+    template <typename Visitor>
+    void
+    forEachSince(uint64_t &seq_num, uint64_t end, Visitor &&visit) const
+    {
+        if (seq_num < oldestSeqNum())
+            seq_num = oldestSeqNum();
+        for (; seq_num < end && seq_num < nextSeqNum(); seq_num++)
+            visit(get(seq_num));
+    }
+
+    /** Visit all the records added since a given sequence number. */
+    template <typename Visitor>
+    void
+    forEachSince(uint64_t &seq_num, Visitor &&visit) const
+    {
+        forEachSince(seq_num, nextSeqNum(), std::forward<Visitor>(visit));
+    }
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif //__MEM_CACHE_PREFETCH_ACCESS_RING_HH__
@@ -0,0 +1,152 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "mem/cache/prefetch/access_ring.hh"
+
+using namespace gem5;
+using prefetch::AccessRing;
+
+namespace
+{
+
+AccessRing::Record
+makeRecord(Addr addr)
+{
+    AccessRing::Record rec;
+    rec.addr = addr;
+    rec.pc = addr + 1;
+    rec.flags = AccessRing::Record::HAS_PC;
+    return rec;
+}
+
+} // anonymous namespace
+
+/** An empty ring holds no records. */
+TEST(AccessRingTest, Empty)
+{
+    AccessRing ring(4);
+    EXPECT_EQ(ring.size(), 0);
+    EXPECT_EQ(ring.capacity(), 4);
+    EXPECT_EQ(ring.oldestSeqNum(), ring.nextSeqNum());
+    EXPECT_FALSE(ring.isValid(ring.nextSeqNum()));
+}
+
+/** Records are found by sequence number and by age. */
+TEST(AccessRingTest, SeqNumLookup)
+{
+    AccessRing ring(4);
+    const uint64_t first = ring.nextSeqNum();
+    for (Addr addr = 0; addr < 3; addr++)
+        EXPECT_FALSE(ring.push(makeRecord(addr * 0x40)));
+
+    EXPECT_EQ(ring.size(), 3);
+    EXPECT_EQ(ring.oldestSeqNum(), first);
+    EXPECT_EQ(ring.nextSeqNum(), first + 3);
+    for (uint64_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(ring.isValid(first + i));
+        EXPECT_EQ(ring.get(first + i).addr, i * 0x40);
+        EXPECT_EQ(ring.get(first + i).pc, i * 0x40 + 1);
+        EXPECT_TRUE(ring.get(first + i).hasPC());
+    }
+    EXPECT_EQ(ring.recent(0).addr, 0x80);
+    EXPECT_EQ(ring.recent(2).addr, 0x0);
+}
+
+/**
+ * Once full, a new record overwrites the oldest one, and the sequence
+ * numbers keep increasing across the wraparound.
+ */
+TEST(AccessRingTest, Wraparound)
+{
+    AccessRing ring(4);
+    const uint64_t first = ring.nextSeqNum();
+    for (Addr addr = 0; addr < 4; addr++)
+        EXPECT_FALSE(ring.push(makeRecord(addr)));
+    for (Addr addr = 4; addr < 10; addr++)
+        EXPECT_TRUE(ring.push(makeRecord(addr)));
+
+    EXPECT_EQ(ring.size(), 4);
+    EXPECT_EQ(ring.oldestSeqNum(), first + 6);
+    EXPECT_EQ(ring.nextSeqNum(), first + 10);
+    for (uint64_t i = 0; i < 6; i++)
+        EXPECT_FALSE(ring.isValid(first + i));
+    for (uint64_t i = 6; i < 10; i++) {
+        ASSERT_TRUE(ring.isValid(first + i));
+        EXPECT_EQ(ring.get(first + i).addr, i);
+    }
+    EXPECT_FALSE(ring.isValid(first + 10));
+    EXPECT_EQ(ring.recent(0).addr, 9);
+    EXPECT_EQ(ring.recent(3).addr, 6);
+}
+
+/** Readers consume the records added since they last looked. */
+TEST(AccessRingTest, ForEachSince)
+{
+    AccessRing ring(8);
+    uint64_t seq_num = ring.nextSeqNum();
+    std::vector<Addr> seen;
+    auto visit = [&seen](const AccessRing::Record &rec) {
+        seen.push_back(rec.addr);
+    };
+
+    for (Addr addr = 0; addr < 3; addr++)
+        ring.push(makeRecord(addr));
+    ring.forEachSince(seq_num, visit);
+    EXPECT_EQ(seen, std::vector<Addr>({0, 1, 2}));
+    EXPECT_EQ(seq_num, ring.nextSeqNum());
+
+    // Nothing new
+    ring.forEachSince(seq_num, visit);
+    EXPECT_EQ(seen.size(), 3);
+
+    // Stop before the most recent record
+    for (Addr addr = 3; addr < 6; addr++)
+        ring.push(makeRecord(addr));
+    seen.clear();
+    ring.forEachSince(seq_num, ring.nextSeqNum() - 1, visit);
+    EXPECT_EQ(seen, std::vector<Addr>({3, 4}));
+    EXPECT_EQ(seq_num, ring.nextSeqNum() - 1);
+}
+
+/** A reader that fell behind skips the records already overwritten. */
+TEST(AccessRingTest, ForEachSinceOverwritten)
+{
+    AccessRing ring(4);
+    uint64_t seq_num = ring.nextSeqNum();
+    for (Addr addr = 0; addr < 7; addr++)
+        ring.push(makeRecord(addr));
+
+    std::vector<Addr> seen;
+    ring.forEachSince(seq_num, [&seen](const AccessRing::Record &rec) {
+        seen.push_back(rec.addr);
+    });
+    EXPECT_EQ(seen, std::vector<Addr>({3, 4, 5, 6}));
+    EXPECT_EQ(seq_num, ring.nextSeqNum());
+}
@@ -49,6 +49,7 @@
 
 #include "base/intmath.hh"
 #include "mem/cache/base.hh"
+#include "mem/cache/prefetch/access_history.hh"
 #include "params/BasePrefetcher.hh"
 #include "sim/system.hh"
 
@@ -86,7 +87,7 @@ void
 Base::PrefetchListener::notify(const CacheAccessProbeArg &arg)
 {
     if (isFill) {
-        parent.notifyFill(arg);
+        parent.probeNotifyFill(arg);
     } else {
         parent.probeNotify(arg, miss);
     }
@@ -96,7 +97,7 @@ void
 Base::PrefetchEvictListener::notify(const EvictionInfo &info)
 {
     if (info.newData.empty())
-        parent.notifyEvict(info);
+        parent.probeNotifyEvict(info);
 }
 
 Base::Base(const BasePrefetcherParams &p)
@@ -109,6 +110,7 @@ Base::Base(const BasePrefetcherParams &p)
       prefetchOnAccess(p.prefetch_on_access),
       prefetchOnPfHit(p.prefetch_on_pf_hit),
       useVirtualAddresses(p.use_virtual_addresses),
+      accessHistory(p.access_history), historyReader(false),
       prefetchStats(this), issuedPrefetches(0),
       usefulPrefetches(0), mmu(nullptr)
 {
@@ -123,6 +125,15 @@ Base::setParentInfo(System *sys, ProbeManager *pm, unsigned blk_size)
     // If the cache has a different block size from the system's, save it
     blkSize = blk_size;
     lBlkSize = floorLog2(blkSize);
+    if (accessHistory)
+        accessHistory->setParentInfo(pm);
+}
+
+void
+Base::shareAccessHistory(AccessHistory *history)
+{
+    if (!accessHistory)
+        accessHistory = history;
 }
 
 Base::StatGroup::StatGroup(statistics::Group *parent)
@@ -142,6 +153,12 @@ Base::StatGroup::StatGroup(statistics::Group *parent)
         "accuracy of the prefetcher"),
     ADD_STAT(coverage, statistics::units::Count::get(),
     "coverage brought by this prefetcher"),
+    ADD_STAT(pfTimely, statistics::units::Count::get(),
+        "number of useful prefetches filled before their first use"),
+    ADD_STAT(timeliness, statistics::units::Ratio::get(),
+        "fraction of the useful or late prefetches that were timely"),
+    ADD_STAT(pfUseDistance, statistics::units::Tick::get(),
+        "ticks between a prefetch fill and the first use of the block"),
     ADD_STAT(pfHitInCache, statistics::units::Count::get(),
         "number of prefetches hitting in cache"),
     ADD_STAT(pfHitInMSHR, statistics::units::Count::get(),
@@ -161,6 +178,15 @@ Base::StatGroup::StatGroup(statistics::Group *parent)
     coverage.flags(total);
     coverage = pfUseful / (pfUseful + demandMshrMisses);
 
+    timeliness.flags(total);
+    // Prefetches that found the demand MSHR already allocated were
+    // issued too late to be useful
+    timeliness = pfTimely / (pfUseful + pfHitInMSHR);
+
+    pfUseDistance
+        .init(16)
+        .flags(pdf | nozero);
+
     pfLate = pfHitInCache + pfHitInMSHR + pfHitInWB;
 }
 
@@ -253,6 +279,14 @@ Base::probeNotify(const CacheAccessProbeArg &acc, bool miss)
             // This case happens when a demand hits on a prefetched line
             // that's not in the requested coherency state.
             prefetchStats.pfUsefulButMiss++;
+
+        auto distance =
+            timeliness.use(blockAddress(pkt->getAddr()), curTick());
+        if (distance) {
+            if (!miss)
+                prefetchStats.pfTimely++;
+            prefetchStats.pfUseDistance.sample(*distance);
+        }
     }
 
     // Verify this access type is observed by prefetcher
@@ -267,21 +301,49 @@ Base::probeNotify(const CacheAccessProbeArg &acc, bool miss)
     }
 }
 
+void
+Base::probeNotifyFill(const CacheAccessProbeArg &acc)
+{
+    const PacketPtr pkt = acc.pkt;
+    if (pkt->cmd == MemCmd::HardPFResp &&
+        pkt->req->requestorId() == requestorId) {
+        timeliness.fill(blockAddress(pkt->getAddr()), curTick());
+    }
+
+    notifyFill(acc);
+}
+
+void
+Base::probeNotifyEvict(const EvictionInfo &info)
+{
+    timeliness.evict(blockAddress(info.addr));
+
+    notifyEvict(info);
+}
+
 void
 Base::regProbeListeners()
 {
     /**
      * If no probes were added by the configuration scripts, connect to the
      * parent cache using the probe "Miss". Also connect to "Hit", if the
-     * cache is configured to prefetch on accesses.
+     * cache is configured to prefetch on accesses. With an access history,
+     * the history listens to both and notifies the prefetcher instead.
      */
     if (listeners.empty() && probeManager != nullptr) {
-        listeners.push_back(new PrefetchListener(*this, probeManager,
-                                                "Miss", false, true));
+        if (accessHistory) {
+            accessHistory->subscribe(this);
+            historyReader = true;
+        } else {
+            listeners.push_back(new PrefetchListener(*this, probeManager,
+                                                    "Miss", false, true));
+        }
         listeners.push_back(new PrefetchListener(*this, probeManager,
                                                  "Fill", true, false));
-        listeners.push_back(new PrefetchListener(*this, probeManager,
-                                                 "Hit", false, false));
+        if (!accessHistory) {
+            listeners.push_back(new PrefetchListener(*this, probeManager,
+                                                     "Hit", false, false));
+        }
         listeners.push_back(new PrefetchEvictListener(*this, probeManager,
                                                  "Data Update"));
     }
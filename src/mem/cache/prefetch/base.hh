@@ -53,6 +53,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/cache_probe_arg.hh"
+#include "mem/cache/prefetch/timeliness.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
@@ -69,6 +70,8 @@ class System;
 namespace prefetch
 {
 
+class AccessHistory;
+
 class Base : public ClockedObject
 {
     class PrefetchListener : public ProbeListenerArgBase<CacheAccessProbeArg>
@@ -317,6 +320,19 @@ class Base : public ClockedObject
     /** Use Virtual Addresses for prefetching */
     const bool useVirtualAddresses;
 
+    /**
+     * Access history of the parent cache, shared with other prefetchers.
+     * If set, the history notifies this prefetcher of the accesses to
+     * the cache, in place of the Hit and Miss probes.
+     */
+    AccessHistory *accessHistory;
+
+    /** Whether the access history notifies this prefetcher */
+    bool historyReader;
+
+    /** Fill tick of the prefetched blocks, to measure their timeliness */
+    TimelinessTracker timeliness;
+
     /**
      * Determine if this access should be observed
      * @param pkt The memory request causing the event
@@ -353,6 +369,15 @@ class Base : public ClockedObject
         statistics::Formula accuracy;
         statistics::Formula coverage;
 
+        /** The number of useful prefetches whose block was filled, in a
+         * usable state, before the first demand access to it. */
+        statistics::Scalar pfTimely;
+        /** Fraction of the useful or late prefetches that were timely. */
+        statistics::Formula timeliness;
+        /** Ticks between a prefetch fill and the first demand access to
+         * the prefetched block. */
+        statistics::Histogram pfUseDistance;
+
         /** The number of times a HW-prefetch hits in cache. */
         statistics::Scalar pfHitInCache;
 
@@ -383,6 +408,24 @@ class Base : public ClockedObject
     virtual void
     setParentInfo(System *sys, ProbeManager *pm, unsigned blk_size);
 
+    /**
+     * Share an access history with this prefetcher, if it does not
+     * already have one. Used by prefetchers that contain other
+     * prefetchers so that all of them read from the same history.
+     * @param history the access history of the parent cache
+     */
+    virtual void shareAccessHistory(AccessHistory *history);
+
+    /** Get the access history of the parent cache, if any */
+    AccessHistory *getAccessHistory() const { return accessHistory; }
+
+    /**
+     * Whether this prefetcher is notified of the accesses by its access
+     * history, in which case the access being notified is always the most
+     * recent record of the history.
+     */
+    bool notifiedByHistory() const { return historyReader; }
+
     /**
      * Notify prefetcher of cache access (may be any access or just
      * misses, depending on cache parameters.)
@@ -394,6 +437,20 @@ class Base : public ClockedObject
     virtual void notifyFill(const CacheAccessProbeArg &acc)
     {}
 
+    /**
+     * Process a fill notification from the ProbeListener before
+     * forwarding it to notifyFill.
+     * @param acc probe arg encapsulating the fill packet
+     */
+    void probeNotifyFill(const CacheAccessProbeArg &acc);
+
+    /**
+     * Process an eviction notification from the ProbeListener before
+     * forwarding it to notifyEvict.
+     * @param info information about the evicted block
+     */
+    void probeNotifyEvict(const EvictionInfo &info);
+
     /** Notify prefetcher of cache eviction */
     virtual void notifyEvict(const EvictionInfo &info)
     {}
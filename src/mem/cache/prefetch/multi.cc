@@ -55,8 +55,20 @@ Multi::Multi(const MultiPrefetcherParams &p)
 void
 Multi::setParentInfo(System *sys, ProbeManager *pm, unsigned blk_size)
 {
-    for (auto pf : prefetchers)
+    for (auto pf : prefetchers) {
+        // Sub-prefetchers without a history of their own train on the
+        // one of the Multi prefetcher
+        pf->shareAccessHistory(accessHistory);
         pf->setParentInfo(sys, pm, blk_size);
+    }
+}
+
+void
+Multi::shareAccessHistory(AccessHistory *history)
+{
+    Base::shareAccessHistory(history);
+    for (auto pf : prefetchers)
+        pf->shareAccessHistory(accessHistory);
 }
 
 Tick
@@ -58,6 +58,7 @@ class Multi : public Base
   public:
     void
     setParentInfo(System *sys, ProbeManager *pm, unsigned blk_size) override;
+    void shareAccessHistory(AccessHistory *history) override;
     PacketPtr getPacket() override;
     Tick nextPrefetchReadyTime() const override;
 
@@ -53,6 +53,7 @@
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/HWPrefetch.hh"
+#include "mem/cache/prefetch/access_history.hh"
 #include "mem/cache/prefetch/associative_set_impl.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "params/StridePrefetcher.hh"
@@ -85,7 +86,8 @@ Stride::Stride(const StridePrefetcherParams &p)
     useRequestorId(p.use_requestor_id),
     degree(p.degree),
     pcTableInfo(p.table_assoc, p.table_entries, p.table_indexing_policy,
-        p.table_replacement_policy)
+        p.table_replacement_policy),
+    historySeqNum(0)
 {
 }
 
@@ -116,22 +118,10 @@ Stride::allocateNewContext(int context)
     return &(insertion_result.first->second);
 }
 
-void
-Stride::calculatePrefetch(const PrefetchInfo &pfi,
-                                    std::vector<AddrPriority> &addresses,
-                                    const CacheAccessor &cache)
+bool
+Stride::train(Addr pc, Addr addr, bool is_secure, RequestorID requestor_id,
+              int &stride)
 {
-    if (!pfi.hasPC()) {
-        DPRINTF(HWPrefetch, "Ignoring request with no PC.\n");
-        return;
-    }
-
-    // Get required packet info
-    Addr pf_addr = pfi.getAddr();
-    Addr pc = pfi.getPC();
-    bool is_secure = pfi.isSecure();
-    RequestorID requestor_id = useRequestorId ? pfi.getRequestorId() : 0;
-
     // Get corresponding pc table
     PCTable* pcTable = findTable(requestor_id);
 
@@ -142,7 +132,7 @@ Stride::calculatePrefetch(const PrefetchInfo &pfi,
         pcTable->accessEntry(entry);
 
         // Hit in table
-        int new_stride = pf_addr - entry->lastAddr;
+        int new_stride = addr - entry->lastAddr;
         bool stride_match = (new_stride == entry->stride);
 
         // Adjust confidence for stride entry
@@ -157,38 +147,83 @@ Stride::calculatePrefetch(const PrefetchInfo &pfi,
         }
 
         DPRINTF(HWPrefetch, "Hit: PC %x pkt_addr %x (%s) stride %d (%s), "
-                "conf %d\n", pc, pf_addr, is_secure ? "s" : "ns",
+                "conf %d\n", pc, addr, is_secure ? "s" : "ns",
                 new_stride, stride_match ? "match" : "change",
                 (int)entry->confidence);
 
-        entry->lastAddr = pf_addr;
-
-        // Abort prefetch generation if below confidence threshold
-        if (entry->confidence.calcSaturation() < threshConf) {
-            return;
-        }
-
-        // Generate up to degree prefetches
-        for (int d = 1; d <= degree; d++) {
-            // Round strides up to atleast 1 cacheline
-            int prefetch_stride = new_stride;
-            if (abs(new_stride) < blkSize) {
-                prefetch_stride = (new_stride < 0) ? -blkSize : blkSize;
-            }
+        entry->lastAddr = addr;
+        stride = new_stride;
 
-            Addr new_addr = pf_addr + d * prefetch_stride;
-            addresses.push_back(AddrPriority(new_addr, 0));
-        }
+        return entry->confidence.calcSaturation() >= threshConf;
     } else {
         // Miss in table
-        DPRINTF(HWPrefetch, "Miss: PC %x pkt_addr %x (%s)\n", pc, pf_addr,
+        DPRINTF(HWPrefetch, "Miss: PC %x pkt_addr %x (%s)\n", pc, addr,
                 is_secure ? "s" : "ns");
 
         StrideEntry* entry = pcTable->findVictim(pc);
 
         // Insert new entry's data
-        entry->lastAddr = pf_addr;
+        entry->lastAddr = addr;
         pcTable->insertEntry(pc, is_secure, entry);
+
+        return false;
+    }
+}
+
+void
+Stride::trainFromHistory()
+{
+    const AccessRing &ring = accessHistory->ring();
+
+    // The access being notified is the most recent record
+    const uint64_t current = ring.nextSeqNum() - 1;
+    ring.forEachSince(historySeqNum, current,
+        [this](const AccessRing::Record &rec) {
+            if (!rec.hasPC())
+                return;
+            int stride;
+            train(rec.pc, rec.addr, rec.isSecure(),
+                  useRequestorId ? rec.requestorId : 0, stride);
+        });
+    historySeqNum = current + 1;
+}
+
+void
+Stride::calculatePrefetch(const PrefetchInfo &pfi,
+                                    std::vector<AddrPriority> &addresses,
+                                    const CacheAccessor &cache)
+{
+    // The history only holds physical addresses
+    if (notifiedByHistory() && !useVirtualAddresses)
+        trainFromHistory();
+
+    if (!pfi.hasPC()) {
+        DPRINTF(HWPrefetch, "Ignoring request with no PC.\n");
+        return;
+    }
+
+    // Get required packet info
+    Addr pf_addr = pfi.getAddr();
+    Addr pc = pfi.getPC();
+    bool is_secure = pfi.isSecure();
+    RequestorID requestor_id = useRequestorId ? pfi.getRequestorId() : 0;
+
+    // Abort prefetch generation if below confidence threshold
+    int stride;
+    if (!train(pc, pf_addr, is_secure, requestor_id, stride)) {
+        return;
+    }
+
+    // Generate up to degree prefetches
+    for (int d = 1; d <= degree; d++) {
+        // Round strides up to atleast 1 cacheline
+        int prefetch_stride = stride;
+        if (abs(stride) < blkSize) {
+            prefetch_stride = (stride < 0) ? -blkSize : blkSize;
+        }
+
+        Addr new_addr = pf_addr + d * prefetch_stride;
+        addresses.push_back(AddrPriority(new_addr, 0));
     }
 }
 
@@ -156,6 +156,30 @@ class Stride : public Queued
      */
     PCTable* allocateNewContext(int context);
 
+    /**
+     * Train the table entry of a PC on an access.
+     *
+     * @param pc The PC of the access.
+     * @param addr The address of the access.
+     * @param is_secure Whether the access is secure.
+     * @param requestor_id The context of the access.
+     * @param stride Set to the stride from the previous access of the PC.
+     * @return Whether the stride of the PC is confident enough to
+     *         prefetch with.
+     */
+    bool train(Addr pc, Addr addr, bool is_secure, RequestorID requestor_id,
+               int &stride);
+
+    /** Sequence number of the next access history record to train on */
+    uint64_t historySeqNum;
+
+    /**
+     * Train on the accesses recorded in the access history since the
+     * last notification, which this prefetcher was not notified of
+     * (e.g., hits when it only observes misses).
+     */
+    void trainFromHistory();
+
   public:
     Stride(const StridePrefetcherParams &p);
 
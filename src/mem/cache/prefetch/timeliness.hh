@@ -0,0 +1,94 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Tracking of the time between a prefetch fill and the first use of the
+ * prefetched block.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_TIMELINESS_HH__
+#define __MEM_CACHE_PREFETCH_TIMELINESS_HH__
+
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+/**
+ * Remembers when each prefetched block was filled until its first demand
+ * access or its eviction, to measure how timely the prefetches are.
+ */
+class TimelinessTracker
+{
+  private:
+    /** Fill tick of the prefetched blocks not used yet */
+    std::unordered_map<Addr, Tick> fillTick;
+
+  public:
+    /**
+     * A prefetch filled a block. A later fill of the same block replaces
+     * the earlier one.
+     * @param blk_addr address of the block
+     * @param when tick of the fill
+     */
+    void fill(Addr blk_addr, Tick when) { fillTick[blk_addr] = when; }
+
+    /** A block was evicted, it will not be used after its fill. */
+    void evict(Addr blk_addr) { fillTick.erase(blk_addr); }
+
+    /**
+     * A demand access used a prefetched block. Only the first use after
+     * a fill is measured.
+     * @param blk_addr address of the block
+     * @param when tick of the access
+     * @return the ticks since the fill, if the fill was seen
+     */
+    std::optional<Tick>
+    use(Addr blk_addr, Tick when)
+    {
+        auto it = fillTick.find(blk_addr);
+        if (it == fillTick.end())
+            return std::nullopt;
+        const Tick distance = when - it->second;
+        fillTick.erase(it);
+        return distance;
+    }
+
+    /** Number of filled blocks waiting for their first use */
+    size_t size() const { return fillTick.size(); }
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif //__MEM_CACHE_PREFETCH_TIMELINESS_HH__
@@ -0,0 +1,84 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/prefetch/timeliness.hh"
+
+using namespace gem5;
+using prefetch::TimelinessTracker;
+
+/** The first use of a prefetched block measures the time since its fill. */
+TEST(TimelinessTest, FirstUse)
+{
+    TimelinessTracker tracker;
+    tracker.fill(0x1000, 100);
+    EXPECT_EQ(tracker.size(), 1);
+
+    auto distance = tracker.use(0x1000, 250);
+    ASSERT_TRUE(distance.has_value());
+    EXPECT_EQ(*distance, 150);
+    EXPECT_EQ(tracker.size(), 0);
+
+    // Later uses of the block are not prefetch uses anymore
+    EXPECT_FALSE(tracker.use(0x1000, 300).has_value());
+}
+
+/** Blocks whose fill was not seen are not measured. */
+TEST(TimelinessTest, UnknownBlock)
+{
+    TimelinessTracker tracker;
+    tracker.fill(0x1000, 100);
+    EXPECT_FALSE(tracker.use(0x2000, 200).has_value());
+    EXPECT_EQ(tracker.size(), 1);
+}
+
+/** An evicted block is no longer waiting for its first use. */
+TEST(TimelinessTest, Evict)
+{
+    TimelinessTracker tracker;
+    tracker.fill(0x1000, 100);
+    tracker.fill(0x2000, 110);
+    tracker.evict(0x1000);
+    EXPECT_EQ(tracker.size(), 1);
+    EXPECT_FALSE(tracker.use(0x1000, 200).has_value());
+
+    auto distance = tracker.use(0x2000, 200);
+    ASSERT_TRUE(distance.has_value());
+    EXPECT_EQ(*distance, 90);
+}
+
+/** A block prefetched again is measured from its latest fill. */
+TEST(TimelinessTest, Refill)
+{
+    TimelinessTracker tracker;
+    tracker.fill(0x1000, 100);
+    tracker.fill(0x1000, 180);
+    EXPECT_EQ(tracker.size(), 1);
+
+    auto distance = tracker.use(0x1000, 200);
+    ASSERT_TRUE(distance.has_value());
+    EXPECT_EQ(*distance, 20);
+}
@@ -0,0 +1,287 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/prefetch/trace_replayer.hh"
+
+#include <vector>
+
+#include "base/trace.hh"
+#include "debug/HWPrefetch.hh"
+#include "mem/cache/prefetch/access_history.hh"
+#include "mem/cache/prefetch/base.hh"
+#include "params/PrefetchTraceReplayer.hh"
+#include "proto/packet.pb.h"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+TraceReplayer::TraceReplayer(const PrefetchTraceReplayerParams &p)
+    : ClockedObject(p), prefetcher(p.prefetcher), system(p.system),
+      blkSize(p.block_size), numBlocks(p.cache_size / p.block_size),
+      exitOnEnd(p.exit_on_end),
+      requestorId(p.system->getRequestorId(this)),
+      trace(p.trace_file), traceComplete(false), tickOffset(0),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(numBlocks == 0, "%s: the modelled cache must hold at least "
+             "one block\n", name());
+
+    ProtoMessage::PacketHeader header_msg;
+    if (!trace.read(header_msg)) {
+        fatal("%s: failed to read the packet header from %s\n", name(),
+              p.trace_file);
+    } else if (header_msg.tick_freq() != sim_clock::Frequency) {
+        fatal("%s: trace was recorded with a different tick frequency %d\n",
+              name(), header_msg.tick_freq());
+    }
+}
+
+TraceReplayer::ReplayerStats::ReplayerStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(demandAccesses, statistics::units::Count::get(),
+             "number of demand accesses replayed"),
+    ADD_STAT(demandMisses, statistics::units::Count::get(),
+             "number of demand accesses missing in the modelled cache"),
+    ADD_STAT(demandMissRate, statistics::units::Ratio::get(),
+             "miss rate of the demand accesses"),
+    ADD_STAT(pfFills, statistics::units::Count::get(),
+             "number of prefetches filled in the modelled cache"),
+    ADD_STAT(pfRedundant, statistics::units::Count::get(),
+             "number of prefetches for blocks already cached")
+{
+    demandMissRate = demandMisses / demandAccesses;
+}
+
+void
+TraceReplayer::init()
+{
+    ClockedObject::init();
+
+    // The replayer stands in for the cache the prefetcher is attached
+    // to. Nothing is ever notified through its probe manager, accesses
+    // are fed to the prefetcher directly.
+    prefetcher->setParentInfo(system, getProbeManager(), blkSize);
+}
+
+void
+TraceReplayer::startup()
+{
+    readNextRecord();
+    if (traceComplete) {
+        warn("%s: the trace is empty\n", name());
+        return;
+    }
+
+    // Replay the trace as if it started now
+    tickOffset = curTick() - nextRecord.tick;
+    schedule(replayEvent, curTick());
+}
+
+void
+TraceReplayer::readNextRecord()
+{
+    ProtoMessage::Packet pkt_msg;
+    if (!trace.read(pkt_msg)) {
+        traceComplete = true;
+        return;
+    }
+
+    nextRecord.tick = pkt_msg.tick();
+    nextRecord.cmd = MemCmd(pkt_msg.cmd());
+    nextRecord.addr = pkt_msg.addr();
+    nextRecord.size = pkt_msg.size();
+    nextRecord.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+    nextRecord.hasPC = pkt_msg.has_pc();
+    nextRecord.pc = nextRecord.hasPC ? pkt_msg.pc() : 0;
+}
+
+void
+TraceReplayer::replay()
+{
+    while (!traceComplete && nextRecord.tick + tickOffset <= curTick()) {
+        access(nextRecord);
+        readNextRecord();
+    }
+
+    issuePrefetches();
+
+    Tick next = prefetcher->nextPrefetchReadyTime();
+    if (!traceComplete)
+        next = std::min(next, nextRecord.tick + tickOffset);
+
+    if (next != MaxTick) {
+        schedule(replayEvent, std::max(next, curTick() + 1));
+    } else if (exitOnEnd) {
+        exitSimLoop("prefetch trace replay complete");
+    }
+}
+
+void
+TraceReplayer::access(const TraceRecord &record)
+{
+    // Only demand reads and writes train the prefetcher
+    if (!record.cmd.isRead() && !record.cmd.isWrite())
+        return;
+    if (record.cmd.isPrefetch())
+        return;
+
+    RequestPtr req = std::make_shared<Request>(
+        record.addr, record.size, record.flags, requestorId);
+    if (record.hasPC)
+        req->setPC(record.pc);
+    Packet pkt(req, record.cmd);
+    // Prefetchers may look at the data of writes and hits
+    std::vector<uint8_t> data(record.size, 0);
+    pkt.dataStatic(data.data());
+
+    const Addr blk_addr = blockAlign(record.addr);
+    const bool secure = pkt.isSecure();
+    auto it = blocks.find(blk_addr);
+    const bool miss = it == blocks.end() || it->second->secure != secure;
+
+    stats.demandAccesses++;
+    if (miss) {
+        stats.demandMisses++;
+        prefetcher->incrDemandMhsrMisses();
+    }
+
+    // A prefetcher reading from an access history is notified through it
+    const CacheAccessProbeArg acc(&pkt, *this);
+    if (prefetcher->notifiedByHistory())
+        prefetcher->getAccessHistory()->record(acc, miss);
+    else
+        prefetcher->probeNotify(acc, miss);
+
+    if (miss) {
+        insertBlock(blk_addr, secure, false, requestorId);
+    } else {
+        // Move the block to the MRU position and consume its prefetch
+        it->second->prefetched = false;
+        lruList.splice(lruList.begin(), lruList, it->second);
+    }
+}
+
+void
+TraceReplayer::issuePrefetches()
+{
+    while (prefetcher->nextPrefetchReadyTime() <= curTick()) {
+        PacketPtr pkt = prefetcher->getPacket();
+        if (!pkt)
+            break;
+
+        const Addr blk_addr = blockAlign(pkt->getAddr());
+        if (findBlock(blk_addr, pkt->isSecure())) {
+            stats.pfRedundant++;
+            prefetcher->pfHitInCache();
+        } else {
+            DPRINTF(HWPrefetch, "Replayer filling prefetch %#x\n", blk_addr);
+            stats.pfFills++;
+            insertBlock(blk_addr, pkt->isSecure(), true,
+                        pkt->req->requestorId());
+            pkt->makeResponse();
+            prefetcher->probeNotifyFill(CacheAccessProbeArg(pkt, *this));
+        }
+        delete pkt;
+    }
+}
+
+void
+TraceReplayer::insertBlock(Addr blk_addr, bool secure, bool prefetched,
+                           RequestorID requestor)
+{
+    auto it = blocks.find(blk_addr);
+    if (it != blocks.end()) {
+        // Same address in the other security space, replace it
+        lruList.erase(it->second);
+        blocks.erase(it);
+    }
+
+    if (lruList.size() == numBlocks) {
+        const Block &victim = lruList.back();
+        if (victim.prefetched)
+            prefetcher->prefetchUnused();
+        prefetcher->probeNotifyEvict(CacheDataUpdateProbeArg(
+            victim.addr, victim.secure, victim.requestorId, *this));
+        blocks.erase(victim.addr);
+        lruList.pop_back();
+    }
+
+    lruList.push_front(Block{blk_addr, secure, prefetched, requestor});
+    blocks[blk_addr] = lruList.begin();
+}
+
+const TraceReplayer::Block *
+TraceReplayer::findBlock(Addr addr, bool is_secure) const
+{
+    auto it = blocks.find(blockAlign(addr));
+    if (it == blocks.end() || it->second->secure != is_secure)
+        return nullptr;
+    return &*it->second;
+}
+
+bool
+TraceReplayer::inCache(Addr addr, bool is_secure) const
+{
+    return findBlock(addr, is_secure) != nullptr;
+}
+
+bool
+TraceReplayer::hasBeenPrefetched(Addr addr, bool is_secure) const
+{
+    const Block *blk = findBlock(addr, is_secure);
+    return blk && blk->prefetched;
+}
+
+bool
+TraceReplayer::hasBeenPrefetched(Addr addr, bool is_secure,
+                                 RequestorID requestor) const
+{
+    const Block *blk = findBlock(addr, is_secure);
+    return blk && blk->prefetched && blk->requestorId == requestor;
+}
+
+bool
+TraceReplayer::inMissQueue(Addr addr, bool is_secure) const
+{
+    // Misses are resolved instantly, nothing is ever outstanding
+    return false;
+}
+
+bool
+TraceReplayer::coalesce() const
+{
+    return false;
+}
+
+} // namespace prefetch
+} // namespace gem5
@@ -0,0 +1,181 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Offline harness replaying a recorded access stream into a prefetcher.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_TRACE_REPLAYER_HH__
+#define __MEM_CACHE_PREFETCH_TRACE_REPLAYER_HH__
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/cache_probe_arg.hh"
+#include "proto/protoio.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+struct PrefetchTraceReplayerParams;
+class System;
+
+namespace prefetch
+{
+
+class Base;
+
+/**
+ * Replays a packet trace, as recorded by an AccessHistory or a
+ * MemTraceProbe, into a prefetcher without simulating the cache
+ * hierarchy around it.
+ *
+ * The cache the prefetcher is attached to is approximated by a fully
+ * associative LRU tag array, and prefetches are assumed to be filled as
+ * soon as the prefetcher releases them. Only the replayer and the
+ * prefetcher schedule events, so a trace replays orders of magnitude
+ * faster than the full system it was recorded on, which makes it
+ * possible to iterate quickly on prefetcher configurations.
+ */
+class TraceReplayer : public ClockedObject, public CacheAccessor
+{
+  private:
+    /** A block of the modelled cache */
+    struct Block
+    {
+        Addr addr;
+        bool secure;
+        /** Brought in by a prefetch and not used yet */
+        bool prefetched;
+        RequestorID requestorId;
+    };
+
+    /** Prefetcher the trace is replayed into */
+    Base *prefetcher;
+
+    System *system;
+
+    /** Block size of the modelled cache */
+    const unsigned blkSize;
+
+    /** Number of blocks in the modelled cache */
+    const size_t numBlocks;
+
+    /** Whether to exit the simulation loop at the end of the trace */
+    const bool exitOnEnd;
+
+    /** Requestor ID used for the demand accesses */
+    const RequestorID requestorId;
+
+    /** Blocks in LRU order, most recently used first */
+    std::list<Block> lruList;
+
+    /** Look-up table of the blocks in the modelled cache */
+    std::unordered_map<Addr, std::list<Block>::iterator> blocks;
+
+    ProtoInputStream trace;
+
+    /** A decoded trace record */
+    struct TraceRecord
+    {
+        Tick tick;
+        MemCmd cmd;
+        Addr addr;
+        unsigned size;
+        Request::FlagsType flags;
+        Addr pc;
+        bool hasPC;
+    };
+
+    /** Next record to replay, valid unless the trace is complete */
+    TraceRecord nextRecord;
+
+    /** Set once all the records have been read */
+    bool traceComplete;
+
+    /** Offset between the trace ticks and the simulated ticks */
+    Tick tickOffset;
+
+    EventFunctionWrapper replayEvent;
+
+    struct ReplayerStats : public statistics::Group
+    {
+        ReplayerStats(statistics::Group *parent);
+
+        statistics::Scalar demandAccesses;
+        statistics::Scalar demandMisses;
+        statistics::Formula demandMissRate;
+        statistics::Scalar pfFills;
+        statistics::Scalar pfRedundant;
+    } stats;
+
+    /** Read the next record from the trace */
+    void readNextRecord();
+
+    /** Replay the due records and issue the ready prefetches */
+    void replay();
+
+    /** Feed a record into the prefetcher and the modelled cache */
+    void access(const TraceRecord &record);
+
+    /** Drain the prefetches the prefetcher has ready */
+    void issuePrefetches();
+
+    /** Insert a block in the modelled cache, evicting as needed */
+    void insertBlock(Addr blk_addr, bool secure, bool prefetched,
+                     RequestorID requestor);
+
+    Addr blockAlign(Addr addr) const { return addr & ~Addr(blkSize - 1); }
+
+    /** Find a block of the modelled cache, nullptr if absent */
+    const Block *findBlock(Addr addr, bool is_secure) const;
+
+  public:
+    TraceReplayer(const PrefetchTraceReplayerParams &p);
+
+    void init() override;
+    void startup() override;
+
+    /** @{ */
+    /** CacheAccessor interface, answered by the modelled cache */
+    bool inCache(Addr addr, bool is_secure) const override;
+    bool hasBeenPrefetched(Addr addr, bool is_secure) const override;
+    bool hasBeenPrefetched(Addr addr, bool is_secure,
+                           RequestorID requestor) const override;
+    bool inMissQueue(Addr addr, bool is_secure) const override;
+    bool coalesce() const override;
+    /** @} */
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif //__MEM_CACHE_PREFETCH_TRACE_REPLAYER_HH__
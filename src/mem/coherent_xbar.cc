@@ -305,6 +305,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (snoopFilter && snoop_caches) {
         // Let the snoop filter know about the success of the send operation
         snoopFilter->finishRequest(!success, addr, pkt->isSecure());
+        sendBackInvalidations(true);
     }
 
     // check if we were successful in sending the packet onwards
@@ -724,6 +725,41 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::sendBackInvalidations(bool is_timing)
+{
+    if (!snoopFilter->hasBackInvalidations())
+        return;
+
+    for (const auto &inv : snoopFilter->takeBackInvalidations()) {
+        // A cache maintenance request without a destination makes the
+        // holders write dirty data back to the next level, as an
+        // inclusive cache would on a back-invalidation
+        RequestPtr req = std::make_shared<Request>(
+            inv.addr, system->cacheLineSize(),
+            Request::CLEAN | Request::INVALIDATE, Request::wbRequestorId);
+        if (inv.isSecure)
+            req->setFlags(Request::SECURE);
+
+        Packet snoop_pkt(req, MemCmd::CleanInvalidReq);
+        snoop_pkt.setExpressSnoop();
+
+        DPRINTF(CoherentXBar, "%s: %s to %d ports\n", __func__,
+                snoop_pkt.print(), inv.ports.size());
+
+        for (const auto &p : inv.ports) {
+            if (is_timing) {
+                p->sendTimingSnoopReq(&snoop_pkt);
+            } else {
+                p->sendAtomicSnoop(&snoop_pkt);
+            }
+        }
+
+        snoops++;
+        snoopFanout.sample(inv.ports.size());
+    }
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
@@ -772,6 +808,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             // avoid situations where atomic upward snoops sneak in
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
+            sendBackInvalidations(false);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -311,6 +311,15 @@ class CoherentXBar : public BaseXBar
     bool recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id);
     void recvReqRetry(PortID mem_side_port_id);
 
+    /**
+     * Invalidate the caches holding the lines evicted from a bounded
+     * snoop filter, using clean and invalidate express snoops so that
+     * dirty lines are written back.
+     *
+     * @param is_timing Whether to send timing or atomic snoops
+     */
+    void sendBackInvalidations(bool is_timing);
+
     /**
      * Forward a timing packet to our snoopers, potentially excluding
      * one of the connected coherent requestors to avoid sending a packet
@@ -0,0 +1,420 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/paged_store.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+const char storeMagic[8] = {'g', 'e', 'm', '5', 'p', 'm', 'e', 'm'};
+const uint32_t storeVersion = 1;
+
+/** Fixed header at the start of the file */
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t size;
+    uint64_t uniquePages;
+    uint32_t pagesPerChunk;
+    uint32_t numChunks;
+    uint64_t mapOffset;
+    uint64_t mapSize;
+    uint64_t chunkTableOffset;
+};
+
+static_assert(sizeof(Header) == 64, "Unexpected padding in the header");
+
+/** Location of a compressed chunk of unique pages */
+struct ChunkEntry
+{
+    uint64_t offset;
+    /** Size in the file, equal to the size when not compressed */
+    uint32_t compressedSize;
+    uint32_t size;
+};
+
+static_assert(sizeof(ChunkEntry) == 16, "Unexpected padding in chunks");
+
+unsigned
+hostThreads(unsigned threads)
+{
+    if (threads)
+        return threads;
+    unsigned host_threads = std::thread::hardware_concurrency();
+    return host_threads ? host_threads : 1;
+}
+
+/**
+ * Call a function for every index in [0, n), spreading the calls
+ * across a number of threads, including the calling one.
+ */
+void
+parallelFor(uint64_t n, unsigned threads,
+            const std::function<void(uint64_t)> &fn)
+{
+    threads = std::min<uint64_t>(threads, n);
+    if (threads <= 1) {
+        for (uint64_t i = 0; i < n; ++i)
+            fn(i);
+        return;
+    }
+
+    std::atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < n; i = next++)
+            fn(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+}
+
+/**
+ * Hash the contents of a page.
+ *
+ * @param page Start of the page
+ * @param len Size of the page
+ * @param hash Set to the hash of the contents
+ * @return Whether the page only holds zeros
+ */
+bool
+hashPage(const uint8_t *page, size_t len, uint64_t &hash)
+{
+    uint64_t h = len;
+    uint64_t any = 0;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, page + i, sizeof(word));
+        any |= word;
+        h = (h ^ word) * 0x9e3779b97f4a7c15ULL;
+        h ^= h >> 29;
+    }
+    for (; i < len; ++i) {
+        any |= page[i];
+        h = (h ^ page[i]) * 0x9e3779b97f4a7c15ULL;
+    }
+    hash = h;
+    return any == 0;
+}
+
+bool
+readAt(int fd, void *buf, size_t len, uint64_t offset)
+{
+    uint8_t *dst = (uint8_t *)buf;
+    while (len) {
+        ssize_t bytes = pread(fd, dst, len, offset);
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes <= 0)
+            return false;
+        dst += bytes;
+        len -= bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+void
+writeOrFail(FILE *fp, const void *buf, size_t len, const std::string &path)
+{
+    fatal_if(len && fwrite(buf, len, 1, fp) != 1,
+             "Write failed on physical memory checkpoint file '%s'\n", path);
+}
+
+} // anonymous namespace
+
+PagedStore::Summary
+PagedStore::write(const std::string &path, const uint8_t *pmem,
+                  uint64_t size, unsigned threads)
+{
+    threads = hostThreads(threads);
+
+    Summary summary;
+    const uint64_t num_pages = divCeil(size, (uint64_t)pageSize);
+    summary.pages = num_pages;
+
+    auto page_len = [&](uint64_t page) {
+        return std::min<uint64_t>(pageSize, size - page * pageSize);
+    };
+
+    // hash all the pages, which also finds the zero ones
+    const uint64_t hash_block = 1024;
+    std::vector<uint64_t> hashes(num_pages);
+    std::vector<uint8_t> zero(num_pages);
+    parallelFor(divCeil(num_pages, hash_block), threads, [&](uint64_t b) {
+        const uint64_t end = std::min(num_pages, (b + 1) * hash_block);
+        for (uint64_t p = b * hash_block; p < end; ++p)
+            zero[p] = hashPage(pmem + p * pageSize, page_len(p), hashes[p]);
+    });
+
+    // map every page to a unique page, confirming the matches as
+    // different contents may hash to the same value
+    std::vector<uint64_t> page_map(num_pages, 0);
+    std::vector<uint64_t> unique;
+    std::unordered_map<uint64_t, uint64_t> by_hash;
+    for (uint64_t p = 0; p < num_pages; ++p) {
+        if (zero[p]) {
+            ++summary.zeroPages;
+            continue;
+        }
+
+        auto inserted = by_hash.emplace(hashes[p], unique.size());
+        if (!inserted.second) {
+            const uint64_t q = unique[inserted.first->second];
+            if (page_len(q) == page_len(p) &&
+                std::memcmp(pmem + q * pageSize, pmem + p * pageSize,
+                            page_len(p)) == 0) {
+                page_map[p] = inserted.first->second + 1;
+                ++summary.duplicatePages;
+                continue;
+            }
+        }
+        page_map[p] = unique.size() + 1;
+        unique.push_back(p);
+    }
+
+    FILE *fp = fopen(path.c_str(), "wb");
+    fatal_if(!fp, "Can't open physical memory checkpoint file '%s'\n", path);
+
+    Header header = {};
+    std::memcpy(header.magic, storeMagic, sizeof(storeMagic));
+    header.version = storeVersion;
+    header.pageSize = pageSize;
+    header.size = size;
+    header.uniquePages = unique.size();
+    header.pagesPerChunk = pagesPerChunk;
+    header.numChunks = divCeil(unique.size(), (uint64_t)pagesPerChunk);
+
+    // leave room for the header, written once the offsets are known
+    writeOrFail(fp, &header, sizeof(header), path);
+    uint64_t offset = sizeof(header);
+
+    // compress the chunks in batches, so that the memory used for the
+    // compressed data stays bounded, and write them in order
+    std::vector<ChunkEntry> chunks(header.numChunks);
+    const uint64_t batch = threads * 4;
+    std::vector<std::vector<uint8_t>> out(batch);
+    for (uint64_t first = 0; first < header.numChunks; first += batch) {
+        const uint64_t n = std::min<uint64_t>(batch,
+                                              header.numChunks - first);
+        parallelFor(n, threads, [&](uint64_t i) {
+            const uint64_t c = first + i;
+            const uint64_t begin = c * pagesPerChunk;
+            const uint64_t end = std::min<uint64_t>(unique.size(),
+                                                    begin + pagesPerChunk);
+
+            std::vector<uint8_t> raw((end - begin) * pageSize, 0);
+            for (uint64_t u = begin; u < end; ++u) {
+                std::memcpy(raw.data() + (u - begin) * pageSize,
+                            pmem + unique[u] * pageSize,
+                            page_len(unique[u]));
+            }
+
+            // keep the chunk as is if compressing does not pay off
+            uLongf out_len = compressBound(raw.size());
+            out[i].resize(out_len);
+            if (compress2(out[i].data(), &out_len, raw.data(), raw.size(),
+                          Z_BEST_SPEED) != Z_OK || out_len >= raw.size()) {
+                out[i].swap(raw);
+            } else {
+                out[i].resize(out_len);
+            }
+            chunks[c].size = (end - begin) * pageSize;
+            chunks[c].compressedSize = out[i].size();
+        });
+
+        for (uint64_t i = 0; i < n; ++i) {
+            chunks[first + i].offset = offset;
+            writeOrFail(fp, out[i].data(), out[i].size(), path);
+            offset += out[i].size();
+        }
+    }
+
+    // the page map is mostly made of zeros and increasing indices,
+    // and compresses well
+    uLongf map_len = compressBound(num_pages * sizeof(uint64_t));
+    std::vector<uint8_t> map_out(map_len);
+    fatal_if(compress2(map_out.data(), &map_len,
+                       (const Bytef *)page_map.data(),
+                       num_pages * sizeof(uint64_t), Z_BEST_SPEED) != Z_OK,
+             "Failed to compress the page map of '%s'\n", path);
+    header.mapOffset = offset;
+    header.mapSize = map_len;
+    writeOrFail(fp, map_out.data(), map_len, path);
+    offset += map_len;
+
+    header.chunkTableOffset = offset;
+    writeOrFail(fp, chunks.data(), chunks.size() * sizeof(ChunkEntry), path);
+    offset += chunks.size() * sizeof(ChunkEntry);
+
+    fatal_if(fseek(fp, 0, SEEK_SET) != 0,
+             "Seek failed on physical memory checkpoint file '%s'\n", path);
+    writeOrFail(fp, &header, sizeof(header), path);
+
+    fatal_if(fclose(fp) != 0,
+             "Close failed on physical memory checkpoint file '%s'\n", path);
+
+    summary.fileSize = offset;
+    return summary;
+}
+
+void
+PagedStore::read(const std::string &path, uint8_t *pmem, uint64_t size,
+                 unsigned threads)
+{
+    threads = hostThreads(threads);
+
+    int fd = open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open physical memory checkpoint file '%s'\n",
+             path);
+
+    Header header;
+    fatal_if(!readAt(fd, &header, sizeof(header), 0) ||
+             std::memcmp(header.magic, storeMagic, sizeof(storeMagic)) != 0,
+             "'%s' is not a paged physical memory checkpoint\n", path);
+    fatal_if(header.version != storeVersion,
+             "Unsupported version %d of paged memory checkpoint '%s'\n",
+             header.version, path);
+    fatal_if(header.pageSize != pageSize ||
+             header.pagesPerChunk != pagesPerChunk,
+             "Unsupported page layout in memory checkpoint '%s'\n", path);
+    fatal_if(header.size != size,
+             "Memory range size has changed! Saw %lld, expected %lld\n",
+             header.size, size);
+
+    const uint64_t num_pages = divCeil(size, (uint64_t)pageSize);
+    auto page_len = [&](uint64_t page) {
+        return std::min<uint64_t>(pageSize, size - page * pageSize);
+    };
+
+    std::vector<ChunkEntry> chunks(header.numChunks);
+    fatal_if(!readAt(fd, chunks.data(), chunks.size() * sizeof(ChunkEntry),
+                     header.chunkTableOffset),
+             "Failed to read the chunk table of '%s'\n", path);
+
+    std::vector<uint8_t> map_in(header.mapSize);
+    std::vector<uint64_t> page_map(num_pages);
+    uLongf map_len = num_pages * sizeof(uint64_t);
+    fatal_if(!readAt(fd, map_in.data(), map_in.size(), header.mapOffset) ||
+             uncompress((Bytef *)page_map.data(), &map_len, map_in.data(),
+                        map_in.size()) != Z_OK ||
+             map_len != num_pages * sizeof(uint64_t),
+             "Failed to read the page map of '%s'\n", path);
+
+    // gather the pages sharing each unique page, as offsets into a
+    // single list of destination pages
+    std::vector<uint64_t> dest_start(header.uniquePages + 1, 0);
+    for (uint64_t p = 0; p < num_pages; ++p) {
+        fatal_if(page_map[p] > header.uniquePages,
+                 "Corrupt page map in '%s'\n", path);
+        if (page_map[p])
+            ++dest_start[page_map[p]];
+    }
+    for (uint64_t u = 1; u <= header.uniquePages; ++u)
+        dest_start[u] += dest_start[u - 1];
+    std::vector<uint64_t> dests(dest_start.back());
+    std::vector<uint64_t> fill(dest_start.begin(), dest_start.end() - 1);
+    for (uint64_t p = 0; p < num_pages; ++p) {
+        if (page_map[p])
+            dests[fill[page_map[p] - 1]++] = p;
+    }
+
+    std::atomic<bool> failed(false);
+    parallelFor(header.numChunks, threads, [&](uint64_t c) {
+        const ChunkEntry &chunk = chunks[c];
+        const uint64_t begin = c * pagesPerChunk;
+        const uint64_t end = std::min<uint64_t>(header.uniquePages,
+                                                begin + pagesPerChunk);
+        if (chunk.size != (end - begin) * pageSize) {
+            failed = true;
+            return;
+        }
+
+        std::vector<uint8_t> in(chunk.compressedSize);
+        if (!readAt(fd, in.data(), in.size(), chunk.offset)) {
+            failed = true;
+            return;
+        }
+
+        std::vector<uint8_t> raw;
+        if (chunk.compressedSize == chunk.size) {
+            raw.swap(in);
+        } else {
+            raw.resize(chunk.size);
+            uLongf raw_len = chunk.size;
+            if (uncompress(raw.data(), &raw_len, in.data(), in.size()) !=
+                Z_OK || raw_len != chunk.size) {
+                failed = true;
+                return;
+            }
+        }
+
+        for (uint64_t u = begin; u < end; ++u) {
+            const uint8_t *src = raw.data() + (u - begin) * pageSize;
+            for (uint64_t d = dest_start[u]; d < dest_start[u + 1]; ++d) {
+                std::memcpy(pmem + dests[d] * pageSize, src,
+                            page_len(dests[d]));
+            }
+        }
+    });
+
+    close(fd);
+
+    fatal_if(failed, "Failed to read the pages of memory checkpoint '%s'\n",
+             path);
+}
+
+} // namespace memory
+} // namespace gem5
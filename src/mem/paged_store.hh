@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PAGED_STORE_HH__
+#define __MEM_PAGED_STORE_HH__
+
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A checkpoint format for the backing store of the physical memory,
+ * designed to make large, mostly empty or redundant, memories quick to
+ * save and restore.
+ *
+ * The store is split in pages. Pages that only contain zeros are not
+ * saved at all, and pages with identical contents are only saved once,
+ * found by hashing the contents of the pages. The unique pages are
+ * packed in chunks that are compressed independently, so that both
+ * compression and decompression run on as many host threads as
+ * requested. Since zero pages are never written on restore, the host
+ * only allocates the memory that actually holds data.
+ *
+ * The file starts with a fixed header, followed by the compressed
+ * chunks, the compressed page map, giving for each page the index of
+ * its unique page (or zero), and the table of chunks.
+ */
+class PagedStore
+{
+  public:
+    /** Size of the pages the store is split in */
+    static constexpr uint32_t pageSize = 4096;
+
+    /** Number of unique pages per compressed chunk */
+    static constexpr uint32_t pagesPerChunk = 256;
+
+    /** Summary of a saved store */
+    struct Summary
+    {
+        /** Pages in the store */
+        uint64_t pages = 0;
+        /** Pages only holding zeros */
+        uint64_t zeroPages = 0;
+        /** Pages holding the same contents as another page */
+        uint64_t duplicatePages = 0;
+        /** Size of the file */
+        uint64_t fileSize = 0;
+    };
+
+    /**
+     * Save a backing store to a file.
+     *
+     * @param path File to create
+     * @param pmem Start of the backing store
+     * @param size Size of the backing store
+     * @param threads Host threads to use, 0 for all of them
+     * @return A summary of the contents of the store
+     */
+    static Summary write(const std::string &path, const uint8_t *pmem,
+                         uint64_t size, unsigned threads);
+
+    /**
+     * Restore a backing store from a file. The backing store is
+     * assumed to be zero initialised, which is the case for freshly
+     * mapped memory.
+     *
+     * @param path File to read
+     * @param pmem Start of the backing store
+     * @param size Size of the backing store, must match the file
+     * @param threads Host threads to use, 0 for all of them
+     */
+    static void read(const std::string &path, uint8_t *pmem, uint64_t size,
+                     unsigned threads);
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_PAGED_STORE_HH__
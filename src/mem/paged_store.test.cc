@@ -0,0 +1,132 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "mem/paged_store.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+std::string
+tempStore()
+{
+    char path[] = "/tmp/paged_store.test.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT_GE(fd, 0);
+    close(fd);
+    return path;
+}
+
+/** Fill a page with a pattern depending on a seed */
+void
+fillPage(std::vector<uint8_t> &mem, uint64_t page, uint8_t seed)
+{
+    for (uint64_t i = 0; i < PagedStore::pageSize &&
+             page * PagedStore::pageSize + i < mem.size(); ++i) {
+        mem[page * PagedStore::pageSize + i] = seed + i * 7;
+    }
+}
+
+void
+roundTrip(const std::vector<uint8_t> &mem, unsigned threads,
+          PagedStore::Summary &summary)
+{
+    const std::string path = tempStore();
+    summary = PagedStore::write(path, mem.data(), mem.size(), threads);
+
+    std::vector<uint8_t> restored(mem.size(), 0);
+    PagedStore::read(path, restored.data(), restored.size(), threads);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(restored, mem);
+}
+
+} // anonymous namespace
+
+TEST(PagedStoreTest, AllZero)
+{
+    std::vector<uint8_t> mem(64 * PagedStore::pageSize, 0);
+    PagedStore::Summary summary;
+    roundTrip(mem, 1, summary);
+    EXPECT_EQ(summary.pages, 64);
+    EXPECT_EQ(summary.zeroPages, 64);
+    EXPECT_EQ(summary.duplicatePages, 0);
+}
+
+TEST(PagedStoreTest, ZeroAndDuplicatePages)
+{
+    std::vector<uint8_t> mem(1000 * PagedStore::pageSize, 0);
+    for (uint64_t p = 0; p < 1000; p += 2)
+        fillPage(mem, p, p % 10);
+
+    PagedStore::Summary summary;
+    roundTrip(mem, 4, summary);
+    EXPECT_EQ(summary.pages, 1000);
+    EXPECT_EQ(summary.zeroPages, 500);
+    EXPECT_EQ(summary.duplicatePages, 495);
+    EXPECT_LT(summary.fileSize, mem.size() / 10);
+}
+
+TEST(PagedStoreTest, ManyChunks)
+{
+    const uint64_t pages = PagedStore::pagesPerChunk * 5 + 3;
+    std::vector<uint8_t> mem(pages * PagedStore::pageSize, 0);
+    for (uint64_t p = 0; p < pages; ++p) {
+        fillPage(mem, p, p);
+        // make every page unique
+        mem[p * PagedStore::pageSize] = p;
+        mem[p * PagedStore::pageSize + 1] = p >> 8;
+    }
+
+    PagedStore::Summary summary;
+    roundTrip(mem, 3, summary);
+    EXPECT_EQ(summary.zeroPages, 0);
+    EXPECT_EQ(summary.duplicatePages, 0);
+}
+
+TEST(PagedStoreTest, PartialLastPage)
+{
+    std::vector<uint8_t> mem(3 * PagedStore::pageSize + 100, 0);
+    fillPage(mem, 0, 1);
+    fillPage(mem, 3, 1);
+
+    PagedStore::Summary summary;
+    roundTrip(mem, 2, summary);
+    EXPECT_EQ(summary.pages, 4);
+    EXPECT_EQ(summary.zeroPages, 2);
+    // the last page is shorter and cannot share the first one
+    EXPECT_EQ(summary.duplicatePages, 0);
+}
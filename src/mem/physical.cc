@@ -44,9 +44,15 @@
 #include <unistd.h>
 #include <zlib.h>
 
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -55,6 +61,8 @@
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/paged_store.hh"
+#include "params/SimObject.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -70,6 +78,23 @@
 #endif
 #endif
 
+/**
+ * Explicit huge pages are only available on Linux, and the page size
+ * is encoded in the mmap flags, so make sure the flags exist even
+ * with older headers.
+ */
+#if defined(__linux__)
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+#endif
+
 namespace gem5
 {
 
@@ -80,11 +105,43 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               HugePageMode huge_pages,
+                               const std::vector<int>& eventq_numa_nodes,
+                               CheckpointStoreFormat store_format,
+                               unsigned store_threads) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), hugePages(huge_pages),
+    eventqNumaNodes(eventq_numa_nodes), storeFormat(store_format),
+    storeThreads(store_threads)
 {
+#if !defined(__linux__)
+    fatal_if(hugePages != HugePageMode::none,
+             "Huge pages for the backing store are only supported on "
+             "Linux hosts\n");
+    fatal_if(!eventqNumaNodes.empty(),
+             "NUMA placement of the backing store is only supported on "
+             "Linux hosts\n");
+#endif
+
+    fatal_if(!sharedBackstore.empty() &&
+             (hugePages == HugePageMode::hugetlb_2MB ||
+              hugePages == HugePageMode::hugetlb_1GB),
+             "Explicit huge pages cannot be used with a shared backing "
+             "store, use transparent huge pages instead\n");
+
+    // huge pages are allocated in full, so the mapping granularity
+    // changes accordingly
+    if (hugePages == HugePageMode::hugetlb_2MB ||
+        hugePages == HugePageMode::transparent) {
+        hugePageSize = 2 * 1024 * 1024;
+    } else if (hugePages == HugePageMode::hugetlb_1GB) {
+        hugePageSize = 1024 * 1024 * 1024;
+    } else {
+        hugePageSize = pageSize;
+    }
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -238,16 +295,69 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
+    // huge pages are allocated in full, so round anonymous mappings
+    // up, shared ones are laid out in the backing file at page
+    // granularity
+    size_t map_size = shm_fd == -1 ?
+        roundUp(range.size(), hugePageSize) : range.size();
+
+    const bool use_hugetlb = hugePages == HugePageMode::hugetlb_2MB ||
+        hugePages == HugePageMode::hugetlb_1GB;
+#if defined(__linux__)
+    if (hugePages == HugePageMode::hugetlb_2MB) {
+        map_flags |= MAP_HUGETLB | MAP_HUGE_2MB;
+    } else if (hugePages == HugePageMode::hugetlb_1GB) {
+        map_flags |= MAP_HUGETLB | MAP_HUGE_1GB;
+    }
+#endif
+
+    // transparent huge pages are only used for aligned regions, so
+    // over-allocate anonymous memory and trim it to an aligned window
+    const bool align_thp = hugePages == HugePageMode::transparent &&
+        shm_fd == -1;
+    const size_t mmap_size = align_thp ? map_size + hugePageSize : map_size;
+
+    uint8_t* pmem = (uint8_t*) mmap(NULL, mmap_size,
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, map_offset);
 
     if (pmem == (uint8_t*) MAP_FAILED) {
         perror("mmap");
+        fatal_if(use_hugetlb,
+                 "Could not mmap %d bytes of huge pages for range %s, "
+                 "check the huge page pool of the host\n", map_size,
+                 range.to_string());
         fatal("Could not mmap %d bytes for range %s!\n", range.size(),
               range.to_string());
     }
 
+    if (align_thp) {
+        uint8_t* aligned = (uint8_t*) roundUp((uintptr_t) pmem,
+                                              hugePageSize);
+        if (aligned != pmem)
+            munmap(pmem, aligned - pmem);
+        uint8_t* end = aligned + map_size;
+        uint8_t* mmap_end = pmem + mmap_size;
+        if (end != mmap_end)
+            munmap(end, mmap_end - end);
+        pmem = aligned;
+    }
+
+#if defined(__linux__)
+    if (hugePages == HugePageMode::transparent &&
+        madvise(pmem, map_size, MADV_HUGEPAGE) != 0) {
+        warn("Transparent huge pages not available for range %s: %s\n",
+             range.to_string(), strerror(errno));
+    }
+#endif
+
+    // the NUMA policy has to be in place before the memory is touched
+    int node = numaNode(_memories);
+    if (node >= 0)
+        bindToNumaNode(pmem, map_size, node);
+
+    mappings.emplace_back(pmem, map_size);
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
@@ -265,8 +375,45 @@ PhysicalMemory::createBackingStore(
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
-    for (auto& s : backingStore)
-        munmap((char*)s.pmem, s.range.size());
+    for (auto& m : mappings)
+        munmap((char*)m.first, m.second);
+}
+
+int
+PhysicalMemory::numaNode(const std::vector<AbstractMemory*>& _memories) const
+{
+    if (eventqNumaNodes.empty())
+        return -1;
+    if (eventqNumaNodes.size() == 1)
+        return eventqNumaNodes.front();
+
+    // the memories sharing a backing store are expected to be served
+    // by the same event queue, use the first one
+    uint32_t eventq_index = _memories.front()->params().eventq_index;
+    fatal_if(eventq_index >= eventqNumaNodes.size(),
+             "No host NUMA node given for event queue %d of %s\n",
+             eventq_index, _memories.front()->name());
+    return eventqNumaNodes[eventq_index];
+}
+
+void
+PhysicalMemory::bindToNumaNode(uint8_t* pmem, size_t len, int node) const
+{
+#if defined(__linux__)
+    const unsigned long bits = sizeof(unsigned long) * CHAR_BIT;
+    fatal_if(node < 0, "Invalid host NUMA node %d\n", node);
+    std::vector<unsigned long> node_mask(node / bits + 1, 0);
+    node_mask[node / bits] = 1UL << (node % bits);
+
+    DPRINTF(AddrRanges, "Binding %d bytes of backing store to host NUMA "
+            "node %d\n", len, node);
+
+    if (syscall(SYS_mbind, pmem, len, MPOL_BIND, node_mask.data(),
+                node_mask.size() * bits + 1, 0) != 0) {
+        warn("Could not bind backing store to host NUMA node %d: %s\n",
+             node, strerror(errno));
+    }
+#endif
 }
 
 bool
@@ -365,8 +512,9 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 {
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
-    std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+    const bool paged = storeFormat == CheckpointStoreFormat::paged;
+    std::string filename = name() + ".store" + std::to_string(store_id) +
+        (paged ? ".pstore" : ".pmem");
     long range_size = range.size();
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
@@ -376,6 +524,19 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
 
+    if (paged) {
+        std::string store_format = "paged";
+        SERIALIZE_SCALAR(store_format);
+
+        PagedStore::Summary summary = PagedStore::write(
+            CheckpointIn::dir() + "/" + filename, pmem, range.size(),
+            storeThreads);
+        DPRINTF(Checkpoint, "Saved %d pages, %d zero and %d duplicate, "
+                "in %d bytes\n", summary.pages, summary.zeroPages,
+                summary.duplicatePages, summary.fileSize);
+        return;
+    }
+
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
@@ -443,6 +604,26 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
+    // checkpoints without a format predate the paged one
+    std::string store_format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(store_format);
+    fatal_if(store_format != "gzip" && store_format != "paged",
+             "Unknown format '%s' for physical memory checkpoint '%s'\n",
+             store_format, filename);
+
+    if (store_format == "paged") {
+        fatal_if(store_id >= backingStore.size(),
+                 "Physical memory checkpoint '%s' has no backing store\n",
+                 filename);
+        long range_size;
+        UNSERIALIZE_SCALAR(range_size);
+        DPRINTF(Checkpoint, "Unserializing paged physical memory %s with "
+                "size %d\n", filename, range_size);
+        PagedStore::read(filepath, backingStore[store_id].pmem,
+                         backingStore[store_id].range.size(), storeThreads);
+        return;
+    }
+
     // mmap memoryfile
     gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
     if (compressed_mem == NULL)
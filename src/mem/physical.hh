@@ -40,10 +40,13 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/CheckpointStoreFormat.hh"
+#include "enums/HugePageMode.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -158,10 +161,30 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Huge pages used for the host backing store
+    const HugePageMode hugePages;
+
+    // Granularity of the backing store mappings
+    long hugePageSize;
+
+    // Host NUMA node of each event queue, used to place the backing
+    // store close to the thread accessing it
+    const std::vector<int> eventqNumaNodes;
+
+    // Format used to checkpoint the backing store
+    const CheckpointStoreFormat storeFormat;
+
+    // Host threads used to checkpoint the backing store
+    const unsigned storeThreads;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // The host mappings of the backing store, which may be larger
+    // than the ranges they provide when using huge pages
+    std::vector<std::pair<uint8_t*, size_t>> mappings;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -182,6 +205,25 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * Get the host NUMA node a backing store should be bound to,
+     * based on the event queue of the memories it provides.
+     *
+     * @param _memories The memories the backing store maps to
+     * @return The host NUMA node, or -1 to leave it to the host
+     */
+    int numaNode(const std::vector<AbstractMemory*>& _memories) const;
+
+    /**
+     * Bind a host memory region to a NUMA node. This has to happen
+     * before the region is first touched to have any effect.
+     *
+     * @param pmem Start of the region, page aligned
+     * @param len Size of the region
+     * @param node The host NUMA node
+     */
+    void bindToNumaNode(uint8_t* pmem, size_t len, int node) const;
+
   public:
 
     /**
@@ -191,7 +233,12 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   HugePageMode huge_pages=HugePageMode::none,
+                   const std::vector<int>& eventq_numa_nodes={},
+                   CheckpointStoreFormat store_format=
+                       CheckpointStoreFormat::gzip,
+                   unsigned store_threads=0);
 
     /**
      * Unmap all the backing store we have used.
@@ -49,7 +49,8 @@ class MemTraceProbe(BaseMemProbe):
     # For requests with a valid PC, include the PC in the trace
     with_pc = Param.Bool(False, "Include PC info in the trace")
 
-    # packet trace output file, disabled by default
+    # packet trace output file, disabled by default. A name ending with
+    # .blk selects a block trace, which can be read from any tick.
     trace_file = Param.String("", "Packet trace output file")
 
     # System object to look up the name associated with a requestor ID
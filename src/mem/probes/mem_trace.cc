@@ -60,13 +60,15 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
         // append the current simulation output directory
         filename = simout.resolve(p.trace_file);
 
-        const std::string suffix = ".gz";
+        auto has_suffix = [&filename](const std::string &suffix) {
+            return filename.size() >= suffix.size() &&
+                filename.compare(filename.size() - suffix.size(),
+                                 suffix.size(), suffix) == 0;
+        };
         // If trace_compress has been set, check the suffix. Append
-        // accordingly.
-        if (p.trace_compress &&
-            filename.compare(filename.size() - suffix.size(), suffix.size(),
-                             suffix) != 0)
-            filename = filename + suffix;
+        // accordingly. Block traces are always compressed.
+        if (p.trace_compress && !has_suffix(".gz") && !has_suffix(".blk"))
+            filename = filename + ".gz";
     } else {
         // Generate a filename from the name of the SimObject. Append .trc
         // and .gz if we want compression enabled.
@@ -121,7 +123,7 @@ MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
         pkt_msg.set_pc(pkt_info.pc);
     pkt_msg.set_pkt_id(pkt_info.id);
 
-    traceStream->write(pkt_msg);
+    traceStream->write(pkt_msg, curTick());
 }
 
 } // namespace gem5
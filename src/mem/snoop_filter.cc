@@ -42,6 +42,7 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,12 +53,119 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p)
+    : SimObject(p), bounded(p.bounded), assoc(p.assoc),
+      numSets(bounded ? p.max_capacity / p.system->cacheLineSize() / p.assoc
+              : 0),
+      useCounter(0), numValidEntries(0),
+      linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+      maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+      stats(this)
+{
+    if (bounded) {
+        fatal_if(assoc == 0 || numSets == 0,
+                 "%s: a bounded snoop filter needs at least one set and "
+                 "one way\n", name());
+        fatal_if(!isPowerOf2(numSets),
+                 "%s: the number of sets of a bounded snoop filter (%d) "
+                 "must be a power of 2\n", name(), numSets);
+        entryTags.resize(numSets * assoc, InvalidTag);
+        entryItems.resize(numSets * assoc, SnoopItem{0, 0});
+        entryLastUse.resize(numSets * assoc, 0);
+    }
+}
+
+size_t
+SnoopFilter::setBase(Addr line_addr) const
+{
+    return ((line_addr / linesize) & (numSets - 1)) * assoc;
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::findItem(Addr line_addr)
+{
+    if (!bounded) {
+        auto sf_it = cachedLocations.find(line_addr);
+        return sf_it == cachedLocations.end() ? nullptr : &sf_it->second;
+    }
+
+    const size_t base = setBase(line_addr);
+    for (size_t idx = base; idx < base + assoc; ++idx) {
+        if (entryTags[idx] == line_addr) {
+            entryLastUse[idx] = ++useCounter;
+            return &entryItems[idx];
+        }
+    }
+    return nullptr;
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::allocateItem(Addr line_addr)
+{
+    if (!bounded) {
+        SnoopItem *sf_item =
+            &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+        stats.occupancy = cachedLocations.size();
+        return sf_item;
+    }
+
+    // Prefer a free way, otherwise evict the least recently used line
+    // that has no request in flight, as those still expect responses
+    // to be tracked
+    const size_t base = setBase(line_addr);
+    size_t victim = base + assoc;
+    for (size_t idx = base; idx < base + assoc; ++idx) {
+        if (entryTags[idx] == InvalidTag) {
+            victim = idx;
+            break;
+        }
+        if (entryItems[idx].requested.none() &&
+            (victim == base + assoc ||
+             entryLastUse[idx] < entryLastUse[victim])) {
+            victim = idx;
+        }
+    }
+
+    panic_if(victim == base + assoc,
+             "%s: all the lines of snoop filter set %d have requests in "
+             "flight, increase the associativity\n", name(),
+             (base / assoc));
+
+    if (entryTags[victim] != InvalidTag) {
+        const Addr victim_addr = entryTags[victim];
+        const SnoopItem &victim_item = entryItems[victim];
+
+        DPRINTF(SnoopFilter, "%s:   evicting %#x SF value %x.%x\n",
+                __func__, victim_addr, victim_item.requested,
+                victim_item.holder);
+
+        stats.evictions++;
+        stats.backInvalidations += victim_item.holder.count();
+        pendingBackInvalidations.push_back(BackInvalidation{
+            victim_addr & ~Addr(LineSecure),
+            (victim_addr & LineSecure) != 0,
+            maskToPortList(victim_item.holder)});
+    } else {
+        numValidEntries++;
+    }
+
+    entryTags[victim] = line_addr;
+    entryItems[victim] = SnoopItem{0, 0};
+    entryLastUse[victim] = ++useCounter;
+    stats.occupancy = numValidEntries;
+    return &entryItems[victim];
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(Addr line_addr, SnoopItem *sf_item)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+    if ((sf_item->requested | sf_item->holder).none()) {
+        if (bounded) {
+            entryTags[sf_item - entryItems.data()] = InvalidTag;
+            numValidEntries--;
+        } else {
+            cachedLocations.erase(line_addr);
+        }
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
@@ -78,21 +186,23 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.lineAddr = line_addr;
+    reqLookupResult.item = findItem(line_addr);
+    bool is_hit = (reqLookupResult.item != nullptr);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
-    // portlist.
-    if (!is_hit && !allocate)
+    // portlist. A bounded filter may have evicted, and
+    // back-invalidated, the line an eviction refers to, so never
+    // allocate for those either.
+    if (!is_hit && (!allocate || (bounded && cpkt->isEviction())))
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.item = allocateItem(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = *reqLookupResult.item;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -140,6 +250,14 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         }
     } else { // if (!cpkt->needsResponse())
         assert(cpkt->isEviction());
+        // the line may have been back-invalidated and allocated again
+        // for other requestors while the eviction was in flight
+        if (bounded && (sf_item.holder & req_port).none()) {
+            DPRINTF(SnoopFilter, "%s:   eviction of a back-invalidated "
+                    "line\n", __func__);
+            return snoopSelected(maskToPortList(interested & ~req_port),
+                                 lookupLatency);
+        }
         // make sure that the sender actually had the line
         panic_if((sf_item.holder & req_port).none(), "requestor %x is not a " \
                  "holder :( SF value %x.%x\n", req_port,
@@ -159,10 +277,10 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.item) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.lineAddr == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
         if (will_retry) {
@@ -170,13 +288,14 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            *reqLookupResult.item = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(reqLookupResult.lineAddr, reqLookupResult.item);
+        reqLookupResult.item = nullptr;
     }
 }
 
@@ -191,10 +310,11 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    SnoopItem *sf_it = findItem(line_addr);
+    bool is_hit = (sf_it != nullptr);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!bounded && !is_hit &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +324,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,7 +354,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -264,7 +384,12 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    // The destination has a request in flight, so the line cannot have
+    // been evicted from a bounded filter
+    SnoopItem *sf_it = findItem(line_addr);
+    panic_if(!sf_it, "SF entry for %#x missing on snoop response\n",
+             line_addr);
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -311,8 +436,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    SnoopItem *sf_it = findItem(line_addr);
+    bool is_hit = sf_it != nullptr;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -322,7 +447,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = *sf_it;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +455,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     }
 }
 
@@ -353,12 +478,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    SnoopItem *sf_it = findItem(line_addr);
+    if (!sf_it)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_it;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -377,7 +502,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_it);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -405,8 +530,19 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
-{}
+               "(>1) holders of the requested data."),
+      ADD_STAT(evictions, statistics::units::Count::get(),
+               "Number of lines evicted from a bounded snoop filter to "
+               "make room for new ones."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of caches invalidated because of snoop filter "
+               "evictions."),
+      ADD_STAT(occupancy, statistics::units::Count::get(),
+               "Average number of lines tracked by the snoop filter.")
+{
+    evictions.flags(statistics::nozero);
+    backInvalidations.flags(statistics::nozero);
+}
 
 void
 SnoopFilter::regStats()
@@ -85,6 +85,14 @@ namespace gem5
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * By default the filter tracks an unbounded number of lines in a hash
+ * map. Optionally, the filter is bounded: lines are then tracked in a
+ * set-associative structure stored in flat arrays, as a hardware snoop
+ * filter would be. Allocating a line in a full set evicts the least
+ * recently used line without in-flight requests, and the caches holding
+ * the victim are back-invalidated (the crossbar sends them a clean and
+ * invalidate express snoop) to keep the filter inclusive.
  */
 class SnoopFilter : public SimObject
 {
@@ -95,13 +103,21 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
+    /**
+     * Lines evicted from a bounded filter whose holders must be
+     * invalidated by the crossbar.
+     */
+    struct BackInvalidation
     {
-    }
+        /** Address of the evicted line */
+        Addr addr;
+        /** Whether the line belongs to the secure address space */
+        bool isSecure;
+        /** Ports holding the line */
+        SnoopList ports;
+    };
+
+    SnoopFilter(const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -127,6 +143,30 @@ class SnoopFilter : public SimObject
                  SNOOP_MASK_SIZE, id);
     }
 
+    /**
+     * Check if lookups have evicted lines from a bounded filter whose
+     * holders have not been invalidated yet.
+     */
+    bool
+    hasBackInvalidations() const
+    {
+        return !pendingBackInvalidations.empty();
+    }
+
+    /**
+     * Hand over the pending back-invalidations to the caller, which is
+     * responsible for invalidating the listed ports.
+     *
+     * @return The back-invalidations, oldest first.
+     */
+    std::vector<BackInvalidation>
+    takeBackInvalidations()
+    {
+        std::vector<BackInvalidation> res;
+        res.swap(pendingBackInvalidations);
+        return res;
+    }
+
     /**
      * Lookup a request (from a CPU-side port) in the snoop filter and
      * return a list of other CPU-side ports that need forwarding of the
@@ -225,6 +265,24 @@ class SnoopFilter : public SimObject
      */
     typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
+    /**
+     * Find the item tracking a line.
+     *
+     * @param line_addr Line address, including the LineSecure bit.
+     * @return The item, nullptr if the line is not tracked.
+     */
+    SnoopItem *findItem(Addr line_addr);
+
+    /**
+     * Allocate an empty item to track a line that is not tracked
+     * yet. In a bounded filter, this may evict another line and queue a
+     * back-invalidation of its holders.
+     *
+     * @param line_addr Line address, including the LineSecure bit.
+     * @return The newly allocated item.
+     */
+    SnoopItem *allocateItem(Addr line_addr);
+
     /**
      * Simple factory methods for standard return values.
      */
@@ -261,11 +319,44 @@ class SnoopFilter : public SimObject
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(Addr line_addr, SnoopItem *sf_item);
 
-    /** Simple hash set of cached addresses. */
+    /** Simple hash set of cached addresses, used when unbounded. */
     SnoopFilterCache cachedLocations;
 
+    /** Whether the filter is set associative and capacity bounded */
+    const bool bounded;
+
+    /** Associativity of a bounded filter */
+    const unsigned assoc;
+
+    /** Number of sets of a bounded filter */
+    const unsigned numSets;
+
+    /** Tags of a bounded filter, indexed by set * assoc + way */
+    std::vector<Addr> entryTags;
+
+    /** Items of a bounded filter, indexed as the tags */
+    std::vector<SnoopItem> entryItems;
+
+    /** Last use of each entry of a bounded filter, for LRU replacement */
+    std::vector<uint64_t> entryLastUse;
+
+    /** Use counter of the bounded filter, incremented on each lookup */
+    uint64_t useCounter;
+
+    /** Number of lines tracked by a bounded filter */
+    size_t numValidEntries;
+
+    /** Tag of an unused entry, cannot collide with line addresses */
+    static constexpr Addr InvalidTag = MaxAddr;
+
+    /** Index of the first entry of the set a line maps to */
+    size_t setBase(Addr line_addr) const;
+
+    /** Lines evicted from a bounded filter and not invalidated yet */
+    std::vector<BackInvalidation> pendingBackInvalidations;
+
     /**
      * A request lookup must be followed by a call to finishRequest to inform
      * the operation's success. If a retry is needed, however, all changes
@@ -274,27 +365,18 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /** Item found or allocated by lookupRequest, if any. */
+        SnoopItem *item = nullptr;
+
+        /** Line address of the item, including the LineSecure bit. */
+        Addr lineAddr = 0;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
          * in case finishRequest needs to undo changes made in lookupRequest
          * (because of crossbar retry)
          */
-        SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
+        SnoopItem retryItem{0, 0};
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -329,6 +411,13 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        /** Lines evicted from a bounded filter to make room */
+        statistics::Scalar evictions;
+        /** Caches invalidated because of the evictions */
+        statistics::Scalar backInvalidations;
+        /** Number of tracked lines, sampled on allocation */
+        statistics::Average occupancy;
     } stats;
 };
 
@@ -345,9 +434,15 @@ inline SnoopFilter::SnoopList
 SnoopFilter::maskToPortList(SnoopMask port_mask) const
 {
     SnoopList res;
-    for (const auto& p : cpuSidePorts)
-        if ((port_mask & portToMask(*p)).any())
-            res.push_back(p);
+    if (port_mask.none())
+        return res;
+
+    // The snooping ports are stored in local mask id order, so test the
+    // bits directly rather than building a one-hot mask per port
+    res.reserve(port_mask.count());
+    for (size_t id = 0; id < cpuSidePorts.size(); ++id)
+        if (port_mask[id])
+            res.push_back(cpuSidePorts[id]);
     return res;
 }
 
@@ -74,7 +74,11 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       ADD_STAT(pktCount, statistics::units::Count::get(),
                "Packet count per connected requestor and responder"),
       ADD_STAT(pktSize, statistics::units::Byte::get(),
-               "Cumulative packet size per connected requestor and responder")
+               "Cumulative packet size per connected requestor and responder"),
+      ADD_STAT(decodeHits, statistics::units::Count::get(),
+               "Address lookups resolved by the decode table"),
+      ADD_STAT(decodeFallbacks, statistics::units::Count::get(),
+               "Address lookups not resolved by the decode table")
 {
 }
 
@@ -337,6 +341,16 @@ BaseXBar::findPort(AddrRange addr_range, PacketPtr pkt)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
+    // Check the decode table, which covers the common case of a
+    // packet falling within a single chunk of a port range
+    const PortID *decoded = portDecoder.decode(addr_range.start(),
+                                               addr_range.size());
+    if (decoded) {
+        ++decodeHits;
+        return *decoded;
+    }
+    ++decodeFallbacks;
+
     // Check the address map interval tree
     auto i = portMap.contains(addr_range);
     if (i != portMap.end()) {
@@ -441,6 +455,10 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
                       memSidePorts[conflict_id]->getPeer());
             }
         }
+
+        portDecoder.build(portMap.begin(), portMap.end());
+        DPRINTF(AddrRanges, "Decode table rebuilt with %d intervals\n",
+                portDecoder.size());
     }
 
     // if we have received ranges from all our neighbouring CPU-side-port
@@ -576,6 +594,9 @@ BaseXBar::regStats()
         .init(cpuSidePorts.size(), memSidePorts.size())
         .flags(total | nozero | nonan);
 
+    decodeHits.flags(nozero);
+    decodeFallbacks.flags(nozero);
+
     // both the packet count and total size are two-dimensional
     // vectors, indexed by CPU-side port id and memory-side port id, thus the
     // neighbouring memory-side ports and CPU-side ports, they do not
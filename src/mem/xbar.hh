@@ -49,6 +49,7 @@
 #include <deque>
 #include <unordered_map>
 
+#include "base/addr_decoder.hh"
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
@@ -318,6 +319,14 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /**
+     * Decode table mirroring the port map, where the stripes of
+     * interleaved ranges are resolved directly from the address
+     * bits. It is rebuilt whenever the port map changes and consulted
+     * before falling back to the port map.
+     */
+    AddrDecoder<PortID> portDecoder;
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
@@ -410,6 +419,11 @@ class BaseXBar : public ClockedObject
     statistics::Vector2d pktCount;
     statistics::Vector2d pktSize;
 
+    /** Address lookups resolved by the decode table */
+    statistics::Scalar decodeHits;
+    /** Address lookups that fell back to the port map or default port */
+    statistics::Scalar decodeFallbacks;
+
   public:
 
     virtual ~BaseXBar();
@@ -0,0 +1,454 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "proto/blockio.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "config/have_zstd.hh"
+
+#if HAVE_ZSTD
+#include <zstd.h>
+
+#endif
+
+namespace
+{
+
+void
+putLE(std::string &buf, uint64_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; i++)
+        buf.push_back(char(value >> (8 * i)));
+}
+
+uint64_t
+getLE(const char *buf, unsigned bytes)
+{
+    uint64_t value = 0;
+    for (unsigned i = 0; i < bytes; i++)
+        value |= uint64_t(uint8_t(buf[i])) << (8 * i);
+    return value;
+}
+
+void
+putVarint(std::string &buf, uint64_t value)
+{
+    while (value >= 0x80) {
+        buf.push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    buf.push_back(char(value));
+}
+
+bool
+getVarint(const char *&pos, const char *end, uint64_t &value)
+{
+    value = 0;
+    for (unsigned shift = 0; pos != end && shift < 64; shift += 7) {
+        uint8_t byte = *pos++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+bool
+BlockTrace::isBlockTrace(const std::string &filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    char bytes[4];
+    file.read(bytes, sizeof(bytes));
+    return file.good() && getLE(bytes, sizeof(bytes)) == magicNumber;
+}
+
+BlockTraceWriter::BlockTraceWriter(const std::string &filename) :
+    BlockTraceWriter(filename, HAVE_ZSTD ? Zstd : Zlib)
+{
+}
+
+BlockTraceWriter::BlockTraceWriter(const std::string &filename,
+                                   Codec codec) :
+    fileStream(filename.c_str(),
+            std::ios::out | std::ios::binary | std::ios::trunc),
+    fileName(filename), codec(codec), numRecords(0), prevKey(0)
+{
+    if (codec == Zstd && !HAVE_ZSTD)
+        fatal("Cannot write %s with zstd, which gem5 was built without\n",
+              filename);
+    if (!fileStream.good())
+        panic("Could not open %s for writing\n", filename);
+
+    std::string header;
+    putLE(header, magicNumber, 4);
+    putLE(header, version, 4);
+    fileStream.write(header.data(), header.size());
+}
+
+BlockTraceWriter::~BlockTraceWriter()
+{
+    flushBlock();
+
+    // The index goes at the end, found through the footer
+    std::string tail;
+    uint64_t index_offset = fileStream.tellp();
+    for (const auto &entry : index) {
+        putLE(tail, entry.offset, 8);
+        putLE(tail, entry.firstRecord, 8);
+        putLE(tail, entry.firstKey, 8);
+        putLE(tail, entry.lastKey, 8);
+        putLE(tail, entry.records, 4);
+        putLE(tail, 0, 4);
+    }
+    putLE(tail, index_offset, 8);
+    putLE(tail, index.size(), 8);
+    putLE(tail, version, 4);
+    putLE(tail, magicNumber, 4);
+    fileStream.write(tail.data(), tail.size());
+    fileStream.close();
+}
+
+void
+BlockTraceWriter::write(const void *data, size_t size, uint64_t key)
+{
+    if (key < prevKey)
+        panic("Key %d of record %d of %s is smaller than the previous one\n",
+              key, numRecords, fileName);
+
+    sizes.push_back(size);
+    keys.push_back(key);
+    payloads.append(static_cast<const char *>(data), size);
+    prevKey = key;
+    numRecords++;
+
+    if (payloads.size() >= blockBytes)
+        flushBlock();
+}
+
+void
+BlockTraceWriter::flushBlock()
+{
+    if (sizes.empty())
+        return;
+
+    raw.clear();
+    for (auto size : sizes)
+        putVarint(raw, size);
+    for (auto key : keys)
+        putVarint(raw, key - keys.front());
+    raw += payloads;
+
+    Codec block_codec = codec;
+    if (codec == Zlib) {
+        uLongf compressed_size = compressBound(raw.size());
+        compressed.resize(compressed_size);
+        if (compress2(reinterpret_cast<Bytef *>(&compressed[0]),
+                      &compressed_size,
+                      reinterpret_cast<const Bytef *>(raw.data()),
+                      raw.size(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            panic("Failed to compress a block of %s\n", fileName);
+        }
+        compressed.resize(compressed_size);
+    } else if (codec == Zstd) {
+#if HAVE_ZSTD
+        compressed.resize(ZSTD_compressBound(raw.size()));
+        size_t compressed_size = ZSTD_compress(&compressed[0],
+                compressed.size(), raw.data(), raw.size(), 3);
+        if (ZSTD_isError(compressed_size))
+            panic("Failed to compress a block of %s: %s\n", fileName,
+                  ZSTD_getErrorName(compressed_size));
+        compressed.resize(compressed_size);
+#endif
+    }
+
+    // Keep the block as it is if it does not compress
+    const std::string *data = &compressed;
+    if (codec == None || compressed.size() >= raw.size()) {
+        block_codec = None;
+        data = &raw;
+    }
+
+    IndexEntry entry;
+    entry.offset = fileStream.tellp();
+    entry.firstRecord = numRecords - sizes.size();
+    entry.firstKey = keys.front();
+    entry.lastKey = keys.back();
+    entry.records = sizes.size();
+    index.push_back(entry);
+
+    std::string header;
+    putLE(header, block_codec, 4);
+    putLE(header, data->size(), 4);
+    putLE(header, raw.size(), 4);
+    putLE(header, entry.records, 4);
+    putLE(header, entry.firstKey, 8);
+    putLE(header, entry.lastKey, 8);
+    fileStream.write(header.data(), header.size());
+    fileStream.write(data->data(), data->size());
+    if (!fileStream.good())
+        panic("Failed to write a block of %s\n", fileName);
+
+    sizes.clear();
+    keys.clear();
+    payloads.clear();
+}
+
+BlockTraceReader::BlockTraceReader(const std::string &filename) :
+    fileStream(filename.c_str(), std::ios::in | std::ios::binary),
+    fileName(filename), curBlock(0), loadedBlock(0), payloads(nullptr),
+    nextRecord(0), prevKey(0)
+{
+    if (!fileStream.good())
+        panic("Could not open %s for reading\n", filename);
+
+    char header[fileHeaderSize];
+    fileStream.read(header, sizeof(header));
+    if (!fileStream.good() || getLE(header, 4) != magicNumber)
+        panic("Input file %s is not a valid gem5 block trace.\n", filename);
+    if (getLE(header + 4, 4) != version)
+        panic("Block trace %s has version %d, expected %d.\n", filename,
+              getLE(header + 4, 4), version);
+
+    readIndex();
+    loadedBlock = index.size();
+}
+
+void
+BlockTraceReader::readIndex()
+{
+    fileStream.clear();
+    fileStream.seekg(0, std::ifstream::end);
+    const uint64_t file_size = fileStream.tellg();
+
+    if (file_size >= fileHeaderSize + footerSize) {
+        char footer[footerSize];
+        fileStream.seekg(file_size - footerSize);
+        fileStream.read(footer, sizeof(footer));
+        const uint64_t index_offset = getLE(footer, 8);
+        const uint64_t num_blocks = getLE(footer + 8, 8);
+        if (fileStream.good() && getLE(footer + 20, 4) == magicNumber &&
+            getLE(footer + 16, 4) == version &&
+            index_offset + num_blocks * IndexEntry::size + footerSize ==
+                file_size) {
+            std::string entries(num_blocks * IndexEntry::size, '\0');
+            fileStream.seekg(index_offset);
+            fileStream.read(&entries[0], entries.size());
+            if (!fileStream.good())
+                panic("Failed to read the index of %s\n", fileName);
+
+            index.resize(num_blocks);
+            for (uint64_t i = 0; i < num_blocks; i++) {
+                const char *buf = entries.data() + i * IndexEntry::size;
+                index[i].offset = getLE(buf, 8);
+                index[i].firstRecord = getLE(buf + 8, 8);
+                index[i].firstKey = getLE(buf + 16, 8);
+                index[i].lastKey = getLE(buf + 24, 8);
+                index[i].records = getLE(buf + 32, 4);
+            }
+            return;
+        }
+    }
+
+    // The writer did not finish, walk the blocks that made it to the file
+    warn("Block trace %s has no index, rebuilding it.\n", fileName);
+    uint64_t offset = fileHeaderSize;
+    uint64_t records = 0;
+    while (offset + BlockHeader::size <= file_size) {
+        char header[BlockHeader::size];
+        fileStream.clear();
+        fileStream.seekg(offset);
+        fileStream.read(header, sizeof(header));
+        const uint64_t end = offset + BlockHeader::size + getLE(header + 4, 4);
+        if (!fileStream.good() || end > file_size)
+            break;
+
+        IndexEntry entry;
+        entry.offset = offset;
+        entry.firstRecord = records;
+        entry.firstKey = getLE(header + 16, 8);
+        entry.lastKey = getLE(header + 24, 8);
+        entry.records = getLE(header + 12, 4);
+        index.push_back(entry);
+
+        records += entry.records;
+        offset = end;
+    }
+}
+
+void
+BlockTraceReader::loadBlock(size_t block)
+{
+    char buf[BlockHeader::size];
+    fileStream.clear();
+    fileStream.seekg(index[block].offset);
+    fileStream.read(buf, sizeof(buf));
+
+    BlockHeader header;
+    header.codec = getLE(buf, 4);
+    header.compressedSize = getLE(buf + 4, 4);
+    header.rawSize = getLE(buf + 8, 4);
+    header.records = getLE(buf + 12, 4);
+    header.firstKey = getLE(buf + 16, 8);
+
+    compressed.resize(header.compressedSize);
+    fileStream.read(&compressed[0], compressed.size());
+    if (!fileStream.good())
+        panic("Failed to read block %d of %s\n", block, fileName);
+
+    switch (header.codec) {
+      case None:
+        raw.swap(compressed);
+        break;
+      case Zlib:
+        {
+            raw.resize(header.rawSize);
+            uLongf raw_size = raw.size();
+            if (uncompress(reinterpret_cast<Bytef *>(&raw[0]), &raw_size,
+                           reinterpret_cast<const Bytef *>(
+                               compressed.data()),
+                           compressed.size()) != Z_OK ||
+                raw_size != header.rawSize) {
+                panic("Failed to decompress block %d of %s\n", block,
+                      fileName);
+            }
+        }
+        break;
+      case Zstd:
+#if HAVE_ZSTD
+        raw.resize(header.rawSize);
+        if (ZSTD_decompress(&raw[0], raw.size(), compressed.data(),
+                            compressed.size()) != header.rawSize) {
+            panic("Failed to decompress block %d of %s\n", block,
+                  fileName);
+        }
+        break;
+#else
+        panic("Block trace %s is compressed with zstd, which gem5 was "
+              "built without.\n", fileName);
+#endif
+      default:
+        panic("Block %d of %s has an unknown codec %d\n", block, fileName,
+              header.codec);
+    }
+
+    // Decode the columns
+    sizes.resize(header.records);
+    keys.resize(header.records);
+    offsets.resize(header.records);
+    const char *pos = raw.data();
+    const char *end = raw.data() + raw.size();
+    uint64_t value;
+    for (auto &size : sizes) {
+        if (!getVarint(pos, end, value))
+            panic("Block %d of %s is corrupt\n", block, fileName);
+        size = value;
+    }
+    for (auto &key : keys) {
+        if (!getVarint(pos, end, value))
+            panic("Block %d of %s is corrupt\n", block, fileName);
+        key = header.firstKey + value;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < header.records; i++) {
+        offsets[i] = offset;
+        offset += sizes[i];
+    }
+    if (pos + offset != end)
+        panic("Block %d of %s is corrupt\n", block, fileName);
+
+    payloads = pos;
+    loadedBlock = block;
+}
+
+bool
+BlockTraceReader::read(const char *&data, size_t &size)
+{
+    while (true) {
+        if (curBlock >= index.size())
+            return false;
+        if (loadedBlock != curBlock)
+            loadBlock(curBlock);
+        if (nextRecord < sizes.size())
+            break;
+        curBlock++;
+        nextRecord = 0;
+    }
+
+    data = payloads + offsets[nextRecord];
+    size = sizes[nextRecord];
+    prevKey = keys[nextRecord];
+    nextRecord++;
+    return true;
+}
+
+bool
+BlockTraceReader::seekRecord(uint64_t record)
+{
+    nextRecord = 0;
+    if (record >= numRecords()) {
+        curBlock = index.size();
+        return false;
+    }
+
+    auto it = std::upper_bound(index.begin(), index.end(), record,
+        [](uint64_t record, const IndexEntry &entry) {
+            return record < entry.firstRecord;
+        });
+    curBlock = std::distance(index.begin(), it) - 1;
+    nextRecord = record - index[curBlock].firstRecord;
+    return true;
+}
+
+bool
+BlockTraceReader::seekKey(uint64_t key)
+{
+    nextRecord = 0;
+    auto it = std::lower_bound(index.begin(), index.end(), key,
+        [](const IndexEntry &entry, uint64_t key) {
+            return entry.lastKey < key;
+        });
+    curBlock = std::distance(index.begin(), it);
+    if (it == index.end())
+        return false;
+
+    loadBlock(curBlock);
+    nextRecord = std::distance(keys.begin(),
+            std::lower_bound(keys.begin(), keys.end(), key));
+    return true;
+}
+
+uint64_t
+BlockTraceReader::numRecords() const
+{
+    if (index.empty())
+        return 0;
+    return index.back().firstRecord + index.back().records;
+}
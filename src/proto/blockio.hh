@@ -0,0 +1,304 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a block based container for trace records, which can be
+ * read from any point without decompressing what precedes it.
+ */
+
+#ifndef __PROTO_BLOCKIO_HH__
+#define __PROTO_BLOCKIO_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * A block trace stores a sequence of records, i.e. serialized messages,
+ * in independently compressed blocks. Each record carries a key, e.g. the
+ * tick or the instruction count it belongs to, and the keys must not
+ * decrease along the trace. The file ends with an index giving the range
+ * of records and keys of every block, so a reader seeks to any record or
+ * key by decompressing a single block.
+ *
+ * Within a block the records are stored by column: the sizes of all the
+ * records, then their keys as deltas from the first key of the block, and
+ * then their payloads, which keeps the small and regular fields together
+ * where they compress well. The payloads are opaque to the container, so
+ * the fields of the messages themselves are not split into columns.
+ *
+ * The layout of the file is, with all integers little endian:
+ *   u32 magic, u32 version
+ *   for each block: the block header and the compressed block
+ *   for each block: its index entry
+ *   u64 offset of the index, u64 number of blocks, u32 version, u32 magic
+ *
+ * A trace whose writer did not finish has no index. It is still read, by
+ * walking the block headers.
+ */
+class BlockTrace
+{
+  public:
+
+    /// Use the ASCII characters gblk as our magic number
+    static constexpr uint32_t magicNumber = 0x6b6c6267;
+
+    static constexpr uint32_t version = 1;
+
+    /// Compression of the data of a block
+    enum Codec : uint32_t
+    {
+        None = 0,
+        Zlib = 1,
+        Zstd = 2
+    };
+
+    /// Uncompressed size from which a block is written out
+    static constexpr size_t blockBytes = 1 << 20;
+
+    /// Header preceding the data of each block
+    struct BlockHeader
+    {
+        uint32_t codec;
+        uint32_t compressedSize;
+        uint32_t rawSize;
+        uint32_t records;
+        uint64_t firstKey;
+        uint64_t lastKey;
+
+        static constexpr size_t size = 32;
+    };
+
+    /// Entry of the index of the blocks
+    struct IndexEntry
+    {
+        uint64_t offset;
+        uint64_t firstRecord;
+        uint64_t firstKey;
+        uint64_t lastKey;
+        uint32_t records;
+
+        static constexpr size_t size = 40;
+    };
+
+    static constexpr size_t fileHeaderSize = 8;
+    static constexpr size_t footerSize = 24;
+
+    /**
+     * Check whether a file is a block trace, by looking at its magic
+     * number.
+     *
+     * @param filename Path to the file to check
+     * @return True if the file is a block trace
+     */
+    static bool isBlockTrace(const std::string &filename);
+
+  protected:
+
+    BlockTrace() {}
+
+  private:
+
+    /**
+     * Hide the copy constructor and assignment operator.
+     * @{
+     */
+    BlockTrace(const BlockTrace&);
+    BlockTrace& operator=(const BlockTrace&);
+    /** @} */
+};
+
+/**
+ * A BlockTraceWriter gathers records into blocks, compresses the blocks as
+ * they fill up and writes the index when it is destroyed. Blocks are
+ * compressed with zstd when gem5 is built with it, and with zlib
+ * otherwise.
+ */
+class BlockTraceWriter : public BlockTrace
+{
+
+  public:
+
+    /**
+     * Create a block trace, truncating the file if it exists.
+     *
+     * @param filename Path to the file to create or truncate
+     */
+    BlockTraceWriter(const std::string &filename);
+
+    /**
+     * Create a block trace compressed with the given codec.
+     *
+     * @param filename Path to the file to create or truncate
+     * @param codec Compression of the blocks, None to store them as they
+     *              are
+     */
+    BlockTraceWriter(const std::string &filename, Codec codec);
+
+    /**
+     * Write the last block and the index, and close the file.
+     */
+    ~BlockTraceWriter();
+
+    /**
+     * Append a record to the trace.
+     *
+     * @param data Payload of the record
+     * @param size Size of the payload in bytes
+     * @param key Key of the record, no smaller than the previous one
+     */
+    void write(const void *data, size_t size, uint64_t key);
+
+    /** Key of the last record written, 0 for an empty trace */
+    uint64_t lastKey() const { return prevKey; }
+
+  private:
+
+    /**
+     * Compress the records gathered so far and write them as a block.
+     */
+    void flushBlock();
+
+    std::ofstream fileStream;
+
+    /// Hold on to the file name for error messages
+    const std::string fileName;
+
+    const Codec codec;
+
+    /// Index of the blocks written so far
+    std::vector<IndexEntry> index;
+
+    /// Columns of the block being gathered
+    std::vector<uint32_t> sizes;
+    std::vector<uint64_t> keys;
+    std::string payloads;
+
+    /// Number of records written, including the current block
+    uint64_t numRecords;
+
+    uint64_t prevKey;
+
+    /// Scratch buffers reused by every block
+    std::string raw;
+    std::string compressed;
+};
+
+/**
+ * A BlockTraceReader reads the records of a block trace in order, and
+ * seeks to a record or a key through the index of the blocks.
+ */
+class BlockTraceReader : public BlockTrace
+{
+
+  public:
+
+    /**
+     * Open a block trace and read its index.
+     *
+     * @param filename Path to the file to read from
+     */
+    BlockTraceReader(const std::string &filename);
+
+    /**
+     * Read the next record. The payload stays valid until the reader is
+     * used again.
+     *
+     * @param data Set to the payload of the record
+     * @param size Set to the size of the payload
+     * @return True if a record was read, false at the end of the trace
+     */
+    bool read(const char *&data, size_t &size);
+
+    /**
+     * Position the reader so that the next record read is the given one.
+     *
+     * @param record Number of the record, 0 for the first one
+     * @return False if the trace has fewer records
+     */
+    bool seekRecord(uint64_t record);
+
+    /**
+     * Position the reader on the first record with a key no smaller than
+     * the given one.
+     *
+     * @param key Key to look for
+     * @return False if all the keys of the trace are smaller
+     */
+    bool seekKey(uint64_t key);
+
+    /** Total number of records in the trace */
+    uint64_t numRecords() const;
+
+    /** Key of the record returned by the last read */
+    uint64_t lastKey() const { return prevKey; }
+
+  private:
+
+    /**
+     * Read the index from the end of the file, or rebuild it from the
+     * block headers if the trace was not finished.
+     */
+    void readIndex();
+
+    /**
+     * Decompress a block and decode its columns.
+     *
+     * @param block Position of the block in the index
+     */
+    void loadBlock(size_t block);
+
+    std::ifstream fileStream;
+
+    /// Hold on to the file name for error messages
+    const std::string fileName;
+
+    std::vector<IndexEntry> index;
+
+    /// Block holding the next record, index.size() at the end
+    size_t curBlock;
+
+    /// Block whose columns are decoded, index.size() if there is none
+    size_t loadedBlock;
+
+    /// Columns of the loaded block, with the offsets of the payloads
+    std::vector<uint32_t> sizes;
+    std::vector<uint64_t> keys;
+    std::vector<size_t> offsets;
+    const char *payloads;
+
+    /// Next record to read from the loaded block
+    size_t nextRecord;
+
+    uint64_t prevKey;
+
+    /// Scratch buffers reused by every block
+    std::string raw;
+    std::string compressed;
+};
+
+#endif //__PROTO_BLOCKIO_HH__
@@ -0,0 +1,263 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "proto/blockio.hh"
+
+namespace
+{
+
+/** Records spanning a few blocks, with keys repeating in threes */
+class BlockTraceTest : public ::testing::Test
+{
+  protected:
+    std::string filename;
+    std::vector<std::string> records;
+    std::vector<uint64_t> keys;
+
+    void
+    SetUp() override
+    {
+        char name[] = "blocktrace-XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        filename = name;
+    }
+
+    void TearDown() override { unlink(filename.c_str()); }
+
+    /**
+     * Make records of varied sizes adding up to a few blocks, either
+     * compressible text or random bytes.
+     */
+    void
+    makeRecords(bool compressible, size_t max_size = 300)
+    {
+        std::mt19937 rng(1);
+        size_t bytes = 0;
+        for (uint64_t i = 0; bytes < 3 * BlockTrace::blockBytes + 1000;
+             i++) {
+            std::string record;
+            const size_t size = rng() % max_size;
+            for (size_t j = 0; j < size; j++) {
+                record.push_back(compressible ? 'a' + (i + j) % 7 :
+                                 char(rng()));
+            }
+            bytes += record.size();
+            records.push_back(record);
+            keys.push_back(i / 3 * 10);
+        }
+    }
+
+    void
+    writeTrace(BlockTrace::Codec codec)
+    {
+        BlockTraceWriter writer(filename, codec);
+        for (size_t i = 0; i < records.size(); i++)
+            writer.write(records[i].data(), records[i].size(), keys[i]);
+    }
+
+    /** Codec of the first block, from its header */
+    uint32_t
+    firstBlockCodec()
+    {
+        std::ifstream file(filename, std::ios::binary);
+        file.seekg(BlockTrace::fileHeaderSize);
+        uint8_t bytes[4];
+        file.read(reinterpret_cast<char *>(bytes), sizeof(bytes));
+        return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | bytes[3] << 24;
+    }
+
+    /** Read the next record and check it is the given one */
+    void
+    expectRecord(BlockTraceReader &reader, size_t i)
+    {
+        const char *data;
+        size_t size;
+        ASSERT_TRUE(reader.read(data, size)) << "record " << i;
+        ASSERT_EQ(std::string(data, size), records[i]) << "record " << i;
+        ASSERT_EQ(reader.lastKey(), keys[i]) << "record " << i;
+    }
+
+    void
+    expectRoundTrip()
+    {
+        EXPECT_TRUE(BlockTrace::isBlockTrace(filename));
+        BlockTraceReader reader(filename);
+        EXPECT_EQ(reader.numRecords(), records.size());
+        for (size_t i = 0; i < records.size(); i++)
+            expectRecord(reader, i);
+
+        const char *data;
+        size_t size;
+        EXPECT_FALSE(reader.read(data, size));
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(BlockTraceTest, Empty)
+{
+    writeTrace(BlockTrace::Zlib);
+
+    BlockTraceReader reader(filename);
+    EXPECT_EQ(reader.numRecords(), 0);
+    const char *data;
+    size_t size;
+    EXPECT_FALSE(reader.read(data, size));
+    EXPECT_FALSE(reader.seekRecord(0));
+    EXPECT_FALSE(reader.seekKey(0));
+}
+
+TEST_F(BlockTraceTest, RoundTripZlib)
+{
+    makeRecords(true);
+    writeTrace(BlockTrace::Zlib);
+    EXPECT_EQ(firstBlockCodec(), BlockTrace::Zlib);
+    expectRoundTrip();
+}
+
+TEST_F(BlockTraceTest, RoundTripNone)
+{
+    makeRecords(true);
+    writeTrace(BlockTrace::None);
+    EXPECT_EQ(firstBlockCodec(), BlockTrace::None);
+    expectRoundTrip();
+}
+
+/** Blocks which do not compress are stored as they are */
+TEST_F(BlockTraceTest, IncompressibleBlocks)
+{
+    // Few large records, so that the size and key columns are too small
+    // to make up for the random payloads
+    makeRecords(false, 1 << 16);
+    writeTrace(BlockTrace::Zlib);
+    EXPECT_EQ(firstBlockCodec(), BlockTrace::None);
+    expectRoundTrip();
+}
+
+TEST_F(BlockTraceTest, SeekRecord)
+{
+    makeRecords(true);
+    writeTrace(BlockTrace::Zlib);
+    BlockTraceReader reader(filename);
+
+    // Every record around the block boundaries, backwards and forwards
+    std::vector<size_t> targets = {records.size() - 1, 0, 1};
+    size_t bytes = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        bytes += records[i].size();
+        if (bytes >= BlockTrace::blockBytes) {
+            targets.insert(targets.end(), {i + 1, i, i + 2, i - 1});
+            bytes = 0;
+        }
+    }
+    ASSERT_GT(targets.size(), 3 + 4 * 2);
+
+    for (size_t target : targets) {
+        ASSERT_TRUE(reader.seekRecord(target)) << "record " << target;
+        expectRecord(reader, target);
+        if (target + 1 < records.size())
+            expectRecord(reader, target + 1);
+    }
+
+    EXPECT_FALSE(reader.seekRecord(records.size()));
+    const char *data;
+    size_t size;
+    EXPECT_FALSE(reader.read(data, size));
+
+    // The reader recovers from seeking past the end
+    ASSERT_TRUE(reader.seekRecord(5));
+    expectRecord(reader, 5);
+}
+
+TEST_F(BlockTraceTest, SeekKey)
+{
+    makeRecords(true);
+    writeTrace(BlockTrace::Zlib);
+    BlockTraceReader reader(filename);
+
+    // Keys of records, in between records and within every block
+    for (size_t i = 0; i < records.size(); i += 997) {
+        for (uint64_t key : {keys[i], keys[i] + 1, keys[i] + 10}) {
+            size_t first = std::lower_bound(keys.begin(), keys.end(), key) -
+                keys.begin();
+            ASSERT_TRUE(reader.seekKey(key)) << "key " << key;
+            expectRecord(reader, first);
+            if (first + 1 < records.size())
+                expectRecord(reader, first + 1);
+        }
+    }
+
+    ASSERT_TRUE(reader.seekKey(keys.back()));
+    expectRecord(reader,
+        std::lower_bound(keys.begin(), keys.end(), keys.back()) -
+        keys.begin());
+    EXPECT_FALSE(reader.seekKey(keys.back() + 1));
+}
+
+/** A trace without its index is read up to its last complete block */
+TEST_F(BlockTraceTest, Truncated)
+{
+    makeRecords(true);
+    writeTrace(BlockTrace::Zlib);
+
+    std::ifstream in(filename, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+    in.close();
+
+    // Cut the file within its blocks, as if the writer had stopped
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() * 3 / 4);
+    out.close();
+
+    BlockTraceReader reader(filename);
+    const uint64_t num_records = reader.numRecords();
+    EXPECT_GT(num_records, 0);
+    EXPECT_LT(num_records, records.size());
+    for (size_t i = 0; i < num_records; i++)
+        expectRecord(reader, i);
+    const char *data;
+    size_t size;
+    EXPECT_FALSE(reader.read(data, size));
+
+    ASSERT_TRUE(reader.seekRecord(num_records - 1));
+    expectRecord(reader, num_records - 1);
+    ASSERT_TRUE(reader.seekKey(keys[num_records / 2]));
+    EXPECT_FALSE(reader.seekRecord(num_records));
+}
@@ -46,11 +46,20 @@ using namespace google::protobuf;
 ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
     fileStream(filename.c_str(),
             std::ios::out | std::ios::binary | std::ios::trunc),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    blockWriter(NULL)
 {
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
 
+    // Block traces do their own framing and compression
+    if (filename.find_last_of('.') != std::string::npos &&
+        filename.substr(filename.find_last_of('.') + 1) == "blk") {
+        fileStream.close();
+        blockWriter = new BlockTraceWriter(filename);
+        return;
+    }
+
     // Wrap the output file in a zero copy stream, that in turn is
     // wrapped in a gzip stream if the filename ends with .gz. The
     // latter stream is in turn wrapped in a coded stream
@@ -73,6 +82,11 @@ ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
 
 ProtoOutputStream::~ProtoOutputStream()
 {
+    if (blockWriter != NULL) {
+        delete blockWriter;
+        return;
+    }
+
     // As the compression is optional, see if the stream exists
     if (gzipStream != NULL)
         delete gzipStream;
@@ -83,6 +97,19 @@ ProtoOutputStream::~ProtoOutputStream()
 void
 ProtoOutputStream::write(const Message& msg)
 {
+    write(msg, blockWriter != NULL ? blockWriter->lastKey() : 0);
+}
+
+void
+ProtoOutputStream::write(const Message& msg, uint64_t key)
+{
+    if (blockWriter != NULL) {
+        if (!msg.SerializeToString(&serialized))
+            panic("Unable to serialize message\n");
+        blockWriter->write(serialized.data(), serialized.size(), key);
+        return;
+    }
+
     // Due to the byte limit of the coded stream we create it for
     // every single mesage (based on forum discussions around the size
     // limitation)
@@ -103,11 +130,18 @@ ProtoOutputStream::write(const Message& msg)
 ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream(filename.c_str(), std::ios::in | std::ios::binary),
     fileName(filename), useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    blockReader(NULL)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
 
+    if (BlockTrace::isBlockTrace(filename)) {
+        fileStream.close();
+        blockReader = new BlockTraceReader(filename);
+        return;
+    }
+
     // check the magic number to see if this is a gzip stream
     unsigned char bytes[2];
     fileStream.read((char*) bytes, 2);
@@ -163,6 +197,11 @@ ProtoInputStream::destroyStreams()
 
 ProtoInputStream::~ProtoInputStream()
 {
+    if (blockReader != NULL) {
+        delete blockReader;
+        return;
+    }
+
     destroyStreams();
     fileStream.close();
 }
@@ -171,6 +210,11 @@ ProtoInputStream::~ProtoInputStream()
 void
 ProtoInputStream::reset()
 {
+    if (blockReader != NULL) {
+        blockReader->seekRecord(0);
+        return;
+    }
+
     destroyStreams();
     // seek to the start of the input file and clear any flags
     fileStream.clear();
@@ -178,9 +222,46 @@ ProtoInputStream::reset()
     createStreams();
 }
 
+bool
+ProtoInputStream::seekRecord(uint64_t record)
+{
+    if (blockReader != NULL)
+        return blockReader->seekRecord(record);
+
+    // Skip the messages before it, without parsing them
+    reset();
+    for (uint64_t i = 0; i < record; i++) {
+        io::CodedInputStream codedStream(zeroCopyStream);
+        uint32_t size;
+        if (!codedStream.ReadVarint32(&size) || !codedStream.Skip(size))
+            return false;
+    }
+    return true;
+}
+
+bool
+ProtoInputStream::seekKey(uint64_t key)
+{
+    if (blockReader == NULL)
+        panic("Can't seek to key %d in %s, it is not a block trace\n", key,
+              fileName);
+    return blockReader->seekKey(key);
+}
+
 bool
 ProtoInputStream::read(Message& msg)
 {
+    if (blockReader != NULL) {
+        const char *data;
+        size_t size;
+        if (!blockReader->read(data, size))
+            return false;
+        if (!msg.ParseFromArray(data, size))
+            panic("Unable to read message from block trace %s\n",
+                  fileName);
+        return true;
+    }
+
     // Read a message from the stream by getting the size, using it as
     // a limit when parsing the message, then popping the limit again
     uint32_t size;
@@ -49,7 +49,11 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <cstdint>
 #include <fstream>
+#include <string>
+
+#include "proto/blockio.hh"
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -86,6 +90,10 @@ class ProtoStream
  * basis to avoid having to deal with huge data structures. The latter
  * is made possible by encoding the length of each message in the
  * stream.
+ *
+ * A file name ending with .blk selects a block trace instead (see
+ * BlockTrace), where every message is written with a key, e.g. its tick,
+ * that a reader can seek to.
  */
 class ProtoOutputStream : public ProtoStream
 {
@@ -94,7 +102,8 @@ class ProtoOutputStream : public ProtoStream
 
     /**
      * Create an output stream for a given file name. If the filename
-     * ends with .gz then the file will be compressed accordinly.
+     * ends with .gz then the file will be compressed accordinly, and if
+     * it ends with .blk then the file is a block trace.
      *
      * @param filename Path to the file to create or truncate
      */
@@ -114,6 +123,16 @@ class ProtoOutputStream : public ProtoStream
      */
     void write(const google::protobuf::Message& msg);
 
+    /**
+     * Write a message to the stream with a key. The key is kept by block
+     * traces only, and must not be smaller than the one of the previous
+     * message. A message written without a key gets the previous one.
+     *
+     * @param msg Message to write to the stream
+     * @param key Key of the message, e.g. a tick or an instruction count
+     */
+    void write(const google::protobuf::Message& msg, uint64_t key);
+
   private:
 
     /// Underlying file output stream
@@ -128,6 +147,12 @@ class ProtoOutputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
 
+    /// Block trace writer, used instead of the streams above if set
+    BlockTraceWriter* blockWriter;
+
+    /// Buffer the messages are serialized to for the block trace
+    std::string serialized;
+
 };
 
 /**
@@ -136,6 +161,9 @@ class ProtoOutputStream : public ProtoStream
  * stream is done on a per-message basis to avoid having to deal with
  * huge data structures. The latter assumes the length of each message
  * is encoded in the stream when it is written.
+ *
+ * Block traces are recognised by their magic number and read through
+ * their index, which makes seeking cheap.
  */
 class ProtoInputStream : public ProtoStream
 {
@@ -169,6 +197,28 @@ class ProtoInputStream : public ProtoStream
      */
     void reset();
 
+    /** Whether the stream is a block trace, which seeks cheaply */
+    bool isBlockTrace() const { return blockReader != NULL; }
+
+    /**
+     * Seek so that the next message read is the given one. Block traces
+     * go straight to the block holding it, other streams are read from
+     * the start.
+     *
+     * @param record Number of the message, the header is message 0
+     * @return False if the stream has fewer messages
+     */
+    bool seekRecord(uint64_t record);
+
+    /**
+     * Seek to the first message with a key no smaller than the given
+     * one. Only block traces have keys.
+     *
+     * @param key Key to look for
+     * @return False if all the keys of the stream are smaller
+     */
+    bool seekKey(uint64_t key);
+
   private:
 
     /**
@@ -199,6 +249,9 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Block trace reader, used instead of the streams above if set
+    BlockTraceReader* blockReader;
+
 };
 
 #endif //__PROTO_PROTOIO_HH
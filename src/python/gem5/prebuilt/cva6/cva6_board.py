@@ -0,0 +1,79 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.memory import SingleChannelDDR3_1600
+from gem5.isas import ISA
+from gem5.utils.requires import requires
+
+from .cva6_cache import CVA6CacheHierarchy
+from .cva6_processor import CVA6Processor
+
+
+class CVA6Board(SimpleBoard):
+    """
+    A board with a single CVA6 (Ariane) core, its private L1 caches and a
+    DDR3 memory, for running RISC-V binaries in SE mode.
+
+    The pipeline is a MinorCPU configured to follow CVA6's in-order, single
+    issue pipeline. The scoreboard size and the number of commit ports are
+    configurable as they are in the CVA6 RTL.
+    """
+
+    def __init__(
+        self,
+        clk_freq: str = "1GHz",
+        scoreboard_entries: int = 8,
+        commit_ports: int = 2,
+        l1i_size: str = "16KiB",
+        l1d_size: str = "32KiB",
+        memory_size: str = "1GiB",
+    ) -> None:
+        """
+        :param clk_freq: The clock frequency of the system,
+        default: 1GHz
+        :param scoreboard_entries: The number of issue scoreboard entries,
+        default: 8
+        :param commit_ports: The number of commit ports,
+        default: 2
+        :param l1i_size: The size of the L1 instruction cache,
+        default: 16KiB
+        :param l1d_size: The size of the L1 data cache,
+        default: 32KiB
+        :param memory_size: The size of the main memory,
+        default: 1GiB
+        """
+        requires(isa_required=ISA.RISCV)
+
+        super().__init__(
+            clk_freq=clk_freq,
+            processor=CVA6Processor(
+                num_cores=1,
+                scoreboard_entries=scoreboard_entries,
+                commit_ports=commit_ports,
+            ),
+            memory=SingleChannelDDR3_1600(memory_size),
+            cache_hierarchy=CVA6CacheHierarchy(
+                l1i_size=l1i_size, l1d_size=l1d_size
+            ),
+        )
@@ -0,0 +1,128 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects import (
+    NULL,
+    BadAddr,
+    Port,
+    SystemXBar,
+)
+
+from gem5.components.boards.abstract_board import AbstractBoard
+from gem5.components.cachehierarchies.abstract_cache_hierarchy import (
+    AbstractCacheHierarchy,
+)
+from gem5.components.cachehierarchies.classic.abstract_classic_cache_hierarchy import (
+    AbstractClassicCacheHierarchy,
+)
+from gem5.components.cachehierarchies.classic.caches.l1dcache import L1DCache
+from gem5.components.cachehierarchies.classic.caches.l1icache import L1ICache
+from gem5.components.cachehierarchies.classic.caches.mmu_cache import MMUCache
+from gem5.isas import ISA
+from gem5.utils.override import *
+
+
+class CVA6CacheHierarchy(AbstractClassicCacheHierarchy):
+    """
+    A cache setup where each core has a private L1 Data and Instruction Cache
+    connected straight to the memory bus, as in the CVA6 reference SoC.
+
+    - L1 Instruction Cache:
+        - 16 KiB 4-way set associative by default
+    - L1 Data Cache
+        - 32 KiB 8-way set associative by default
+
+    Neither cache has a prefetcher.
+    """
+
+    def __init__(
+        self,
+        l1i_size: str = "16KiB",
+        l1d_size: str = "32KiB",
+    ) -> None:
+        """
+        :param l1i_size: The size of the L1 Instruction Cache (e.g., "16KiB").
+        :param l1d_size: The size of the L1 Data Cache (e.g., "32KiB").
+        """
+        AbstractClassicCacheHierarchy.__init__(self=self)
+        self._l1i_size = l1i_size
+        self._l1d_size = l1d_size
+
+        self.membus = SystemXBar(width=64)
+        self.membus.badaddr_responder = BadAddr()
+        self.membus.default = self.membus.badaddr_responder.pio
+
+    @overrides(AbstractClassicCacheHierarchy)
+    def get_mem_side_port(self) -> Port:
+        return self.membus.mem_side_ports
+
+    @overrides(AbstractClassicCacheHierarchy)
+    def get_cpu_side_port(self) -> Port:
+        return self.membus.cpu_side_ports
+
+    @overrides(AbstractCacheHierarchy)
+    def incorporate_cache(self, board: AbstractBoard) -> None:
+        # Set up the system port for functional access from the simulator.
+        board.connect_system_port(self.membus.cpu_side_ports)
+
+        for _, port in board.get_memory().get_mem_ports():
+            self.membus.mem_side_ports = port
+
+        num_cores = board.get_processor().get_num_cores()
+
+        self.l1icaches = [
+            L1ICache(size=self._l1i_size, assoc=4) for i in range(num_cores)
+        ]
+        self.l1dcaches = [
+            L1DCache(size=self._l1d_size, assoc=8, mshrs=2, tgts_per_mshr=4)
+            for i in range(num_cores)
+        ]
+        # CVA6 has no hardware prefetchers
+        for cache in self.l1icaches + self.l1dcaches:
+            cache.prefetcher = NULL
+
+        # ITLB Page walk caches
+        self.iptw_caches = [MMUCache(size="4KiB") for _ in range(num_cores)]
+        # DTLB Page walk caches
+        self.dptw_caches = [MMUCache(size="4KiB") for _ in range(num_cores)]
+
+        for i, cpu in enumerate(board.get_processor().get_cores()):
+            cpu.connect_icache(self.l1icaches[i].cpu_side)
+            cpu.connect_dcache(self.l1dcaches[i].cpu_side)
+
+            self.l1icaches[i].mem_side = self.membus.cpu_side_ports
+            self.l1dcaches[i].mem_side = self.membus.cpu_side_ports
+
+            self.iptw_caches[i].mem_side = self.membus.cpu_side_ports
+            self.dptw_caches[i].mem_side = self.membus.cpu_side_ports
+
+            cpu.connect_walker_ports(
+                self.iptw_caches[i].cpu_side, self.dptw_caches[i].cpu_side
+            )
+
+            if board.get_processor().get_isa() == ISA.X86:
+                int_req_port = self.membus.mem_side_ports
+                int_resp_port = self.membus.cpu_side_ports
+                cpu.connect_interrupt(int_req_port, int_resp_port)
+            else:
+                cpu.connect_interrupt()
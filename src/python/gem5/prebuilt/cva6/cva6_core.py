@@ -0,0 +1,207 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects import NULL
+from m5.objects.BaseMinorCPU import *
+from m5.objects.RiscvCPU import RiscvMinorCPU
+
+from gem5.components.processors.base_cpu_core import BaseCPUCore
+from gem5.isas import ISA
+
+
+class CVA6IntFU(MinorDefaultIntFU):
+    opLat = 1
+
+
+class CVA6IntMulFU(MinorDefaultIntMulFU):
+    opLat = 2
+
+
+class CVA6IntDivFU(MinorDefaultIntDivFU):
+    # The divider is serial and not pipelined
+    issueLat = 64
+    opLat = 64
+
+
+class CVA6FloatSimdFU(MinorDefaultFloatSimdFU):
+    opLat = 3
+
+
+class CVA6PredFU(MinorDefaultPredFU):
+    pass
+
+
+class CVA6MemReadFU(MinorDefaultMemFU):
+    opClasses = minorMakeOpClassSet(["MemRead", "FloatMemRead"])
+    opLat = 1
+
+
+class CVA6MemWriteFU(MinorDefaultMemFU):
+    opClasses = minorMakeOpClassSet(["MemWrite", "FloatMemWrite"])
+    opLat = 1
+
+
+class CVA6MiscFU(MinorDefaultMiscFU):
+    pass
+
+
+class CVA6VecFU(MinorDefaultVecFU):
+    pass
+
+
+class CVA6FUPool(MinorFUPool):
+    funcUnits = [
+        CVA6IntFU(),
+        CVA6IntMulFU(),
+        CVA6IntDivFU(),
+        CVA6FloatSimdFU(),
+        CVA6PredFU(),
+        CVA6MemReadFU(),
+        CVA6MemWriteFU(),
+        CVA6MiscFU(),
+        CVA6VecFU(),
+    ]
+
+
+class CVA6BP(LocalBP):
+    btb = SimpleBTB(numEntries=32)
+    ras = ReturnAddrStack(numEntries=2)
+    localPredictorSize = 128
+    localCtrBits = 2
+    indirectBranchPred = NULL
+
+
+class CVA6CPU(RiscvMinorCPU):
+    """
+    A MinorCPU configured as the single issue, in-order CVA6 (Ariane)
+    pipeline. The six CVA6 stages map onto the Minor stages as follows:
+
+    - PC generation: Fetch1
+    - Instruction fetch and the instruction queue: Fetch2
+    - Instruction decode: Decode
+    - Issue, execute and commit: Execute
+
+    The parameters that are changed from the MinorCPU defaults are:
+
+    - threadPolicy:
+        This is initialized to "SingleThreaded".
+    - decodeInputWidth, executeInputWidth, executeIssueLimit:
+        These are changed to 1 as CVA6 decodes and issues one instruction
+        per cycle.
+    - executeMaxInFlightInsts:
+        This models the issue scoreboard, which holds every issued
+        instruction until it commits. Issue stalls while it is full.
+    - executeCommitLimit:
+        This is the number of commit ports (2 by default). Only one memory
+        instruction commits per cycle.
+    - executeLSQStoreBufferSize:
+        This is the depth of the commit queue of the store unit, which
+        writes stores to the data cache after they commit.
+    - executeMaxAccessesInMemory:
+        This is changed from 2 to 1 as the data cache serves one miss at a
+        time.
+    - fetch2InputBufferSize, decodeInputBufferSize, executeInputBufferSize:
+        These are reduced to model the short instruction queue between
+        fetch and decode and the single issue register.
+    """
+
+    threadPolicy = "SingleThreaded"
+
+    # Fetch1 stage
+    fetch1LineSnapWidth = 0
+    fetch1LineWidth = 0
+    fetch1FetchLimit = 1
+    fetch1ToFetch2ForwardDelay = 1
+    fetch1ToFetch2BackwardDelay = 1
+
+    # Fetch2 stage
+    fetch2InputBufferSize = 2
+    fetch2ToDecodeForwardDelay = 1
+    fetch2CycleInput = True
+
+    # Decode stage
+    decodeInputBufferSize = 2
+    decodeToExecuteForwardDelay = 1
+    decodeInputWidth = 1
+    decodeCycleInput = True
+
+    # Execute stage
+    executeInputWidth = 1
+    executeCycleInput = True
+    executeIssueLimit = 1
+    executeMemoryIssueLimit = 1
+    executeCommitLimit = 2
+    executeMemoryCommitLimit = 1
+    executeInputBufferSize = 1
+    executeMaxInFlightInsts = 8
+    executeMaxAccessesInMemory = 1
+    executeLSQMaxStoreBufferStoresPerCycle = 1
+    executeLSQRequestsQueueSize = 1
+    executeLSQTransfersQueueSize = 2
+    executeLSQStoreBufferSize = 4
+    executeBranchDelay = 1
+    executeSetTraceTimeOnCommit = True
+    executeSetTraceTimeOnIssue = False
+    executeAllowEarlyMemoryIssue = True
+
+    # Functional Units and Branch Prediction
+    executeFuncUnits = CVA6FUPool()
+    branchPred = CVA6BP()
+
+
+class CVA6Core(BaseCPUCore):
+    """
+    CVA6Core models a CVA6 (Ariane) application class core. The core has a
+    single thread.
+
+    The latencies of the functional units are:
+      - IntFU: 1 cycle
+      - IntMulFU: 2 cycles
+      - IntDivFU: 64 cycles, not pipelined (NOTE: the latency is variable
+        in hardware, this is the worst case for 64 bit operands)
+      - FloatSimdFU: 3 cycles
+      - MemReadFU: 1 cycle
+      - MemWriteFU: 1 cycle
+    The branch predictor is a 128 entry table of 2 bit counters with a
+    32 entry BTB and a 2 entry RAS. There is no indirect predictor.
+    """
+
+    def __init__(
+        self,
+        core_id: int,
+        scoreboard_entries: int = 8,
+        commit_ports: int = 2,
+    ):
+        """
+        :param core_id: The ID of the core.
+        :param scoreboard_entries: The number of issue scoreboard entries,
+                                   i.e., how many issued instructions may
+                                   wait to commit.
+        :param commit_ports: The number of instructions committed per cycle.
+        """
+        super().__init__(core=CVA6CPU(cpu_id=core_id), isa=ISA.RISCV)
+        self.core.executeMaxInFlightInsts = scoreboard_entries
+        self.core.executeCommitLimit = commit_ports
+        self.core.isa[0].enable_rvv = False
+        self.core.mmu.itb.size = 16
+        self.core.mmu.dtb.size = 16
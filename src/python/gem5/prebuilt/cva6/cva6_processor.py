@@ -0,0 +1,57 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from gem5.components.processors.base_cpu_processor import BaseCPUProcessor
+from gem5.components.processors.cpu_types import CPUTypes
+
+from .cva6_core import CVA6Core
+
+
+class CVA6Processor(BaseCPUProcessor):
+    """
+    A CVA6Processor contains a number of cores of CVA6Core.
+    """
+
+    def __init__(
+        self,
+        num_cores: int = 1,
+        scoreboard_entries: int = 8,
+        commit_ports: int = 2,
+    ) -> None:
+        """
+        :param num_cores: The number of cores.
+        :param scoreboard_entries: The number of issue scoreboard entries of
+                                   each core.
+        :param commit_ports: The number of commit ports of each core.
+        """
+        self._cpu_type = CPUTypes.MINOR
+        super().__init__(
+            cores=[
+                CVA6Core(
+                    core_id=i,
+                    scoreboard_entries=scoreboard_entries,
+                    commit_ports=commit_ports,
+                )
+                for i in range(num_cores)
+            ]
+        )
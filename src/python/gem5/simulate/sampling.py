@@ -0,0 +1,311 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Systematic sampling of a workload on detailed CPUs, in the style of SMARTS
+(Wunderlich et al., ISCA 2003).
+
+The workload runs on the functional (``ATOMIC``) cores of a
+``SimpleSwitchableProcessor``, which keep the caches and branch predictors
+warm.
+Every ``period`` instructions the processor switches to the detailed cores
+(``O3`` or ``MINOR``), runs ``detailed_warmup`` instructions to fill the
+pipeline and then measures the IPC of the next ``unit_size`` instructions.
+The sampler stops the simulation once the confidence interval of the mean
+IPC is within ``target_error`` of the mean.
+
+.. code-block:: python
+
+    sampler = SMARTSSampler(board=board, unit_size=1000, period=1000000)
+    simulator = Simulator(
+        board=board,
+        on_exit_event={ExitEvent.MAX_INSTS: sampler.get_generator()},
+    )
+    simulator.run()
+    print(sampler.get_summary())
+
+The sampler drives the ``MAX_INSTS`` exit event, so it cannot be combined
+with ``Simulator.schedule_max_insts``.
+"""
+
+import json
+from enum import Enum
+from math import sqrt
+from pathlib import Path
+from statistics import (
+    NormalDist,
+    mean,
+    stdev,
+)
+from typing import (
+    Dict,
+    Generator,
+    List,
+    Optional,
+)
+
+import m5
+import m5.stats
+from m5.util import warn
+
+from ..components.boards.abstract_board import AbstractBoard
+from ..components.processors.cpu_types import CPUTypes
+from ..components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+
+
+class _Phase(Enum):
+    FUNCTIONAL = "functional warming"
+    DETAILED_WARMUP = "detailed warming"
+    MEASUREMENT = "measurement"
+
+
+class SMARTSSampler:
+    """
+    Alternates functional warming, detailed warming and measurement units on
+    a ``SimpleSwitchableProcessor`` and estimates the mean IPC of the
+    workload with a confidence interval.
+
+    The processor must start on the ATOMIC cores. Instruction counts are
+    taken from the first core; the IPC of a unit is the number of
+    instructions committed by all cores over the cycles of the unit.
+    """
+
+    def __init__(
+        self,
+        board: AbstractBoard,
+        unit_size: int = 1000,
+        detailed_warmup: int = 2000,
+        period: int = 1000000,
+        target_error: float = 0.03,
+        confidence: float = 0.997,
+        min_units: int = 30,
+        max_units: Optional[int] = None,
+        dump_stats: bool = False,
+    ) -> None:
+        """
+        :param board: The board to sample. Its processor must be a
+                      ``SimpleSwitchableProcessor`` starting on the
+                      ``ATOMIC`` cores.
+        :param unit_size: The number of instructions measured per unit.
+        :param detailed_warmup: The number of instructions run on the
+                                detailed cores before each unit.
+        :param period: The number of instructions from the start of one
+                       unit to the start of the next.
+        :param target_error: The relative half-width of the confidence
+                             interval at which sampling stops.
+        :param confidence: The confidence level of the interval.
+        :param min_units: The number of units to measure before testing the
+                          error.
+        :param max_units: Stop after this many units, even if the target
+                          error has not been reached. ``None`` for no limit.
+        :param dump_stats: If ``True``, the stats are reset at the start of
+                           each unit and dumped at its end, so every unit
+                           appears as a separate dump in the stats output.
+        """
+        processor = board.get_processor()
+        if not isinstance(processor, SimpleSwitchableProcessor):
+            raise Exception(
+                "SMARTS sampling requires a SimpleSwitchableProcessor."
+            )
+        if unit_size <= 0:
+            raise Exception("The unit size must be a positive integer.")
+        if detailed_warmup < 0:
+            raise Exception("The detailed warmup cannot be negative.")
+        if period <= unit_size + detailed_warmup:
+            raise Exception(
+                "The sampling period must be larger than the detailed "
+                "warmup and the unit size combined."
+            )
+        if not 0 < confidence < 1:
+            raise Exception("The confidence must be between 0 and 1.")
+        if min_units < 2:
+            raise Exception("At least two units are needed for an error.")
+
+        cores = processor.get_cores()
+        if cores[0].get_type() != CPUTypes.ATOMIC:
+            raise Exception(
+                "SMARTS sampling requires the processor to start on the "
+                "ATOMIC cores, which do the functional warming, and switch "
+                "to the detailed cores for the measurements."
+            )
+        if len(cores) > 1:
+            warn(
+                "Sampling units are delimited by the instructions of the "
+                "first core only."
+            )
+
+        self._board = board
+        self._processor = processor
+        self._unit_size = unit_size
+        self._detailed_warmup = detailed_warmup
+        self._functional = period - unit_size - detailed_warmup
+        self._target_error = target_error
+        self._z = NormalDist().inv_cdf((1 + confidence) / 2)
+        self._confidence = confidence
+        self._min_units = min_units
+        self._max_units = max_units
+        self._dump_stats = dump_stats
+
+        self._phase = _Phase.FUNCTIONAL
+        self._ticks_per_cycle = None
+        self._unit_start_tick = 0
+        self._unit_start_insts = 0
+        self._units: List[Dict] = []
+
+        # The first exit is scheduled as a parameter since the cores have
+        # not been instantiated yet.
+        cores[0]._set_inst_stop_any_thread(self._functional, False)
+
+    def _schedule(self, insts: int) -> None:
+        self._processor.get_cores()[0]._set_inst_stop_any_thread(insts, True)
+
+    def _total_insts(self) -> int:
+        return sum(
+            core.get_simobject().totalInsts()
+            for core in self._processor.get_cores()
+        )
+
+    def _begin_unit(self) -> None:
+        if self._dump_stats:
+            m5.stats.reset()
+        self._unit_start_tick = m5.curTick()
+        self._unit_start_insts = self._total_insts()
+
+    def _end_unit(self) -> None:
+        if self._dump_stats:
+            m5.stats.dump()
+        if self._ticks_per_cycle is None:
+            clock = self._board.get_clock_domain().clock[0]
+            self._ticks_per_cycle = clock.getValue()
+
+        insts = self._total_insts() - self._unit_start_insts
+        cycles = (m5.curTick() - self._unit_start_tick) / self._ticks_per_cycle
+        self._units.append(
+            {
+                "start_tick": self._unit_start_tick,
+                "insts": insts,
+                "cycles": cycles,
+                "ipc": insts / cycles if cycles else 0.0,
+            }
+        )
+
+    def _done(self) -> bool:
+        count = len(self._units)
+        if self._max_units is not None and count >= self._max_units:
+            return True
+        if count < self._min_units:
+            return False
+        error = self.get_relative_error()
+        return error is not None and error <= self._target_error
+
+    def get_generator(self) -> Generator[bool, None, None]:
+        """
+        Returns the generator to handle the ``MAX_INSTS`` exit event with.
+        It yields ``True``, ending the simulation loop, once the target error
+        or ``max_units`` is reached. Running the simulator again resumes
+        sampling.
+        """
+        while True:
+            if self._phase == _Phase.FUNCTIONAL:
+                self._processor.switch()
+                if self._detailed_warmup:
+                    self._phase = _Phase.DETAILED_WARMUP
+                    self._schedule(self._detailed_warmup)
+                else:
+                    self._phase = _Phase.MEASUREMENT
+                    self._begin_unit()
+                    self._schedule(self._unit_size)
+            elif self._phase == _Phase.DETAILED_WARMUP:
+                self._phase = _Phase.MEASUREMENT
+                self._begin_unit()
+                self._schedule(self._unit_size)
+            else:
+                self._end_unit()
+                self._processor.switch()
+                self._phase = _Phase.FUNCTIONAL
+                self._schedule(self._functional)
+                if self._done():
+                    yield True
+                    continue
+            yield False
+
+    def get_units(self) -> List[Dict]:
+        """
+        Returns the measured units, in order. Each unit is a dictionary with
+        its ``start_tick``, ``insts``, ``cycles`` and ``ipc``.
+        """
+        return self._units
+
+    def get_ipc(self) -> Optional[float]:
+        """Returns the mean IPC over the measured units."""
+        if not self._units:
+            return None
+        return mean(unit["ipc"] for unit in self._units)
+
+    def get_confidence_interval(self) -> Optional[float]:
+        """
+        Returns the half-width of the confidence interval of the mean IPC,
+        or ``None`` if fewer than two units have been measured.
+        """
+        if len(self._units) < 2:
+            return None
+        ipcs = [unit["ipc"] for unit in self._units]
+        return self._z * stdev(ipcs) / sqrt(len(ipcs))
+
+    def get_relative_error(self) -> Optional[float]:
+        """
+        Returns the half-width of the confidence interval relative to the
+        mean IPC.
+        """
+        interval = self.get_confidence_interval()
+        ipc = self.get_ipc()
+        if interval is None or not ipc:
+            return None
+        return interval / ipc
+
+    def get_summary(self) -> Dict:
+        """Returns the estimate and the sampling parameters."""
+        return {
+            "ipc": self.get_ipc(),
+            "confidence_interval": self.get_confidence_interval(),
+            "relative_error": self.get_relative_error(),
+            "confidence": self._confidence,
+            "target_error": self._target_error,
+            "num_units": len(self._units),
+            "unit_size": self._unit_size,
+            "detailed_warmup": self._detailed_warmup,
+            "period": self._functional
+            + self._detailed_warmup
+            + self._unit_size,
+        }
+
+    def write_json(self, path: Path) -> None:
+        """Writes the summary and the measured units to a JSON file."""
+        with open(path, "w") as f:
+            json.dump(
+                {"summary": self.get_summary(), "units": self._units},
+                f,
+                indent=4,
+            )
@@ -0,0 +1,482 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This file contains a driver which runs the regions of a sampled workload
+(e.g., SimPoints or LoopPoint regions) in parallel, one gem5 process per
+region, and merges the stats of the regions weighted by their weights.
+
+Only counters add up over the regions: the merged value of a counter is
+the sum of its values in each region times the weight of the region.
+Ratios and rates (e.g., ``ipc``, miss rates, ``simFreq``) are merged as
+the mean of their values weighted by the region weights instead, which is
+an estimate: the exact value is the ratio of the merged counters it is
+computed from (e.g., ``committedInsts / numCycles``).
+
+Each region is run by a configuration script which restores the checkpoint
+of the region and simulates it. The script is run once per region with the
+arguments given to the driver, where ``{region}`` is replaced by the region
+id and ``{checkpoint}`` by the checkpoint path of the region, if any. The
+outputs of a region go to ``<outdir>/region<id>``.
+"""
+
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+from pathlib import Path
+from typing import (
+    Dict,
+    Iterable,
+    List,
+    Optional,
+    Tuple,
+    Union,
+)
+
+from m5.util import warn
+from m5.util.convert import toMemorySize
+
+from ...resources.looppoint import Looppoint
+from ...resources.resource import SimpointResource
+from ._command_line import _gem5_args_for_multiprocessing
+
+
+class Region:
+    """A region to run, with its weight in the merged stats."""
+
+    def __init__(
+        self,
+        region_id: Union[int, str],
+        weight: float,
+        checkpoint: Optional[Path] = None,
+    ) -> None:
+        """
+        :param region_id: The id of the region. It names the output
+                          directory of the region.
+        :param weight: The weight of the region. The merged counters are
+                       the sum of the counters of each region times its
+                       weight.
+        :param checkpoint: The checkpoint the region is restored from.
+        """
+        self.region_id = region_id
+        self.weight = weight
+        self.checkpoint = checkpoint
+
+    def get_name(self) -> str:
+        return f"region{self.region_id}"
+
+
+def simpoint_regions(
+    simpoint: SimpointResource, checkpoint_dir: Optional[Path] = None
+) -> List[Region]:
+    """
+    Returns a region per SimPoint, weighted by the SimPoint weights. The
+    checkpoints are named as ``simpoints_save_checkpoint_generator`` names
+    them.
+    """
+    return [
+        Region(
+            region_id=i,
+            weight=weight,
+            checkpoint=(
+                checkpoint_dir / f"cpt.SimPoint{i}" if checkpoint_dir else None
+            ),
+        )
+        for i, weight in enumerate(simpoint.get_weight_list())
+    ]
+
+
+def looppoint_regions(
+    looppoint: Looppoint, checkpoint_dir: Optional[Path] = None
+) -> List[Region]:
+    """
+    Returns a region per LoopPoint region, weighted by the region
+    multipliers, so the merged stats extrapolate to the whole workload. The
+    checkpoints are named as ``looppoint_save_checkpoint_generator`` names
+    them.
+    """
+    return [
+        Region(
+            region_id=rid,
+            weight=region.get_multiplier(),
+            checkpoint=(
+                checkpoint_dir / f"cpt.Region{rid}" if checkpoint_dir else None
+            ),
+        )
+        for rid, region in looppoint.get_regions().items()
+    ]
+
+
+def _read_proc_kib(path: str, field: str) -> Optional[int]:
+    """Returns a field of a /proc status file in bytes."""
+    try:
+        with open(path) as f:
+            for line in f:
+                if line.startswith(field + ":"):
+                    return int(line.split()[1]) * 1024
+    except OSError:
+        pass
+    return None
+
+
+def _available_memory() -> Optional[int]:
+    return _read_proc_kib("/proc/meminfo", "MemAvailable")
+
+
+# The units of the stats which add up over the regions.
+_COUNTER_UNITS = {"Count", "Cycle", "Tick", "Second", "Bit", "Byte", "Joule"}
+
+# The unit at the end of a line of a text stats file, e.g., "(Count)" or
+# "((Count/Cycle))".
+_UNIT_RE = re.compile(r"\((\w+|\(\w+/\w+\))\)$")
+
+
+def stat_kind(name: str, unit: Optional[str]) -> str:
+    """
+    Returns how a stat is merged over the regions, from its name and its
+    unit in the text stats file:
+
+    * ``counter``: an event count or an amount (e.g., cycles, bytes,
+      seconds), merged by weighted sum.
+    * ``ratio``: a ratio, a rate, a mean or a level (e.g., ipc, miss
+      rates, ``simFreq``, power), merged by weighted mean.
+    * ``min`` and ``max``: extremes, merged by taking the extreme.
+    * ``unknown``: a stat without a unit, which is not merged.
+    """
+    field = name.rsplit("::", 1)[1] if "::" in name else ""
+    if field == "min_value":
+        return "min"
+    if field == "max_value" or name.endswith("hostMemory"):
+        return "max"
+    if field in ("mean", "gmean", "stdev"):
+        return "ratio"
+    if unit is None:
+        return "unknown"
+    return "counter" if unit in _COUNTER_UNITS else "ratio"
+
+
+def _parse_text_stats(
+    path: Path, dump: int
+) -> Dict[str, Tuple[float, Optional[str]]]:
+    """
+    Returns the numeric stats of a dump in a text stats file, with their
+    units. Vector and distribution entries are kept under their full names
+    (e.g., ``system.cpu.op_class::IntAlu``) with their first value.
+    """
+    dumps = []
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- Begin"):
+                dumps.append({})
+                continue
+            if not dumps or line.startswith("----------"):
+                continue
+            fields = line.split("#", 1)[0].split()
+            if len(fields) < 2:
+                continue
+            try:
+                value = float(fields[1])
+            except ValueError:
+                continue
+            if math.isfinite(value):
+                unit = _UNIT_RE.search(line.rstrip())
+                dumps[-1][fields[0]] = (value, unit and unit.group(1))
+    if not dumps:
+        return {}
+    return dumps[dump]
+
+
+def merge_region_stats(
+    regions: Iterable[Tuple[float, Dict[str, Tuple[float, Optional[str]]]]],
+    normalize: bool = False,
+) -> Dict[str, Dict[str, Union[str, float]]]:
+    """
+    Merges the stats of regions, given as pairs of the weight of a region
+    and its stats, as ``_parse_text_stats`` returns them. Returns the kind
+    (see ``stat_kind``) and the merged value of each stat.
+
+    :param normalize: If ``True``, divide the sums of the counters by the
+                      total weight of the regions. Use this with SimPoint
+                      weights when some regions have failed.
+    """
+    kinds = {}
+    sums = {}
+    weights = {}
+    total_weight = 0.0
+    for weight, stats in regions:
+        total_weight += weight
+        for name, (value, unit) in stats.items():
+            kind = kinds.setdefault(name, stat_kind(name, unit))
+            if kind in ("counter", "ratio"):
+                sums[name] = sums.get(name, 0.0) + weight * value
+                weights[name] = weights.get(name, 0.0) + weight
+            elif kind == "min":
+                sums[name] = min(sums.get(name, value), value)
+            elif kind == "max":
+                sums[name] = max(sums.get(name, value), value)
+
+    merged = {}
+    for name, kind in kinds.items():
+        value = sums.get(name)
+        if kind == "ratio":
+            value = value / weights[name] if weights[name] else None
+        elif kind == "counter" and normalize and total_weight:
+            value /= total_weight
+        merged[name] = {"kind": kind, "value": value}
+    return merged
+
+
+class RegionRunner:
+    """
+    Runs regions in parallel, each in its own gem5 process, and merges their
+    stats.
+
+    A region is started when fewer than ``max_processes`` regions are
+    running and the host has enough memory available for it. The memory of
+    a region is ``memory_per_region`` if given. Otherwise it is the largest
+    peak memory of the regions seen so far, and regions are started one at
+    a time until a region has run for ``learn_time`` seconds. The memory a
+    running region may still grow into is kept free for it.
+    """
+
+    def __init__(
+        self,
+        regions: List[Region],
+        config: Union[str, Path],
+        config_args: Optional[List[str]] = None,
+        max_processes: Optional[int] = None,
+        memory_per_region: Optional[str] = None,
+        learn_time: float = 30.0,
+        poll_interval: float = 1.0,
+        stats_dump: int = -1,
+    ) -> None:
+        """
+        :param regions: The regions to run.
+        :param config: The configuration script which runs a region.
+        :param config_args: The arguments to the configuration script.
+                            ``{region}`` and ``{checkpoint}`` are replaced by
+                            the id and the checkpoint of the region.
+        :param max_processes: The maximum number of regions running at once.
+                              Defaults to the number of host CPUs.
+        :param memory_per_region: The host memory a region needs (e.g.,
+                                  "4GiB"). If ``None``, it is measured.
+        :param learn_time: The time the first region runs alone for when
+                           the memory of a region is measured.
+        :param poll_interval: The time between checks of the running
+                              regions, in seconds.
+        :param stats_dump: The dump in the stats file of each region which
+                           holds the stats of the region. Defaults to the
+                           last dump.
+        """
+        from m5 import options
+
+        if not regions:
+            raise Exception("No regions to run.")
+        if len({region.get_name() for region in regions}) != len(regions):
+            raise Exception("The region ids must be unique.")
+        if "://" in options.stats_file:
+            raise Exception(
+                "The stats of the regions can only be merged from text "
+                "stats files."
+            )
+
+        self._regions = regions
+        self._config = Path(config)
+        self._config_args = config_args or []
+        self._max_processes = max_processes or os.cpu_count() or 1
+        self._memory_per_region = (
+            toMemorySize(memory_per_region) if memory_per_region else None
+        )
+        self._learn_time = learn_time
+        self._poll_interval = poll_interval
+        self._stats_dump = stats_dump
+        self._outdir = Path(options.outdir)
+        self._stats_file = options.stats_file
+
+        # The largest peak memory of a region seen so far, in bytes.
+        self._peak_memory = 0
+        self._results: Dict[str, Dict] = {}
+
+    def _command(self, region: Region) -> List[str]:
+        args = [
+            arg.format(
+                region=region.region_id,
+                checkpoint=region.checkpoint or "",
+            )
+            for arg in self._config_args
+        ]
+        return (
+            [sys.executable]
+            + _gem5_args_for_multiprocessing(region.get_name())
+            + ["--redirect-stdout", "--redirect-stderr", "--silent-redirect"]
+            + [self._config.as_posix()]
+            + args
+        )
+
+    def _region_memory(self) -> Optional[int]:
+        if self._memory_per_region:
+            return self._memory_per_region
+        return self._peak_memory or None
+
+    def _can_start(self, running: Dict) -> bool:
+        if not running:
+            return True
+        if len(running) >= self._max_processes:
+            return False
+
+        needed = self._region_memory()
+        if needed is None:
+            # Nothing is known about the memory of a region yet. Wait for
+            # the first region to run for a while before starting more.
+            return False
+
+        available = _available_memory()
+        if available is None:
+            return True
+
+        # Keep free the memory the running regions have yet to allocate.
+        for state in running.values():
+            pid = state["proc"].pid
+            rss = _read_proc_kib(f"/proc/{pid}/status", "VmRSS") or 0
+            available -= max(0, needed - rss)
+        return available >= needed
+
+    def _update_peak_memory(self, running: Dict) -> None:
+        now = time.monotonic()
+        for state in running.values():
+            pid = state["proc"].pid
+            hwm = _read_proc_kib(f"/proc/{pid}/status", "VmHWM")
+            state["peak"] = max(state["peak"], hwm or 0)
+            # Regions which are still starting up have not reached their
+            # peak yet.
+            if now - state["start"] >= self._learn_time:
+                self._peak_memory = max(self._peak_memory, state["peak"])
+
+    def run(self) -> None:
+        """
+        Runs all the regions and returns when they have all finished. The
+        gem5 options of this process (e.g., ``--stats-file``) are forwarded
+        to the region processes.
+        """
+        pending = list(self._regions)
+        running = {}
+
+        while pending or running:
+            self._update_peak_memory(running)
+
+            for name, state in list(running.items()):
+                proc = state["proc"]
+                if proc.poll() is None:
+                    continue
+                del running[name]
+                self._peak_memory = max(self._peak_memory, state["peak"])
+                result = self._results[name]
+                result["exit_code"] = proc.returncode
+                result["seconds"] = time.monotonic() - state["start"]
+                result["peak_memory"] = state["peak"]
+                if proc.returncode != 0:
+                    warn(
+                        f"Region {result['region']} failed with exit code "
+                        f"{proc.returncode}. See {self._outdir / name}."
+                    )
+
+            while pending and self._can_start(running):
+                region = pending.pop(0)
+                name = region.get_name()
+                (self._outdir / name).mkdir(parents=True, exist_ok=True)
+                proc = subprocess.Popen(
+                    self._command(region), stdin=subprocess.DEVNULL
+                )
+                running[name] = {
+                    "proc": proc,
+                    "start": time.monotonic(),
+                    "peak": 0,
+                }
+                self._results[name] = {
+                    "region": region.region_id,
+                    "weight": region.weight,
+                    "outdir": (self._outdir / name).as_posix(),
+                }
+                print(f"Started region {region.region_id} (pid {proc.pid}).")
+
+            if running:
+                time.sleep(self._poll_interval)
+
+    def get_weighted_stats(
+        self, normalize: bool = False
+    ) -> Dict[str, Dict[str, Union[str, float]]]:
+        """
+        Returns the stats merged over the regions that completed, with
+        their kinds (see ``merge_region_stats``): the weighted sums of the
+        counters and the weighted means of the ratios.
+
+        :param normalize: If ``True``, divide the sums of the counters by
+                          the total weight of the completed regions. Use
+                          this with SimPoint weights when some regions have
+                          failed.
+        """
+        regions = []
+        for region in self._regions:
+            result = self._results.get(region.get_name(), {})
+            if result.get("exit_code") != 0:
+                continue
+            stats_path = Path(result["outdir"]) / self._stats_file
+            try:
+                stats = _parse_text_stats(stats_path, self._stats_dump)
+            except (OSError, IndexError):
+                warn(f"No stats for region {region.region_id}.")
+                continue
+            regions.append((region.weight, stats))
+        return merge_region_stats(regions, normalize)
+
+    def get_failed_regions(self) -> List[Region]:
+        """Returns the regions which did not complete successfully."""
+        return [
+            region
+            for region in self._regions
+            if self._results.get(region.get_name(), {}).get("exit_code") != 0
+        ]
+
+    def write_report(self, path: Path, normalize: bool = False) -> None:
+        """
+        Writes the results of each region and the merged stats to a JSON
+        file. Each stat gives its kind, which says how it was merged, and
+        its merged value.
+        """
+        failed = self.get_failed_regions()
+        with open(path, "w") as f:
+            json.dump(
+                {
+                    "regions": list(self._results.values()),
+                    "failed": [region.region_id for region in failed],
+                    "missing_weight": sum(region.weight for region in failed),
+                    "peak_memory": self._peak_memory,
+                    "stats": self.get_weighted_stats(normalize),
+                },
+                f,
+                indent=4,
+            )
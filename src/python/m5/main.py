@@ -227,6 +227,20 @@ def parse_options():
         default="stats.txt",
         help="Sets the output file for statistics [Default: %default]",
     )
+    option(
+        "--stats-filter",
+        metavar="REGEX",
+        action="append",
+        default=[],
+        help="Only dump the stats whose full name matches REGEX, e.g. "
+        "'system\\.cpu\\d*\\.ipc' (can be given multiple times)",
+    )
+    option(
+        "--stats-skip-zero",
+        action="store_true",
+        default=False,
+        help="Don't dump the stats whose values are all zero",
+    )
     option(
         "--stats-help",
         action="callback",
@@ -558,6 +572,7 @@ def main():
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    stats.setDumpFilter(options.stats_filter, options.stats_skip_zero)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -190,6 +190,30 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin"])
+def _binaryFactory(fn, desc=True, formulas=True):
+    """Output stats in a compact binary format.
+
+    The binary stat file describes the stats once and then only records
+    the values that changed at each dump, which makes frequent periodic
+    dumps cheap to write and small. Use m5.stats.binary.BinaryStats to
+    load selected stats as numpy arrays.
+
+    Known limitations:
+      * Sparse histograms currently unsupported.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+
+    Example:
+      bin://stats.bin?desc=False
+
+    """
+
+    return _m5.stats.initBinary(fn, desc, formulas)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -356,7 +380,70 @@ def prepare():
     _visit_stats(lambda g, s: s.prepare())
 
 
+# Filter of the stats to dump, None to dump them all
+dump_filter = None
+
+
+def setDumpFilter(patterns=None, skip_zero=False):
+    """Select the stats of the stat groups that the dumps output
+
+    Only the stats whose full names, e.g. system.cpu.ipc, match one of the
+    regular expressions are prepared and output, and the stat groups are
+    walked in C++, which makes dumps of large systems much faster. The
+    JSON output is not filtered.
+
+    Arguments:
+        patterns: Regular expressions matching the full names of the
+                  stats to dump. All the stats are dumped if empty.
+        skip_zero: Also skip the stats whose values are all zero, e.g.
+                   that were not touched since the last reset. Outputs
+                   only recording changes, like bin://, still get the
+                   stats they recorded before, so that they see them
+                   become zero.
+    """
+
+    global dump_filter
+    if not patterns and not skip_zero:
+        dump_filter = None
+        return
+
+    try:
+        dump_filter = _m5.stats.DumpFilter(list(patterns or []), skip_zero)
+    except RuntimeError as e:
+        fatal(f"Invalid stat filter {patterns}: {e}")
+
+
+def _prepare_filtered():
+    # Legacy stats
+    for stat in stats_list:
+        stat.prepare()
+
+    # New stats
+    dump_filter.prepare(Root.getInstance().getCCObject())
+
+
+def _dump_filtered(visitor, roots):
+    if roots:
+        for root in roots:
+            for p in root.path_list():
+                visitor.beginGroup(p)
+            path = ".".join(root.path_list())
+            dump_filter.visit(root.getCCObject(), visitor, path)
+            for p in reversed(root.path_list()):
+                visitor.endGroup()
+    else:
+        dump_filter.visit(Root.getInstance().getCCObject(), visitor)
+
+        # Legacy stats
+        for stat in stats_list:
+            stat.visit(visitor)
+
+
 def _dump_to_visitor(visitor, roots=None):
+    if dump_filter is not None:
+        _dump_filtered(visitor, roots)
+        return
+
     # New stats
     def dump_group(group):
         for stat in group.getStats():
@@ -415,19 +502,30 @@ def dump(roots=None):
         sim_root = Root.getInstance()
         if sim_root:
             sim_root.preDumpStats()
-        prepare()
 
-    for output in outputList:
-        if isinstance(output, JsonOutputVistor):
-            if not all_roots:
-                output.dump(Root.getInstance())
+    # The stats don't change until the end of the dump, so evaluate each
+    # formula once however many formulas and outputs read it.
+    _m5.stats.beginFormulaCache()
+    try:
+        if new_dump:
+            if dump_filter is not None:
+                _prepare_filtered()
             else:
-                output.dump(all_roots)
-        else:
-            if output.valid():
-                output.begin()
-                _dump_to_visitor(output, roots=all_roots)
-                output.end()
+                prepare()
+
+        for output in outputList:
+            if isinstance(output, JsonOutputVistor):
+                if not all_roots:
+                    output.dump(Root.getInstance())
+                else:
+                    output.dump(all_roots)
+            else:
+                if output.valid():
+                    output.begin()
+                    _dump_to_visitor(output, roots=all_roots)
+                    output.end()
+    finally:
+        _m5.stats.endFormulaCache()
 
 
 def reset():
@@ -0,0 +1,250 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Reader of the binary stat files written by the bin:// stat output (see
+src/base/stats/binary.hh). It only depends on the standard library and
+numpy, so it also works outside of gem5, e.g.:
+
+    python3 src/python/m5/stats/binary.py m5out/stats.bin "system.cpu.ipc"
+
+prints the selected stats, which may be given as shell-style patterns, at
+every dump. From Python:
+
+    stats = BinaryStats("m5out/stats.bin")
+    ipc = stats.load(["system.cpu.ipc"])["system.cpu.ipc"]
+"""
+
+import fnmatch
+import gzip
+import struct
+from typing import (
+    Dict,
+    Iterable,
+    List,
+)
+
+KINDS = ["scalar", "vector", "dist", "vector_dist", "vector2d", "formula"]
+
+
+class BinaryStat:
+    """Description of a stat in a binary stat file"""
+
+    def __init__(self, name, kind, unit, desc, labels):
+        self.name = name
+        self.kind = kind
+        self.unit = unit
+        self.desc = desc
+        self.labels = labels
+
+
+class BinaryStats:
+    """
+    A binary stat file. Opening it reads the description of the stats and
+    the ticks of the dumps; the values are only decoded by load(), for the
+    stats asked for.
+    """
+
+    def __init__(self, path: str):
+        opener = open
+        with open(path, "rb") as f:
+            if f.read(2) == b"\x1f\x8b":
+                opener = gzip.open
+        with opener(path, "rb") as f:
+            self._data = f.read()
+
+        if self._data[:8] != b"gem5stat":
+            raise ValueError(f"{path} is not a binary stat file")
+        (version,) = struct.unpack_from("<I", self._data, 8)
+        if version != 1:
+            raise ValueError(f"{path} has an unsupported version {version}")
+
+        self.stats: List[BinaryStat] = []
+        self._by_name: Dict[str, int] = {}
+        self.ticks: List[int] = []
+        self._records()
+
+    def _varint(self, pos):
+        result = 0
+        shift = 0
+        data = self._data
+        while True:
+            b = data[pos]
+            pos += 1
+            result |= (b & 0x7F) << shift
+            if not (b & 0x80):
+                return result, pos
+            shift += 7
+
+    def _string(self, pos):
+        size, pos = self._varint(pos)
+        return self._data[pos : pos + size].decode(), pos + size
+
+    def _records(self, decode=None):
+        """
+        Walk the records of the file, calling decode(dump, id, changes)
+        for the values of the stats in decode's keys, where changes is a
+        list of (index, value) pairs or None with all the values.
+        """
+        data = self._data
+        pos = 12
+        dump = 0
+        while pos < len(data):
+            tag = data[pos : pos + 1]
+            pos += 1
+            if tag == b"S":
+                count, pos = self._varint(pos)
+                for _ in range(count):
+                    name, pos = self._string(pos)
+                    kind = KINDS[data[pos]]
+                    unit, pos = self._string(pos + 1)
+                    desc, pos = self._string(pos)
+                    num_labels, pos = self._varint(pos)
+                    labels = []
+                    for _ in range(num_labels):
+                        label, pos = self._string(pos)
+                        labels.append(label)
+                    if decode is None:
+                        self._by_name[name] = len(self.stats)
+                        self.stats.append(
+                            BinaryStat(name, kind, unit, desc, labels)
+                        )
+            elif tag == b"D":
+                (tick,) = struct.unpack_from("<Q", data, pos)
+                pos += 8
+                if decode is None:
+                    self.ticks.append(tick)
+                count, pos = self._varint(pos)
+                for _ in range(count):
+                    stat, pos = self._varint(pos)
+                    changed, pos = self._varint(pos)
+                    wanted = decode is not None and stat in decode
+                    if changed == len(self.stats[stat].labels):
+                        if wanted:
+                            values = struct.unpack_from(
+                                f"<{changed}d", data, pos
+                            )
+                            decode[stat](dump, None, values)
+                        pos += 8 * changed
+                    else:
+                        pairs = []
+                        for _ in range(changed):
+                            index, pos = self._varint(pos)
+                            if wanted:
+                                (value,) = struct.unpack_from("<d", data, pos)
+                                pairs.append((index, value))
+                            pos += 8
+                        if wanted:
+                            decode[stat](dump, pairs, None)
+                dump += 1
+            else:
+                raise ValueError(f"Corrupt binary stat file at {pos - 1}")
+
+    def names(self, pattern: str = "*") -> List[str]:
+        """Names of the stats matching a shell-style pattern"""
+        return [s.name for s in self.stats if fnmatch.fnmatch(s.name, pattern)]
+
+    def stat(self, name: str) -> BinaryStat:
+        return self.stats[self._by_name[name]]
+
+    def load(self, patterns: Iterable[str]) -> Dict[str, "numpy.ndarray"]:
+        """
+        Load the values of the stats matching the given names or
+        shell-style patterns at every dump. Each stat gives an array with
+        a row per dump and a column per value, or a single column for a
+        scalar. Dumps before a stat first appears are NaN.
+        """
+        import numpy
+
+        selected = {}
+        for pattern in patterns:
+            for name in self.names(pattern):
+                stat = self._by_name[name]
+                width = len(self.stats[stat].labels)
+                selected[stat] = numpy.full(
+                    (len(self.ticks), width), numpy.nan
+                )
+
+        # Each dump only holds the changes, so carry the values forward
+        last = {stat: -1 for stat in selected}
+
+        def update(stat):
+            def apply(dump, pairs, values):
+                array = selected[stat]
+                if last[stat] >= 0:
+                    array[last[stat] + 1 : dump + 1] = array[last[stat]]
+                if values is not None:
+                    array[dump] = values
+                else:
+                    for index, value in pairs:
+                        array[dump, index] = value
+                last[stat] = dump
+
+            return apply
+
+        self._records({stat: update(stat) for stat in selected})
+
+        result = {}
+        for stat, array in selected.items():
+            if last[stat] >= 0:
+                array[last[stat] + 1 :] = array[last[stat]]
+            if self.stats[stat].kind == "scalar":
+                array = array[:, 0]
+            result[self.stats[stat].name] = array
+        return result
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(
+        description="Print stats of a binary stat file at every dump"
+    )
+    parser.add_argument("file", help="Binary stat file")
+    parser.add_argument(
+        "stats", nargs="*", default=["*"], help="Stat names or patterns"
+    )
+    args = parser.parse_args()
+
+    stats = BinaryStats(args.file)
+    values = stats.load(args.stats)
+    header = ["tick"]
+    for name, array in values.items():
+        labels = stats.stat(name).labels
+        if array.ndim == 1:
+            header.append(name)
+        else:
+            header.extend(f"{name}::{label}" for label in labels)
+    print(",".join(header))
+    for dump, tick in enumerate(stats.ticks):
+        row = [str(tick)]
+        for array in values.values():
+            if array.ndim == 1:
+                row.append(repr(float(array[dump])))
+            else:
+                row.extend(repr(float(v)) for v in array[dump])
+        print(",".join(row))
+
+
+if __name__ == "__main__":
+    main()
@@ -42,6 +42,8 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
+#include "base/stats/filter.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -114,6 +116,7 @@ pybind_init_stats(py::module_ &m_native)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
+        .def("initBinary", &statistics::initBinary)
         .def("registerPythonStatsHandlers",
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
@@ -121,6 +124,8 @@ pybind_init_stats(py::module_ &m_native)
         .def("updateEvents", &statistics::updateEvents)
         .def("processResetQueue", &statistics::processResetQueue)
         .def("processDumpQueue", &statistics::processDumpQueue)
+        .def("beginFormulaCache", &statistics::beginFormulaCache)
+        .def("endFormulaCache", &statistics::endFormulaCache)
         .def("enable", &statistics::enable)
         .def("enabled", &statistics::enabled)
         .def("statsList", &statistics::statsList)
@@ -134,6 +139,14 @@ pybind_init_stats(py::module_ &m_native)
         .def("endGroup", &statistics::Output::endGroup)
         ;
 
+    py::class_<statistics::DumpFilter>(m, "DumpFilter")
+        .def(py::init<const std::vector<std::string> &, bool>())
+        .def("prepare", &statistics::DumpFilter::prepare,
+             py::arg("group"), py::arg("path") = "")
+        .def("visit", &statistics::DumpFilter::visit,
+             py::arg("group"), py::arg("output"), py::arg("path") = "")
+        ;
+
     py::class_<statistics::Info,
         std::unique_ptr<statistics::Info, py::nodelete>>(m, "Info")
         .def_readwrite("name", &statistics::Info::name)
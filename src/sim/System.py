@@ -49,6 +49,18 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+class HugePageMode(ScopedEnum):
+    """How the host backing store of the guest memory uses huge pages"""
+
+    vals = ["none", "transparent", "hugetlb_2MB", "hugetlb_1GB"]
+
+
+class CheckpointStoreFormat(ScopedEnum):
+    """Format of the backing store in checkpoints"""
+
+    vals = ["gzip", "paged"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -104,6 +116,41 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Large guest memories put a lot of pressure on the host TLB. The
+    # backing store can either be advised as eligible for transparent
+    # huge pages, or be mapped explicitly from the hugetlbfs pool, in
+    # which case enough huge pages must have been reserved on the host
+    # (e.g. through /proc/sys/vm/nr_hugepages).
+    backstore_huge_pages = Param.HugePageMode(
+        "none", "Host huge pages used for the backing store"
+    )
+
+    # On multi-socket hosts, the backing store of a memory can be bound
+    # to the host NUMA node local to the thread running its event
+    # queue, to avoid cross-socket traffic in parallel simulations.
+    eventq_numa_nodes = VectorParam.Int(
+        [],
+        "Host NUMA node of each event queue thread, the backing store of "
+        "a memory is bound to the node of its event queue. A single entry "
+        "binds all the backing stores to that node, and an empty list "
+        "leaves the placement to the host.",
+    )
+
+    # The gzip format is a compressed image of the whole backing
+    # store. The paged format skips zero pages, saves identical pages
+    # once, and compresses chunks of pages on multiple host threads,
+    # which makes large memories much faster to save and restore. The
+    # format of a checkpoint is recorded in it, so restoring does not
+    # depend on this parameter.
+    checkpoint_store_format = Param.CheckpointStoreFormat(
+        "gzip", "Format of the backing store in checkpoints"
+    )
+    checkpoint_store_threads = Param.Unsigned(
+        0,
+        "Host threads used to save and restore the backing store in the "
+        "paged format, 0 to use all of them",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
@@ -75,6 +75,10 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostMinorPageFaults, statistics::units::Count::get(),
+             "Number of host page faults served without I/O"),
+    ADD_STAT(hostMajorPageFaults, statistics::units::Count::get(),
+             "Number of host page faults requiring I/O"),
 
     statTime(true),
     startTick(0)
@@ -88,6 +92,16 @@ Root::RootStats::RootStats()
         .prereq(hostMemory)
         ;
 
+    hostMinorPageFaults
+        .functor([]() { return pageFaults(false); })
+        .prereq(hostMinorPageFaults)
+        ;
+
+    hostMajorPageFaults
+        .functor([]() { return pageFaults(true); })
+        .prereq(hostMajorPageFaults)
+        ;
+
     hostSeconds
         .functor([this]() {
                 Time now;
@@ -109,6 +109,8 @@ class Root : public SimObject
 
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
+        statistics::Value hostMinorPageFaults;
+        statistics::Value hostMajorPageFaults;
 
         static RootStats instance;
 
@@ -0,0 +1,221 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run a workload on copies of a system whose CPUs only differ in the value
+of one parameter, and check that the copies commit the same instructions
+at the same ticks and end after the same number of cycles. This is meant
+for the parameters that choose between implementations of the same
+behaviour, which must not change the simulated timing. With --ignore-ticks,
+only the order of the commits is compared, for the parameters that move
+commits within the cycles the CPU accounts for.
+"""
+
+import argparse
+import hashlib
+import os
+import sys
+
+import m5
+from m5.objects import *
+
+valid_cpu = {
+    "ArmMinorCPU": ArmMinorCPU,
+    "ArmDerivO3CPU": ArmO3CPU,
+    "RiscvMinorCPU": RiscvMinorCPU,
+    "RiscvDerivO3CPU": RiscvO3CPU,
+    "ArmNonCachingSimpleCPU": ArmNonCachingSimpleCPU,
+    "RiscvNonCachingSimpleCPU": RiscvNonCachingSimpleCPU,
+}
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", type=str)
+parser.add_argument("--cpu", choices=valid_cpu.keys(), required=True)
+parser.add_argument("--param", required=True, help="CPU parameter to vary")
+parser.add_argument(
+    "--values", nargs="+", required=True, help="Values of the parameter"
+)
+parser.add_argument(
+    "--trace-ticks",
+    type=int,
+    default=100000000,
+    help="Compare the committed instructions up to this tick",
+)
+parser.add_argument(
+    "--ignore-ticks",
+    action="store_true",
+    help="Compare the committed instructions without their ticks",
+)
+parser.add_argument(
+    "--report",
+    nargs="*",
+    default=[],
+    help="CPU stats to print for each value",
+)
+parser.add_argument(
+    "--expect-zero",
+    nargs="*",
+    default=[],
+    help="CPU stats which must be zero for each value, when they exist",
+)
+
+args = parser.parse_args()
+
+
+def create_system(value):
+    system = System()
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = "1GHz"
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_ranges = [AddrRange("512MB")]
+
+    system.cpu = valid_cpu[args.cpu]()
+    setattr(system.cpu, args.param, value)
+
+    system.membus = SystemXBar()
+    if isinstance(system.cpu, BaseNonCachingSimpleCPU):
+        system.mem_mode = "atomic_noncaching"
+        system.cpu.icache_port = system.membus.cpu_side_ports
+        system.cpu.dcache_port = system.membus.cpu_side_ports
+    else:
+        system.mem_mode = "timing"
+        add_caches(system)
+    system.cpu.createInterruptController()
+
+    system.mem_ctrl = SimpleMemory(latency="30ns")
+    system.mem_ctrl.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.mem_side_ports
+    system.system_port = system.membus.cpu_side_ports
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    return system
+
+
+def add_caches(system):
+    system.cpu.l1i = Cache(
+        size="32kB",
+        assoc=8,
+        tag_latency=1,
+        data_latency=1,
+        response_latency=1,
+        mshrs=16,
+        tgts_per_mshr=20,
+    )
+    system.cpu.l1d = Cache(
+        size="32kB",
+        assoc=8,
+        tag_latency=1,
+        data_latency=1,
+        response_latency=1,
+        mshrs=16,
+        tgts_per_mshr=20,
+    )
+    system.cpu.l1i.cpu_side = system.cpu.icache_port
+    system.cpu.l1i.mem_side = system.membus.cpu_side_ports
+    system.cpu.l1d.cpu_side = system.cpu.dcache_port
+    system.cpu.l1d.mem_side = system.membus.cpu_side_ports
+
+
+# The systems are independent, so sharing the event queue does not
+# change the timing of any of them
+root = Root(full_system=False)
+systems = {}
+for value in args.values:
+    name = f"system_{value.lower()}"
+    systems[name] = create_system(value)
+    setattr(root, name, systems[name])
+
+m5.instantiate()
+
+trace_file = "exec.trace"
+m5.trace.output(trace_file)
+m5.debug.flags["Exec"].enable()
+exit_event = m5.simulate(args.trace_ticks)
+m5.debug.flags["Exec"].disable()
+if exit_event.getCause() == "simulate() limit reached":
+    exit_event = m5.simulate()
+
+if exit_event.getCause() != "exiting with last active thread context":
+    print(f"Unexpected exit: {exit_event.getCause()}")
+    sys.exit(1)
+
+# Hash the commit stream of each system, with the tick of each commit
+# unless it is ignored
+digests = {name: hashlib.sha256() for name in systems}
+commits = dict.fromkeys(systems, 0)
+with open(os.path.join(m5.options.outdir, trace_file)) as trace:
+    for line in trace:
+        fields = line.split(": ", 2)
+        if len(fields) != 3 or fields[1].split(".")[0] not in digests:
+            continue
+        tick, obj, message = fields
+        name = obj.split(".")[0]
+        if args.ignore_ticks:
+            digests[name].update(message.encode())
+        else:
+            digests[name].update(f"{tick}:{message}".encode())
+        commits[name] += 1
+
+failed = False
+reference = args.values[0]
+ref_name = f"system_{reference.lower()}"
+ref_cpu = systems[ref_name].cpu
+for value in args.values:
+    name = f"system_{value.lower()}"
+    cpu = systems[name].cpu
+
+    print(f"{args.param}={value}:")
+    print(f"  traced commits: {commits[name]}")
+    for stat in ["numCycles", "commitStats0.numInsts"] + args.report:
+        info = cpu.resolveStat(stat)
+        if info is not None:
+            print(f"  {stat}: {info.value:.0f}")
+
+    for stat in args.expect_zero:
+        info = cpu.resolveStat(stat)
+        if info is not None and info.value != 0:
+            print(f"  {stat} should be zero")
+            failed = True
+
+    if value == reference:
+        continue
+    if digests[name].digest() != digests[ref_name].digest():
+        print(f"  commit stream differs from {args.param}={reference}")
+        failed = True
+    for stat in ("numCycles", "commitStats0.numInsts"):
+        if cpu.resolveStat(stat).value != ref_cpu.resolveStat(stat).value:
+            print(f"  {stat} differs from {args.param}={reference}")
+            failed = True
+
+if commits[ref_name] == 0:
+    print("No commit traced, the binary may have been built without tracing")
+
+if failed:
+    sys.exit(1)
@@ -95,3 +95,82 @@ for isa in valid_isas:
                 valid_isas=(constants.all_compiled_tag,),
                 fixtures=[workload_binary],
             )
+
+# Parameters which choose between implementations of the same behaviour.
+# Each test runs the workload with every value of the parameter, and
+# checks that the commit streams and cycle counts match.
+variant_tests = {
+    "o3_iq_scheduler": (
+        "DerivO3CPU",
+        ["--param", "iqScheduler", "--values", "ListOrder", "ReadyBitmap"],
+    ),
+    # Validate ticks every cycle, and counts the cycles Skip would have
+    # skipped, and the ones where skipping would have changed the timing
+    "o3_cycle_skipping": (
+        "DerivO3CPU",
+        [
+            "--param",
+            "cycleSkipping",
+            "--values",
+            "Off",
+            "Skip",
+            "Validate",
+            "--report",
+            "skippedCycles",
+            "skippableCycles",
+            "skipMispredicts",
+            "--expect-zero",
+            "skipMispredicts",
+        ],
+    ),
+    "minor_cycle_skipping": (
+        "MinorCPU",
+        [
+            "--param",
+            "cycleSkipping",
+            "--values",
+            "Off",
+            "Skip",
+            "Validate",
+            "--report",
+            "skippedCycles",
+            "skippableCycles",
+            "skipMispredicts",
+            "--expect-zero",
+            "skipMispredicts",
+        ],
+    ),
+    # A fast functional batch commits at the tick it starts at, but must
+    # account for the same cycles as ticking every cycle
+    "atomic_fast_functional": (
+        "NonCachingSimpleCPU",
+        [
+            "--param",
+            "fast_functional",
+            "--values",
+            "False",
+            "True",
+            "--ignore-ticks",
+        ],
+    ),
+}
+
+cpu_prefix = {constants.arm_tag: "Arm", constants.riscv_tag: "Riscv"}
+
+for isa in cpu_prefix:
+    path = joinpath(base_path, isa.lower())
+    for workload in workloads:
+        url = isa_url[isa] + "/" + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        for name, (cpu, args) in variant_tests.items():
+            gem5_verify_config(
+                name=f"cpu_variants_{name}_{isa}_{workload}",
+                verifiers=(),  # The config returns non-zero on fail
+                config=joinpath(getcwd(), "compare_variants.py"),
+                config_args=[binary, f"--cpu={cpu_prefix[isa]}{cpu}"] + args,
+                valid_isas=(constants.all_compiled_tag,),
+                length=constants.long_tag,
+                fixtures=[workload_binary],
+            )
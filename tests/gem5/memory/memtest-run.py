@@ -24,12 +24,24 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import argparse
+
 import m5
 from m5.objects import *
 
 m5.util.addToPath("../../../configs/")
 from common.Caches import *
 
+parser = argparse.ArgumentParser(description="Cache coherence memory tester")
+parser.add_argument(
+    "--bounded-snoop-filter",
+    action="store_true",
+    help="Track the L1 caches with a tiny bounded snoop filter, so that "
+    "lines are evicted from it and back-invalidated in the L1s",
+)
+
+args = parser.parse_args()
+
 # MAX CORES IS 8 with the fals sharing method
 nb_cores = 8
 cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
@@ -49,6 +61,13 @@ system.cpu_clk_domain = SrcClockDomain(
 )
 
 system.toL2Bus = L2XBar(clk_domain=system.cpu_clk_domain)
+if args.bounded_snoop_filter:
+    # 256 lines in 16 sets, far less than the 1024 lines the testers
+    # share, and with enough ways that a set never has all its lines
+    # waiting for responses
+    system.toL2Bus.snoop_filter = SnoopFilter(
+        lookup_latency=0, bounded=True, max_capacity="16KiB", assoc=16
+    )
 system.l2c = L2Cache(clk_domain=system.cpu_clk_domain, size="64kB", assoc=8)
 system.l2c.cpu_side = system.toL2Bus.mem_side_ports
 
@@ -80,3 +99,17 @@ m5.instantiate()
 exit_event = m5.simulate()
 if exit_event.getCause() != "maximum number of loads reached":
     exit(1)
+
+if args.bounded_snoop_filter:
+    # The testers check every value they load, so a cache that kept a
+    # line after its snoop filter entry was evicted would have missed
+    # later snoops and failed the run by now. What is left is making
+    # sure the run evicted lines that some L1 held, i.e. that the
+    # crossbar sent them a CleanInvalidReq.
+    snoop_filter = system.toL2Bus.snoop_filter
+    evictions = snoop_filter.resolveStat("evictions").value
+    back_invalidations = snoop_filter.resolveStat("backInvalidations").value
+    print(f"Snoop filter evictions: {evictions:.0f}")
+    print(f"Snoop filter back-invalidations: {back_invalidations:.0f}")
+    if evictions == 0 or back_invalidations == 0:
+        exit(1)
@@ -70,6 +70,15 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+gem5_verify_config(
+    name="memtest_bounded_snoop_filter",
+    verifiers=(),  # The config returns non-zero on fail
+    config=joinpath(getcwd(), "memtest-run.py"),
+    config_args=["--bounded-snoop-filter"],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
@@ -0,0 +1,123 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import gzip
+import math
+import os
+import tempfile
+import unittest
+
+from m5.stats.binary import BinaryStats
+
+# The stat file written by the dump sequence of src/base/stats/binary.test.cc,
+# whose Format test checks that the writer still produces these bytes. The
+# dumps are at ticks 100 to 400; sys.freq never changes, late.stat first
+# appears in the third dump and the last dump changes nothing.
+SEQUENCE = bytes.fromhex(
+    "67656d3573746174010000005305097379732e636f756e740005436f756e7400"
+    "0100087379732e667265710005436f756e74000100077379732e766563010543"
+    "6f756e740003016101620163087379732e646973740205436f756e74000e0773"
+    "616d706c65730373756d0773717561726573096d696e5f76616c7565096d6178"
+    "5f76616c75650a756e646572666c6f7773096f766572666c6f7773036d696e03"
+    "6d61780b6275636b65745f73697a65076275636b657430076275636b65743107"
+    "6275636b657432076275636b657433097379732e726174696f0505526174696f"
+    "00010130446400000000000000050001000000000000f03f0101000000000040"
+    "8f400203000000000000f03f00000000000000000000000000000000030e0000"
+    "000000000040000000000000f03f000000000000f03f00000000000000000000"
+    "00000000f03f0000000000000000000000000000000000000000000000000000"
+    "000000000840000000000000f03f000000000000f03f000000000000f03f0000"
+    "00000000000000000000000000000401fca9f1d24d62503f44c8000000000000"
+    "0004000100000000000000400201010000000000001440030500000000000000"
+    "08400100000000000008400200000000000014400400000000000000400c0000"
+    "00000000f03f0401fca9f1d24d62603f5301096c6174652e737461740005436f"
+    "756e74000100442c010000000000000405010000000000001040000100000000"
+    "000008400203000000000000004000000000000018400000000000001c400401"
+    "fa7e6abc7493683f44900100000000000000"
+)
+
+
+def dist(samples, total, squares, min_val, max_val, buckets):
+    return [samples, total, squares, min_val, max_val, 0, 0, 0, 3, 1] + buckets
+
+
+class BinaryStatsTestSuite(unittest.TestCase):
+    """Reads back the stat file written by the binary stat output"""
+
+    def open(self, data=SEQUENCE):
+        fd, path = tempfile.mkstemp(suffix=".bin")
+        with os.fdopen(fd, "wb") as f:
+            f.write(data)
+        self.addCleanup(os.remove, path)
+        return BinaryStats(path)
+
+    def test_schema(self):
+        stats = self.open()
+        self.assertEqual(
+            stats.names(),
+            [
+                "sys.count",
+                "sys.freq",
+                "sys.vec",
+                "sys.dist",
+                "sys.ratio",
+                "late.stat",
+            ],
+        )
+        self.assertEqual(stats.names("sys.*")[-1], "sys.ratio")
+        self.assertEqual(
+            [stats.stat(name).kind for name in stats.names()],
+            ["scalar", "scalar", "vector", "dist", "formula", "scalar"],
+        )
+        self.assertEqual(stats.stat("sys.vec").labels, ["a", "b", "c"])
+        self.assertEqual(stats.stat("sys.ratio").unit, "Ratio")
+        self.assertEqual(stats.ticks, [100, 200, 300, 400])
+
+    def test_values(self):
+        values = self.open().load(["sys.*"])
+        self.assertEqual(values["sys.count"].tolist(), [1, 2, 3, 3])
+        self.assertEqual(values["sys.freq"].tolist(), [1000] * 4)
+        self.assertEqual(
+            values["sys.vec"].tolist(),
+            [[1, 0, 0], [1, 5, 0], [2, 6, 7], [2, 6, 7]],
+        )
+        self.assertEqual(
+            values["sys.ratio"].tolist(),
+            [[0.001], [0.002], [0.003], [0.003]],
+        )
+        one = dist(2, 1, 1, 0, 1, [1, 1, 0, 0])
+        two = dist(3, 3, 5, 0, 2, [1, 1, 1, 0])
+        self.assertEqual(values["sys.dist"].tolist(), [one, two, two, two])
+        self.assertNotIn("late.stat", values)
+
+    def test_late_stat(self):
+        late = self.open().load(["late.stat"])["late.stat"].tolist()
+        self.assertTrue(math.isnan(late[0]) and math.isnan(late[1]))
+        self.assertEqual(late[2:], [4, 4])
+
+    def test_gzip(self):
+        values = self.open(gzip.compress(SEQUENCE)).load(["sys.count"])
+        self.assertEqual(values["sys.count"].tolist(), [1, 2, 3, 3])
+
+    def test_not_a_stat_file(self):
+        with self.assertRaises(ValueError):
+            self.open(b"---------text")
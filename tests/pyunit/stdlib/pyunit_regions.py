@@ -0,0 +1,128 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import os
+import tempfile
+import unittest
+
+from gem5.utils.multiprocessing.regions import (
+    _parse_text_stats,
+    merge_region_stats,
+    stat_kind,
+)
+
+STATS = """
+---------- Begin Simulation Statistics ----------
+simSeconds                0.001000 # Number of seconds simulated (Second)
+simFreq          1000000000000 # Ticks per second ((Tick/Second))
+hostMemory                 1048576 # Number of bytes of host memory used (Byte)
+system.cpu.numCycles          2000 # Number of cpu cycles simulated (Cycle)
+system.cpu.committedInsts     1000 # Number of instructions committed (Count)
+system.cpu.ipc            0.500000 # Instructions per cycle ((Count/Cycle))
+system.cpu.dcache.missRate::total 0.250000 # Miss rate (Ratio)
+system.cpu.lat::mean      3.000000 # Latency (Cycle)
+system.cpu.lat::min_value        2 # Latency (Cycle)
+system.cpu.lat::max_value        7 # Latency (Cycle)
+system.cpu.op_class::IntAlu    600 60.00% 60.00% # Class of ops (Count)
+system.cpu.old              12 # A stat without a unit
+---------- End Simulation Statistics   ----------
+"""
+
+
+def region(scale):
+    """The stats of a region running scale times as long as the first"""
+    stats = {
+        "system.cpu.numCycles": (2000.0 * scale, "Cycle"),
+        "system.cpu.committedInsts": (1000.0 * scale, "Count"),
+        "system.cpu.ipc": (0.5, "(Count/Cycle)"),
+        "simFreq": (1e12, "(Tick/Second)"),
+        "system.cpu.lat::min_value": (2.0, "Cycle"),
+        "system.cpu.lat::max_value": (7.0, "Cycle"),
+        "system.cpu.old": (12.0, None),
+    }
+    return stats
+
+
+class RegionStatsTestSuite(unittest.TestCase):
+    """Tests the merging of the stats of sampled regions"""
+
+    def test_parse(self):
+        fd, path = tempfile.mkstemp(suffix=".txt")
+        with os.fdopen(fd, "w") as f:
+            f.write(STATS)
+        self.addCleanup(os.remove, path)
+        stats = _parse_text_stats(path, -1)
+        self.assertEqual(stats["simSeconds"], (0.001, "Second"))
+        self.assertEqual(stats["simFreq"], (1e12, "(Tick/Second)"))
+        self.assertEqual(stats["system.cpu.ipc"], (0.5, "(Count/Cycle)"))
+        self.assertEqual(
+            stats["system.cpu.op_class::IntAlu"], (600.0, "Count")
+        )
+        self.assertEqual(stats["system.cpu.old"], (12.0, None))
+
+    def test_kinds(self):
+        self.assertEqual(stat_kind("system.cpu.numCycles", "Cycle"), "counter")
+        self.assertEqual(stat_kind("simSeconds", "Second"), "counter")
+        self.assertEqual(stat_kind("system.cpu.op::total", "Count"), "counter")
+        self.assertEqual(stat_kind("system.cpu.ipc", "(Count/Cycle)"), "ratio")
+        self.assertEqual(stat_kind("simFreq", "(Tick/Second)"), "ratio")
+        self.assertEqual(stat_kind("system.l2.missRate", "Ratio"), "ratio")
+        self.assertEqual(stat_kind("system.cpu.lat::mean", "Cycle"), "ratio")
+        self.assertEqual(stat_kind("hostMemory", "Byte"), "max")
+        self.assertEqual(stat_kind("system.lat::min_value", "Cycle"), "min")
+        self.assertEqual(stat_kind("system.lat::max_value", "Cycle"), "max")
+        self.assertEqual(stat_kind("system.cpu.old", None), "unknown")
+
+    def test_merge(self):
+        slow = region(2)
+        slow["system.cpu.ipc"] = (0.25, "(Count/Cycle)")
+        slow["system.cpu.lat::min_value"] = (1.0, "Cycle")
+        merged = merge_region_stats([(3.0, region(1)), (1.0, slow)])
+        self.assertEqual(
+            merged["system.cpu.numCycles"],
+            {"kind": "counter", "value": 3 * 2000 + 4000},
+        )
+        self.assertEqual(merged["system.cpu.committedInsts"]["value"], 5000)
+        # Ratios and rates are weighted means, not weighted sums
+        self.assertEqual(
+            merged["system.cpu.ipc"],
+            {"kind": "ratio", "value": (3 * 0.5 + 0.25) / 4},
+        )
+        self.assertEqual(merged["simFreq"], {"kind": "ratio", "value": 1e12})
+        self.assertEqual(merged["system.cpu.lat::min_value"]["value"], 1)
+        self.assertEqual(merged["system.cpu.lat::max_value"]["value"], 7)
+        self.assertEqual(
+            merged["system.cpu.old"], {"kind": "unknown", "value": None}
+        )
+
+    def test_merge_normalized(self):
+        merged = merge_region_stats(
+            [(0.75, region(1)), (0.25, region(2))], normalize=True
+        )
+        self.assertEqual(merged["system.cpu.numCycles"]["value"], 2500)
+        self.assertEqual(merged["system.cpu.ipc"]["value"], 0.5)
+        self.assertEqual(merged["simFreq"]["value"], 1e12)
+
+    def test_ratio_missing_from_regions(self):
+        merged = merge_region_stats([(1.0, region(1)), (3.0, {})])
+        self.assertEqual(merged["system.cpu.ipc"]["value"], 0.5)
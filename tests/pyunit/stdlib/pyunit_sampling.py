@@ -0,0 +1,187 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import unittest
+from unittest import mock
+
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+from gem5.simulate.sampling import SMARTSSampler
+
+# Ticks per cycle of the board clock
+PERIOD = 500
+
+
+class FakeCore:
+    """A core whose committed instructions are set by the test"""
+
+    def __init__(self, cpu_type):
+        self.cpu_type = cpu_type
+        self.insts = 0
+        # (instructions, scheduled after an exit) of each stop scheduled
+        self.stops = []
+
+    def get_type(self):
+        return self.cpu_type
+
+    def get_simobject(self):
+        return mock.Mock(totalInsts=lambda: self.insts)
+
+    def _set_inst_stop_any_thread(self, insts, already_started):
+        self.stops.append((insts, already_started))
+
+
+class SMARTSSamplerTestSuite(unittest.TestCase):
+    """Tests the phases and the estimate of the SMARTS sampler"""
+
+    def setUp(self):
+        self.tick = 0
+        patcher = mock.patch("m5.curTick", lambda: self.tick)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def sampler(self, cpu_type=CPUTypes.ATOMIC, **kwargs):
+        self.core = FakeCore(cpu_type)
+        self.processor = mock.create_autospec(
+            SimpleSwitchableProcessor, instance=True
+        )
+        self.processor.get_cores.return_value = [self.core]
+        board = mock.Mock()
+        board.get_processor.return_value = self.processor
+        board.get_clock_domain.return_value.clock = [
+            mock.Mock(getValue=lambda: PERIOD)
+        ]
+        return SMARTSSampler(board=board, **kwargs)
+
+    def run_unit(self, generator, insts, cycles):
+        """Run a sampling period, measuring a unit at the given IPC"""
+        self.assertFalse(next(generator))  # to detailed warmup
+        self.assertFalse(next(generator))  # to measurement
+        self.core.insts += insts
+        self.tick += cycles * PERIOD
+        return next(generator)  # back to functional warming
+
+    def test_requires_atomic_start(self):
+        with self.assertRaises(Exception):
+            self.sampler(cpu_type=CPUTypes.O3)
+        with self.assertRaises(Exception):
+            self.sampler(cpu_type=CPUTypes.TIMING)
+
+    def test_phases(self):
+        sampler = self.sampler(
+            unit_size=1000, detailed_warmup=2000, period=10000
+        )
+        # The first functional warming is set before instantiation
+        self.assertEqual(self.core.stops, [(7000, False)])
+
+        generator = sampler.get_generator()
+        self.assertFalse(next(generator))
+        self.assertEqual(self.processor.switch.call_count, 1)
+        self.assertEqual(self.core.stops[-1], (2000, True))
+
+        self.assertFalse(next(generator))
+        self.assertEqual(self.processor.switch.call_count, 1)
+        self.assertEqual(self.core.stops[-1], (1000, True))
+
+        self.core.insts = 1000
+        self.tick = 4000 * PERIOD
+        self.assertFalse(next(generator))
+        self.assertEqual(self.processor.switch.call_count, 2)
+        self.assertEqual(self.core.stops[-1], (7000, True))
+        self.assertEqual(
+            sampler.get_units(),
+            [{"start_tick": 0, "insts": 1000, "cycles": 4000, "ipc": 0.25}],
+        )
+
+    def test_no_detailed_warmup(self):
+        sampler = self.sampler(unit_size=1000, detailed_warmup=0, period=5000)
+        self.assertEqual(self.core.stops, [(4000, False)])
+
+        generator = sampler.get_generator()
+        self.assertFalse(next(generator))
+        self.assertEqual(self.core.stops[-1], (1000, True))
+        self.assertFalse(next(generator))
+        self.assertEqual(self.core.stops[-1], (4000, True))
+        self.assertEqual(len(sampler.get_units()), 1)
+
+    def test_confidence_interval(self):
+        sampler = self.sampler(confidence=0.95, min_units=3)
+        self.assertIsNone(sampler.get_ipc())
+        self.assertIsNone(sampler.get_confidence_interval())
+
+        generator = sampler.get_generator()
+        for cycles in (1000, 500, 250):
+            self.run_unit(generator, 1000, cycles)
+
+        # IPCs 1, 2 and 4: mean 7/3, standard deviation sqrt(7/3), and
+        # z = 1.95996 at 95%
+        self.assertAlmostEqual(sampler.get_ipc(), 7 / 3)
+        interval = 1.959964 * (7 / 3) ** 0.5 / 3**0.5
+        self.assertAlmostEqual(
+            sampler.get_confidence_interval(), interval, places=5
+        )
+        self.assertAlmostEqual(
+            sampler.get_relative_error(), interval / (7 / 3), places=5
+        )
+
+    def test_z_score(self):
+        # IPCs 1 and 3: mean 2 and a standard error of 1, so the interval
+        # is z, two sided, i.e. 2.96774 at 99.7%
+        sampler = self.sampler(confidence=0.997)
+        generator = sampler.get_generator()
+        self.run_unit(generator, 1000, 1000)
+        self.run_unit(generator, 3000, 1000)
+        self.assertAlmostEqual(
+            sampler.get_confidence_interval(), 2.967738, places=5
+        )
+        self.assertAlmostEqual(
+            sampler.get_relative_error(), 2.967738 / 2, places=5
+        )
+
+    def test_stops_at_target_error(self):
+        sampler = self.sampler(min_units=3, target_error=0.03)
+        generator = sampler.get_generator()
+
+        # The IPC does not vary at all, but it takes min_units units to
+        # stop
+        self.assertFalse(self.run_unit(generator, 1000, 1000))
+        self.assertFalse(self.run_unit(generator, 1000, 1000))
+        self.assertTrue(self.run_unit(generator, 1000, 1000))
+        self.assertEqual(sampler.get_relative_error(), 0)
+
+        # Resuming measures another unit, after which the target error is
+        # still met
+        self.assertTrue(self.run_unit(generator, 1000, 1000))
+        self.assertEqual(len(sampler.get_units()), 4)
+
+    def test_stops_at_max_units(self):
+        sampler = self.sampler(min_units=2, max_units=3, target_error=0.01)
+        generator = sampler.get_generator()
+
+        # The IPC varies too much to ever reach the target error
+        self.assertFalse(self.run_unit(generator, 1000, 1000))
+        self.assertFalse(self.run_unit(generator, 1000, 250))
+        self.assertTrue(self.run_unit(generator, 1000, 1000))
+        self.assertGreater(sampler.get_relative_error(), 0.01)
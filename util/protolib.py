@@ -68,17 +68,187 @@
 # with protobuf python messages. For eg, the decode scripts for different
 # types of proto objects can use the same function to decode a single message
 
+import bisect
 import gzip
+import io
 import struct
+import zlib
+
+
+class BlockTraceFile:
+    """
+    A block trace (see src/proto/blockio.hh) read as the stream of length
+    prefixed messages the other trace files hold, so that the decode
+    scripts read it unchanged. seek_record and seek_key move to a message
+    through the index of the blocks, decompressing only the block that
+    holds it.
+    """
+
+    magic = 0x6B6C6267
+    version = 1
+    block_header = struct.Struct("<IIIIQQ")
+    index_entry = struct.Struct("<QQQQII")
+    footer = struct.Struct("<QQII")
+
+    def __init__(self, in_file):
+        self._file = open(in_file, "rb")
+        magic, version = struct.unpack("<II", self._file.read(8))
+        if magic != self.magic or version != self.version:
+            raise OSError(f"{in_file} is not a block trace version 1")
+        self._index = self._read_index()
+        self._last_keys = [entry[3] for entry in self._index]
+        self._first_records = [entry[1] for entry in self._index]
+        # Pending bytes of the stream, which starts with the magic number
+        # of the other trace files
+        self._buf = b"gem5"
+        self._next_block = 0
+
+    def _read_index(self):
+        self._file.seek(0, 2)
+        file_size = self._file.tell()
+        if file_size >= 8 + self.footer.size:
+            self._file.seek(file_size - self.footer.size)
+            offset, blocks, version, magic = self.footer.unpack(
+                self._file.read(self.footer.size)
+            )
+            size = blocks * self.index_entry.size
+            if (
+                magic == self.magic
+                and version == self.version
+                and offset + size + self.footer.size == file_size
+            ):
+                self._file.seek(offset)
+                data = self._file.read(size)
+                return list(self.index_entry.iter_unpack(data))
+
+        # The writer did not finish, walk the blocks instead
+        index = []
+        offset = 8
+        records = 0
+        while offset + self.block_header.size <= file_size:
+            self._file.seek(offset)
+            header = self.block_header.unpack(
+                self._file.read(self.block_header.size)
+            )
+            end = offset + self.block_header.size + header[1]
+            if end > file_size:
+                break
+            index.append((offset, records, header[4], header[5], header[3], 0))
+            records += header[3]
+            offset = end
+        return index
+
+    def _load_block(self, block):
+        """Return the sizes, keys and payloads of the records of a block"""
+        self._file.seek(self._index[block][0])
+        codec, compressed_size, raw_size, records, first_key, _ = (
+            self.block_header.unpack(self._file.read(self.block_header.size))
+        )
+        data = self._file.read(compressed_size)
+        if codec == 1:
+            data = zlib.decompress(data)
+        elif codec == 2:
+            import zstandard
+
+            data = zstandard.ZstdDecompressor().decompress(
+                data, max_output_size=raw_size
+            )
+
+        pos = 0
+        columns = []
+        for _ in range(2):
+            column = []
+            for _ in range(records):
+                value, pos = _DecodeVarint(data, pos)
+                column.append(value)
+            columns.append(column)
+        sizes, keys = columns
+        keys = [first_key + key for key in keys]
+        payloads = []
+        for size in sizes:
+            payloads.append(data[pos : pos + size])
+            pos += size
+        return keys, payloads
+
+    def _stream(self, payloads):
+        out = io.BytesIO()
+        for payload in payloads:
+            _EncodeVarint32(out, len(payload))
+            out.write(payload)
+        return out.getvalue()
+
+    def read(self, size):
+        while len(self._buf) < size and self._next_block < len(self._index):
+            _, payloads = self._load_block(self._next_block)
+            self._buf += self._stream(payloads)
+            self._next_block += 1
+        data = self._buf[:size]
+        self._buf = self._buf[size:]
+        return data
+
+    def num_records(self):
+        if not self._index:
+            return 0
+        return self._index[-1][1] + self._index[-1][4]
+
+    def _seek(self, block, payloads, first):
+        self._buf = self._stream(payloads[first:])
+        self._next_block = block + 1
+
+    def seek_record(self, record):
+        """
+        Move to a message, the header being message 0. Return False if the
+        trace has fewer messages.
+        """
+        if record >= self.num_records():
+            self._buf = b""
+            self._next_block = len(self._index)
+            return False
+        block = bisect.bisect_right(self._first_records, record) - 1
+        _, payloads = self._load_block(block)
+        self._seek(block, payloads, record - self._first_records[block])
+        return True
+
+    def seek_key(self, key):
+        """
+        Move to the first message with a key, e.g. a tick, no smaller than
+        the given one. Return False if all the keys are smaller.
+        """
+        block = bisect.bisect_left(self._last_keys, key)
+        if block == len(self._index):
+            self._buf = b""
+            self._next_block = block
+            return False
+        keys, payloads = self._load_block(block)
+        self._seek(block, payloads, bisect.bisect_left(keys, key))
+        return True
+
+    def close(self):
+        self._file.close()
+
+
+def _DecodeVarint(data, pos):
+    result = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        result |= (b & 0x7F) << shift
+        if not (b & 0x80):
+            return (result, pos)
+        shift += 7
 
 
 def openFileRd(in_file):
     """
     This opens the file passed as argument for reading using an appropriate
     function depending on if it is gzipped or not. It returns the file
-    handle.
+    handle. Block traces are returned as a BlockTraceFile.
     """
     try:
+        with open(in_file, "rb") as f:
+            if f.read(4) == struct.pack("<I", BlockTraceFile.magic):
+                return BlockTraceFile(in_file)
         # First see if this file is gzipped
         try:
             # Opening the file works even if it is not a gzip file